@@ -4,6 +4,7 @@
 #include "GameFramework/Actor.h"
 #include "CoreMinimal.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimSequenceBase.h"
 
 
 
@@ -47,16 +48,26 @@ void UBMAnimNotifyState_HitBoxWindow::NotifyBegin(
         return;
     }
 
-    TArray<FName> Names;
+    uint64 Mask = 0;
     FBMHitBoxActivationParams Params;
-    if (!OwnerChar->ResolveHitBoxWindow(WindowId, Names, Params) || Names.Num() == 0)
+    if (bUseCombatContext)
+    {
+        OwnerChar->ResolveHitBoxWindow(WindowId, Mask, Params);
+    }
+    else
+    {
+        // Notify 为所有播放该动画的角色共享，掩码缓存在各自的 HitBox 组件上
+        Mask = HB->ResolveCachedHitBoxMask(this, HitBoxNamesOverride);
+    }
+
+    if (Mask == 0)
     {
         UE_LOG(LogBMHitBoxWindow, Warning, TEXT("[%s] NotifyBegin: No valid HitBox window context. (Window=%s)"),
             *OwnerChar->GetName(), *WindowId.ToString());
         return;
     }
 
-    HB->ActivateHitBoxesByNames(Names, Params);
+    HB->ActivateHitBoxesByMask(Mask, Params);
 }
 
 /*
@@ -83,3 +94,29 @@ void UBMAnimNotifyState_HitBoxWindow::NotifyEnd(
         HB->DeactivateAllHitBoxes();
     }
 }
+
+#if WITH_EDITOR
+/*
+ * @brief Validate animation, it reports hit box window notifies whose override names cannot be resolved
+ * @param Anim The animation
+ * @param HitBox The hit box component of the character
+ */
+void UBMAnimNotifyState_HitBoxWindow::ValidateAnimation(const UAnimSequenceBase* Anim, const UBMHitBoxComponent* HitBox)
+{
+    if (!Anim || !HitBox) return;
+
+    for (const FAnimNotifyEvent& Event : Anim->Notifies)
+    {
+        const UBMAnimNotifyState_HitBoxWindow* Window = Cast<UBMAnimNotifyState_HitBoxWindow>(Event.NotifyStateClass);
+        if (!Window || Window->bUseCombatContext) continue;
+
+        TArray<FName> Unresolved;
+        HitBox->ResolveHitBoxMask(Window->HitBoxNamesOverride, &Unresolved);
+        for (const FName& Name : Unresolved)
+        {
+            UE_LOG(LogBMHitBoxWindow, Warning, TEXT("[%s] HitBoxWindow '%s' at %.2fs references unknown HitBox '%s'."),
+                *Anim->GetName(), *Window->WindowId.ToString(), Event.GetTriggerTime(), *Name.ToString());
+        }
+    }
+}
+#endif
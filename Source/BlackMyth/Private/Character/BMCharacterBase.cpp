@@ -6,13 +6,17 @@
 #include "Character/Components/BMAnimEventComponent.h"
 #include "Character/Components/BMHitBoxComponent.h"
 #include "Character/Components/BMHurtBoxComponent.h"
+#include "Character/Animation/BMAnimNotifyState_HitBoxWindow.h"
 #include "Camera/BMCameraShakeSubsystem.h"
+#include "Core/BMDataSubsystem.h"
 
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 
 #include "Animation/AnimInstance.h"
+#include "Engine/GameInstance.h"
 #include "Components/PrimitiveComponent.h"
+#include "DrawDebugHelpers.h"
 
 DEFINE_LOG_CATEGORY(LogBMCharacter);
 
@@ -38,6 +42,8 @@ void ABMCharacterBase::BeginPlay()
     Super::BeginPlay();
 
     CacheHurtBoxes();
+    CacheVirtualHurtBoxBones();
+    CreateVirtualHurtBoxProxy();
 
     if (ensure(Stats))
     {
@@ -54,6 +60,9 @@ void ABMCharacterBase::BeginPlay()
         UPrimitiveComponent* Prim = Cast<UPrimitiveComponent>(C);
         if (!Prim) continue;
 
+        // Profile 默认已对 CameraBoom Ignore，只修正蓝图里改过 Profile 的组件
+        if (Prim->GetCollisionResponseToChannel(CameraBoomChannel) == ECR_Ignore) continue;
+
         // ֻ�� trace ��Ӧ
         Prim->SetCollisionResponseToChannel(CameraBoomChannel, ECR_Ignore);
     }
@@ -71,6 +80,27 @@ void ABMCharacterBase::Tick(float DeltaSeconds)
     {
         FSM->TickState(DeltaSeconds);
     }
+
+    if (bDebugDrawVirtualHurtBoxes)
+    {
+        for (int32 i = 0; i < VirtualHurtBoxes.Num(); ++i)
+        {
+            FTransform BoxToWorld;
+            if (!GetVirtualHurtBoxWorldTransform(i, BoxToWorld)) continue;
+
+            DrawDebugBox(
+                GetWorld(),
+                BoxToWorld.GetLocation(),
+                VirtualHurtBoxes[i].BoxExtent * BoxToWorld.GetScale3D(),
+                BoxToWorld.GetRotation(),
+                bVirtualHurtBoxesEnabled ? FColor::Cyan : FColor(0, 90, 90),
+                false,
+                0.0f,
+                0,
+                2.0f
+            );
+        }
+    }
 }
 
 /*
@@ -92,6 +122,240 @@ void ABMCharacterBase::CacheHurtBoxes()
     }
 }
 
+/*
+ * @brief Compile hit box mask, it resolves the hit box names of an attack spec into a bit mask once
+ * @param HitBoxNames The hit box names of the attack spec
+ * @param Anim The attack animation, only used for editor validation
+ * @param Context The log context
+ * @return The compiled hit box mask
+ */
+uint64 ABMCharacterBase::CompileHitBoxMask(const TArray<FName>& HitBoxNames, const UAnimSequenceBase* Anim, const FString& Context) const
+{
+    if (!HitBox)
+    {
+        return 0;
+    }
+
+    TArray<FName> Unresolved;
+    const uint64 Mask = HitBox->ResolveHitBoxMask(HitBoxNames, &Unresolved);
+    for (const FName& Name : Unresolved)
+    {
+        UE_LOG(LogBMCharacter, Warning, TEXT("[%s] Attack '%s' references unknown HitBox '%s'."),
+            *GetName(), *Context, *Name.ToString());
+    }
+
+#if WITH_EDITOR
+    UBMAnimNotifyState_HitBoxWindow::ValidateAnimation(Anim, HitBox);
+#else
+    (void)Anim;
+#endif
+
+    return Mask;
+}
+
+/*
+ * @brief Cache virtual hurt box bones, it resolves the bone index and the element bit sets of every virtual hurt box once
+ */
+void ABMCharacterBase::CacheVirtualHurtBoxBones()
+{
+    const USkeletalMeshComponent* MeshComp = GetMesh();
+
+    for (FBMHurtBoxDefinition& Def : VirtualHurtBoxes)
+    {
+        Def.WeaknessMask = BMGameplayBits::MakeElementMask(Def.WeaknessTypes);
+        Def.ResistanceMask = BMGameplayBits::MakeElementMask(Def.ResistanceTypes);
+
+        Def.CachedBoneIndex = INDEX_NONE;
+        if (!MeshComp || Def.AttachSocketOrBone.IsNone()) continue;
+
+        Def.CachedBoneIndex = MeshComp->GetBoneIndex(Def.AttachSocketOrBone);
+        if (Def.CachedBoneIndex == INDEX_NONE && !MeshComp->DoesSocketExist(Def.AttachSocketOrBone))
+        {
+            UE_LOG(LogBMCharacter, Warning, TEXT("[%s] Virtual HurtBox '%s' AttachSocketOrBone '%s' does NOT exist on mesh."),
+                *GetName(), *Def.Name.ToString(), *Def.AttachSocketOrBone.ToString());
+        }
+    }
+}
+
+/*
+ * @brief Create virtual hurt box proxy, it creates a capsule on the hurt box channel as the broad phase proxy of the virtual hurt boxes
+ */
+void ABMCharacterBase::CreateVirtualHurtBoxProxy()
+{
+    if (!HasVirtualHurtBoxes() || VirtualHurtBoxProxy)
+    {
+        return;
+    }
+
+    UCapsuleComponent* Capsule = GetCapsuleComponent();
+    if (!Capsule)
+    {
+        return;
+    }
+
+    const FName CompName = MakeUniqueObjectName(this, UCapsuleComponent::StaticClass(), TEXT("BM_HurtProxy"));
+    VirtualHurtBoxProxy = NewObject<UCapsuleComponent>(this, CompName);
+    AddInstanceComponent(VirtualHurtBoxProxy);
+    VirtualHurtBoxProxy->RegisterComponent();
+    VirtualHurtBoxProxy->AttachToComponent(Capsule, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+
+    const float Padding = FMath::Max(0.f, VirtualHurtBoxProxyPadding);
+    VirtualHurtBoxProxy->SetCapsuleSize(
+        Capsule->GetUnscaledCapsuleRadius() + Padding,
+        Capsule->GetUnscaledCapsuleHalfHeight() + Padding);
+
+    VirtualHurtBoxProxy->SetCollisionProfileName(BMCollisionProfiles::HurtBoxForTeam(Team));
+    VirtualHurtBoxProxy->SetGenerateOverlapEvents(true);
+    VirtualHurtBoxProxy->SetCanEverAffectNavigation(false);
+}
+
+/*
+ * @brief Get virtual hurt box proxy, it gets the broad phase proxy of the virtual hurt boxes
+ * @return The proxy component
+ */
+UPrimitiveComponent* ABMCharacterBase::GetVirtualHurtBoxProxy() const
+{
+    return VirtualHurtBoxProxy;
+}
+
+/*
+ * @brief Apply area damage modifiers, it applies the modifiers of the hurt region closest to the area origin
+ * @param InOutInfo The damage info
+ * @param Origin The origin of the area damage
+ */
+void ABMCharacterBase::ApplyAreaDamageModifiers(FBMDamageInfo& InOutInfo, const FVector& Origin) const
+{
+    const UBMHurtBoxComponent* BestComp = nullptr;
+    int32 BestVirtual = INDEX_NONE;
+    double BestDistSq = TNumericLimits<double>::Max();
+
+    for (const TObjectPtr<UBMHurtBoxComponent>& HB : HurtBoxes)
+    {
+        const UPrimitiveComponent* Bound = HB ? HB->GetBoundComponent() : nullptr;
+        if (!Bound || !HB->IsHurtBoxEnabled()) continue;
+
+        const double DistSq = FVector::DistSquared(Bound->GetComponentLocation(), Origin);
+        if (DistSq < BestDistSq)
+        {
+            BestDistSq = DistSq;
+            BestComp = HB;
+        }
+    }
+
+    if (bVirtualHurtBoxesEnabled)
+    {
+        for (int32 i = 0; i < VirtualHurtBoxes.Num(); ++i)
+        {
+            FTransform BoxToWorld;
+            if (!GetVirtualHurtBoxWorldTransform(i, BoxToWorld)) continue;
+
+            const double DistSq = FVector::DistSquared(BoxToWorld.GetLocation(), Origin);
+            if (DistSq < BestDistSq)
+            {
+                BestDistSq = DistSq;
+                BestComp = nullptr;
+                BestVirtual = i;
+            }
+        }
+    }
+
+    if (BestComp)
+    {
+        BestComp->ModifyIncomingDamage(InOutInfo);
+    }
+    else if (VirtualHurtBoxes.IsValidIndex(BestVirtual))
+    {
+        const FBMHurtBoxDefinition& Def = VirtualHurtBoxes[BestVirtual];
+        BMHurtBoxUtils::ApplyDamageModifiers(InOutInfo, Def.DamageMultiplier, Def.WeaknessMask, Def.ResistanceMask);
+    }
+}
+
+/*
+ * @brief Register virtual hurt box, it adds a bone-space hurt box descriptor
+ * @param Def The hurt box definition
+ */
+void ABMCharacterBase::RegisterVirtualHurtBox(const FBMHurtBoxDefinition& Def)
+{
+    VirtualHurtBoxes.Add(Def);
+}
+
+/*
+ * @brief Get virtual hurt box world transform, it evaluates the hurt box from the component space bone transforms
+ * @param Index The virtual hurt box index
+ * @param OutTransform The world transform
+ * @return True if the transform is evaluated, false otherwise
+ */
+bool ABMCharacterBase::GetVirtualHurtBoxWorldTransform(int32 Index, FTransform& OutTransform) const
+{
+    const USkeletalMeshComponent* MeshComp = GetMesh();
+    if (!MeshComp || !VirtualHurtBoxes.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    const FBMHurtBoxDefinition& Def = VirtualHurtBoxes[Index];
+
+    FTransform BoneToWorld;
+    const TArray<FTransform>& ComponentSpace = MeshComp->GetComponentSpaceTransforms();
+    if (ComponentSpace.IsValidIndex(Def.CachedBoneIndex))
+    {
+        BoneToWorld = ComponentSpace[Def.CachedBoneIndex] * MeshComp->GetComponentTransform();
+    }
+    else if (Def.AttachSocketOrBone.IsNone())
+    {
+        BoneToWorld = MeshComp->GetComponentTransform();
+    }
+    else
+    {
+        // Socket 或 LeaderPose 跟随网格，走引擎的通用路径
+        BoneToWorld = MeshComp->GetSocketTransform(Def.AttachSocketOrBone, RTS_World);
+    }
+
+    OutTransform = Def.RelativeTransform * BoneToWorld;
+    return true;
+}
+
+/*
+ * @brief Find overlapping virtual hurt box, it evaluates the virtual hurt boxes against the query box
+ * @param BoxToWorld The query box world transform
+ * @param BoxExtent The query box half extent
+ * @param OutHurtBoxToWorld The optional world transform of the matched hurt box
+ * @return The matched virtual hurt box index, INDEX_NONE if nothing overlaps
+ */
+int32 ABMCharacterBase::FindOverlappingVirtualHurtBox(const FTransform& BoxToWorld, const FVector& BoxExtent, FTransform* OutHurtBoxToWorld) const
+{
+    if (!bVirtualHurtBoxesEnabled)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 BestIndex = INDEX_NONE;
+    double BestDistSq = TNumericLimits<double>::Max();
+    FTransform BestTransform;
+
+    for (int32 i = 0; i < VirtualHurtBoxes.Num(); ++i)
+    {
+        FTransform HurtToWorld;
+        if (!GetVirtualHurtBoxWorldTransform(i, HurtToWorld)) continue;
+
+        if (!BMHurtBoxUtils::OverlapOBB(BoxToWorld, BoxExtent, HurtToWorld, VirtualHurtBoxes[i].BoxExtent)) continue;
+
+        const double DistSq = FVector::DistSquared(BoxToWorld.GetLocation(), HurtToWorld.GetLocation());
+        if (DistSq < BestDistSq)
+        {
+            BestDistSq = DistSq;
+            BestIndex = i;
+            BestTransform = HurtToWorld;
+        }
+    }
+
+    if (OutHurtBoxToWorld && BestIndex != INDEX_NONE)
+    {
+        *OutHurtBoxToWorld = BestTransform;
+    }
+    return BestIndex;
+}
+
 /*
  * @brief Get forward vector, it gets the forward vector
  * @return The forward vector
@@ -119,7 +383,7 @@ bool ABMCharacterBase::CanBeDamagedBy(const FBMDamageInfo& Info) const
     if (TempInstigator)
     {
         // ��������ߺ��ܺ�����ͬһ��Ӫ,������˺�
-        if (TempInstigator->Team == this->Team && this->Team != EBMTeam::Neutral)
+        if (!BMGameplayBits::IsHostile(TempInstigator->Team, this->Team))
         {
             return false;
         }
@@ -177,6 +441,21 @@ float ABMCharacterBase::TakeDamageFromHit(FBMDamageInfo& InOutInfo)
             }
         }
     }
+    if (!MatchedHB && VirtualHurtBoxes.IsValidIndex(InOutInfo.VirtualHurtBoxIndex))
+    {
+        const FBMHurtBoxDefinition& Def = VirtualHurtBoxes[InOutInfo.VirtualHurtBoxIndex];
+        BMHurtBoxUtils::ApplyDamageModifiers(InOutInfo, Def.DamageMultiplier, Def.WeaknessMask, Def.ResistanceMask);
+    }
+
+    // 元素克制：攻击元素 x 自身元素，直接读预编译矩阵；数据未就绪时不阻塞，按 1.0 处理
+    if (const UGameInstance* GI = GetGameInstance())
+    {
+        const UBMDataSubsystem* Data = GI->GetSubsystem<UBMDataSubsystem>();
+        if (Data && Data->IsDataReady())
+        {
+            InOutInfo.DamageValue *= Data->GetElementalMultiplier(InOutInfo.ElementType, ElementType);
+        }
+    }
 
     // Stats ���ս���
     const float Applied = Stats->ApplyDamage(InOutInfo);
@@ -301,18 +580,18 @@ void ABMCharacterBase::ClearActiveHitWindow()
 /*
  * @brief Resolve hit box window, it resolves the hit box window
  * @param WindowId The window id
- * @param OutHitBoxNames The out hit box names
+ * @param OutHitBoxMask The out hit box mask
  * @param OutParams The out params
  * @return True if the hit box window is resolved, false otherwise
  */
 bool ABMCharacterBase::ResolveHitBoxWindow(
     FName WindowId,
-    TArray<FName>& OutHitBoxNames,
+    uint64& OutHitBoxMask,
     FBMHitBoxActivationParams& OutParams
 ) const
 {
     (void)WindowId;
-    OutHitBoxNames.Reset();
+    OutHitBoxMask = 0;
     OutParams = FBMHitBoxActivationParams();
     return false;
 }
@@ -330,6 +609,12 @@ void ABMCharacterBase::SetAllHurtBoxesEnabled(bool bEnabled)
         if (!HB) continue;
         HB->SetHurtBoxEnabled(bEnabled);
     }
+
+    bVirtualHurtBoxesEnabled = bEnabled;
+    if (VirtualHurtBoxProxy)
+    {
+        VirtualHurtBoxProxy->SetCollisionEnabled(bEnabled ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+    }
 }
 
 /*
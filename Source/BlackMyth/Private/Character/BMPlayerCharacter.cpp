@@ -280,6 +280,7 @@ void ABMPlayerCharacter::BeginPlay()
 {
     Super::BeginPlay();
 
+    CompileHitBoxMasks();
     InitFSMStates();
 
     // �� Combat �¼�
@@ -511,32 +512,21 @@ void ABMPlayerCharacter::InitFSMStates()
     if (!Machine) return;
 
     // ������ע��״̬
-    auto* SIdle = NewObject<UBMPlayerState_Idle>(Machine);
-    auto* SMove = NewObject<UBMPlayerState_Move>(Machine);
-    auto* SJump = NewObject<UBMPlayerState_Jump>(Machine);
-    auto* SAtk = NewObject<UBMPlayerState_Attack>(Machine);
-    auto* SHit = NewObject<UBMPlayerState_Hit>(Machine);
-    auto* SDeath = NewObject<UBMPlayerState_Death>(Machine);
-    auto* SDodge = NewObject<UBMPlayerState_Dodge>(Machine);
-
-    SIdle->Init(this);
-    SMove->Init(this);
-    SJump->Init(this);
-    SAtk->Init(this);
-    SHit->Init(this);
-    SDeath->Init(this);
-    SDodge->Init(this);
-
-    Machine->RegisterState(BMStateNames::Idle, SIdle);
-    Machine->RegisterState(BMStateNames::Move, SMove);
-    Machine->RegisterState(BMStateNames::Jump, SJump);
-    Machine->RegisterState(BMStateNames::Attack, SAtk);
-    Machine->RegisterState(BMStateNames::Hit, SHit);
-    Machine->RegisterState(BMStateNames::Death, SDeath);
-    Machine->RegisterState(BMStateNames::Dodge, SDodge);
+    static const FBMStateMachineDefinition Definition = []()
+    {
+        FBMStateMachineDefinition Def;
+        Def.AddState(EBMStateId::Idle, BMStateNames::Idle, GetDefault<UBMPlayerState_Idle>());
+        Def.AddState(EBMStateId::Move, BMStateNames::Move, GetDefault<UBMPlayerState_Move>());
+        Def.AddState(EBMStateId::Jump, BMStateNames::Jump, GetDefault<UBMPlayerState_Jump>());
+        Def.AddState(EBMStateId::Attack, BMStateNames::Attack, GetDefault<UBMPlayerState_Attack>());
+        Def.AddState(EBMStateId::Hit, BMStateNames::Hit, GetDefault<UBMPlayerState_Hit>());
+        Def.AddState(EBMStateId::Death, BMStateNames::Death, GetDefault<UBMPlayerState_Death>());
+        Def.AddState(EBMStateId::Dodge, BMStateNames::Dodge, GetDefault<UBMPlayerState_Dodge>());
+        return Def;
+    }();
 
     // ��ʼ״̬
-    Machine->ChangeStateByName(BMStateNames::Idle);
+    Machine->InitStateMachine(&Definition, EBMStateId::Idle);
 }
 
 void ABMPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -774,7 +764,7 @@ void ABMPlayerCharacter::ApplyGait()
 
     if (UBMStateMachineComponent* Machine = GetFSM())
     {
-        if (Machine->GetCurrentStateName() == BMStateNames::Move)
+        if (Machine->GetCurrentStateId() == EBMStateId::Move)
         {
             PlayMoveLoop();
         }
@@ -796,7 +786,7 @@ void ABMPlayerCharacter::Input_JumpPressed()
     bPendingJump = true;
     if (UBMStateMachineComponent* Machine = GetFSM())
     {
-        Machine->ChangeStateByName(BMStateNames::Jump);
+        Machine->ChangeStateById(EBMStateId::Jump);
     }
 }
 
@@ -871,18 +861,18 @@ void ABMPlayerCharacter::OnActionRequested(EBMCombatAction Action)
     }
     UBMStateMachineComponent* Machine = GetFSM();
     if (!Machine) return;
-    const FName CurState = Machine->GetCurrentStateName();
+    const EBMStateId CurState = Machine->GetCurrentStateId();
     // ��ͨ����
     if (Action == EBMCombatAction::NormalAttack)
     {
         EnqueueAction(Action);
-        if (CurState != BMStateNames::Attack)
+        if (CurState != EBMStateId::Attack)
         {
             if (UCharacterMovementComponent* Move = GetCharacterMovement())
             {
                 if (Move->IsFalling()) return;
             }
-            Machine->ChangeStateByName(BMStateNames::Attack);
+            Machine->ChangeStateById(EBMStateId::Attack);
         }
         return;
     }
@@ -890,7 +880,7 @@ void ABMPlayerCharacter::OnActionRequested(EBMCombatAction Action)
     // ���ܵ��Σ�Ҫ����ȴ����
     if (BMCombatUtils::IsSkillAction(Action))
     {
-        if (CurState == BMStateNames::Attack || CurState == BMStateNames::Dodge)
+        if (CurState == EBMStateId::Attack || CurState == EBMStateId::Dodge)
         {
             return; // �����������в弼��
         }
@@ -919,7 +909,7 @@ void ABMPlayerCharacter::OnActionRequested(EBMCombatAction Action)
         }
 
         EnqueueAction(Action);
-        Machine->ChangeStateByName(BMStateNames::Attack);
+        Machine->ChangeStateById(EBMStateId::Attack);
         return;
     }
 
@@ -950,7 +940,7 @@ void ABMPlayerCharacter::OnActionRequested(EBMCombatAction Action)
 
         if (UBMStateMachineComponent* TempMachine = GetFSM())
         {
-            TempMachine->ChangeStateByName(BMStateNames::Dodge);
+            TempMachine->ChangeStateById(EBMStateId::Dodge);
         }
         return;
     }
@@ -960,22 +950,28 @@ void ABMPlayerCharacter::OnActionRequested(EBMCombatAction Action)
 /*
  * @brief Should interrupt current attack, it should interrupt the current attack
  * @param Incoming The incoming
+ * @param OutReason The reason of the decision, recorded in the state machine trace
  * @return True if the current attack should be interrupted, false otherwise
  */
-bool ABMPlayerCharacter::ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming) const
+bool ABMPlayerCharacter::ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming, EBMStateChangeReason& OutReason) const
 {
     if (!bHasActiveAttackContext)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[%s] No ActiveAttackContext while attacking."), *GetName());
+        OutReason = EBMStateChangeReason::InterruptNoContext;
         return true;
     }
 
-
-    if (bActiveUninterruptible) return false;
+    if (bActiveUninterruptible)
+    {
+        OutReason = EBMStateChangeReason::Uninterruptible;
+        return false;
+    }
 
     float P = BMCombatUtils::IsHeavyIncoming(Incoming) ? ActiveInterruptChanceOnHeavyHit : ActiveInterruptChance;
     P = FMath::Clamp(P, 0.f, 1.f);
-    return FMath::FRand() < P;
+    const bool bWillInterrupt = FMath::FRand() < P;
+    OutReason = bWillInterrupt ? EBMStateChangeReason::Interrupted : EBMStateChangeReason::InterruptResisted;
+    return bWillInterrupt;
 }
 
 /*
@@ -990,7 +986,7 @@ void ABMPlayerCharacter::Landed(const FHitResult& Hit)
     // ��غ�ص� Move/Idle
     if (UBMStateMachineComponent* Machine = GetFSM())
     {
-        Machine->ChangeStateByName(HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
+        Machine->ChangeStateById(HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
     }
 }
 
@@ -1231,19 +1227,24 @@ void ABMPlayerCharacter::HandleDamageTaken(const FBMDamageInfo& FinalInfo)
     UBMStateMachineComponent* Machine = GetFSM();
     if (!Machine) return;
 
-    const FName Cur = Machine->GetCurrentStateName();
+    const EBMStateId Cur = Machine->GetCurrentStateId();
 
     // �ǹ����ؽ� Hit
-    if (Cur != BMStateNames::Attack)
+    if (Cur != EBMStateId::Attack)
     {
-        Machine->ChangeStateByName(BMStateNames::Hit);
+        Machine->ChangeStateById(EBMStateId::Hit);
         return;
     }
 
     // �����а���ǰ��ʽ��������Ƿ���
-    if (ShouldInterruptCurrentAttack(FinalInfo))
+    EBMStateChangeReason Reason = EBMStateChangeReason::Request;
+    if (ShouldInterruptCurrentAttack(FinalInfo, Reason))
+    {
+        Machine->ChangeStateById(EBMStateId::Hit, Reason);
+    }
+    else
     {
-        Machine->ChangeStateByName(BMStateNames::Hit);
+        Machine->RecordRejectedChange(EBMStateId::Hit, Reason);
     }
     // ����ֻ��Ѫ������״̬�������ܻ�
 }
@@ -1258,7 +1259,7 @@ void ABMPlayerCharacter::HandleDeath(const FBMDamageInfo& LastHitInfo)
 
     if (UBMStateMachineComponent* Machine = GetFSM())
     {
-        Machine->ChangeStateByName(BMStateNames::Death);
+        Machine->ChangeStateById(EBMStateId::Death);
     }
 
     // Stop any level music via GameInstance
@@ -1290,17 +1291,17 @@ void ABMPlayerCharacter::HandleDeath(const FBMDamageInfo& LastHitInfo)
 /*
  * @brief Resolve hit box window, it resolves the hit box window
  * @param WindowId The window id
- * @param OutHitBoxNames The out hit box names
+ * @param OutHitBoxMask The out hit box mask
  * @param OutParams The out params
  * @return True if the hit box window is resolved, false otherwise
  */
 bool ABMPlayerCharacter::ResolveHitBoxWindow(
     FName WindowId,
-    TArray<FName>& OutHitBoxNames,
+    uint64& OutHitBoxMask,
     FBMHitBoxActivationParams& OutParams
 ) const
 {
-    OutHitBoxNames.Reset();
+    OutHitBoxMask = 0;
     OutParams = FBMHitBoxActivationParams();
 
     if (!bHasActiveAttackContext)
@@ -1313,54 +1314,128 @@ bool ABMPlayerCharacter::ResolveHitBoxWindow(
 
     if (WindowId.IsNone() || WindowId == DefaultWindowId)
     {
-        OutHitBoxNames = ActiveHitBoxNames;
+        OutHitBoxMask = ActiveHitBoxMask;
         OutParams = ActiveHitBoxParams;
-        return OutHitBoxNames.Num() > 0;
+        return OutHitBoxMask != 0;
     }
 
     return false;
 }
 
 /*
- * @brief Enqueue action, it enqueues the action
+ * @brief Stamp sub frame, it estimates the press time of an input dispatched this frame as the middle of the frame interval
+ * @param FrameTime The world time of this frame
+ * @param DeltaSeconds The delta time of this frame
+ * @return The press time, never earlier than the latest entry
+ */
+double FBMInputBuffer::StampSubFrame(double FrameTime, double DeltaSeconds) const
+{
+    return FMath::Max(FrameTime - 0.5 * FMath::Max(0.0, DeltaSeconds), LatestTime);
+}
+
+/*
+ * @brief Push, it records the action over the oldest entry
  * @param Action The action
+ * @param Time The press time
  */
-void ABMPlayerCharacter::EnqueueAction(EBMCombatAction Action)
+void FBMInputBuffer::Push(EBMCombatAction Action, double Time)
 {
-    ActionQueue.Reset();
-    ActionQueue.Add(Action);
+    FBMBufferedInput& Slot = Entries[Head];
+    Slot.Action = Action;
+    Slot.Time = Time;
+    Slot.bConsumed = false;
+    Head = (Head + 1) % Capacity;
+    LatestTime = FMath::Max(LatestTime, Time);
 }
 
 /*
- * @brief Consume next queued action, it consumes the next queued action
+ * @brief Consume latest, it takes the newest pending input and drops the older ones
  * @param OutAction The out action
- * @return True if the next queued action is consumed, false otherwise
+ * @return True if a pending input is consumed, false otherwise
  */
-bool ABMPlayerCharacter::ConsumeNextQueuedAction(EBMCombatAction& OutAction)
+bool FBMInputBuffer::ConsumeLatest(EBMCombatAction& OutAction)
 {
-    if (ActionQueue.Num() <= 0) return false;
-    OutAction = ActionQueue[0];
-    ActionQueue.RemoveAt(0);
-    return true;
+    bool bFound = false;
+
+    // 从最新往最旧遍历
+    for (int32 i = 1; i <= Capacity; ++i)
+    {
+        FBMBufferedInput& Slot = Entries[(Head - i + Capacity) % Capacity];
+        if (Slot.bConsumed)
+        {
+            continue;
+        }
+        if (!bFound)
+        {
+            OutAction = Slot.Action;
+            bFound = true;
+        }
+        Slot.bConsumed = true;
+    }
+    return bFound;
 }
 
 /*
- * @brief Consume one queued normal attack, it consumes the one queued normal attack
- * @return True if the one queued normal attack is consumed, false otherwise
+ * @brief Consume in window, it consumes the oldest pending input of the action inside the time window
+ * @param Action The action
+ * @param WindowStart The window start time
+ * @param WindowEnd The window end time
+ * @return True if a matching input is consumed, false otherwise
  */
-bool ABMPlayerCharacter::ConsumeOneQueuedNormalAttack()
+bool FBMInputBuffer::ConsumeInWindow(EBMCombatAction Action, double WindowStart, double WindowEnd)
 {
-    for (int32 i = 0; i < ActionQueue.Num(); ++i)
+    // 从最旧往最新遍历
+    for (int32 i = 0; i < Capacity; ++i)
     {
-        if (ActionQueue[i] == EBMCombatAction::NormalAttack)
+        FBMBufferedInput& Slot = Entries[(Head + i) % Capacity];
+        if (Slot.bConsumed || Slot.Action != Action)
+        {
+            continue;
+        }
+        if (Slot.Time >= WindowStart && Slot.Time <= WindowEnd)
         {
-            ActionQueue.RemoveAt(i);
+            Slot.bConsumed = true;
             return true;
         }
     }
     return false;
 }
 
+/*
+ * @brief Enqueue action, it records the action with its estimated press time into the input ring buffer
+ * @param Action The action
+ */
+void ABMPlayerCharacter::EnqueueAction(EBMCombatAction Action)
+{
+    const UWorld* World = GetWorld();
+    const double Time = World ? InputBuffer.StampSubFrame(World->GetTimeSeconds(), World->GetDeltaSeconds()) : 0.0;
+    InputBuffer.Push(Action, Time);
+
+    OnInputBuffered.Broadcast(Action, Time);
+}
+
+/*
+ * @brief Consume next queued action, it takes the newest pending input and drops the older ones
+ * @param OutAction The out action
+ * @return True if a pending input is consumed, false otherwise
+ */
+bool ABMPlayerCharacter::ConsumeNextQueuedAction(EBMCombatAction& OutAction)
+{
+    return InputBuffer.ConsumeLatest(OutAction);
+}
+
+/*
+ * @brief Consume buffered action, it consumes the oldest pending input of the action inside the time window
+ * @param Action The action
+ * @param WindowStart The window start time
+ * @param WindowEnd The window end time
+ * @return True if a matching input is consumed, false otherwise
+ */
+bool ABMPlayerCharacter::ConsumeBufferedAction(EBMCombatAction Action, double WindowStart, double WindowEnd)
+{
+    return InputBuffer.ConsumeInWindow(Action, WindowStart, WindowEnd);
+}
+
 /*
  * @brief Select skill spec, it selects the skill spec
  * @param Action The action
@@ -1395,23 +1470,41 @@ bool ABMPlayerCharacter::GetComboStep(int32 Index, FBMPlayerComboStep& Out) cons
     return Out.Anim != nullptr;
 }
 
+/*
+ * @brief Compile hit box masks, it resolves the hit box names of every combo step and skill once
+ */
+void ABMPlayerCharacter::CompileHitBoxMasks()
+{
+    for (int32 i = 0; i < NormalComboSteps.Num(); ++i)
+    {
+        FBMPlayerComboStep& Step = NormalComboSteps[i];
+        Step.HitBoxMask = CompileHitBoxMask(Step.HitBoxNames, Step.Anim, FString::Printf(TEXT("Combo%d"), i));
+    }
+
+    for (FBMPlayerSkillSlot& Slot : SkillSlots)
+    {
+        FBMPlayerAttackSpec& Spec = Slot.Spec;
+        Spec.HitBoxMask = CompileHitBoxMask(Spec.HitBoxNames, Spec.Anim, Spec.Id.ToString());
+    }
+}
+
 /*
  * @brief Set active attack context, it sets the active attack context
- * @param HitBoxNames The hit box names
+ * @param HitBoxMask The precompiled hit box mask
  * @param Params The params
  * @param bUninterruptible The uninterruptible
  * @param InterruptChance The interrupt chance
  * @param InterruptChanceOnHeavyHit The interrupt chance on heavy hit
  */
 void ABMPlayerCharacter::SetActiveAttackContext(
-    const TArray<FName>& HitBoxNames,
+    uint64 HitBoxMask,
     const FBMHitBoxActivationParams& Params,
     bool bUninterruptible,
     float InterruptChance,
     float InterruptChanceOnHeavyHit
 )
 {
-    ActiveHitBoxNames = HitBoxNames;
+    ActiveHitBoxMask = HitBoxMask;
     ActiveHitBoxParams = Params;
 
     bActiveUninterruptible = bUninterruptible;
@@ -1427,7 +1520,7 @@ void ABMPlayerCharacter::SetActiveAttackContext(
 void ABMPlayerCharacter::ClearActiveAttackContext()
 {
     bHasActiveAttackContext = false;
-    ActiveHitBoxNames.Reset();
+    ActiveHitBoxMask = 0;
     ActiveHitBoxParams = FBMHitBoxActivationParams();
 
     bActiveUninterruptible = false;
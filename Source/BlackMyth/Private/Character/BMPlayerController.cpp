@@ -7,7 +7,6 @@
 #include "Kismet/GameplayStatics.h"
 #include "Character/Components/BMStatsComponent.h"
 #include "Core/BMTypes.h"
-#include "System/Event/BMEventBusSubsystem.h"
 #include "Character/Components/BMExperienceComponent.h"
 #include "UI/BMNotificationWidget.h"
 #include "Character/Enemy/BMEnemyBoss.h"
@@ -129,10 +128,6 @@ void ABMPlayerController::SetupInputComponent()
         InputComponent->BindKey(EKeys::K, IE_Pressed, this, &ABMPlayerController::ApplyHalfHPDamage);
         UE_LOG(LogTemp, Log, TEXT("ABMPlayerController: Bound K to ApplyHalfHPDamage via C++"));
 
-        // Bind Skill1 to RightMouseButton, Skill2 to Q, Skill3 to E
-        //InputComponent->BindKey(EKeys::RightMouseButton, IE_Pressed, this, &ABMPlayerController::StartSkill1Cooldown);
-        //InputComponent->BindKey(EKeys::Q, IE_Pressed, this, &ABMPlayerController::StartSkill2Cooldown);
-        //InputComponent->BindKey(EKeys::E, IE_Pressed, this, &ABMPlayerController::StartSkill3Cooldown);
         // Debug: L to add one level worth of XP
         InputComponent->BindKey(EKeys::L, IE_Pressed, this, &ABMPlayerController::DebugGainOneLevel);
         UE_LOG(LogTemp, Log, TEXT("ABMPlayerController: Bound RMB->Skill1, Q->Skill2, E->Skill3, L->GainOneLevel"));
@@ -261,138 +256,6 @@ void ABMPlayerController::ConsumeStaminaTest()
         StaminaCost, bSuccess, OldStamina, NewStamina, Block.MaxStamina);
 }
 
-/*
- * @brief Start skill 1 cooldown, it starts the skill 1 cooldown
- */
-void ABMPlayerController::StartSkill1Cooldown()
-{
-    TriggerSkillCooldown(TEXT("Skill1"), 10.f);
-}
-
-/*
- * @brief Start skill 2 cooldown, it starts the skill 2 cooldown
- */
-void ABMPlayerController::StartSkill2Cooldown()
-{
-    TriggerSkillCooldown(TEXT("Skill2"), 8.f);
-}
-
-/*
- * @brief Start skill 3 cooldown, it starts the skill 3 cooldown
- */
-void ABMPlayerController::StartSkill3Cooldown()
-{
-    TriggerSkillCooldown(TEXT("Skill3"), 12.f);
-}
-
-/*
- * @brief Trigger skill cooldown, it triggers the skill cooldown
- * @param SkillId The skill id
- * @param TotalSeconds The total seconds
- */
-void ABMPlayerController::TriggerSkillCooldown(FName SkillId, float TotalSeconds)
-{
-    UBMEventBusSubsystem* Bus = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBMEventBusSubsystem>() : nullptr;
-    if (!Bus)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("TriggerSkillCooldown: EventBus not found."));
-        return;
-    }
-
-    if (SkillId == TEXT("Skill1"))
-    {
-        // Do not restart if cooldown already running
-        if (GetWorldTimerManager().IsTimerActive(Skill1CooldownTimer))
-        {
-            UE_LOG(LogTemp, Log, TEXT("Skill1 cooldown already running (%fs remaining)."), Skill1Remaining);
-            return;
-        }
-        Skill1Remaining = TotalSeconds;
-        Bus->EmitSkillCooldown(SkillId, Skill1Remaining);
-        GetWorldTimerManager().SetTimer(Skill1CooldownTimer, this, &ABMPlayerController::OnSkillCooldownTick_Skill1, 1.0f, true);
-    }
-    else if (SkillId == TEXT("Skill2"))
-    {
-        // Do not restart if cooldown already running
-        if (GetWorldTimerManager().IsTimerActive(Skill2CooldownTimer))
-        {
-            UE_LOG(LogTemp, Log, TEXT("Skill2 cooldown already running (%fs remaining)."), Skill2Remaining);
-            return;
-        }
-        Skill2Remaining = TotalSeconds;
-        Bus->EmitSkillCooldown(SkillId, Skill2Remaining);
-        GetWorldTimerManager().SetTimer(Skill2CooldownTimer, this, &ABMPlayerController::OnSkillCooldownTick_Skill2, 1.0f, true);
-    }
-    else if (SkillId == TEXT("Skill3"))
-    {
-        if (GetWorldTimerManager().IsTimerActive(Skill3CooldownTimer))
-        {
-            UE_LOG(LogTemp, Log, TEXT("Skill3 cooldown already running (%fs remaining)."), Skill3Remaining);
-            return;
-        }
-        Skill3Remaining = TotalSeconds;
-        Bus->EmitSkillCooldown(SkillId, Skill3Remaining);
-        GetWorldTimerManager().SetTimer(Skill3CooldownTimer, this, &ABMPlayerController::OnSkillCooldownTick_Skill3, 1.0f, true);
-    }
-}
-
-/*
- * @brief On skill cooldown tick skill 1, it on the skill cooldown tick skill 1
- */
-void ABMPlayerController::OnSkillCooldownTick_Skill1()
-{
-    UBMEventBusSubsystem* Bus = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBMEventBusSubsystem>() : nullptr;
-    if (!Bus)
-    {
-        GetWorldTimerManager().ClearTimer(Skill1CooldownTimer);
-        return;
-    }
-    Skill1Remaining = FMath::Max(0.f, Skill1Remaining - 1.f);
-    Bus->EmitSkillCooldown(TEXT("Skill1"), Skill1Remaining);
-    if (Skill1Remaining <= 0.f)
-    {
-        GetWorldTimerManager().ClearTimer(Skill1CooldownTimer);
-    }
-}
-
-/*
- * @brief On skill cooldown tick skill 2, it on the skill cooldown tick skill 2
- */
-void ABMPlayerController::OnSkillCooldownTick_Skill2()
-{
-    UBMEventBusSubsystem* Bus = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBMEventBusSubsystem>() : nullptr;
-    if (!Bus)
-    {
-        GetWorldTimerManager().ClearTimer(Skill2CooldownTimer);
-        return;
-    }
-    Skill2Remaining = FMath::Max(0.f, Skill2Remaining - 1.f);
-    Bus->EmitSkillCooldown(TEXT("Skill2"), Skill2Remaining);
-    if (Skill2Remaining <= 0.f)
-    {
-        GetWorldTimerManager().ClearTimer(Skill2CooldownTimer);
-    }
-}
-
-/*
- * @brief On skill cooldown tick skill 3, it on the skill cooldown tick skill 3
- */
-void ABMPlayerController::OnSkillCooldownTick_Skill3()
-{
-    UBMEventBusSubsystem* Bus = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBMEventBusSubsystem>() : nullptr;
-    if (!Bus)
-    {
-        GetWorldTimerManager().ClearTimer(Skill3CooldownTimer);
-        return;
-    }
-    Skill3Remaining = FMath::Max(0.f, Skill3Remaining - 1.f);
-    Bus->EmitSkillCooldown(TEXT("Skill3"), Skill3Remaining);
-    if (Skill3Remaining <= 0.f)
-    {
-        GetWorldTimerManager().ClearTimer(Skill3CooldownTimer);
-    }
-}
-
 /*
  * @brief Toggle pause menu, it toggles the pause menu
  */
@@ -1,11 +1,104 @@
 #include "Character/Components/BMCharacterState.h"
 #include "Character/BMCharacterBase.h"
+#include "Character/Components/BMStateMachineComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBMCharacterState, Log, All);
+
+/*
+ * @brief Set deadline, it schedules the event on the state machine clock, an already pending event is moved
+ * @param EventId The id of the event
+ * @param Delay The delay in seconds
+ * @return True if the deadline is set, false if all slots are used
+ */
+bool FBMStateContext::SetDeadline(uint8 EventId, float Delay)
+{
+    const double DueTime = Time + FMath::Max(0.f, Delay);
+
+    for (int32 i = 0; i < NumDeadlines; ++i)
+    {
+        if (Deadlines[i].EventId == EventId)
+        {
+            Deadlines[i].Time = DueTime;
+            return true;
+        }
+    }
+
+    if (NumDeadlines >= MaxDeadlines)
+    {
+        UE_LOG(LogBMCharacterState, Warning, TEXT("Deadline slots are full, event %d dropped."), EventId);
+        return false;
+    }
+
+    Deadlines[NumDeadlines].Time = DueTime;
+    Deadlines[NumDeadlines].EventId = EventId;
+    ++NumDeadlines;
+    return true;
+}
+
+/*
+ * @brief Clear deadline, it cancels the pending event
+ * @param EventId The id of the event
+ */
+void FBMStateContext::ClearDeadline(uint8 EventId)
+{
+    for (int32 i = 0; i < NumDeadlines; ++i)
+    {
+        if (Deadlines[i].EventId == EventId)
+        {
+            Deadlines[i] = Deadlines[--NumDeadlines];
+            return;
+        }
+    }
+}
 
 /*
- * @brief Initialize the character state
- * @param Owner The owner of the character state
+ * @brief Has deadline, it checks if the event is pending
+ * @param EventId The id of the event
+ * @return True if the event is pending, false otherwise
  */
-void UBMCharacterState::Init(ABMCharacterBase* Owner)
+bool FBMStateContext::HasDeadline(uint8 EventId) const
 {
-    Context = Owner;
+    for (int32 i = 0; i < NumDeadlines; ++i)
+    {
+        if (Deadlines[i].EventId == EventId) return true;
+    }
+    return false;
+}
+
+/*
+ * @brief Pop due deadline, it removes the earliest event that is due on the state machine clock
+ * @param OutEventId The id of the event
+ * @return True if an event is due, false otherwise
+ */
+bool FBMStateContext::PopDueDeadline(uint8& OutEventId)
+{
+    int32 Earliest = INDEX_NONE;
+    for (int32 i = 0; i < NumDeadlines; ++i)
+    {
+        if (Deadlines[i].Time <= Time && (Earliest == INDEX_NONE || Deadlines[i].Time < Deadlines[Earliest].Time))
+        {
+            Earliest = i;
+        }
+    }
+
+    if (Earliest == INDEX_NONE) return false;
+
+    OutEventId = Deadlines[Earliest].EventId;
+    Deadlines[Earliest] = Deadlines[--NumDeadlines];
+    return true;
+}
+
+/*
+ * @brief Get active context, it returns the state machine context of the owner if the owner is still in this state
+ * @param Owner The owner of the state machine
+ * @return The context, nullptr if the owner is invalid or has left this state
+ */
+FBMStateContext* UBMCharacterState::GetActiveContext(const ABMCharacterBase* Owner) const
+{
+    if (!Owner) return nullptr;
+
+    UBMStateMachineComponent* Machine = Owner->GetFSM();
+    if (!Machine || Machine->GetCurrentState() != this) return nullptr;
+
+    return &Machine->GetStateContext();
 }
@@ -1,7 +1,45 @@
 #include "Character/Components/BMCombatComponent.h"
 
+#include "Character/BMCharacterBase.h"
+#include "Character/Components/BMStatsComponent.h"
+#include "Core/BMTagRegistry.h"
+#include "System/Event/BMEventBusSubsystem.h"
+
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "TimerManager.h"
+#include "Engine/OverlapResult.h"
+#include "CollisionQueryParams.h"
+
 DEFINE_LOG_CATEGORY(LogBMCombat);
 
+DECLARE_CYCLE_STAT(TEXT("AoE Damage"), STAT_BMAoEDamage, STATGROUP_BMCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AoE Candidates"), STAT_BMAoECandidates, STATGROUP_BMCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AoE Victims"), STAT_BMAoEVictims, STATGROUP_BMCombat);
+
+namespace
+{
+    // 范围伤害候选：SortKey 越小越优先
+    struct FBMAoECandidate
+    {
+        ABMCharacterBase* Victim = nullptr;
+        float SortKey = 0.f;
+    };
+
+    // 与 DefaultEngine.ini 中的 HurtBox Object Channel 对应（PlayerHurtBox / EnemyHurtBox）
+    static void AddHostileHurtBoxChannels(EBMTeam Team, FCollisionObjectQueryParams& OutParams)
+    {
+        if (Team != EBMTeam::Player)
+        {
+            OutParams.AddObjectTypesToQuery(ECC_GameTraceChannel4);
+        }
+        if (Team != EBMTeam::Enemy)
+        {
+            OutParams.AddObjectTypesToQuery(ECC_GameTraceChannel5);
+        }
+    }
+}
+
 /*
  * @brief Constructor of the UBMCombatComponent class
  */
@@ -57,6 +95,21 @@ bool UBMCombatComponent::RequestAction(EBMCombatAction Action)
     return false;
 }
 
+/*
+ * @brief End play, it clears the cooldown expiry timer
+ * @param EndPlayReason The end play reason
+ */
+void UBMCombatComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* W = GetWorld())
+    {
+        W->GetTimerManager().ClearTimer(CooldownExpiryTimer);
+    }
+    CooldownHeap.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 /*
  * @brief Is cooldown ready
  * @param Key The key
@@ -64,14 +117,7 @@ bool UBMCombatComponent::RequestAction(EBMCombatAction Action)
  */
 bool UBMCombatComponent::IsCooldownReady(FName Key) const
 {
-    if (Key.IsNone()) return true;
-
-    const float Now = GetWorldTimeSecondsSafe();
-    if (const float* End = CooldownEndTimes.Find(Key))
-    {
-        return Now >= *End;
-    }
-    return true;
+    return GetCooldownRemaining(Key) <= 0.f;
 }
 
 /*
@@ -83,16 +129,18 @@ float UBMCombatComponent::GetCooldownRemaining(FName Key) const
 {
     if (Key.IsNone()) return 0.f;
 
-    const float Now = GetWorldTimeSecondsSafe();
-    if (const float* End = CooldownEndTimes.Find(Key))
+    const int32* Index = CooldownIndexByKey.Find(Key);
+    if (!Index)
     {
-        return FMath::Max(0.f, *End - Now);
+        return 0.f;
     }
-    return 0.f;
+
+    const FBMCooldownEntry& Entry = CooldownEntries[*Index];
+    return Entry.bActive ? FMath::Max(0.f, Entry.EndTime - GetWorldTimeSecondsSafe()) : 0.f;
 }
 
 /*
- * @brief Commit cooldown
+ * @brief Commit cooldown, it records the absolute end time and schedules the ready notification
  * @param Key The key
  * @param CooldownSeconds The cooldown seconds
  */
@@ -103,11 +151,31 @@ void UBMCombatComponent::CommitCooldown(FName Key, float CooldownSeconds)
     const float Cd = FMath::Max(0.f, CooldownSeconds);
     if (Cd <= 0.f) return;
 
-    const float Now = GetWorldTimeSecondsSafe();
-    CooldownEndTimes.FindOrAdd(Key) = Now + Cd;
+    int32 Index = INDEX_NONE;
+    if (const int32* Found = CooldownIndexByKey.Find(Key))
+    {
+        Index = *Found;
+    }
+    else
+    {
+        Index = CooldownEntries.AddDefaulted();
+        CooldownEntries[Index].Key = Key;
+        CooldownIndexByKey.Add(Key, Index);
+    }
+
+    FBMCooldownEntry& Entry = CooldownEntries[Index];
+    Entry.EndTime = GetWorldTimeSecondsSafe() + Cd;
+    Entry.Duration = Cd;
+    Entry.bActive = true;
+
+    // 旧节点（若有）因 EndTime 不一致在出堆时被丢弃
+    CooldownHeap.HeapPush(FBMCooldownHeapNode{ Entry.EndTime, Index });
+    ScheduleCooldownExpiry();
 
     UE_LOG(LogBMCombat, Verbose, TEXT("[%s] CommitCooldown: %s = %.2fs"),
         *GetOwner()->GetName(), *Key.ToString(), Cd);
+
+    BroadcastCooldownStarted(Entry);
 }
 
 /*
@@ -132,10 +200,17 @@ bool UBMCombatComponent::TryCommitCooldown(FName Key, float CooldownSeconds)
  */
 void UBMCombatComponent::ClearCooldown(FName Key)
 {
-    if (!Key.IsNone())
+    if (Key.IsNone()) return;
+
+    const int32* Index = CooldownIndexByKey.Find(Key);
+    if (!Index || !CooldownEntries[*Index].bActive)
     {
-        CooldownEndTimes.Remove(Key);
+        return;
     }
+
+    CooldownEntries[*Index].bActive = false;
+    ScheduleCooldownExpiry();
+    BroadcastCooldownReady(Key);
 }
 
 /*
@@ -143,7 +218,125 @@ void UBMCombatComponent::ClearCooldown(FName Key)
  */
 void UBMCombatComponent::ResetAllCooldowns()
 {
-    CooldownEndTimes.Reset();
+    CooldownHeap.Reset();
+    if (UWorld* W = GetWorld())
+    {
+        W->GetTimerManager().ClearTimer(CooldownExpiryTimer);
+    }
+
+    for (FBMCooldownEntry& Entry : CooldownEntries)
+    {
+        if (Entry.bActive)
+        {
+            Entry.bActive = false;
+            BroadcastCooldownReady(Entry.Key);
+        }
+    }
+}
+
+/*
+ * @brief Schedule cooldown expiry, it drops stale heap nodes and aims the single expiry timer at the heap top
+ */
+void UBMCombatComponent::ScheduleCooldownExpiry()
+{
+    UWorld* W = GetWorld();
+    if (!W)
+    {
+        return;
+    }
+
+    while (CooldownHeap.Num() > 0)
+    {
+        const FBMCooldownHeapNode& Top = CooldownHeap.HeapTop();
+        const FBMCooldownEntry& Entry = CooldownEntries[Top.EntryIndex];
+        if (Entry.bActive && Entry.EndTime == Top.EndTime)
+        {
+            break;
+        }
+        FBMCooldownHeapNode Discard;
+        CooldownHeap.HeapPop(Discard, EAllowShrinking::No);
+    }
+
+    FTimerManager& TM = W->GetTimerManager();
+    if (CooldownHeap.Num() == 0)
+    {
+        TM.ClearTimer(CooldownExpiryTimer);
+        return;
+    }
+
+    const float Delay = FMath::Max(CooldownHeap.HeapTop().EndTime - W->GetTimeSeconds(), KINDA_SMALL_NUMBER);
+    TM.SetTimer(CooldownExpiryTimer, this, &UBMCombatComponent::HandleCooldownExpiry, Delay, false);
+}
+
+/*
+ * @brief Handle cooldown expiry, it pops every expired cooldown and broadcasts ready once for each
+ */
+void UBMCombatComponent::HandleCooldownExpiry()
+{
+    const float Now = GetWorldTimeSecondsSafe();
+
+    while (CooldownHeap.Num() > 0 && CooldownHeap.HeapTop().EndTime <= Now)
+    {
+        FBMCooldownHeapNode Node;
+        CooldownHeap.HeapPop(Node, EAllowShrinking::No);
+
+        FBMCooldownEntry& Entry = CooldownEntries[Node.EntryIndex];
+        if (!Entry.bActive || Entry.EndTime != Node.EndTime)
+        {
+            continue;
+        }
+
+        Entry.bActive = false;
+        BroadcastCooldownReady(Entry.Key);
+    }
+
+    ScheduleCooldownExpiry();
+}
+
+/*
+ * @brief Broadcast cooldown started, it notifies the listeners and forwards player cooldowns to the event bus
+ * @param Entry The cooldown entry
+ */
+void UBMCombatComponent::BroadcastCooldownStarted(const FBMCooldownEntry& Entry)
+{
+    OnCooldownStarted.Broadcast(Entry.Key, Entry.EndTime, Entry.Duration);
+
+    if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+    {
+        if (OwnerPawn->IsPlayerControlled())
+        {
+            if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+            {
+                if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
+                {
+                    Bus->EmitSkillCooldownStarted(Entry.Key, Entry.EndTime, Entry.Duration);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @brief Broadcast cooldown ready, it notifies the listeners and forwards player cooldowns to the event bus
+ * @param Key The key
+ */
+void UBMCombatComponent::BroadcastCooldownReady(FName Key)
+{
+    OnCooldownReady.Broadcast(Key);
+
+    if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+    {
+        if (OwnerPawn->IsPlayerControlled())
+        {
+            if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+            {
+                if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
+                {
+                    Bus->EmitSkillCooldownReady(Key);
+                }
+            }
+        }
+    }
 }
 
 /*
@@ -190,4 +383,157 @@ bool UBMCombatComponent::GetActiveHitBoxWindowContext(TArray<FName>& OutHitBoxNa
     OutHitBoxNames = ActiveHitBoxNames;
     OutParams = ActiveHitBoxParams;
     return OutHitBoxNames.Num() > 0;
-}
\ No newline at end of file
+}
+
+/*
+ * @brief Apply area damage, it gathers hostile targets with one spatial query, applies the part modifiers in one batched pass and settles every victim once
+ * @param Spec The area damage spec
+ * @return The area damage result
+ */
+FBMAoEDamageResult UBMCombatComponent::ApplyAreaDamage(const FBMAoEDamageSpec& Spec)
+{
+    SCOPE_CYCLE_COUNTER(STAT_BMAoEDamage);
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    FBMAoEDamageResult Result;
+
+    ABMCharacterBase* Attacker = Cast<ABMCharacterBase>(GetOwner());
+    UWorld* World = GetWorld();
+    if (!Attacker || !World || Spec.Radius <= 0.f)
+    {
+        return Result;
+    }
+
+    const FVector Dir = Spec.Direction.GetSafeNormal(UE_SMALL_NUMBER, Attacker->GetActorForwardVector());
+
+    // 粗筛：一次空间查询，Cone 用外接球，Capsule 沿 Direction 摆放
+    FVector QueryCenter = Spec.Origin;
+    FQuat QueryRot = FQuat::Identity;
+    FCollisionShape QueryShape = FCollisionShape::MakeSphere(Spec.Radius);
+    if (Spec.Shape == EBMAoEShape::Capsule)
+    {
+        const float HalfLength = Spec.Length * 0.5f;
+        QueryCenter = Spec.Origin + Dir * HalfLength;
+        QueryRot = FRotationMatrix::MakeFromZ(Dir).ToQuat();
+        QueryShape = FCollisionShape::MakeCapsule(Spec.Radius, HalfLength + Spec.Radius);
+    }
+
+    FCollisionObjectQueryParams ObjectParams;
+    AddHostileHurtBoxChannels(Attacker->Team, ObjectParams);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BMAoEDamage), false, Attacker);
+
+    TArray<FOverlapResult> Overlaps;
+    World->OverlapMultiByObjectType(Overlaps, QueryCenter, QueryRot, ObjectParams, QueryShape, QueryParams);
+
+    // 细筛：按角色去重（同一角色可能有多个 HurtBox），过滤阵营/死亡/锥形角度
+    const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(Spec.ConeHalfAngle));
+
+    TArray<FBMAoECandidate> Candidates;
+    Candidates.Reserve(Overlaps.Num());
+    TSet<const AActor*> Seen;
+    Seen.Reserve(Overlaps.Num());
+
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        ABMCharacterBase* Victim = Cast<ABMCharacterBase>(Overlap.GetActor());
+        if (!Victim || Victim == Attacker) continue;
+
+        bool bAlreadySeen = false;
+        Seen.Add(Victim, &bAlreadySeen);
+        if (bAlreadySeen) continue;
+
+        if (!BMGameplayBits::IsHostile(Attacker->Team, Victim->Team)) continue;
+
+        const UBMStatsComponent* VictimStats = Victim->GetStats();
+        if (!VictimStats || VictimStats->IsDead()) continue;
+
+        const FVector ToVictim = Victim->GetActorLocation() - Spec.Origin;
+        const float Dist = ToVictim.Size();
+        const float Alignment = Dist > KINDA_SMALL_NUMBER ? FVector::DotProduct(ToVictim / Dist, Dir) : 1.f;
+        if (Spec.Shape == EBMAoEShape::Cone && Alignment < CosHalfAngle) continue;
+
+        FBMAoECandidate& C = Candidates.AddDefaulted_GetRef();
+        C.Victim = Victim;
+        switch (Spec.Priority)
+        {
+            case EBMAoETargetPriority::LowestHealth:
+                C.SortKey = VictimStats->GetStatBlock().HP;
+                break;
+            case EBMAoETargetPriority::MostAligned:
+                C.SortKey = -Alignment;
+                break;
+            case EBMAoETargetPriority::Nearest:
+            default:
+                C.SortKey = Dist;
+                break;
+        }
+    }
+
+    Result.NumCandidates = Candidates.Num();
+    INC_DWORD_STAT_BY(STAT_BMAoECandidates, Candidates.Num());
+
+    // 按优先级截断到目标上限
+    const int32 Cap = FMath::Clamp(Spec.MaxTargets, 1, MaxAoETargets);
+    Candidates.Sort([](const FBMAoECandidate& A, const FBMAoECandidate& B) { return A.SortKey < B.SortKey; });
+    if (Candidates.Num() > Cap)
+    {
+        Candidates.SetNum(Cap, EAllowShrinking::No);
+    }
+
+    // 单段基础伤害
+    float PerHit = Spec.BaseDamage;
+    if (PerHit <= 0.f)
+    {
+        if (const UBMStatsComponent* S = Attacker->GetStats())
+        {
+            PerHit = S->GetStatBlock().Attack * S->GetAttackMultiplier();
+        }
+    }
+    PerHit *= Spec.DamageScale;
+
+    const int32 HitCount = FMath::Max(1, Spec.HitCount);
+
+    // 批量修正：先为全部受害者算好最终伤害，再统一结算，避免结算回调（死亡/受击状态）穿插在修正中
+    TArray<FBMDamageInfo, TInlineAllocator<16>> Infos;
+    Infos.SetNum(Candidates.Num());
+    for (int32 i = 0; i < Candidates.Num(); ++i)
+    {
+        ABMCharacterBase* Victim = Candidates[i].Victim;
+        FBMDamageInfo& Info = Infos[i];
+
+        Info.InstigatorActor = Attacker;
+        Info.TargetActor = Victim;
+        Info.RawDamageValue = PerHit;
+        Info.DamageValue = PerHit;
+        Info.DamageType = Spec.DamageType;
+        Info.ElementType = Spec.ElementType;
+        Info.HitReaction = Spec.HitReaction;
+        Info.HitLocation = Victim->GetActorLocation();
+        Info.HitNormal = (Spec.Origin - Info.HitLocation).GetSafeNormal();
+
+        // 部位修正在此完成，HitComponent/VirtualHurtBoxIndex 留空，受击方不会重复修正
+        Victim->ApplyAreaDamageModifiers(Info, Spec.Origin);
+
+        Info.DamageValue *= HitCount;
+        Info.HitCount = HitCount;
+    }
+
+    // 每个受害者一次结算
+    for (int32 i = 0; i < Candidates.Num(); ++i)
+    {
+        Result.TotalDamage += Candidates[i].Victim->TakeDamageFromHit(Infos[i]);
+    }
+    Result.NumVictims = Candidates.Num();
+    INC_DWORD_STAT_BY(STAT_BMAoEVictims, Candidates.Num());
+
+    const double ElapsedUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+    if (AoEBudgetMicroseconds > 0.f && ElapsedUs > AoEBudgetMicroseconds)
+    {
+        UE_LOG(LogBMCombat, Warning, TEXT("[%s] AoE '%s' took %.1fus (budget %.1fus, %d candidates, %d victims x %d hits)."),
+            *Attacker->GetName(), *Spec.AttackId.ToString(), ElapsedUs, AoEBudgetMicroseconds,
+            Result.NumCandidates, Result.NumVictims, HitCount);
+    }
+
+    return Result;
+}
@@ -37,17 +37,95 @@ void UBMExperienceComponent::BeginPlay()
 {
     Super::BeginPlay();
     
-    // 广播初始状态
-    const float MaxXP = GetMaxXPForNextLevel();
-    const float Percent = GetExpPercent();
-    OnXPChangedNative.Broadcast(CurrentXP, MaxXP, Percent);
+    // 广播初始状态（点数不依赖数据表，立即广播）
     OnSkillPointChangedNative.Broadcast(SkillPoints);
     OnAttributePointChangedNative.Broadcast(AttributePoints);
     
     // 发送到 EventBus 供 UI 使用
-    EmitXPChangedToEventBus(CurrentXP, MaxXP, Percent);
     EmitSkillPointsChangedToEventBus(SkillPoints);
     EmitAttributePointsChangedToEventBus(AttributePoints);
+
+    UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    UBMDataSubsystem* DataSubsystem = GameInstance ? GameInstance->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    if (DataSubsystem)
+    {
+        // 经验上限读成长表：数据就绪后再广播，不阻塞在异步加载上
+        DataReadyHandle = DataSubsystem->CallOrRegisterOnDataReady(
+            FOnBMDataReady::FDelegate::CreateUObject(this, &UBMExperienceComponent::HandleDataReady));
+    }
+    else
+    {
+        HandleDataReady();
+    }
+
+#if BM_DATA_HOT_RELOAD
+    // 成长表按等级只读取当前一行，订阅整表增量后按行名过滤即可
+    if (DataSubsystem)
+    {
+        DataDeltaHandle = DataSubsystem->OnDataDelta.AddUObject(this, &UBMExperienceComponent::HandleDataDelta);
+    }
+#endif
+}
+
+/*
+ * @brief Handle data ready, it broadcasts the initial XP state once the growth table can be read
+ */
+void UBMExperienceComponent::HandleDataReady()
+{
+    DataReadyHandle.Reset();
+
+    const float MaxXP = GetMaxXPForNextLevel();
+    const float Percent = GetExpPercent();
+    OnXPChangedNative.Broadcast(CurrentXP, MaxXP, Percent);
+    EmitXPChangedToEventBus(CurrentXP, MaxXP, Percent);
+}
+
+/*
+ * @brief End play, it drops the pending data ready callback and the data hot reload subscription
+ * @param EndPlayReason The end play reason
+ */
+void UBMExperienceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    UBMDataSubsystem* DataSubsystem = GameInstance ? GameInstance->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    if (DataReadyHandle.IsValid())
+    {
+        if (DataSubsystem)
+        {
+            DataSubsystem->OnDataReady.Remove(DataReadyHandle);
+        }
+        DataReadyHandle.Reset();
+    }
+    if (DataDeltaHandle.IsValid())
+    {
+        if (DataSubsystem)
+        {
+            DataSubsystem->OnDataDelta.Remove(DataDeltaHandle);
+        }
+        DataDeltaHandle.Reset();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+/*
+ * @brief Handle data delta, it reapplies the growth row of the current level after a reload
+ * @param Delta The rows changed by the reload
+ */
+void UBMExperienceComponent::HandleDataDelta(const FBMDataDelta& Delta)
+{
+    if (Delta.Table != EBMDataTable::PlayerGrowth || !Delta.Contains(FName(*FString::FromInt(Level))))
+    {
+        return;
+    }
+
+    UE_LOG(LogBMExperience, Log, TEXT("HandleDataDelta: Growth data for level %d reloaded"), Level);
+    ApplyLevelUpBonuses();
+
+    const float MaxXP = GetMaxXPForNextLevel();
+    const float Percent = GetExpPercent();
+    OnXPChangedNative.Broadcast(CurrentXP, MaxXP, Percent);
+    EmitXPChangedToEventBus(CurrentXP, MaxXP, Percent);
 }
 
 /*
@@ -3,13 +3,35 @@
 #include "Character/BMCharacterBase.h"
 #include "Character/Components/BMStatsComponent.h"
 #include "Character/Components/BMHurtBoxComponent.h"
+#include "Character/Components/BMCombatComponent.h"
+#include "Core/BMTagRegistry.h"
 
 #include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/OverlapResult.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY(LogBMHitBox);
 
+// stat BMCombat：Overlap 回调总数与其中被 C++ 过滤掉的无效回调数
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HitBox Overlap Callbacks"), STAT_BMHitBoxOverlapCallbacks, STATGROUP_BMCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HitBox Rejected Overlaps"), STAT_BMHitBoxRejectedOverlaps, STATGROUP_BMCombat);
+
+// 通道过滤前的候选对与其中被通道剔除的对数，剔除比例 = Eliminated / Candidate
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HitBox Candidate Pairs"), STAT_BMHitBoxCandidatePairs, STATGROUP_BMCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HitBox Eliminated Pairs"), STAT_BMHitBoxEliminatedPairs, STATGROUP_BMCombat);
+
+namespace
+{
+    static TAutoConsoleVariable<int32> CVarBMHitBoxCountCandidates(
+        TEXT("bm.HitBox.CountCandidates"),
+        0,
+        TEXT("1: active hit boxes run an extra all-object-types overlap query each tick and count the pairs the collision channels eliminate (stat BMCombat). Costs one query per active hit box."),
+        ECVF_Cheat);
+}
+
 /*
  * @brief Constructor of the UBMHitBoxComponent class
  */
@@ -26,7 +48,7 @@ void UBMHitBoxComponent::BeginPlay()
     Super::BeginPlay();
 
     NameToDefIndex.Empty();
-    ComponentToHitBoxName.Empty();
+    ComponentToHitBoxIndex.Empty();
 
     if (Definitions.Num() == 0)
     {
@@ -39,15 +61,24 @@ void UBMHitBoxComponent::BeginPlay()
         Definitions.Add(Def);
     }
 
+    if (Definitions.Num() > MaxHitBoxCount)
+    {
+        UE_LOG(LogBMHitBox, Warning, TEXT("[%s] %d HitBox definitions registered, only the first %d can be activated."),
+            *GetNameSafe(GetOwner()), Definitions.Num(), MaxHitBoxCount);
+    }
+
+    // 名字在此一次性解析为下标，运行时窗口只按掩码开关
+    BoxesByIndex.Reset();
+    BoxesByIndex.SetNum(Definitions.Num());
+
     for (int32 i = 0; i < Definitions.Num(); ++i)
     {
         const FBMHitBoxDefinition& Def = Definitions[i];
-        EnsureCreated(Def);
-
-        if (!Def.Name.IsNone())
+        if (!Def.Name.IsNone() && !NameToDefIndex.Contains(Def.Name))
         {
             NameToDefIndex.Add(Def.Name, i);
         }
+        EnsureCreated(i);
     }
 
     DeactivateAllHitBoxes();
@@ -71,11 +102,14 @@ void UBMHitBoxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
     }
 
     HitBoxes.Empty();
-    ComponentToHitBoxName.Empty();
+    BoxesByIndex.Reset();
+    ComponentToHitBoxIndex.Empty();
     NameToDefIndex.Empty();
+    CachedMasksByKey.Empty();
 
-    ActiveHitBoxNames.Reset();
+    ActiveMask = 0;
     HitRecordsThisWindow.Reset();
+    PendingVirtualHits.Reset();
     ActiveWindowParams = FBMHitBoxActivationParams();
 
     Super::EndPlay(EndPlayReason);
@@ -87,7 +121,64 @@ void UBMHitBoxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
  */
 void UBMHitBoxComponent::RegisterDefinition(const FBMHitBoxDefinition& Def)
 {
-    Definitions.Add(Def);
+    const int32 Index = Definitions.Add(Def);
+
+    // 注册时即确定下标，攻击规格可在 BeginPlay 前预编译掩码
+    if (!Def.Name.IsNone() && !NameToDefIndex.Contains(Def.Name))
+    {
+        NameToDefIndex.Add(Def.Name, Index);
+    }
+
+    // 新名称可能让之前无法解析的名称生效
+    CachedMasksByKey.Reset();
+}
+
+/*
+ * @brief Find hit box index, it finds the definition index of the hit box name
+ * @param HitBoxName The hit box name
+ * @return The definition index, INDEX_NONE if not found or beyond the mask width
+ */
+int32 UBMHitBoxComponent::FindHitBoxIndex(FName HitBoxName) const
+{
+    const int32* Index = NameToDefIndex.Find(HitBoxName);
+    return (Index && *Index < MaxHitBoxCount) ? *Index : INDEX_NONE;
+}
+
+/*
+ * @brief Resolve hit box mask, it resolves the hit box names to a bit mask
+ * @param HitBoxNames The hit box names
+ * @param OutUnresolved The optional names that cannot be resolved
+ * @return The hit box mask
+ */
+uint64 UBMHitBoxComponent::ResolveHitBoxMask(const TArray<FName>& HitBoxNames, TArray<FName>* OutUnresolved) const
+{
+    uint64 Mask = 0;
+    for (const FName& Name : HitBoxNames)
+    {
+        const int32 Index = FindHitBoxIndex(Name);
+        if (Index == INDEX_NONE)
+        {
+            if (OutUnresolved) OutUnresolved->Add(Name);
+            continue;
+        }
+        Mask |= (1ull << Index);
+    }
+    return Mask;
+}
+
+/*
+ * @brief Resolve cached hit box mask, it resolves the names once per key and keeps the mask on this component
+ * @param Key The cache key, usually the notify that asks
+ * @param HitBoxNames The hit box names
+ * @return The hit box mask
+ */
+uint64 UBMHitBoxComponent::ResolveCachedHitBoxMask(const UObject* Key, const TArray<FName>& HitBoxNames)
+{
+    if (const uint64* Cached = CachedMasksByKey.Find(Key))
+    {
+        return *Cached;
+    }
+    return CachedMasksByKey.Add(Key, ResolveHitBoxMask(HitBoxNames));
 }
 
 /*
@@ -136,9 +227,10 @@ FName UBMHitBoxComponent::TypeToName(EBMHitBoxType Type)
  */
 const FBMHitBoxDefinition* UBMHitBoxComponent::FindDefByType(EBMHitBoxType Type) const
 {
+    const uint8 TypeBit = BMGameplayBits::HitBoxTypeBit(Type);
     for (const FBMHitBoxDefinition& Def : Definitions)
     {
-        if (Def.Type == Type)
+        if (BMGameplayBits::HitBoxTypeBit(Def.Type) & TypeBit)
         {
             return &Def;
         }
@@ -156,20 +248,21 @@ const FBMHitBoxDefinition* UBMHitBoxComponent::FindDefByType(EBMHitBoxType Type)
 
 /*
  * @brief Ensure created, it ensures that the hit box is created
- * @param Def The definition to ensure
+ * @param Index The definition index to ensure
  */
-void UBMHitBoxComponent::EnsureCreated(const FBMHitBoxDefinition& Def)
+void UBMHitBoxComponent::EnsureCreated(int32 Index)
 {
     AActor* Owner = GetOwner();
-    if (!Owner) return;
+    if (!Owner || !Definitions.IsValidIndex(Index) || !BoxesByIndex.IsValidIndex(Index)) return;
 
+    const FBMHitBoxDefinition& Def = Definitions[Index];
     if (Def.Name.IsNone())
     {
         UE_LOG(LogBMHitBox, Warning, TEXT("[%s] HitBoxDefinition has None name."), *Owner->GetName());
         return;
     }
 
-    if (HitBoxes.Contains(Def.Name))
+    if (BoxesByIndex[Index] || HitBoxes.Contains(Def.Name))
     {
         return;
     }
@@ -204,19 +297,18 @@ void UBMHitBoxComponent::EnsureCreated(const FBMHitBoxDefinition& Def)
     Box->SetBoxExtent(Def.BoxExtent);
     Box->SetRelativeTransform(Def.RelativeTransform);
 
+    // 专用 HitBox 通道：只与敌对阵营的 HurtBox（含虚拟 HurtBox 代理）产生 Overlap
+    const ABMCharacterBase* OwnerChar = Cast<ABMCharacterBase>(Owner);
+    Box->SetCollisionProfileName(BMCollisionProfiles::HitBoxForTeam(OwnerChar ? OwnerChar->Team : EBMTeam::Neutral));
     Box->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     Box->SetGenerateOverlapEvents(true);
 
-    // ֻ Overlap WorldDynamic
-    Box->SetCollisionObjectType(ECC_WorldDynamic);
-    Box->SetCollisionResponseToAllChannels(ECR_Ignore);
-    Box->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Overlap);
-
     Box->ComponentTags.Add(TEXT("BM_HitBox"));
     Box->OnComponentBeginOverlap.AddDynamic(this, &UBMHitBoxComponent::OnHitBoxOverlap);
 
     HitBoxes.Add(Def.Name, Box);
-    ComponentToHitBoxName.Add(Box, Def.Name);
+    BoxesByIndex[Index] = Box;
+    ComponentToHitBoxIndex.Add(Box, Index);
 }
 
 /*
@@ -246,47 +338,134 @@ void UBMHitBoxComponent::OnHitBoxOverlap(
 {
     (void)OtherBodyIndex;
 
+    INC_DWORD_STAT(STAT_BMHitBoxOverlapCallbacks);
+
     // �����Ϸ��Լ��
     if (!OverlappedComponent || !OtherActor || OtherActor == GetOwner())
     {
+        INC_DWORD_STAT(STAT_BMHitBoxRejectedOverlaps);
         return;
     }
 
-    // �������жԷ��� HurtBox
-    if (!OtherComp || !OtherComp->ComponentHasTag(TEXT("BM_HurtBox")))
+    // ͨ�� OverlappedComponent �ҵ�HitBox
+    const int32* HitBoxIndexPtr = ComponentToHitBoxIndex.Find(OverlappedComponent);
+    if (!HitBoxIndexPtr)
     {
         return;
     }
 
-    // ͨ�� OverlappedComponent �ҵ�HitBox
-    const FName* HitBoxNamePtr = ComponentToHitBoxName.Find(OverlappedComponent);
-    if (!HitBoxNamePtr)
+    const int32 HitBoxIndex = *HitBoxIndexPtr;
+
+    // ��ǰ���ڼ����HitBoxNames
+    if (!IsHitBoxActive(HitBoxIndex))
     {
         return;
     }
 
-    const FName HitBoxName = *HitBoxNamePtr;
-    if (HitBoxName.IsNone())
+    // 通道过滤后只剩敌对阵营的 HurtBox，这里不再需要 Tag 判断
+    ABMCharacterBase* Victim = Cast<ABMCharacterBase>(OtherActor);
+    if (!Victim || !OtherComp)
     {
+        INC_DWORD_STAT(STAT_BMHitBoxRejectedOverlaps);
         return;
     }
 
-    // ��ǰ���ڼ����HitBoxNames
-    if (!ActiveHitBoxNames.Contains(HitBoxName))
+    // 虚拟 HurtBox：代理胶囊只做粗筛，窄相在重叠期间按需求值
+    if (OtherComp == Victim->GetVirtualHurtBoxProxy())
     {
+        FBMPendingVirtualHit Pending;
+        Pending.HitBoxIndex = HitBoxIndex;
+        Pending.HitBoxComp = Cast<UBoxComponent>(OverlappedComponent);
+        Pending.Victim = Victim;
+        Pending.VictimComp = OtherComp;
+
+        if (!TryVirtualHit(Pending))
+        {
+            PendingVirtualHits.Add(Pending);
+        }
         return;
     }
 
-    // ����������/�ܺ���
+    // 组件 HurtBox：直接结算
+    const FVector HitLocation = bFromSweep ? FVector(SweepResult.ImpactPoint) : OtherComp->GetComponentLocation();
+    const FVector HitNormal = bFromSweep ? FVector(SweepResult.ImpactNormal) : FVector::UpVector;
+    ApplyHit(HitBoxIndex, Victim, OtherComp, HitLocation, HitNormal, INDEX_NONE);
+}
+
+/*
+ * @brief Try virtual hit, it runs the narrow phase against the victim's virtual hurt boxes
+ * @param Pending The pending record
+ * @return True if the record is finished (hit or stale), false if it needs to be checked again
+ */
+bool UBMHitBoxComponent::TryVirtualHit(const FBMPendingVirtualHit& Pending)
+{
+    UBoxComponent* Box = Pending.HitBoxComp.Get();
+    ABMCharacterBase* Victim = Pending.Victim.Get();
+    UPrimitiveComponent* VictimComp = Pending.VictimComp.Get();
+
+    if (!Box || !Victim || !VictimComp || !IsHitBoxActive(Pending.HitBoxIndex))
+    {
+        return true;
+    }
+
+    if (!Box->IsOverlappingComponent(VictimComp))
+    {
+        return true;
+    }
+
+    FTransform HurtToWorld;
+    const int32 HurtIndex = Victim->FindOverlappingVirtualHurtBox(Box->GetComponentTransform(), Box->GetUnscaledBoxExtent(), &HurtToWorld);
+    if (HurtIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    ApplyHit(Pending.HitBoxIndex, Victim, VictimComp, HurtToWorld.GetLocation(), FVector::UpVector, HurtIndex);
+    return true;
+}
+
+/*
+ * @brief Process pending virtual hits, it re-evaluates the pending records while the hit box still overlaps the proxy
+ */
+void UBMHitBoxComponent::ProcessPendingVirtualHits()
+{
+    for (int32 i = PendingVirtualHits.Num() - 1; i >= 0; --i)
+    {
+        if (TryVirtualHit(PendingVirtualHits[i]))
+        {
+            PendingVirtualHits.RemoveAtSwap(i);
+        }
+    }
+}
+
+/*
+ * @brief Apply hit, it checks the dedup policy, builds the damage info and sends it to the victim
+ * @param HitBoxIndex The hit box definition index
+ * @param Victim The victim
+ * @param OtherComp The hit component
+ * @param HitLocation The hit location
+ * @param HitNormal The hit normal
+ * @param VirtualHurtBoxIndex The virtual hurt box index, INDEX_NONE for component hurt boxes
+ */
+void UBMHitBoxComponent::ApplyHit(
+    int32 HitBoxIndex,
+    ABMCharacterBase* Victim,
+    UPrimitiveComponent* OtherComp,
+    const FVector& HitLocation,
+    const FVector& HitNormal,
+    int32 VirtualHurtBoxIndex)
+{
     ABMCharacterBase* Attacker = ResolveOwnerCharacter();
-    ABMCharacterBase* Victim = Cast<ABMCharacterBase>(OtherActor);
-    if (!Attacker || !Victim)
+    if (!Attacker || !Victim || !Definitions.IsValidIndex(HitBoxIndex))
     {
         return;
     }
 
+    const FBMHitBoxDefinition* Def = &Definitions[HitBoxIndex];
+    const FName HitBoxName = Def->Name;
+
     // ȥ��
-    TWeakObjectPtr<AActor> TargetKey(OtherActor);
+    TWeakObjectPtr<AActor> TargetKey(Victim);
     FBMHitRecord& Record = HitRecordsThisWindow.FindOrAdd(TargetKey);
 
     // ��ȡȥ�ز���
@@ -319,34 +498,6 @@ void UBMHitBoxComponent::OnHitBoxOverlap(
     Record.TotalHits++;
     Record.HitBoxHits.FindOrAdd(HitBoxName)++;
 
-    // ��λHitBoxDefinition
-    const FBMHitBoxDefinition* Def = nullptr;
-
-    if (const int32* DefIndex = NameToDefIndex.Find(HitBoxName))
-    {
-        if (Definitions.IsValidIndex(*DefIndex))
-        {
-            Def = &Definitions[*DefIndex];
-        }
-    }
-
-    if (!Def)
-    {
-        for (const FBMHitBoxDefinition& D : Definitions)
-        {
-            if (D.Name == HitBoxName)
-            {
-                Def = &D;
-                break;
-            }
-        }
-    }
-
-    if (!Def)
-    {
-        return;
-    }
-
     // ��������˺�
     float BaseAttack = 0.f;
     float AttackMultiplier = 1.0f;
@@ -388,17 +539,9 @@ void UBMHitBoxComponent::OnHitBoxOverlap(
     }
 
     Info.HitComponent = OtherComp;
-
-    if (bFromSweep)
-    {
-        Info.HitLocation = SweepResult.ImpactPoint;
-        Info.HitNormal = SweepResult.ImpactNormal;
-    }
-    else
-    {
-        Info.HitLocation = OtherComp->GetComponentLocation();
-        Info.HitNormal = FVector::UpVector;
-    }
+    Info.VirtualHurtBoxIndex = VirtualHurtBoxIndex;
+    Info.HitLocation = HitLocation;
+    Info.HitNormal = HitNormal;
 
     // ����
     Victim->TakeDamageFromHit(Info);
@@ -414,15 +557,25 @@ void UBMHitBoxComponent::OnHitBoxOverlap(
 void UBMHitBoxComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (PendingVirtualHits.Num() > 0)
+    {
+        ProcessPendingVirtualHits();
+    }
+
+    if (ActiveMask != 0 && CVarBMHitBoxCountCandidates.GetValueOnGameThread() != 0)
+    {
+        CountCandidatePairs();
+    }
+
     if (!bDebugDraw) return;
 
-    for (const auto& KVP : HitBoxes)
+    for (int32 i = 0; i < BoxesByIndex.Num(); ++i)
     {
-        const FName Name = KVP.Key;
-        UBoxComponent* Box = KVP.Value;
+        UBoxComponent* Box = BoxesByIndex[i];
         if (!Box) continue;
 
-        const bool bActive = ActiveHitBoxNames.Contains(Name);
+        const bool bActive = IsHitBoxActive(i);
         const FColor Color = bActive ? DebugColorActive : DebugColorInactive;
 
         DrawDebugBox(
@@ -439,16 +592,61 @@ void UBMHitBoxComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAc
     }
 }
 
+/*
+ * @brief Count candidate pairs, it queries every object type around the active hit boxes and counts the new pairs of this window,
+ *        and the pairs whose responses do not overlap as eliminated by the collision channels
+ */
+void UBMHitBoxComponent::CountCandidatePairs()
+{
+    UWorld* World = GetWorld();
+    if (!World) return;
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BMHitBoxCandidates), false, GetOwner());
+    const FCollisionObjectQueryParams AllObjects(FCollisionObjectQueryParams::InitType::AllObjects);
+
+    TArray<FOverlapResult> Overlaps;
+    for (uint64 Bits = ActiveMask; Bits != 0; Bits &= Bits - 1)
+    {
+        const int32 Index = FMath::CountTrailingZeros64(Bits);
+        const UBoxComponent* Box = BoxesByIndex.IsValidIndex(Index) ? BoxesByIndex[Index].Get() : nullptr;
+        if (!Box) continue;
+
+        Overlaps.Reset();
+        World->OverlapMultiByObjectType(Overlaps, Box->GetComponentLocation(), Box->GetComponentQuat(), AllObjects,
+            FCollisionShape::MakeBox(Box->GetScaledBoxExtent()), QueryParams);
+
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            const UPrimitiveComponent* Other = Overlap.GetComponent();
+            if (!Other || Other == Box) continue;
+
+            bool bAlreadyCounted = false;
+            CandidatePairsThisWindow.Add(MakeTuple(Index, TObjectKey<UPrimitiveComponent>(Other)), &bAlreadyCounted);
+            if (bAlreadyCounted) continue;
+
+            INC_DWORD_STAT(STAT_BMHitBoxCandidatePairs);
+
+            // 双方都为 Overlap 响应时才会产生回调，否则该对已被通道在宽相剔除
+            const bool bTested = Box->GetCollisionResponseToChannel(Other->GetCollisionObjectType()) == ECR_Overlap
+                && Other->GetCollisionResponseToChannel(Box->GetCollisionObjectType()) == ECR_Overlap;
+            if (!bTested)
+            {
+                INC_DWORD_STAT(STAT_BMHitBoxEliminatedPairs);
+            }
+        }
+    }
+}
+
 /*
  * @brief Set hit box collision enabled, it sets the hit box collision enabled
- * @param HitBoxName The hit box name
+ * @param Index The hit box definition index
  * @param bEnabled The enabled
  */
-void UBMHitBoxComponent::SetHitBoxCollisionEnabled(FName HitBoxName, bool bEnabled)
+void UBMHitBoxComponent::SetHitBoxCollisionEnabled(int32 Index, bool bEnabled)
 {
-    if (HitBoxName.IsNone()) return;
+    if (!BoxesByIndex.IsValidIndex(Index)) return;
 
-    if (UBoxComponent* Box = HitBoxes.FindRef(HitBoxName))
+    if (UBoxComponent* Box = BoxesByIndex[Index])
     {
         Box->SetCollisionEnabled(bEnabled ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
     }
@@ -460,11 +658,22 @@ void UBMHitBoxComponent::SetHitBoxCollisionEnabled(FName HitBoxName, bool bEnabl
  * @return The names
  */
 TArray<FName> UBMHitBoxComponent::FindNamesByType(EBMHitBoxType Type) const
+{
+    return FindNamesByTypeMask(BMGameplayBits::HitBoxTypeBit(Type));
+}
+
+/*
+ * @brief Find names by type mask, it finds the names of the definitions whose type bit is in the mask
+ * @param TypeMask The hit box type bits
+ * @return The names
+ */
+TArray<FName> UBMHitBoxComponent::FindNamesByTypeMask(uint8 TypeMask) const
 {
     TArray<FName> Out;
     for (const FBMHitBoxDefinition& Def : Definitions)
     {
-        if (Def.Type == Type && !Def.Name.IsNone())
+        // 类型判定为一次按位与
+        if ((BMGameplayBits::HitBoxTypeBit(Def.Type) & TypeMask) && !Def.Name.IsNone())
         {
             Out.Add(Def.Name);
         }
@@ -473,7 +682,7 @@ TArray<FName> UBMHitBoxComponent::FindNamesByType(EBMHitBoxType Type) const
 }
 
 /*
- * @brief Activate hit boxes by names, it activates the hit boxes by names
+ * @brief Activate hit boxes by names, it resolves the names to a mask and activates the hit boxes
  * @param HitBoxNames The hit box names
  * @param Params The activation parameters
  */
@@ -485,48 +694,69 @@ void UBMHitBoxComponent::ActivateHitBoxesByNames(const TArray<FName>& HitBoxName
         return;
     }
 
+    ActivateHitBoxesByMask(ResolveHitBoxMask(HitBoxNames), Params);
+}
+
+/*
+ * @brief Deactivate hit boxes by names, it resolves the names to a mask and deactivates the hit boxes
+ * @param HitBoxNames The hit box names
+ */
+void UBMHitBoxComponent::DeactivateHitBoxesByNames(const TArray<FName>& HitBoxNames)
+{
+    DeactivateHitBoxesByMask(ResolveHitBoxMask(HitBoxNames));
+}
+
+/*
+ * @brief Activate hit boxes by mask, it enables the hit boxes whose bits are set
+ * @param Mask The hit box mask
+ * @param Params The activation parameters
+ */
+void UBMHitBoxComponent::ActivateHitBoxesByMask(uint64 Mask, const FBMHitBoxActivationParams& Params)
+{
+    if (Mask == 0)
+    {
+        UE_LOG(LogBMHitBox, Warning, TEXT("[HitBox] ActivateHitBoxesByMask called with empty mask."));
+        return;
+    }
+
     ActiveWindowParams = Params;
 
     if (ActiveWindowParams.bResetHitRecords)
     {
         HitRecordsThisWindow.Reset();
+        CandidatePairsThisWindow.Reset();
     }
 
-    for (const FName& Name : HitBoxNames)
+    // 只遍历新开启的位
+    for (uint64 Bits = Mask & ~ActiveMask; Bits != 0; Bits &= Bits - 1)
     {
-        if (Name.IsNone()) continue;
-
-        // ��û����
-        const int32* Index = NameToDefIndex.Find(Name);
-        if (Index && Definitions.IsValidIndex(*Index))
-        {
-            EnsureCreated(Definitions[*Index]);
-        }
-
-        // ����
-        ActiveHitBoxNames.Add(Name);
-        SetHitBoxCollisionEnabled(Name, true);
+        const int32 Index = FMath::CountTrailingZeros64(Bits);
+        EnsureCreated(Index);
+        SetHitBoxCollisionEnabled(Index, true);
     }
+
+    ActiveMask |= Mask;
 }
 
 /*
- * @brief Deactivate hit boxes by names, it deactivates the hit boxes by names
- * @param HitBoxNames The hit box names
+ * @brief Deactivate hit boxes by mask, it disables the hit boxes whose bits are set
+ * @param Mask The hit box mask
  */
-void UBMHitBoxComponent::DeactivateHitBoxesByNames(const TArray<FName>& HitBoxNames)
+void UBMHitBoxComponent::DeactivateHitBoxesByMask(uint64 Mask)
 {
-    for (const FName& Name : HitBoxNames)
+    for (uint64 Bits = Mask & ActiveMask; Bits != 0; Bits &= Bits - 1)
     {
-        if (Name.IsNone()) continue;
-
-        SetHitBoxCollisionEnabled(Name, false);
-        ActiveHitBoxNames.Remove(Name);
+        SetHitBoxCollisionEnabled(FMath::CountTrailingZeros64(Bits), false);
     }
 
-    if (ActiveHitBoxNames.Num() == 0)
+    ActiveMask &= ~Mask;
+
+    if (PendingVirtualHits.Num() > 0)
     {
-        // ActiveWindowParams = FBMHitBoxActivationParams();
-        // HitRecordsThisWindow.Reset(); 
+        PendingVirtualHits.RemoveAllSwap([this](const FBMPendingVirtualHit& P)
+            {
+                return !IsHitBoxActive(P.HitBoxIndex);
+            });
     }
 }
 
@@ -535,15 +765,13 @@ void UBMHitBoxComponent::DeactivateHitBoxesByNames(const TArray<FName>& HitBoxNa
  */
 void UBMHitBoxComponent::DeactivateAllHitBoxes()
 {
-    for (auto& KVP : HitBoxes)
+    for (uint64 Bits = ActiveMask; Bits != 0; Bits &= Bits - 1)
     {
-        if (KVP.Value)
-        {
-            KVP.Value->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-        }
+        SetHitBoxCollisionEnabled(FMath::CountTrailingZeros64(Bits), false);
     }
-    ActiveHitBoxNames.Reset();
+    ActiveMask = 0;
     ActiveWindowParams = FBMHitBoxActivationParams();
     HitRecordsThisWindow.Reset();
+    PendingVirtualHits.Reset();
+    CandidatePairsThisWindow.Reset();
 }
-
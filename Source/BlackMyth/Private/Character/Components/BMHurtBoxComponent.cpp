@@ -1,5 +1,7 @@
 #include "Character/Components/BMHurtBoxComponent.h"
 
+#include "Character/BMCharacterBase.h"
+
 #include "Components/BoxComponent.h"
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -20,9 +22,19 @@ UBMHurtBoxComponent::UBMHurtBoxComponent()
 void UBMHurtBoxComponent::BeginPlay()
 {
     Super::BeginPlay();
+    RefreshElementMasks();
     CreateOrUpdateCollision();
 }
 
+/*
+ * @brief Refresh element masks, it rebuilds the weakness and resistance bit sets from the element arrays
+ */
+void UBMHurtBoxComponent::RefreshElementMasks()
+{
+    WeaknessMask = BMGameplayBits::MakeElementMask(WeaknessTypes);
+    ResistanceMask = BMGameplayBits::MakeElementMask(ResistanceTypes);
+}
+
 /*
  * @brief End play, it destroys the collision and resets the bound component
  * @param EndPlayReason The reason for the end play
@@ -85,15 +97,11 @@ void UBMHurtBoxComponent::CreateOrUpdateCollision()
     CollisionBox->SetBoxExtent(BoxExtent);
     CollisionBox->SetRelativeTransform(RelativeTransform);
 
-    // ֻ���� Overlap
-    CollisionBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    // 专用 HurtBox 通道：只与敌对阵营的 HitBox 产生 Overlap（QueryOnly）
+    const ABMCharacterBase* OwnerChar = Cast<ABMCharacterBase>(Owner);
+    CollisionBox->SetCollisionProfileName(BMCollisionProfiles::HurtBoxForTeam(OwnerChar ? OwnerChar->Team : EBMTeam::Neutral));
     CollisionBox->SetGenerateOverlapEvents(true);
 
-    // �� HitBox ͳһ�� WorldDynamic
-    CollisionBox->SetCollisionObjectType(ECC_WorldDynamic);
-    CollisionBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-    CollisionBox->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Overlap);
-
     CollisionBox->ComponentTags.Add(TEXT("BM_HurtBox"));
 
     BoundComponent = CollisionBox;
@@ -104,19 +112,104 @@ void UBMHurtBoxComponent::CreateOrUpdateCollision()
  * @param InOutInfo The incoming damage info
  */
 void UBMHurtBoxComponent::ModifyIncomingDamage(FBMDamageInfo& InOutInfo) const
+{
+    BMHurtBoxUtils::ApplyDamageModifiers(InOutInfo, DamageMultiplier, WeaknessMask, ResistanceMask);
+}
+
+/*
+ * @brief Apply damage modifiers, it applies the part multiplier and the weakness/resistance multipliers
+ * @param InOutInfo The incoming damage info
+ * @param DamageMultiplier The part damage multiplier
+ * @param WeaknessMask The weakness element bit set
+ * @param ResistanceMask The resistance element bit set
+ */
+void BMHurtBoxUtils::ApplyDamageModifiers(
+    FBMDamageInfo& InOutInfo,
+    float DamageMultiplier,
+    uint8 WeaknessMask,
+    uint8 ResistanceMask)
 {
     InOutInfo.DamageValue *= DamageMultiplier;
 
-    if (WeaknessTypes.Contains(InOutInfo.ElementType))
+    const uint8 ElementBit = BMGameplayBits::ElementBit(InOutInfo.ElementType);
+    if (WeaknessMask & ElementBit)
     {
         InOutInfo.DamageValue *= 1.25f;
     }
-    if (ResistanceTypes.Contains(InOutInfo.ElementType))
+    if (ResistanceMask & ElementBit)
     {
         InOutInfo.DamageValue *= 0.75f;
     }
 }
 
+/*
+ * @brief Overlap OBB, it tests two oriented boxes with the separating axis theorem
+ * @param A The world transform of box A
+ * @param ExtentA The half extent of box A
+ * @param B The world transform of box B
+ * @param ExtentB The half extent of box B
+ * @return True if the boxes overlap, false otherwise
+ */
+bool BMHurtBoxUtils::OverlapOBB(const FTransform& A, const FVector& ExtentA, const FTransform& B, const FVector& ExtentB)
+{
+    const FVector Ea = ExtentA * A.GetScale3D().GetAbs();
+    const FVector Eb = ExtentB * B.GetScale3D().GetAbs();
+
+    const FQuat Qa = A.GetRotation();
+    const FQuat Qb = B.GetRotation();
+    const FVector Ua[3] = { Qa.GetAxisX(), Qa.GetAxisY(), Qa.GetAxisZ() };
+    const FVector Ub[3] = { Qb.GetAxisX(), Qb.GetAxisY(), Qb.GetAxisZ() };
+
+    // B 在 A 局部坐标系下的旋转矩阵与平移
+    double R[3][3];
+    double AbsR[3][3];
+    for (int32 i = 0; i < 3; ++i)
+    {
+        for (int32 j = 0; j < 3; ++j)
+        {
+            R[i][j] = FVector::DotProduct(Ua[i], Ub[j]);
+            AbsR[i][j] = FMath::Abs(R[i][j]) + KINDA_SMALL_NUMBER;
+        }
+    }
+
+    const FVector D = B.GetLocation() - A.GetLocation();
+    const double T[3] = { FVector::DotProduct(D, Ua[0]), FVector::DotProduct(D, Ua[1]), FVector::DotProduct(D, Ua[2]) };
+
+    // A 的三个面法线
+    for (int32 i = 0; i < 3; ++i)
+    {
+        const double Ra = Ea[i];
+        const double Rb = Eb[0] * AbsR[i][0] + Eb[1] * AbsR[i][1] + Eb[2] * AbsR[i][2];
+        if (FMath::Abs(T[i]) > Ra + Rb) return false;
+    }
+
+    // B 的三个面法线
+    for (int32 j = 0; j < 3; ++j)
+    {
+        const double Ra = Ea[0] * AbsR[0][j] + Ea[1] * AbsR[1][j] + Ea[2] * AbsR[2][j];
+        const double Rb = Eb[j];
+        if (FMath::Abs(T[0] * R[0][j] + T[1] * R[1][j] + T[2] * R[2][j]) > Ra + Rb) return false;
+    }
+
+    // 9 条边叉积轴
+    for (int32 i = 0; i < 3; ++i)
+    {
+        const int32 i1 = (i + 1) % 3;
+        const int32 i2 = (i + 2) % 3;
+        for (int32 j = 0; j < 3; ++j)
+        {
+            const int32 j1 = (j + 1) % 3;
+            const int32 j2 = (j + 2) % 3;
+            const double Ra = Ea[i1] * AbsR[i2][j] + Ea[i2] * AbsR[i1][j];
+            const double Rb = Eb[j1] * AbsR[i][j2] + Eb[j2] * AbsR[i][j1];
+            const double Dist = FMath::Abs(T[i2] * R[i1][j] - T[i1] * R[i2][j]);
+            if (Dist > Ra + Rb) return false;
+        }
+    }
+
+    return true;
+}
+
 /*
  * @brief On hit, it handles the hit
  * @param AppliedDamage The applied damage
@@ -2,9 +2,11 @@
 
 #include "Character/Components/BMInventoryComponent.h"
 #include "Character/Components/BMStatsComponent.h"
+#include "Character/BMCharacterBase.h"
 #include "Core/BMDataSubsystem.h"
 #include "Data/BMItemData.h"
 #include "System/Event/BMEventBusSubsystem.h"
+#include "System/BMStatusEffectSubsystem.h"
 #include "Engine/Engine.h"
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
@@ -393,7 +395,25 @@ bool UBMInventoryComponent::UseItem(FName ItemID, int32 Count)
 			// 持续回血：15秒内恢复50%血量
 			constexpr float HPRegenDuration = 15.f;
 			constexpr float HPRegenPercent = 50.f;
-			StatsComp->AddBuff(EBMBuffType::HealthRegenOverTime, HPRegenPercent, HPRegenDuration);
+			constexpr float HPRegenPeriod = 0.5f;
+
+			// 由持续效果子系统统一调度，按周期回复；没有子系统时退回组件内的增益
+			UBMStatusEffectSubsystem* StatusEffects = GetWorld() ? GetWorld()->GetSubsystem<UBMStatusEffectSubsystem>() : nullptr;
+			ABMCharacterBase* OwnerCharacter = Cast<ABMCharacterBase>(GetOwner());
+			if (StatusEffects && OwnerCharacter)
+			{
+				FBMStatusEffectSpec Spec;
+				Spec.EffectId = FName(TEXT("BM_ItemHealthRegen"));
+				Spec.Duration = HPRegenDuration;
+				Spec.Period = HPRegenPeriod;
+				Spec.MagnitudePerTick = StatsComp->GetEffectiveMaxHp() * HPRegenPercent / 100.f * HPRegenPeriod / HPRegenDuration;
+				Spec.bHeal = true;
+				StatusEffects->ApplyStatusEffect(OwnerCharacter, Spec, OwnerCharacter);
+			}
+			else
+			{
+				StatsComp->AddBuff(EBMBuffType::HealthRegenOverTime, HPRegenPercent, HPRegenDuration);
+			}
 			Effects.Add(TEXT("HP Regen 50% (15s)"));
 			
 			UE_LOG(LogTemp, Log, TEXT("UBMInventoryComponent::UseItem - %s 添加持续回血 (%.1f%% over %.1fs)"), 
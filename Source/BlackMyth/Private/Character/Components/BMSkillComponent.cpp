@@ -27,13 +27,66 @@ void UBMSkillComponent::BeginPlay()
 {
     Super::BeginPlay();
 
-    // 如果 SkillID 已在编辑器中设置，自动初始化技能数据
+    // 如果 SkillID 已在编辑器中设置，数据就绪后自动初始化技能数据（不阻塞在异步加载上）
     if (!SkillID.IsNone())
     {
-        InitializeSkill(SkillID);
+        UWorld* World = GetWorld();
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        if (UBMDataSubsystem* DataSubsystem = GameInstance ? GameInstance->GetSubsystem<UBMDataSubsystem>() : nullptr)
+        {
+            DataReadyHandle = DataSubsystem->CallOrRegisterOnDataReady(FOnBMDataReady::FDelegate::CreateWeakLambda(this, [this]()
+            {
+                DataReadyHandle.Reset();
+                InitializeSkill(SkillID);
+            }));
+        }
     }
 }
 
+/*
+ * @brief End play, it drops the pending data ready callback and the data hot reload subscription
+ * @param EndPlayReason The end play reason
+ */
+void UBMSkillComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UWorld* World = GetWorld();
+    UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    UBMDataSubsystem* DataSubsystem = GameInstance ? GameInstance->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    if (DataReadyHandle.IsValid())
+    {
+        if (DataSubsystem)
+        {
+            DataSubsystem->OnDataReady.Remove(DataReadyHandle);
+        }
+        DataReadyHandle.Reset();
+    }
+    if (SkillDataHandle.IsValid())
+    {
+        if (DataSubsystem)
+        {
+            DataSubsystem->UnsubscribeRow(EBMDataTable::Skill, SkillID, SkillDataHandle);
+        }
+        SkillDataHandle.Reset();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+/*
+ * @brief Handle skill data changed, it fetches the skill data again after a reload
+ * @param Table The table
+ * @param RowName The row name
+ */
+void UBMSkillComponent::HandleSkillDataChanged(EBMDataTable Table, FName RowName)
+{
+    UWorld* World = GetWorld();
+    UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    const UBMDataSubsystem* DataSubsystem = GameInstance ? GameInstance->GetSubsystem<UBMDataSubsystem>() : nullptr;
+
+    SkillData = DataSubsystem ? DataSubsystem->GetSkillData(RowName) : nullptr;
+    UE_LOG(LogBMSkill, Log, TEXT("HandleSkillDataChanged: Reloaded skill %s%s"), *RowName.ToString(), SkillData ? TEXT("") : TEXT(" (row removed)"));
+}
+
 /*
  * @brief Initialize skill, it initializes the skill data
  * @param InSkillID The skill ID
@@ -77,6 +130,16 @@ bool UBMSkillComponent::InitializeSkill(FName InSkillID)
         return false;
     }
 
+#if BM_DATA_HOT_RELOAD
+    // 按行订阅：热重载时只有使用该技能的组件会收到通知
+    if (SkillDataHandle.IsValid())
+    {
+        DataSubsystem->UnsubscribeRow(EBMDataTable::Skill, SkillID, SkillDataHandle);
+    }
+    SkillDataHandle = DataSubsystem->SubscribeRow(EBMDataTable::Skill, InSkillID,
+        FOnBMDataRowChanged::FDelegate::CreateUObject(this, &UBMSkillComponent::HandleSkillDataChanged));
+#endif
+
     SkillID = InSkillID;
     LastUsedTime = 0.0f;
     bIsSkillActive = false;
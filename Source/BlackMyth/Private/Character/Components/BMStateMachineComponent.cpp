@@ -1,6 +1,125 @@
 #include "Character/Components/BMStateMachineComponent.h"
 #include "Character/Components/BMCharacterState.h"
+#include "Character/BMCharacterBase.h"
 #include "Core/BMTypes.h"
+#include "Character/Components/BMCombatComponent.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+DEFINE_LOG_CATEGORY(LogBMStateMachine);
+
+DECLARE_CYCLE_STAT(TEXT("FSM Tick"), STAT_BMFSMTick, STATGROUP_BMCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FSM Deadlines Fired"), STAT_BMFSMDeadlinesFired, STATGROUP_BMCombat);
+
+namespace
+{
+    static const TCHAR* ReasonToString(EBMStateChangeReason Reason)
+    {
+        switch (Reason)
+        {
+        case EBMStateChangeReason::Request:            return TEXT("Request");
+        case EBMStateChangeReason::Init:               return TEXT("Init");
+        case EBMStateChangeReason::Deadline:           return TEXT("Deadline");
+        case EBMStateChangeReason::Update:             return TEXT("Update");
+        case EBMStateChangeReason::InterruptNoContext: return TEXT("InterruptNoContext");
+        case EBMStateChangeReason::Interrupted:        return TEXT("Interrupted");
+        case EBMStateChangeReason::InterruptResisted:  return TEXT("InterruptResisted");
+        case EBMStateChangeReason::Uninterruptible:    return TEXT("Uninterruptible");
+        default:                                       return TEXT("Unknown");
+        }
+    }
+
+    static const TCHAR* ResultToString(EBMStateChangeResult Result)
+    {
+        switch (Result)
+        {
+        case EBMStateChangeResult::Entered:      return TEXT("Entered");
+        case EBMStateChangeResult::Denied:       return TEXT("Denied");
+        case EBMStateChangeResult::Unregistered: return TEXT("Unregistered");
+        case EBMStateChangeResult::Rejected:     return TEXT("Rejected");
+        default:                                 return TEXT("Unknown");
+        }
+    }
+
+    static FString StateIdToString(EBMStateId Id)
+    {
+        return StaticEnum<EBMStateId>()->GetNameStringByValue(static_cast<int64>(Id));
+    }
+
+    /*
+     * @brief Dump trace, it writes the transition records of one character or of the whole world to a CSV file
+     * @param Args The command arguments: [ActorName|all] [FilePath]
+     * @param World The world
+     */
+    static void DumpTrace(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World) return;
+
+        const FString Filter = Args.Num() > 0 ? Args[0] : FString();
+        const bool bAll = Filter.IsEmpty() || Filter.Equals(TEXT("all"), ESearchCase::IgnoreCase);
+        const FString FilePath = Args.Num() > 1
+            ? Args[1]
+            : FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("BMFSMTrace.csv");
+
+        FString Csv = TEXT("Actor,Frame,Time,From,To,Reason,Result,Repeat\n");
+        TArray<FBMStateTraceRecord> Records;
+        int32 NumActors = 0;
+        int32 NumRows = 0;
+
+        for (TActorIterator<ABMCharacterBase> It(World); It; ++It)
+        {
+            const ABMCharacterBase* Character = *It;
+            if (!bAll && Character->GetName() != Filter && Character->GetActorNameOrLabel() != Filter)
+            {
+                continue;
+            }
+
+            const UBMStateMachineComponent* Machine = Character->GetFSM();
+            if (!Machine) continue;
+
+            Machine->GetTraceRecords(Records);
+            ++NumActors;
+
+            const FString ActorName = Character->GetName();
+            for (const FBMStateTraceRecord& Record : Records)
+            {
+                Csv += FString::Printf(TEXT("%s,%u,%.4f,%s,%s,%s,%s,%d\n"),
+                    *ActorName,
+                    Record.Frame,
+                    Record.Time,
+                    *StateIdToString(Record.From),
+                    *StateIdToString(Record.To),
+                    ReasonToString(Record.Reason),
+                    ResultToString(Record.Result),
+                    Record.Repeat);
+                ++NumRows;
+            }
+        }
+
+        if (NumActors == 0)
+        {
+            UE_LOG(LogBMStateMachine, Warning, TEXT("bm.FSM.DumpTrace: no character matches '%s'."), *Filter);
+            return;
+        }
+
+        if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+        {
+            UE_LOG(LogBMStateMachine, Error, TEXT("bm.FSM.DumpTrace: failed to write %s."), *FilePath);
+            return;
+        }
+
+        UE_LOG(LogBMStateMachine, Log, TEXT("bm.FSM.DumpTrace: wrote %d records from %d characters to %s."),
+            NumRows, NumActors, *FilePath);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMFSMDumpTraceCommand(
+        TEXT("bm.FSM.DumpTrace"),
+        TEXT("bm.FSM.DumpTrace [ActorName|all] [FilePath]: write the recent state machine transitions of one character (or every character) to CSV, default Saved/Profiling/BMFSMTrace.csv."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DumpTrace));
+}
 
 /*
  * @brief Constructor of the UBMStateMachineComponent class
@@ -11,74 +130,242 @@ UBMStateMachineComponent::UBMStateMachineComponent()
 }
 
 /*
- * @brief Register state, it registers the state
- * @param Name The name of the state
- * @param State The state
+ * @brief Constructor of the FBMStateMachineDefinition struct, it starts with no states and every transition denied
+ */
+FBMStateMachineDefinition::FBMStateMachineDefinition()
+{
+    for (int32 From = 0; From < NumStates; ++From)
+    {
+        States[From] = nullptr;
+        Names[From] = NAME_None;
+        for (int32 To = 0; To < NumStates; ++To)
+        {
+            RequiredFlags[From][To] = DenyFlags;
+        }
+    }
+}
+
+/*
+ * @brief Add state, it registers the shared state and expands its transition rules into the table
+ * @param Id The id of the state
+ * @param Name The debug name of the state
+ * @param State The shared state object
+ */
+void FBMStateMachineDefinition::AddState(EBMStateId Id, FName Name, const UBMCharacterState* State)
+{
+    const int32 From = static_cast<int32>(Id);
+    if (From <= 0 || From >= NumStates || !State) return;
+
+    States[From] = State;
+    Names[From] = Name;
+
+    for (int32 To = 0; To < NumStates; ++To)
+    {
+        switch (State->GetTransitionRule(static_cast<EBMStateId>(To)))
+        {
+        case EBMStateTransitionRule::Allow:
+            RequiredFlags[From][To] = 0;
+            break;
+        case EBMStateTransitionRule::WhenFinished:
+            RequiredFlags[From][To] = FBMStateContext::Flag_Finished;
+            break;
+        case EBMStateTransitionRule::WhenRecovering:
+            RequiredFlags[From][To] = FBMStateContext::Flag_Recovering;
+            break;
+        default:
+            RequiredFlags[From][To] = DenyFlags;
+            break;
+        }
+    }
+}
+
+/*
+ * @brief Init state machine, it binds the shared definition and enters the initial state
+ * @param InDefinition The state machine definition
+ * @param InitialState The id of the initial state
  */
-void UBMStateMachineComponent::RegisterState(FName Name, UBMCharacterState* State)
+void UBMStateMachineComponent::InitStateMachine(const FBMStateMachineDefinition* InDefinition, EBMStateId InitialState)
 {
-    if (Name.IsNone() || !State) return;
-    States.Add(Name, State);
+    if (!InDefinition) return;
+
+    Definition = InDefinition;
+    Context.Owner = Cast<ABMCharacterBase>(GetOwner());
+
+    RecordTrace(CurrentStateId, InitialState, EBMStateChangeReason::Init, EBMStateChangeResult::Entered);
+    EnterState(InitialState);
 }
 
 /*
- * @brief Change state, it changes the state
- * @param NewState The new state
+ * @brief Change state by id, it checks the transition table, records the attempt and changes the state
+ * @param Id The id of the target state
+ * @param Reason The reason of the change
+ * @return True if the state is changed or already active, false otherwise
  */
-void UBMStateMachineComponent::ChangeState(UBMCharacterState* NewState)
+bool UBMStateMachineComponent::ChangeStateById(EBMStateId Id, EBMStateChangeReason Reason)
 {
-    if (NewState == Current) return;
+    if (Reason == EBMStateChangeReason::Request)
+    {
+        Reason = DispatchReason;
+    }
 
-    if (Current)
+    if (!Definition || !Definition->GetState(Id))
     {
-        Current->OnExit(0.f);
+        RecordTrace(CurrentStateId, Id, Reason, EBMStateChangeResult::Unregistered);
+        return false;
     }
-    Current = NewState;
 
-    // ��������
-    CurrentStateName = NAME_None;
-    for (const auto& It : States)
+    if (CurrentStateId != EBMStateId::None)
     {
-        if (It.Value == Current)
+        const uint8 Required = Definition->GetRequiredFlags(CurrentStateId, Id);
+        if ((Context.Flags & Required) != Required)
         {
-            CurrentStateName = It.Key;
-            break;
+            RecordTrace(CurrentStateId, Id, Reason, EBMStateChangeResult::Denied);
+            return false;
         }
     }
 
-    if (Current)
+    if (Id == CurrentStateId) return true;
+
+    // 先记录再进入，OnEnter 中发起的嵌套切换排在其后
+    RecordTrace(CurrentStateId, Id, Reason, EBMStateChangeResult::Entered);
+    EnterState(Id);
+    return true;
+}
+
+/*
+ * @brief Record rejected change, it records a change that the gameplay code decided not to request
+ * @param Id The id of the state that would have been entered
+ * @param Reason The reason of the rejection
+ */
+void UBMStateMachineComponent::RecordRejectedChange(EBMStateId Id, EBMStateChangeReason Reason)
+{
+    RecordTrace(CurrentStateId, Id, Reason, EBMStateChangeResult::Rejected);
+}
+
+/*
+ * @brief Record trace, it writes a fixed size record into the ring buffer, an identical record in a row only bumps the repeat count
+ * @param From The id of the current state
+ * @param To The id of the target state
+ * @param Reason The reason of the change
+ * @param Result The result of the change
+ */
+void UBMStateMachineComponent::RecordTrace(EBMStateId From, EBMStateId To, EBMStateChangeReason Reason, EBMStateChangeResult Result)
+{
+    const uint32 Frame = static_cast<uint32>(GFrameCounter);
+    const UWorld* World = GetWorld();
+    const float Time = World ? World->GetTimeSeconds() : 0.f;
+
+    if (TraceWriteCount > 0)
     {
-        Current->OnEnter(0.f);
+        FBMStateTraceRecord& Last = TraceRecords[(TraceWriteCount - 1) % TraceCapacity];
+        if (Last.From == From && Last.To == To && Last.Reason == Reason && Last.Result == Result && Last.Repeat < MAX_uint16)
+        {
+            ++Last.Repeat;
+            Last.Frame = Frame;
+            Last.Time = Time;
+            return;
+        }
     }
+
+    FBMStateTraceRecord& Record = TraceRecords[TraceWriteCount % TraceCapacity];
+    Record.Frame = Frame;
+    Record.Time = Time;
+    Record.From = From;
+    Record.To = To;
+    Record.Reason = Reason;
+    Record.Result = Result;
+    Record.Repeat = 1;
+    ++TraceWriteCount;
 }
 
 /*
- * @brief Change state by name, it changes the state by name
- * @param Name The name of the state
- * @return True if the state is changed, false otherwise
+ * @brief Get trace records, it copies the ring buffer from the oldest record to the newest
+ * @param OutRecords The records
  */
-bool UBMStateMachineComponent::ChangeStateByName(FName Name)
+void UBMStateMachineComponent::GetTraceRecords(TArray<FBMStateTraceRecord>& OutRecords) const
 {
-    TObjectPtr<UBMCharacterState>* Found = States.Find(Name);
-    if (!Found || !(*Found)) return false;
+    OutRecords.Reset();
 
-    if (Current && !Current->CanTransitionTo(Name))
+    const uint32 Num = FMath::Min<uint32>(TraceWriteCount, TraceCapacity);
+    OutRecords.Reserve(Num);
+    for (uint32 i = TraceWriteCount - Num; i < TraceWriteCount; ++i)
     {
-        return false;
+        OutRecords.Add(TraceRecords[i % TraceCapacity]);
+    }
+}
+
+/*
+ * @brief Enter state, it exits the current state, resets the context and enters the new state
+ * @param Id The id of the new state
+ */
+void UBMStateMachineComponent::EnterState(EBMStateId Id)
+{
+    if (const UBMCharacterState* Current = GetCurrentState())
+    {
+        Current->OnExit(Context, 0.f);
     }
 
-    ChangeState(*Found);
-    return true;
+    Context.ResetData();
+    Context.ClearDeadlines();
+    Context.Flags = 0;
+    CurrentStateId = Id;
+
+    if (const UBMCharacterState* Next = GetCurrentState())
+    {
+        Next->OnEnter(Context, 0.f);
+    }
+}
+
+/*
+ * @brief Get current state, it returns the shared state object of the current state
+ * @return The current state, nullptr if no state is active
+ */
+const UBMCharacterState* UBMStateMachineComponent::GetCurrentState() const
+{
+    return Definition ? Definition->GetState(CurrentStateId) : nullptr;
 }
 
 /*
- * @brief Tick state, it ticks the state
+ * @brief Get current state name, it returns the debug name of the current state
+ * @return The name of the current state, NAME_None if no state is active
+ */
+FName UBMStateMachineComponent::GetCurrentStateName() const
+{
+    return Definition ? Definition->GetStateName(CurrentStateId) : NAME_None;
+}
+
+/*
+ * @brief Tick state, it advances the state machine clock, dispatches the due deadlines and ticks the state
  * @param DeltaSeconds The delta seconds
  */
 void UBMStateMachineComponent::TickState(float DeltaSeconds)
 {
-    if (Current)
+    SCOPE_CYCLE_COUNTER(STAT_BMFSMTick);
+
+    Context.Time += DeltaSeconds;
+
+    // 更新中发起的请求按来源记录原因
+    ON_SCOPE_EXIT { DispatchReason = EBMStateChangeReason::Request; };
+
+    // 到期事件可能触发切换，切换会清空挂起事件，因此每次都从当前状态重新取
+    DispatchReason = EBMStateChangeReason::Deadline;
+    const EBMStateId StateBeforeDeadlines = CurrentStateId;
+    uint8 EventId = 0;
+    while (Context.PopDueDeadline(EventId))
+    {
+        const UBMCharacterState* Current = GetCurrentState();
+        if (!Current) break;
+
+        INC_DWORD_STAT(STAT_BMFSMDeadlinesFired);
+        Current->OnDeadline(Context, EventId);
+    }
+
+    // 本帧刚由到期事件切入的状态从下一帧开始更新，避免拿到切换前的帧时间
+    if (CurrentStateId != StateBeforeDeadlines) return;
+
+    DispatchReason = EBMStateChangeReason::Update;
+    if (const UBMCharacterState* Current = GetCurrentState())
     {
-        Current->OnUpdate(DeltaSeconds);
+        Current->OnUpdate(Context, DeltaSeconds);
     }
 }
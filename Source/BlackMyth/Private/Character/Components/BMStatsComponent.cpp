@@ -4,35 +4,563 @@
 #include "Engine/GameInstance.h"
 #include "UI/BMDeathWidget.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
 
 DEFINE_LOG_CATEGORY(LogBMStats);
 
+namespace
+{
+    // 解析值与上限的差小于该值时视为已回满（吸收浮点误差）
+    static constexpr float ResourceFullTolerance = 1e-3f;
+
+    // 资源事件定时器的最小间隔（SetTimer 的间隔 <= 0 会清除定时器）
+    static constexpr float MinResourceEventDelay = 0.001f;
+
+    /*
+     * @brief Check regen, it compares a per-frame stamina integration with the analytic stamina of the player's stats component
+     * @param Args The command arguments: [Seconds] [Fps]
+     * @param World The world
+     */
+    static void CheckRegen(const TArray<FString>& Args, UWorld* World)
+    {
+        const APawn* Player = World ? UGameplayStatics::GetPlayerPawn(World, 0) : nullptr;
+        UBMStatsComponent* Stats = Player ? Player->FindComponentByClass<UBMStatsComponent>() : nullptr;
+        if (!Stats)
+        {
+            UE_LOG(LogBMStats, Warning, TEXT("bm.Stats.RegenCheck: no player stats component."));
+            return;
+        }
+
+        const float Seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 5.f;
+        const float Fps = Args.Num() > 1 ? FMath::Max(1.f, FCString::Atof(*Args[1])) : 60.f;
+
+        const float Current = Stats->GetCurrentStamina();
+        const float Max = Stats->GetStatBlock().MaxStamina;
+        if (Current >= Max)
+        {
+            UE_LOG(LogBMStats, Log, TEXT("bm.Stats.RegenCheck: stamina is full (%.3f), spend some first."), Current);
+            return;
+        }
+
+        int32 Frames = 0;
+        const float MaxError = Stats->MeasureStaminaRegenError(Seconds, Fps, Frames);
+
+        UE_LOG(LogBMStats, Log, TEXT("bm.Stats.RegenCheck: %d frames at %.0f fps, max |stepped - analytic| = %g, current stamina %.3f / %.3f, rate %.3f/s."),
+            Frames, Fps, MaxError, Current, Max, Stats->GetStaminaRegenRate());
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMStatsRegenCheckCommand(
+        TEXT("bm.Stats.RegenCheck"),
+        TEXT("bm.Stats.RegenCheck [Seconds] [Fps]: integrate the player's stamina regen per frame from now and compare it with the stats component's analytic stamina at the same timestamps; logs the largest difference."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&CheckRegen));
+}
+
 /*
  * @brief Constructor of the UBMStatsComponent class
  */
 UBMStatsComponent::UBMStatsComponent()
 {
-    PrimaryComponentTick.bCanEverTick = true;
+    // 资源恢复按时间解析计算，回满与增益到期由定时器驱动，组件无需 Tick
+    PrimaryComponentTick.bCanEverTick = false;
 }
 
 /*
- * @brief Begin play, it initializes the stats
+ * @brief Begin play, it initializes the stats and imports the owner actor tags as gameplay tags
  */
 void UBMStatsComponent::BeginPlay()
 {
     Super::BeginPlay();
 
+    // Actor Tags（如 Boss 在 BeginPlay 中添加的 "Boss"）一次性转换为位集合
+    if (const AActor* Owner = GetOwner())
+    {
+        TagBits.Add(FBMTagRegistry::Get().MakeTagBits(Owner->Tags));
+    }
+
+    // 子系统只查找一次，后续属性推送直接使用缓存
     if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
     {
-        if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
+        CachedEventBus = GI->GetSubsystem<UBMEventBusSubsystem>();
+        CachedUIManager = GI->GetSubsystem<UBMUIManagerSubsystem>();
+    }
+
+    ResourceAnchorTime = GetWorldTimeSeconds();
+    StaminaRegenDelayUntil = 0.0;
+    ScheduleResourceEvent();
+
+    // 初始值立即推送，保证 HUD 首帧正确
+    MarkStatDirty(StatChannel_Health | StatChannel_Stamina);
+    FlushStatChanges();
+}
+
+/*
+ * @brief End play, it clears the resource event, stat flush and stat settle timers
+ * @param EndPlayReason The end play reason
+ */
+void UBMStatsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(ResourceEventTimer);
+        World->GetTimerManager().ClearTimer(StatFlushTimer);
+        World->GetTimerManager().ClearTimer(StatSettleTimer);
+    }
+    bStatFlushScheduled = false;
+    UnsettledStatChannels = 0;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+/*
+ * @brief Mark stat dirty, it marks the channels dirty and schedules one coalesced flush
+ * @param Channels The stat channels
+ */
+void UBMStatsComponent::MarkStatDirty(uint8 Channels)
+{
+    DirtyStatChannels |= Channels;
+
+    if (bStatFlushScheduled)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World || !HasBegunPlay())
+    {
+        return;
+    }
+
+    // 同帧（或同一 UI 周期）内的多次变化只推送一次
+    bStatFlushScheduled = true;
+    if (UIUpdateInterval > 0.f)
+    {
+        World->GetTimerManager().SetTimer(StatFlushTimer, this, &UBMStatsComponent::HandleStatFlushTimer, UIUpdateInterval, false);
+    }
+    else
+    {
+        StatFlushTimer = World->GetTimerManager().SetTimerForNextTick(this, &UBMStatsComponent::HandleStatFlushTimer);
+    }
+}
+
+/*
+ * @brief Handle stat flush timer, it reschedules the resource event if requested and flushes the dirty channels
+ */
+void UBMStatsComponent::HandleStatFlushTimer()
+{
+    bStatFlushScheduled = false;
+
+    if (bResourceRescheduleRequested)
+    {
+        bResourceRescheduleRequested = false;
+        ScheduleResourceEvent();
+    }
+
+    FlushStatChanges();
+}
+
+/*
+ * @brief Get world time seconds, it returns the world time used as the regen time base
+ * @return The world time in seconds
+ */
+double UBMStatsComponent::GetWorldTimeSeconds() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetTimeSeconds() : 0.0;
+}
+
+/*
+ * @brief Evaluate stamina, it computes the stamina at the time from the anchor value and the regen rate
+ * @param Time The world time
+ * @return The stamina at the time
+ */
+float UBMStatsComponent::EvaluateStamina(double Time) const
+{
+    if (IsDead() || Stats.MaxStamina <= 0.f || Stats.Stamina >= Stats.MaxStamina)
+    {
+        return Stats.Stamina;
+    }
+
+    const double Elapsed = Time - FMath::Max(ResourceAnchorTime, StaminaRegenDelayUntil);
+    if (Elapsed <= 0.0)
+    {
+        return Stats.Stamina;
+    }
+
+    const float Value = FMath::Clamp(Stats.Stamina + GetStaminaRegenRate() * (float)Elapsed, 0.f, Stats.MaxStamina);
+    return (Stats.MaxStamina - Value <= ResourceFullTolerance) ? Stats.MaxStamina : Value;
+}
+
+/*
+ * @brief Evaluate HP, it computes the HP at the time from the anchor value and the health regen rate
+ * @param Time The world time
+ * @return The HP at the time
+ */
+float UBMStatsComponent::EvaluateHP(double Time) const
+{
+    const float EffectiveMaxHp = GetEffectiveMaxHp();
+    if (IsDead() || BuffAggregate.HealthRegenPercentPerSec <= 0.f || Stats.HP >= EffectiveMaxHp)
+    {
+        return Stats.HP;
+    }
+
+    const double Elapsed = Time - ResourceAnchorTime;
+    if (Elapsed <= 0.0)
+    {
+        return Stats.HP;
+    }
+
+    const float Value = FMath::Clamp(Stats.HP + GetHealthRegenRate() * (float)Elapsed, 0.f, EffectiveMaxHp);
+    return (EffectiveMaxHp - Value <= ResourceFullTolerance) ? EffectiveMaxHp : Value;
+}
+
+/*
+ * @brief Settle resources, it writes the analytic values back to the stat block and moves the time base to now
+ */
+void UBMStatsComponent::SettleResources()
+{
+    const double Now = GetWorldTimeSeconds();
+    if (Now <= ResourceAnchorTime)
+    {
+        return;
+    }
+
+    Stats.Stamina = EvaluateStamina(Now);
+    Stats.HP = EvaluateHP(Now);
+    ResourceAnchorTime = Now;
+}
+
+/*
+ * @brief Schedule resource event, it arms one timer for the earliest of stamina full, health full and buff expiry
+ */
+void UBMStatsComponent::ScheduleResourceEvent()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    SettleResources();
+
+    const double Now = GetWorldTimeSeconds();
+    double Delay = TNumericLimits<double>::Max();
+
+    if (!IsDead())
+    {
+        const float StaminaRate = GetStaminaRegenRate();
+        if (StaminaRate > 0.f && Stats.Stamina < Stats.MaxStamina)
+        {
+            const double RegenStart = FMath::Max(Now, StaminaRegenDelayUntil);
+            Delay = FMath::Min(Delay, (RegenStart - Now) + (Stats.MaxStamina - Stats.Stamina) / StaminaRate);
+        }
+
+        const float HealthRate = GetHealthRegenRate();
+        const float EffectiveMaxHp = GetEffectiveMaxHp();
+        if (HealthRate > 0.f && Stats.HP < EffectiveMaxHp)
         {
-            const float HealthNormalized = Stats.MaxHP > 0.f ? Stats.HP / Stats.MaxHP : 0.f;
-            Bus->EmitPlayerHealth(HealthNormalized);
+            Delay = FMath::Min(Delay, (double)((EffectiveMaxHp - Stats.HP) / HealthRate));
+        }
+    }
+
+    if (NextBuffExpiryTime < MAX_flt)
+    {
+        Delay = FMath::Min(Delay, (double)NextBuffExpiryTime - Now);
+    }
+
+    FTimerManager& TimerManager = World->GetTimerManager();
+    if (Delay == TNumericLimits<double>::Max())
+    {
+        TimerManager.ClearTimer(ResourceEventTimer);
+        return;
+    }
 
-            const float StaminaNormalized = Stats.MaxStamina > 0.f ? Stats.Stamina / Stats.MaxStamina : 0.f;
-            Bus->EmitPlayerStamina(StaminaNormalized);
+    TimerManager.SetTimer(ResourceEventTimer, this, &UBMStatsComponent::HandleResourceEvent,
+        FMath::Max((float)Delay, MinResourceEventDelay), false);
+}
+
+/*
+ * @brief Handle resource event, it settles the resources, expires the buffs, pushes the full values and schedules the next event
+ */
+void UBMStatsComponent::HandleResourceEvent()
+{
+    if (IsDead())
+    {
+        return;
+    }
+
+    SettleResources();
+    TickBuffs();
+
+    // 回满时推送一次精确的满值（恢复过程中 UI 直接读取解析值）
+    MarkStatDirty(StatChannel_Health | StatChannel_Stamina);
+
+    ScheduleResourceEvent();
+}
+
+/*
+ * @brief Get current stamina, it returns the analytic stamina at the current time
+ * @return The current stamina
+ */
+float UBMStatsComponent::GetCurrentStamina() const
+{
+    return EvaluateStamina(GetWorldTimeSeconds());
+}
+
+/*
+ * @brief Get current HP, it returns the analytic HP at the current time
+ * @return The current HP
+ */
+float UBMStatsComponent::GetCurrentHP() const
+{
+    return EvaluateHP(GetWorldTimeSeconds());
+}
+
+/*
+ * @brief Measure stamina regen error, it integrates the stamina per frame from now, honoring the regen delay, and compares it with EvaluateStamina at every frame
+ * @param Seconds The duration to check
+ * @param Fps The integration frame rate
+ * @param OutFrames The number of frames integrated
+ * @return The largest absolute difference between the integrated and the analytic stamina
+ */
+float UBMStatsComponent::MeasureStaminaRegenError(float Seconds, float Fps, int32& OutFrames) const
+{
+    OutFrames = FMath::CeilToInt(Seconds * Fps);
+
+    TArray<float> FrameDeltas;
+    FrameDeltas.Init(1.f / FMath::Max(1.f, Fps), OutFrames);
+    return MeasureStaminaRegenError(FrameDeltas);
+}
+
+/*
+ * @brief Measure stamina regen error, it integrates the stamina over the given frame deltas from now, honoring the regen delay, and compares it with EvaluateStamina at the end of every frame
+ * @param FrameDeltas The delta seconds of every frame
+ * @return The largest absolute difference between the integrated and the analytic stamina
+ */
+float UBMStatsComponent::MeasureStaminaRegenError(TConstArrayView<float> FrameDeltas) const
+{
+    const double Now = GetWorldTimeSeconds();
+    const double RegenStart = FMath::Max(Now, StaminaRegenDelayUntil);
+    const float Rate = GetStaminaRegenRate();
+    const float Max = Stats.MaxStamina;
+
+    // 逐帧积分（原 TickComponent 的做法），只累计每帧中恢复延迟结束后的部分
+    float Stepped = EvaluateStamina(Now);
+    float MaxError = 0.f;
+    double FrameEnd = Now;
+    for (const float Dt : FrameDeltas)
+    {
+        FrameEnd += Dt;
+        const double Active = FrameEnd - FMath::Max(FrameEnd - Dt, RegenStart);
+        if (Active > 0.0 && Stepped < Max)
+        {
+            Stepped = FMath::Clamp(Stepped + Rate * (float)Active, 0.f, Max);
         }
+        MaxError = FMath::Max(MaxError, FMath::Abs(Stepped - EvaluateStamina(FrameEnd)));
+    }
+    return MaxError;
+}
+
+/*
+ * @brief Is regenerating, it checks whether the stamina or the health is still regenerating
+ * @return True if a resource is regenerating, false otherwise
+ */
+bool UBMStatsComponent::IsRegenerating() const
+{
+    if (IsDead())
+    {
+        return false;
     }
+
+    const bool bStaminaRegen = GetStaminaRegenRate() > 0.f && GetCurrentStamina() < Stats.MaxStamina;
+    const bool bHealthRegen = GetHealthRegenRate() > 0.f && GetCurrentHP() < GetEffectiveMaxHp();
+    return bStaminaRegen || bHealthRegen;
+}
+
+/*
+ * @brief Get stat block, it returns a copy of the stat block with the analytic HP and stamina at the current time
+ * @return The stat block
+ */
+FBMStatBlock UBMStatsComponent::GetStatBlock() const
+{
+    FBMStatBlock Block = Stats;
+    Block.Stamina = GetCurrentStamina();
+    Block.HP = GetCurrentHP();
+    return Block;
+}
+
+/*
+ * @brief Get stat block mutable, it settles the analytic resources and requests a reschedule after the caller edits the block
+ * @return The mutable stat block
+ */
+FBMStatBlock& UBMStatsComponent::GetStatBlockMutable()
+{
+    SettleResources();
+
+    // 调用方可能修改上限或当前值，下一次合并推送时重新安排回满事件
+    bResourceRescheduleRequested = true;
+    MarkStatDirty(0);
+    return Stats;
+}
+
+/*
+ * @brief Should send stat, it checks whether the change crosses a display quantum
+ * @param NewValue The new normalized value
+ * @param LastSent The last sent normalized value
+ * @param bExact True to send any change regardless of the display quantum
+ * @return True if the change should be sent, false otherwise
+ */
+bool UBMStatsComponent::ShouldSendStat(float NewValue, float LastSent, bool bExact) const
+{
+    if (LastSent < 0.f)
+    {
+        return true;
+    }
+    if (NewValue == LastSent)
+    {
+        return false;
+    }
+    // 满/空值必须精确显示
+    if (bExact || NewValue <= 0.f || NewValue >= 1.f)
+    {
+        return true;
+    }
+    return FMath::Abs(NewValue - LastSent) >= UIDisplayQuantum;
+}
+
+/*
+ * @brief Flush stat changes, it sends the dirty channels to the event bus at most once
+ */
+void UBMStatsComponent::FlushStatChanges()
+{
+    const uint8 Channels = DirtyStatChannels;
+    DirtyStatChannels = 0;
+
+    SendStatChannels(Channels, false);
+    ScheduleStatSettle();
+}
+
+/*
+ * @brief Send stat channels, it sends the normalized values of the channels that changed enough,
+ *        channels held back by the display quantum are remembered for the exact value flush
+ * @param Channels The stat channels
+ * @param bExact True to send any change regardless of the display quantum
+ */
+void UBMStatsComponent::SendStatChannels(uint8 Channels, bool bExact)
+{
+    UBMEventBusSubsystem* Bus = CachedEventBus.Get();
+    if (Channels == 0 || !Bus)
+    {
+        return;
+    }
+
+    const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+    const bool bPlayer = OwnerPawn && OwnerPawn->IsPlayerControlled();
+
+    // 显示值与当前值不同（变化不足一个步长）的通道记下，停止变化后补推精确值
+    auto TrackUnsettled = [this](uint8 Channel, float Normalized, float LastSent)
+    {
+        if (Normalized != LastSent)
+        {
+            UnsettledStatChannels |= Channel;
+        }
+        else
+        {
+            UnsettledStatChannels &= ~Channel;
+        }
+    };
+
+    if (Channels & StatChannel_Health)
+    {
+        static const FBMTagBits BossBits = FBMTagRegistry::Get().GetTagBits(BMGameplayTags::Boss);
+        if (bPlayer || TagBits.HasAny(BossBits))
+        {
+            const float EffectiveMaxHp = GetEffectiveMaxHp();
+            const float Normalized = EffectiveMaxHp > 0.f ? FMath::Clamp(GetCurrentHP() / EffectiveMaxHp, 0.f, 1.f) : 0.f;
+            if (ShouldSendStat(Normalized, LastSentHealth, bExact))
+            {
+                LastSentHealth = Normalized;
+                if (bPlayer)
+                {
+                    Bus->EmitPlayerHealth(Normalized);
+                }
+                else
+                {
+                    Bus->EmitBossHealth(Normalized);
+                }
+            }
+            TrackUnsettled(StatChannel_Health, Normalized, LastSentHealth);
+        }
+    }
+
+    if (!bPlayer)
+    {
+        return;
+    }
+
+    if (Channels & StatChannel_Stamina)
+    {
+        const float Normalized = Stats.MaxStamina > 0.f ? FMath::Clamp(GetCurrentStamina() / Stats.MaxStamina, 0.f, 1.f) : 0.f;
+        if (ShouldSendStat(Normalized, LastSentStamina, bExact))
+        {
+            LastSentStamina = Normalized;
+            Bus->EmitPlayerStamina(Normalized);
+        }
+        TrackUnsettled(StatChannel_Stamina, Normalized, LastSentStamina);
+    }
+
+    if (Channels & StatChannel_Mana)
+    {
+        const float Normalized = Stats.MaxMP > 0.f ? FMath::Clamp(Stats.MP / Stats.MaxMP, 0.f, 1.f) : 0.f;
+        if (ShouldSendStat(Normalized, LastSentMana, bExact))
+        {
+            LastSentMana = Normalized;
+            Bus->EmitPlayerMana(Normalized);
+        }
+        TrackUnsettled(StatChannel_Mana, Normalized, LastSentMana);
+    }
+}
+
+/*
+ * @brief Schedule stat settle, it restarts the exact value flush while changes keep being held back, capped by the settle timeout
+ */
+void UBMStatsComponent::ScheduleStatSettle()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    FTimerManager& TimerManager = World->GetTimerManager();
+    if (UnsettledStatChannels == 0)
+    {
+        TimerManager.ClearTimer(StatSettleTimer);
+        return;
+    }
+
+    // 第一次未推送的变化开始计最迟时间，之后的变化只推迟到不超过它
+    const double Now = GetWorldTimeSeconds();
+    if (!TimerManager.IsTimerActive(StatSettleTimer))
+    {
+        StatSettleDeadline = Now + FMath::Max(UIDisplaySettleDelay, UIDisplaySettleTimeout);
+    }
+
+    const double Delay = FMath::Min((double)UIDisplaySettleDelay, StatSettleDeadline - Now);
+    TimerManager.SetTimer(StatSettleTimer, this, &UBMStatsComponent::HandleStatSettleTimer,
+        FMath::Max((float)Delay, MinResourceEventDelay), false);
+}
+
+/*
+ * @brief Handle stat settle timer, it sends the exact values of the channels that were held back by the display quantum
+ */
+void UBMStatsComponent::HandleStatSettleTimer()
+{
+    const uint8 Channels = UnsettledStatChannels;
+    UnsettledStatChannels = 0;
+    SendStatChannels(Channels, true);
 }
 
 /*
@@ -63,6 +591,9 @@ float UBMStatsComponent::ApplyDamage(FBMDamageInfo& InOutInfo)
         return 0.f;
     }
 
+    // 持续回血按旧值结算到当前时刻，再扣除伤害
+    SettleResources();
+
     float Mitigated = Input;
     if (InOutInfo.DamageType != EBMDamageType::TrueDamage)
     {
@@ -78,66 +609,54 @@ float UBMStatsComponent::ApplyDamage(FBMDamageInfo& InOutInfo)
 
     InOutInfo.DamageValue = Applied;
 
-    if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+    // 同帧多次受击合并为一次推送（玩家血条 / Boss 血条）
+    MarkStatDirty(StatChannel_Health);
+
+    // 持续回血的回满时间随之变化；死亡时停止所有恢复
+    if (IsDead())
     {
-        if (OwnerPawn->IsPlayerControlled())
+        if (UWorld* World = GetWorld())
         {
-            if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-            {
-                if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                {
-                    const float Normalized = Stats.MaxHP > 0.f ? Stats.HP / Stats.MaxHP : 0.f;
-                    Bus->EmitPlayerHealth(Normalized);
-                }
-            }
-        }
-        else
-        {
-            if (OwnerPawn->ActorHasTag(TEXT("Boss")))
-            {
-                if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-                {
-                    if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                    {
-                        const float Normalized = Stats.MaxHP > 0.f ? Stats.HP / Stats.MaxHP : 0.f;
-                        Bus->EmitBossHealth(Normalized);
-                    }
-                }
-            }
+            World->GetTimerManager().ClearTimer(ResourceEventTimer);
         }
     }
+    else if (BuffAggregate.HealthRegenPercentPerSec > 0.f)
+    {
+        ScheduleResourceEvent();
+    }
 
     if (IsDead() && !bDeathBroadcasted)
     {
         bDeathBroadcasted = true;
+
+        // 死亡前先把 0 血推送出去，合并推送定时器可能晚于死亡处理
+        FlushStatChanges();
+
         OnDeathNative.Broadcast(InOutInfo.InstigatorActor.Get());
 
         if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
         {
             if (OwnerPawn->IsPlayerControlled())
             {
-                if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+                if (UBMEventBusSubsystem* Bus = CachedEventBus.Get())
                 {
-                    if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                    {
-                        Bus->EmitPlayerDied();
-                    }
-                    if (auto* UI = GI->GetSubsystem<UBMUIManagerSubsystem>())
+                    Bus->EmitPlayerDied();
+                }
+                if (UBMUIManagerSubsystem* UI = CachedUIManager.Get())
+                {
+                    // Try to load a default death widget if available. You can also expose in GI if preferred.
+                    if (UClass* DeathClass = LoadClass<UBMDeathWidget>(nullptr, TEXT("/Game/UI/WBP_Death.WBP_Death_C")))
                     {
-                        // Try to load a default death widget if available. You can also expose in GI if preferred.
-                        if (UClass* DeathClass = LoadClass<UBMDeathWidget>(nullptr, TEXT("/Game/UI/WBP_Death.WBP_Death_C")))
+                        UI->ShowDeath(DeathClass);
+                        // Switch to UI-only input so player cannot control character and can use mouse to click
+                        if (UWorld* World = GetWorld())
                         {
-                            UI->ShowDeath(DeathClass);
-                            // Switch to UI-only input so player cannot control character and can use mouse to click
-                            if (UWorld* World = GetWorld())
+                            if (APlayerController* PC = World->GetFirstPlayerController())
                             {
-                                if (APlayerController* PC = World->GetFirstPlayerController())
-                                {
-                                    FInputModeUIOnly InputMode;
-                                    InputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
-                                    PC->SetInputMode(InputMode);
-                                    PC->bShowMouseCursor = true;
-                                }
+                                FInputModeUIOnly InputMode;
+                                InputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
+                                PC->SetInputMode(InputMode);
+                                PC->bShowMouseCursor = true;
                             }
                         }
                     }
@@ -157,19 +676,16 @@ float UBMStatsComponent::ApplyDamage(FBMDamageInfo& InOutInfo)
 bool UBMStatsComponent::TryConsumeStamina(float Amount)
 {
     if (Amount <= 0.f) return true;
+
+    SettleResources();
     if (Stats.Stamina < Amount) return false;
     Stats.Stamina -= Amount;
-    
-    // Emit stamina change to UI
-    if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-    {
-        if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-        {
-            const float Normalized = Stats.MaxStamina > 0.f ? Stats.Stamina / Stats.MaxStamina : 0.f;
-            Bus->EmitPlayerStamina(Normalized);
-        }
-    }
-    
+
+    // 从消耗时刻（加上恢复延迟）重新开始恢复，并安排回满事件
+    StaminaRegenDelayUntil = GetWorldTimeSeconds() + StaminaRegenDelay;
+    ScheduleResourceEvent();
+
+    MarkStatDirty(StatChannel_Stamina);
     return true;
 }
 
@@ -183,52 +699,10 @@ bool UBMStatsComponent::TryConsumeMP(float Amount)
     if (Amount <= 0.f) return true;
     if (Stats.MP < Amount) return false;
     Stats.MP -= Amount;
+    MarkStatDirty(StatChannel_Mana);
     return true;
 }
 
-/*
- * @brief Tick component, it ticks the component
- * @param DeltaTime The delta time
- * @param TickType The tick type
- * @param ThisTickFunction The tick function
- */
-void UBMStatsComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    if (DeltaTime <= 0.f || IsDead())
-    {
-        return;
-    }
-
-    // ��������Ч����ʱ��
-    TickBuffs(DeltaTime);
-
-    // ����������ѪЧ��
-    TickHealthRegen(DeltaTime);
-
-    // �����ָ�
-    if (Stats.MaxStamina > 0.f && Stats.Stamina < Stats.MaxStamina)
-    {
-        const float OldStamina = Stats.Stamina;
-        const float RegenMultiplier = GetStaminaRegenMultiplier();
-        const float Regen = StaminaRegenPerSec * RegenMultiplier * DeltaTime;
-        Stats.Stamina = FMath::Clamp(Stats.Stamina + Regen, 0.f, Stats.MaxStamina);
-
-        if (!FMath::IsNearlyEqual(Stats.Stamina, OldStamina))
-        {
-            if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-            {
-                if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                {
-                    const float Normalized = Stats.MaxStamina > 0.f ? Stats.Stamina / Stats.MaxStamina : 0.f;
-                    Bus->EmitPlayerStamina(Normalized);
-                }
-            }
-        }
-    }
-}
-
 /*
  * @brief Revive to full, it revives the stats to full
  * @param NewMaxHP The new max HP
@@ -238,6 +712,9 @@ void UBMStatsComponent::ReviveToFull(float NewMaxHP)
     Stats.MaxHP = FMath::Max(1.f, NewMaxHP);
     Stats.HP = Stats.MaxHP;
     bDeathBroadcasted = false;
+    ResourceAnchorTime = GetWorldTimeSeconds();
+    ScheduleResourceEvent();
+    MarkStatDirty(StatChannel_Health);
 }
 
 /*
@@ -246,7 +723,7 @@ void UBMStatsComponent::ReviveToFull(float NewMaxHP)
  */
 void UBMStatsComponent::AddGameplayTag(FName Tag)
 {
-    if (!Tag.IsNone()) Tags.Add(Tag);
+    TagBits.Add(FBMTagBits::FromIndex(FBMTagRegistry::Get().FindOrAddTag(Tag)));
 }
 
 /*
@@ -255,7 +732,7 @@ void UBMStatsComponent::AddGameplayTag(FName Tag)
  */
 void UBMStatsComponent::RemoveGameplayTag(FName Tag)
 {
-    if (!Tag.IsNone()) Tags.Remove(Tag);
+    TagBits.Remove(FBMTagRegistry::Get().GetTagBits(Tag));
 }
 
 /*
@@ -265,7 +742,7 @@ void UBMStatsComponent::RemoveGameplayTag(FName Tag)
  */
 bool UBMStatsComponent::HasGameplayTag(FName Tag) const
 {
-    return !Tag.IsNone() && Tags.Contains(Tag);
+    return TagBits.HasAny(FBMTagRegistry::Get().GetTagBits(Tag));
 }
 
 /*
@@ -278,6 +755,8 @@ void UBMStatsComponent::InitializeFromBlock(const FBMStatBlock& In)
     Stats.HP = FMath::Clamp(Stats.HP, 0.f, Stats.MaxHP);
     Stats.MP = FMath::Clamp(Stats.MP, 0.f, Stats.MaxMP);
     Stats.Stamina = FMath::Clamp(Stats.Stamina, 0.f, Stats.MaxStamina);
+    ResourceAnchorTime = GetWorldTimeSeconds();
+    ScheduleResourceEvent();
 }
 
 /*
@@ -287,21 +766,11 @@ void UBMStatsComponent::Revive()
 {
     bDeathBroadcasted = false;
     Stats.HP = Stats.MaxHP;
+    ResourceAnchorTime = GetWorldTimeSeconds();
+    ScheduleResourceEvent();
     // Notify HUD 
-    if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
-    {
-        if (OwnerPawn->IsPlayerControlled())
-        {
-            if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-            {
-                if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                {
-                    const float Normalized = Stats.MaxHP > 0.f ? Stats.HP / Stats.MaxHP : 0.f;
-                    Bus->EmitPlayerHealth(Normalized);
-                }
-            }
-        }
-    }
+    MarkStatDirty(StatChannel_Health);
+    FlushStatChanges();
 }
 
 // ==================== ����Ч��ʵ�� ====================
@@ -332,6 +801,8 @@ void UBMStatsComponent::HealByAmount(float Amount)
         return;
     }
 
+    SettleResources();
+
     const float OldHP = Stats.HP;
     const float EffectiveMaxHp = GetEffectiveMaxHp();
     Stats.HP = FMath::Clamp(Stats.HP + Amount, 0.f, EffectiveMaxHp);
@@ -343,20 +814,7 @@ void UBMStatsComponent::HealByAmount(float Amount)
             Healed, OldHP, Stats.HP, EffectiveMaxHp);
 
         // ֪ͨUI����Ѫ��
-        if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
-        {
-            if (OwnerPawn->IsPlayerControlled())
-            {
-                if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-                {
-                    if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                    {
-                        const float Normalized = EffectiveMaxHp > 0.f ? Stats.HP / EffectiveMaxHp : 0.f;
-                        Bus->EmitPlayerHealth(Normalized);
-                    }
-                }
-            }
-        }
+        MarkStatDirty(StatChannel_Health);
     }
 }
 
@@ -377,7 +835,15 @@ void UBMStatsComponent::AddBuff(EBMBuffType Type, float Value, float Duration)
     RemoveBuff(Type);
 
     FBMBuffInstance NewBuff(Type, Value, Duration);
+    NewBuff.EndTime = (GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f) + Duration;
     ActiveBuffs.Add(NewBuff);
+    RebuildBuffAggregate();
+
+    // MaxHpBoost 会改变血条的归一化基准
+    if (Type == EBMBuffType::MaxHpBoost)
+    {
+        MarkStatDirty(StatChannel_Health);
+    }
 
     UE_LOG(LogBMStats, Log, TEXT("Added buff: Type=%d, Value=%.1f, Duration=%.1fs"), 
         static_cast<int32>(Type), Value, Duration);
@@ -389,10 +855,19 @@ void UBMStatsComponent::AddBuff(EBMBuffType Type, float Value, float Duration)
  */
 void UBMStatsComponent::RemoveBuff(EBMBuffType Type)
 {
-    ActiveBuffs.RemoveAll([Type](const FBMBuffInstance& Buff)
+    const int32 Removed = ActiveBuffs.RemoveAll([Type](const FBMBuffInstance& Buff)
     {
         return Buff.Type == Type;
     });
+
+    if (Removed > 0)
+    {
+        RebuildBuffAggregate();
+        if (Type == EBMBuffType::MaxHpBoost)
+        {
+            MarkStatDirty(StatChannel_Health);
+        }
+    }
 }
 
 /*
@@ -402,10 +877,7 @@ void UBMStatsComponent::RemoveBuff(EBMBuffType Type)
  */
 bool UBMStatsComponent::HasBuff(EBMBuffType Type) const
 {
-    return ActiveBuffs.ContainsByPredicate([Type](const FBMBuffInstance& Buff)
-    {
-        return Buff.Type == Type && !Buff.IsExpired();
-    });
+    return BuffAggregate.Has(Type);
 }
 
 /*
@@ -414,7 +886,7 @@ bool UBMStatsComponent::HasBuff(EBMBuffType Type) const
  */
 bool UBMStatsComponent::IsInvulnerable() const
 {
-    return HasBuff(EBMBuffType::Invulnerability);
+    return BuffAggregate.Has(EBMBuffType::Invulnerability);
 }
 
 /*
@@ -423,16 +895,7 @@ bool UBMStatsComponent::IsInvulnerable() const
  */
 float UBMStatsComponent::GetAttackMultiplier() const
 {
-    float Multiplier = 1.0f;
-    for (const FBMBuffInstance& Buff : ActiveBuffs)
-    {
-        if (Buff.Type == EBMBuffType::AttackBoost && !Buff.IsExpired())
-        {
-            // �ٷֱȼӳ�
-            Multiplier += Buff.Value / 100.f;
-        }
-    }
-    return Multiplier;
+    return BuffAggregate.AttackMultiplier;
 }
 
 /*
@@ -441,16 +904,7 @@ float UBMStatsComponent::GetAttackMultiplier() const
  */
 float UBMStatsComponent::GetStaminaRegenMultiplier() const
 {
-    float Multiplier = 1.0f;
-    for (const FBMBuffInstance& Buff : ActiveBuffs)
-    {
-        if (Buff.Type == EBMBuffType::StaminaRegenBoost && !Buff.IsExpired())
-        {
-            // ���ʼӳ�
-            Multiplier *= Buff.Value;
-        }
-    }
-    return Multiplier;
+    return BuffAggregate.StaminaRegenMultiplier;
 }
 
 /*
@@ -459,160 +913,108 @@ float UBMStatsComponent::GetStaminaRegenMultiplier() const
  */
 float UBMStatsComponent::GetEffectiveMaxHp() const
 {
-    float EffectiveMaxHp = Stats.MaxHP;
-    
-    // ���� MaxHpBoost ����Ч��
-    for (const FBMBuffInstance& Buff : ActiveBuffs)
-    {
-        if (Buff.Type == EBMBuffType::MaxHpBoost && !Buff.IsExpired())
-        {
-            // Value �洢������ʱ��������������ֵ
-            EffectiveMaxHp = FMath::Max(EffectiveMaxHp, Buff.Value);
-        }
-    }
-    
-    return EffectiveMaxHp;
+    return FMath::Max(Stats.MaxHP, BuffAggregate.MaxHpFloor);
 }
 
 /*
- * @brief Tick buffs, it ticks the buffs
- * @param DeltaTime The delta time
+ * @brief Get active buffs, it returns the active buffs with the remaining time derived from the end time
+ * @return The active buffs
  */
-void UBMStatsComponent::TickBuffs(float DeltaTime)
+TArray<FBMBuffInstance> UBMStatsComponent::GetActiveBuffs() const
 {
-    bool bHadExpiredBuffs = false;
-    bool bMaxHpBuffExpired = false;
+    const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f;
 
-    for (FBMBuffInstance& Buff : ActiveBuffs)
+    TArray<FBMBuffInstance> Result = ActiveBuffs;
+    for (FBMBuffInstance& Buff : Result)
     {
-        if (!Buff.IsExpired())
-        {
-            Buff.RemainingTime -= DeltaTime;
-            if (Buff.IsExpired())
-            {
-                bHadExpiredBuffs = true;
-                
-                // ��¼�Ƿ��� MaxHpBoost ����
-                if (Buff.Type == EBMBuffType::MaxHpBoost)
-                {
-                    bMaxHpBuffExpired = true;
-                }
-                
-                UE_LOG(LogBMStats, Log, TEXT("Buff expired: Type=%d"), static_cast<int32>(Buff.Type));
-            }
-        }
+        Buff.RemainingTime = FMath::Max(0.f, Buff.EndTime - Now);
     }
+    return Result;
+}
 
-    // ��� MaxHpBoost ���ڣ���Ҫ������ǰHP�Ա���Ѫ���ٷֱ�
-    if (bMaxHpBuffExpired)
+/*
+ * @brief Rebuild buff aggregate, it folds the active buffs into the cached modifiers and finds the next expiry
+ */
+void UBMStatsComponent::RebuildBuffAggregate()
+{
+    // 速率即将变化：按旧速率结算到当前时刻
+    SettleResources();
+
+    BuffAggregate = FBMBuffAggregate();
+    NextBuffExpiryTime = MAX_flt;
+
+    for (const FBMBuffInstance& Buff : ActiveBuffs)
     {
-        const float OldEffectiveMaxHp = GetEffectiveMaxHp();
-        
-        // �Ƴ��ѹ��ڵ�����Ч��
-        TArray<FBMBuffInstance> TempExpiredBuffs;
-        for (const FBMBuffInstance& Buff : ActiveBuffs)
-        {
-            if (Buff.IsExpired() && Buff.Type == EBMBuffType::MaxHpBoost)
-            {
-                TempExpiredBuffs.Add(Buff);
-            }
-        }
-        
-        // ���Ƴ����ڵ� MaxHpBoost
-        for (const FBMBuffInstance& ExpiredBuff : TempExpiredBuffs)
-        {
-            ActiveBuffs.RemoveAll([&ExpiredBuff](const FBMBuffInstance& Buff)
-            {
-                return Buff.Type == ExpiredBuff.Type && 
-                       FMath::IsNearlyEqual(Buff.Value, ExpiredBuff.Value) && 
-                       Buff.IsExpired();
-            });
-        }
-        
-        // ��ȡ�µ���Ч�������ֵ
-        const float NewEffectiveMaxHp = GetEffectiveMaxHp();
-        
-        // ���㵱ǰHP�ٷֱ�
-        const float HpPercentage = (OldEffectiveMaxHp > 0.f) ? (Stats.HP / OldEffectiveMaxHp) : 1.0f;
-        
-        // �����µ��������ֵ������ǰHP�����ְٷֱȲ���
-        Stats.HP = FMath::Clamp(NewEffectiveMaxHp * HpPercentage, 0.f, NewEffectiveMaxHp);
-        
-        UE_LOG(LogBMStats, Log, TEXT("MaxHpBoost expired: MaxHP %.1f -> %.1f, HP adjusted to %.1f (%.1f%%)"), 
-            OldEffectiveMaxHp, NewEffectiveMaxHp, Stats.HP, HpPercentage * 100.f);
-        
-        // ֪ͨUI����Ѫ��
-        if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+        BuffAggregate.TypeMask |= (1u << static_cast<uint8>(Buff.Type));
+        NextBuffExpiryTime = FMath::Min(NextBuffExpiryTime, Buff.EndTime);
+
+        switch (Buff.Type)
         {
-            if (OwnerPawn->IsPlayerControlled())
+        case EBMBuffType::AttackBoost:
+            // 百分比加成
+            BuffAggregate.AttackMultiplier += Buff.Value / 100.f;
+            break;
+        case EBMBuffType::StaminaRegenBoost:
+            // 倍率加成
+            BuffAggregate.StaminaRegenMultiplier *= Buff.Value;
+            break;
+        case EBMBuffType::MaxHpBoost:
+            // Value 存储的是临时提升后的最大生命值
+            BuffAggregate.MaxHpFloor = FMath::Max(BuffAggregate.MaxHpFloor, Buff.Value);
+            break;
+        case EBMBuffType::HealthRegenOverTime:
+            // Value 是在 TotalDuration 内恢复的最大生命值百分比
+            if (Buff.TotalDuration > 0.f)
             {
-                if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-                {
-                    if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                    {
-                        const float Normalized = NewEffectiveMaxHp > 0.f ? Stats.HP / NewEffectiveMaxHp : 0.f;
-                        Bus->EmitPlayerHealth(Normalized);
-                    }
-                }
+                BuffAggregate.HealthRegenPercentPerSec += Buff.Value / Buff.TotalDuration;
             }
+            break;
+        default:
+            break;
         }
     }
 
-    // �Ƴ������ѹ��ڵ�����Ч��
-    if (bHadExpiredBuffs)
-    {
-        ActiveBuffs.RemoveAll([](const FBMBuffInstance& Buff)
-        {
-            return Buff.IsExpired();
-        });
-    }
+    ScheduleResourceEvent();
 }
 
 /*
- * @brief Tick health regen, it ticks the health regen
- * @param DeltaTime The delta time
+ * @brief Tick buffs, it removes the expired buffs once the earliest end time is reached
  */
-void UBMStatsComponent::TickHealthRegen(float DeltaTime)
+void UBMStatsComponent::TickBuffs()
 {
-    // ���ҳ�����ѪЧ��
-    for (const FBMBuffInstance& Buff : ActiveBuffs)
+    const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f;
+    if (Now < NextBuffExpiryTime)
     {
-        if (Buff.Type == EBMBuffType::HealthRegenOverTime && !Buff.IsExpired())
-        {
-            // Value ���� TotalDuration �ڻָ�����HP�ٷֱ�
-            // ÿ��ָ��� = (Value / TotalDuration) * EffectiveMaxHP / 100
-            if (Buff.TotalDuration > 0.f)
-            {
-                const float EffectiveMaxHp = GetEffectiveMaxHp();
-                const float RegenPerSecond = (Buff.Value / Buff.TotalDuration) * EffectiveMaxHp / 100.f;
-                const float RegenThisTick = RegenPerSecond * DeltaTime;
-                
-                if (RegenThisTick > 0.f && Stats.HP < EffectiveMaxHp)
-                {
-                    const float OldHP = Stats.HP;
-                    Stats.HP = FMath::Clamp(Stats.HP + RegenThisTick, 0.f, EffectiveMaxHp);
+        return;
+    }
 
-                    // ֪ͨUI����Ѫ��
-                    if (!FMath::IsNearlyEqual(Stats.HP, OldHP))
-                    {
-                        if (const APawn* OwnerPawn = Cast<APawn>(GetOwner()))
-                        {
-                            if (OwnerPawn->IsPlayerControlled())
-                            {
-                                if (UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
-                                {
-                                    if (auto* Bus = GI->GetSubsystem<UBMEventBusSubsystem>())
-                                    {
-                                        const float Normalized = EffectiveMaxHp > 0.f ? Stats.HP / EffectiveMaxHp : 0.f;
-                                        Bus->EmitPlayerHealth(Normalized);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+    const float OldEffectiveMaxHp = GetEffectiveMaxHp();
+    bool bMaxHpBuffExpired = false;
+
+    ActiveBuffs.RemoveAll([Now, &bMaxHpBuffExpired](const FBMBuffInstance& Buff)
+    {
+        if (!Buff.IsExpired(Now))
+        {
+            return false;
         }
+        bMaxHpBuffExpired |= (Buff.Type == EBMBuffType::MaxHpBoost);
+        UE_LOG(LogBMStats, Log, TEXT("Buff expired: Type=%d"), static_cast<int32>(Buff.Type));
+        return true;
+    });
+
+    RebuildBuffAggregate();
+
+    // MaxHpBoost 过期时按原血量百分比调整当前 HP
+    if (bMaxHpBuffExpired)
+    {
+        const float NewEffectiveMaxHp = GetEffectiveMaxHp();
+        const float HpPercentage = (OldEffectiveMaxHp > 0.f) ? (Stats.HP / OldEffectiveMaxHp) : 1.0f;
+        Stats.HP = FMath::Clamp(NewEffectiveMaxHp * HpPercentage, 0.f, NewEffectiveMaxHp);
+
+        UE_LOG(LogBMStats, Log, TEXT("MaxHpBoost expired: MaxHP %.1f -> %.1f, HP adjusted to %.1f (%.1f%%)"), 
+            OldEffectiveMaxHp, NewEffectiveMaxHp, Stats.HP, HpPercentage * 100.f);
+
+        MarkStatDirty(StatChannel_Health);
+        ScheduleResourceEvent();
     }
 }
-
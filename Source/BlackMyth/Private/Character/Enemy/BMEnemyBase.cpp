@@ -58,6 +58,7 @@ void ABMEnemyBase::BeginPlay()
     Super::BeginPlay();
 
     HomeLocation = GetActorLocation();
+    CompileAttackSpecHitBoxMasks();
 
     CachePlayerPawn();
     StartPerceptionTimer();
@@ -75,44 +76,78 @@ void ABMEnemyBase::BeginPlay()
     }
 }
 
+/*
+ * @brief End play, it drops the pending data ready callback and the data hot reload subscription
+ * @param EndPlayReason The end play reason
+ */
+void ABMEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UGameInstance* GI = GetGameInstance();
+    UBMDataSubsystem* DataSys = GI ? GI->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    if (DataReadyHandle.IsValid())
+    {
+        if (DataSys)
+        {
+            DataSys->OnDataReady.Remove(DataReadyHandle);
+        }
+        DataReadyHandle.Reset();
+    }
+    if (EnemyDataHandle.IsValid())
+    {
+        if (DataSys)
+        {
+            DataSys->UnsubscribeRow(EBMDataTable::Enemy, SubscribedEnemyID, EnemyDataHandle);
+        }
+        EnemyDataHandle.Reset();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ABMEnemyBase::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
 }
 
 /*
- * @brief Init enemy states, it initializes the enemy states
+ * @brief Init enemy states, it binds the shared state machine definition and enters the idle state
  */
 void ABMEnemyBase::InitEnemyStates()
 {
     UBMStateMachineComponent* Machine = GetFSM();
     if (!Machine) return;
 
-    auto* SIdle = NewObject<UBMEnemyState_Idle>(Machine);
-    auto* SPatrol = NewObject<UBMEnemyState_Patrol>(Machine);
-    auto* SChase = NewObject<UBMEnemyState_Chase>(Machine);
-    auto* SAtk = NewObject<UBMEnemyState_Attack>(Machine);
-    auto* SHit = NewObject<UBMEnemyState_Hit>(Machine);
-    auto* SDeath = NewObject<UBMEnemyState_Death>(Machine);
-    auto* SDodge = NewObject<UBMEnemyState_Dodge>(Machine);
-    
-    SIdle->Init(this);
-    SPatrol->Init(this);
-    SChase->Init(this);
-    SAtk->Init(this);
-    SHit->Init(this);
-    SDeath->Init(this);
-    SDodge->Init(this);
-
-    Machine->RegisterState(BMEnemyStateNames::Idle, SIdle);
-    Machine->RegisterState(BMEnemyStateNames::Patrol, SPatrol);
-    Machine->RegisterState(BMEnemyStateNames::Chase, SChase);
-    Machine->RegisterState(BMEnemyStateNames::Attack, SAtk);
-    Machine->RegisterState(BMEnemyStateNames::Hit, SHit);
-    Machine->RegisterState(BMEnemyStateNames::Death, SDeath);
-    Machine->RegisterState(BMEnemyStateNames::Dodge, SDodge);
-
-    Machine->ChangeStateByName(BMEnemyStateNames::Idle);
+    Machine->InitStateMachine(GetStateMachineDefinition(), EBMStateId::Idle);
+}
+
+/*
+ * @brief Get state machine definition, it returns the definition shared by all common enemies
+ * @return The state machine definition
+ */
+const FBMStateMachineDefinition* ABMEnemyBase::GetStateMachineDefinition() const
+{
+    static const FBMStateMachineDefinition Definition = []()
+    {
+        FBMStateMachineDefinition Def;
+        AddCommonEnemyStates(Def);
+        return Def;
+    }();
+    return &Definition;
+}
+
+/*
+ * @brief Add common enemy states, it adds the states shared by every enemy type
+ * @param Def The definition to fill
+ */
+void ABMEnemyBase::AddCommonEnemyStates(FBMStateMachineDefinition& Def)
+{
+    Def.AddState(EBMStateId::Idle, BMEnemyStateNames::Idle, GetDefault<UBMEnemyState_Idle>());
+    Def.AddState(EBMStateId::Patrol, BMEnemyStateNames::Patrol, GetDefault<UBMEnemyState_Patrol>());
+    Def.AddState(EBMStateId::Chase, BMEnemyStateNames::Chase, GetDefault<UBMEnemyState_Chase>());
+    Def.AddState(EBMStateId::Attack, BMEnemyStateNames::Attack, GetDefault<UBMEnemyState_Attack>());
+    Def.AddState(EBMStateId::Hit, BMEnemyStateNames::Hit, GetDefault<UBMEnemyState_Hit>());
+    Def.AddState(EBMStateId::Death, BMEnemyStateNames::Death, GetDefault<UBMEnemyState_Death>());
+    Def.AddState(EBMStateId::Dodge, BMEnemyStateNames::Dodge, GetDefault<UBMEnemyState_Dodge>());
 }
 
 /*
@@ -226,9 +261,12 @@ void ABMEnemyBase::DropLoot()
     UBMInventoryComponent* PlayerInventory = PlayerPawn->FindComponentByClass<UBMInventoryComponent>();
     UBMExperienceComponent* PlayerExperience = PlayerPawn->FindComponentByClass<UBMExperienceComponent>();
 
-    int32 TotalCurrency = 0;
-    float TotalExp = 0.0f;
-    TArray<FString> DroppedItems;
+    // 掉落通知以结构化数据发出，文本由通知界面在显示时格式化
+    UBMEventBusSubsystem* EventBus = nullptr;
+    if (UGameInstance* GI = GetGameInstance())
+    {
+        EventBus = GI->GetSubsystem<UBMEventBusSubsystem>();
+    }
 
     // 掉落金币
     if (PlayerInventory && CurrencyDropMax > 0)
@@ -236,9 +274,9 @@ void ABMEnemyBase::DropLoot()
         const int32 Currency = FMath::RandRange(FMath::Max(0, CurrencyDropMin), FMath::Max(0, CurrencyDropMax));
         if (Currency > 0)
         {
-            if (PlayerInventory->AddCurrency(Currency))
+            if (PlayerInventory->AddCurrency(Currency) && EventBus)
             {
-                TotalCurrency = Currency;
+                EventBus->EmitNotify(FBMNotifyPayload::Make(EBMNotifyMessage::LootCurrency, EBMNotifyPriority::Low).AddInt(Currency));
             }
         }
     }
@@ -250,7 +288,10 @@ void ABMEnemyBase::DropLoot()
         if (Exp > 0.0f)
         {
             PlayerExperience->AddXP(Exp);
-            TotalExp = Exp;
+            if (EventBus)
+            {
+                EventBus->EmitNotify(FBMNotifyPayload::Make(EBMNotifyMessage::LootXP, EBMNotifyPriority::Low).AddFloat(Exp));
+            }
         }
     }
 
@@ -278,62 +319,9 @@ void ABMEnemyBase::DropLoot()
             }
 
             // 尝试添加物品
-            if (PlayerInventory->AddItem(LootItem.ItemID, Quantity))
-            {
-                // 移除前缀
-                FString ItemName = LootItem.ItemID.ToString();
-                ItemName.RemoveFromStart(TEXT("Item_"));
-                DroppedItems.Add(FString::Printf(TEXT("%s x%d"), *ItemName, Quantity));
-            }
-        }
-    }
-
-    // 构建通知消息
-    FString NotificationMessage;
-    bool bHasLoot = false;
-
-    if (TotalCurrency > 0)
-    {
-        NotificationMessage += FString::Printf(TEXT("Currency: +%d"), TotalCurrency);
-        bHasLoot = true;
-    }
-
-    if (TotalExp > 0.0f)
-    {
-        if (bHasLoot)
-        {
-            NotificationMessage += TEXT(" | ");
-        }
-        NotificationMessage += FString::Printf(TEXT("XP: +%.0f"), TotalExp);
-        bHasLoot = true;
-    }
-
-    if (DroppedItems.Num() > 0)
-    {
-        if (bHasLoot)
-        {
-            NotificationMessage += TEXT(" | ");
-        }
-        NotificationMessage += TEXT("Items: ");
-        for (int32 i = 0; i < DroppedItems.Num(); ++i)
-        {
-            NotificationMessage += DroppedItems[i];
-            if (i < DroppedItems.Num() - 1)
+            if (PlayerInventory->AddItem(LootItem.ItemID, Quantity) && EventBus)
             {
-                NotificationMessage += TEXT(", ");
-            }
-        }
-        bHasLoot = true;
-    }
-
-    // 通过事件总线发送通知
-    if (bHasLoot)
-    {
-        if (UGameInstance* GI = GetGameInstance())
-        {
-            if (UBMEventBusSubsystem* EventBus = GI->GetSubsystem<UBMEventBusSubsystem>())
-            {
-                EventBus->EmitNotify(FText::FromString(NotificationMessage));
+                EventBus->EmitNotify(FBMNotifyPayload::Make(EBMNotifyMessage::LootItem, EBMNotifyPriority::Low).AddName(LootItem.ItemID).AddInt(Quantity));
             }
         }
     }
@@ -698,7 +686,7 @@ bool ABMEnemyBase::CanBeDamagedBy(const FBMDamageInfo& Info) const
 
     if (const ABMCharacterBase* Inst = Cast<ABMCharacterBase>(Info.InstigatorActor.Get()))
     {
-        if (Inst->Team == Team) return false;
+        if (!BMGameplayBits::IsHostile(Inst->Team, Team)) return false;
     }
     return true;
 }
@@ -724,43 +712,30 @@ void ABMEnemyBase::ClearActiveAttackSpec()
 /*
  * @brief Should interrupt current attack, it checks if the enemy should interrupt the current attack
  * @param Incoming The incoming
+ * @param OutReason The reason of the decision, recorded in the state machine trace
  * @return True if the enemy should interrupt the current attack, false otherwise
  */
-bool ABMEnemyBase::ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming) const
+bool ABMEnemyBase::ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming, EBMStateChangeReason& OutReason) const
 {
     if (!bHasActiveAttackSpec)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[%s] InterruptCheck: No ActiveAttackSpec while attacking. Default=Interruptible."),
-            *GetName());
+        OutReason = EBMStateChangeReason::InterruptNoContext;
         return true; // 没有招式信息默认可打断
     }
 
     const FBMEnemyAttackSpec& Spec = ActiveAttackSpec;
     if (Spec.bUninterruptible)
     {
-        UE_LOG(LogTemp, Log, TEXT("[%s] InterruptCheck: Spec is Uninterruptible. Attack will NOT be interrupted."),
-            *GetName());
+        OutReason = EBMStateChangeReason::Uninterruptible;
         return false; // 霸体不可打断
     }
 
     const float P = BMCombatUtils::IsHeavyIncoming(Incoming) ? Spec.InterruptChanceOnHeavyHit : Spec.InterruptChance;
     const float ClampedP = FMath::Clamp(P, 0.f, 1.f);
-    const float R = FMath::FRand();
-    const bool bWillInterrupt = (R < ClampedP);
-
-    // 说明当前是什么招式、打断概率多少，这次是否打断成功
-    UE_LOG(
-        LogTemp,
-        Log,
-        TEXT("[%s] InterruptCheck: Attack=%s, Incoming=%s, Chance=%.2f, Rand=%.2f, Result=%s"),
-        *GetName(),
-        Spec.Anim ? *Spec.Anim->GetName() : TEXT("None"),
-        BMCombatUtils::IsHeavyIncoming(Incoming) ? TEXT("Heavy") : TEXT("Normal"),
-        ClampedP,
-        R,
-        bWillInterrupt ? TEXT("INTERRUPTED") : TEXT("NOT_INTERRUPTED")
-    );
+    const bool bWillInterrupt = (FMath::FRand() < ClampedP);
 
+    // 判定结果写入状态机切换记录（bm.FSM.DumpTrace），不再逐次输出日志
+    OutReason = bWillInterrupt ? EBMStateChangeReason::Interrupted : EBMStateChangeReason::InterruptResisted;
     return bWillInterrupt;
 }
 
@@ -776,24 +751,29 @@ void ABMEnemyBase::RequestHitState(const FBMDamageInfo& FinalInfo)
     if (!Machine) return;
 
     // 死亡状态优先
-    if (Machine->GetCurrentStateName() == BMEnemyStateNames::Death)
+    if (Machine->GetCurrentStateId() == EBMStateId::Death)
     {
         return;
     }
 
-    const FName Cur = Machine->GetCurrentStateName();
+    const EBMStateId Cur = Machine->GetCurrentStateId();
 
     // 非攻击必进受击
-    if (Cur != BMEnemyStateNames::Attack)
+    if (Cur != EBMStateId::Attack)
     {
-        Machine->ChangeStateByName(BMEnemyStateNames::Hit);
+        Machine->ChangeStateById(EBMStateId::Hit);
         return;
     }
 
     // 攻击中看当前招式是否可打断
-    if (ShouldInterruptCurrentAttack(FinalInfo))
+    EBMStateChangeReason Reason = EBMStateChangeReason::Request;
+    if (ShouldInterruptCurrentAttack(FinalInfo, Reason))
     {
-        Machine->ChangeStateByName(BMEnemyStateNames::Hit);
+        Machine->ChangeStateById(EBMStateId::Hit, Reason);
+    }
+    else
+    {
+        Machine->RecordRejectedChange(EBMStateId::Hit, Reason);
     }
 }
 
@@ -808,7 +788,7 @@ void ABMEnemyBase::RequestDeathState(const FBMDamageInfo& LastHitInfo)
     UBMStateMachineComponent* Machine = GetFSM();
     if (!Machine) return;
 
-    Machine->ChangeStateByName(BMEnemyStateNames::Death);
+    Machine->ChangeStateById(EBMStateId::Death);
 }
 
 /*
@@ -858,17 +838,17 @@ void ABMEnemyBase::HandleDeath(const FBMDamageInfo& LastHitInfo)
 /*
  * @brief Resolve hit box window, it resolves the hit box window
  * @param WindowId The window id
- * @param OutHitBoxNames The out hit box names
+ * @param OutHitBoxMask The out hit box mask
  * @param OutParams The out params
  * @return True if the hit box window is resolved, false otherwise
  */
 bool ABMEnemyBase::ResolveHitBoxWindow(
     FName WindowId,
-    TArray<FName>& OutHitBoxNames,
+    uint64& OutHitBoxMask,
     FBMHitBoxActivationParams& OutParams
 ) const
 {
-    OutHitBoxNames.Reset();
+    OutHitBoxMask = 0;
     OutParams = FBMHitBoxActivationParams();
 
     if (!bHasActiveAttackSpec)
@@ -880,9 +860,9 @@ bool ABMEnemyBase::ResolveHitBoxWindow(
 
     if (WindowId.IsNone() || WindowId == DefaultWindowId)
     {
-        OutHitBoxNames = ActiveAttackSpec.HitBoxNames;
+        OutHitBoxMask = ActiveAttackSpec.HitBoxMask;
         OutParams = ActiveAttackSpec.HitBoxParams;
-        return OutHitBoxNames.Num() > 0;
+        return OutHitBoxMask != 0;
     }
 
     return false;
@@ -895,6 +875,9 @@ bool ABMEnemyBase::ResolveHitBoxWindow(
  */
 bool ABMEnemyBase::TryEvadeIncomingHit(const FBMDamageInfo& InInfo)
 {
+    // 持续伤害不可闪避
+    if (InInfo.DamageType == EBMDamageType::DOT) return false;
+
     UBMStatsComponent* S = GetStats();
     if (S && S->IsDead()) return false;
 
@@ -923,7 +906,7 @@ bool ABMEnemyBase::TryEvadeIncomingHit(const FBMDamageInfo& InInfo)
     DodgeLockedDir = ComputeBackwardDodgeDirFromHit(InInfo);
 
     // 切 Dodge 状态
-    M->ChangeStateByName(BMEnemyStateNames::Dodge);
+    M->ChangeStateById(EBMStateId::Dodge);
 
     return true; // 不结算伤害
 }
@@ -951,6 +934,17 @@ FVector ABMEnemyBase::ComputeBackwardDodgeDirFromHit(const FBMDamageInfo& InInfo
     return Dir.IsNearlyZero() ? -GetActorForwardVector() : Dir.GetSafeNormal();
 }
 
+/*
+ * @brief Compile attack spec hit box masks, it resolves the hit box names of every attack spec once
+ */
+void ABMEnemyBase::CompileAttackSpecHitBoxMasks()
+{
+    for (FBMEnemyAttackSpec& Spec : AttackSpecs)
+    {
+        Spec.HitBoxMask = CompileHitBoxMask(Spec.HitBoxNames, Spec.Anim, Spec.Id.ToString());
+    }
+}
+
 /*
  * @brief Init floating health bar, it initializes the floating health bar
  */
@@ -985,7 +979,7 @@ void ABMEnemyBase::InitFloatingHealthBar()
 }
 
 /*
- * @brief Load stats from data table, it loads the stats from the data table
+ * @brief Load stats from data table, it applies the data row now or once the data subsystem is ready
  */
 void ABMEnemyBase::LoadStatsFromDataTable()
 {
@@ -1003,48 +997,114 @@ void ABMEnemyBase::LoadStatsFromDataTable()
         return;
     }
 
+    // 数据未就绪时不阻塞：先以默认数值开始，就绪后再应用
+    if (!DataReadyHandle.IsValid())
+    {
+        DataReadyHandle = DataSys->CallOrRegisterOnDataReady(
+            FOnBMDataReady::FDelegate::CreateUObject(this, &ABMEnemyBase::HandleEnemyDataReady));
+    }
+}
+
+/*
+ * @brief Handle enemy data ready, it applies the stats and assets of the data row and subscribes to its reloads
+ */
+void ABMEnemyBase::HandleEnemyDataReady()
+{
+    DataReadyHandle.Reset();
+
+    const FName EnemyID = GetEnemyDataID();
+    UGameInstance* GI = GetGameInstance();
+    UBMDataSubsystem* DataSys = GI ? GI->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    if (!DataSys)
+    {
+        return;
+    }
+
     const FBMEnemyData* Data = DataSys->GetEnemyData(EnemyID);
     if (!Data)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[%s] LoadStatsFromDataTable: EnemyData not found for ID '%s', using default stats"), 
+        UE_LOG(LogTemp, Warning, TEXT("[%s] HandleEnemyDataReady: EnemyData not found for ID '%s', using default stats"), 
             *GetName(), *EnemyID.ToString());
         return;
     }
 
+    // 数据晚于 BeginPlay 就绪时血量仍是满的，直接回满；已在播放的循环动画在下次切换状态时换用新资产
+    ApplyEnemyData(*Data, false);
+
+    // Load assets from DataTable
+    LoadAssetsFromDataTable(Data);
+
+#if BM_DATA_HOT_RELOAD
+    // 数据行变化时只通知本敌人（按行订阅，与场上敌人总数无关）
+    if (!EnemyDataHandle.IsValid())
+    {
+        SubscribedEnemyID = EnemyID;
+        EnemyDataHandle = DataSys->SubscribeRow(EBMDataTable::Enemy, EnemyID,
+            FOnBMDataRowChanged::FDelegate::CreateUObject(this, &ABMEnemyBase::HandleEnemyDataChanged));
+    }
+#endif
+
+    UE_LOG(LogTemp, Log, TEXT("[%s] HandleEnemyDataReady: Loaded stats for '%s' - HP=%.0f, Attack=%.0f, Defense=%.0f"), 
+        *GetName(), *EnemyID.ToString(), Data->MaxHP, Data->AttackPower, Data->Defense);
+}
+
+/*
+ * @brief Apply enemy data, it applies the stats, AI, dodge and loot parameters of the data row
+ * @param Data The enemy data
+ * @param bKeepHealthRatio Whether to keep the current health ratio instead of refilling
+ */
+void ABMEnemyBase::ApplyEnemyData(const FBMEnemyData& Data, bool bKeepHealthRatio)
+{
     // 应用数据到 Stats
     if (UBMStatsComponent* MyStatsComp = GetStats())
     {
         FBMStatBlock& MyStats = MyStatsComp->GetStatBlockMutable();
-        MyStats.MaxHP = Data->MaxHP;
-        MyStats.HP = Data->MaxHP;
-        MyStats.Attack = Data->AttackPower;
-        MyStats.Defense = Data->Defense;
-        MyStats.MoveSpeed = Data->MoveSpeed;
+        const float HPRatio = bKeepHealthRatio && MyStats.MaxHP > 0.f ? MyStats.HP / MyStats.MaxHP : 1.f;
+        MyStats.MaxHP = Data.MaxHP;
+        MyStats.HP = Data.MaxHP * HPRatio;
+        MyStats.Attack = Data.AttackPower;
+        MyStats.Defense = Data.Defense;
+        MyStats.MoveSpeed = Data.MoveSpeed;
     }
 
     // AI 参数
-    AggroRange = Data->AggroRange;
-    PatrolRadius = Data->PatrolRadius;
-    PatrolSpeed = Data->PatrolSpeed;
-    ChaseSpeed = Data->ChaseSpeed;
+    AggroRange = Data.AggroRange;
+    PatrolRadius = Data.PatrolRadius;
+    PatrolSpeed = Data.PatrolSpeed;
+    ChaseSpeed = Data.ChaseSpeed;
     
     // 战斗参数
-    DodgeDistance = Data->DodgeDistance;
-    DodgeOnHitChance = Data->DodgeOnHitChance;
-    DodgeCooldown = Data->DodgeCooldown;
-    DodgePlayRate = Data->DodgePlayRate;
+    DodgeDistance = Data.DodgeDistance;
+    DodgeOnHitChance = Data.DodgeOnHitChance;
+    DodgeCooldown = Data.DodgeCooldown;
+    DodgePlayRate = Data.DodgePlayRate;
     
     // Apply loot parameters
-    CurrencyDropMin = Data->CurrencyDropMin;
-    CurrencyDropMax = Data->CurrencyDropMax;
-    ExpDropMin = Data->ExpDropMin;
-    ExpDropMax = Data->ExpDropMax;
+    CurrencyDropMin = Data.CurrencyDropMin;
+    CurrencyDropMax = Data.CurrencyDropMax;
+    ExpDropMin = Data.ExpDropMin;
+    ExpDropMax = Data.ExpDropMax;
+}
 
-    // Load assets from DataTable
-    LoadAssetsFromDataTable(Data);
+/*
+ * @brief Handle enemy data changed, it reapplies the reloaded data row keeping the health ratio
+ * @param Table The table
+ * @param RowName The row name
+ */
+void ABMEnemyBase::HandleEnemyDataChanged(EBMDataTable Table, FName RowName)
+{
+    UGameInstance* GI = GetGameInstance();
+    const UBMDataSubsystem* DataSys = GI ? GI->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    const FBMEnemyData* Data = DataSys ? DataSys->GetEnemyData(RowName) : nullptr;
+    if (!Data)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[%s] HandleEnemyDataChanged: row '%s' was removed, keeping current stats"), *GetName(), *RowName.ToString());
+        return;
+    }
 
-    UE_LOG(LogTemp, Log, TEXT("[%s] LoadStatsFromDataTable: Loaded stats for '%s' - HP=%.0f, Attack=%.0f, Defense=%.0f"), 
-        *GetName(), *EnemyID.ToString(), Data->MaxHP, Data->AttackPower, Data->Defense);
+    ApplyEnemyData(*Data, true);
+    UE_LOG(LogTemp, Log, TEXT("[%s] HandleEnemyDataChanged: reloaded '%s' - HP=%.0f, Attack=%.0f, Defense=%.0f"),
+        *GetName(), *RowName.ToString(), Data->MaxHP, Data->AttackPower, Data->Defense);
 }
 
 /*
@@ -100,14 +100,6 @@ void ABMEnemyBoss::BeginPlay()
     ApplyConfiguredAssets();
     BuildAttackSpecs();
 
-	// 注册二阶段转换状态
-    if (UBMStateMachineComponent* Machine = GetFSM())
-    {
-        auto* SPhase = NewObject<UBMEnemyBossState_PhaseChange>(Machine);
-        SPhase->Init(this);
-        Machine->RegisterState(BMEnemyStateNames::PhaseChange, SPhase);
-    }
-
     // 调试可视化
     //if (UBMHitBoxComponent* HB = GetHitBox()) HB->bDebugDraw = true;
     //for (UBMHurtBoxComponent* HB : HurtBoxes)
@@ -164,6 +156,22 @@ void ABMEnemyBoss::BeginPlay()
     }
 }
 
+/*
+ * @brief Get state machine definition, it returns the definition shared by all bosses, with the phase change state added
+ * @return The state machine definition
+ */
+const FBMStateMachineDefinition* ABMEnemyBoss::GetStateMachineDefinition() const
+{
+    static const FBMStateMachineDefinition Definition = []()
+    {
+        FBMStateMachineDefinition Def;
+        AddCommonEnemyStates(Def);
+        Def.AddState(EBMStateId::PhaseChange, BMEnemyStateNames::PhaseChange, GetDefault<UBMEnemyBossState_PhaseChange>());
+        return Def;
+    }();
+    return &Definition;
+}
+
 /*
  * @brief Apply configured assets, it applies the configured assets
  */
@@ -177,31 +185,32 @@ void ABMEnemyBoss::ApplyConfiguredAssets()
  */
 void ABMEnemyBoss::BuildHurtBoxes()
 {
-    if (!HurtBody)
+    // 虚拟 HurtBox：只注册骨骼空间描述符，不创建碰撞组件
     {
-        HurtBody = CreateDefaultSubobject<UBMHurtBoxComponent>(TEXT("HB_Body"));
-        HurtBody->AttachSocketOrBone = TEXT("spine_03");
-        HurtBody->BoxExtent = FVector(34.f, 40.f, 60.f);     
-        HurtBody->DamageMultiplier = 1.0f;
-        HurtBoxes.Add(HurtBody);
+        FBMHurtBoxDefinition Def;
+        Def.Name = TEXT("Body");
+        Def.AttachSocketOrBone = TEXT("spine_03");
+        Def.BoxExtent = FVector(34.f, 40.f, 60.f);
+        Def.DamageMultiplier = 1.0f;
+        RegisterVirtualHurtBox(Def);
     }
 
-    if (!HurtAbdomen)
     {
-        HurtAbdomen = CreateDefaultSubobject<UBMHurtBoxComponent>(TEXT("HB_Abdomen"));
-        HurtAbdomen->AttachSocketOrBone = TEXT("spine_01");
-        HurtAbdomen->BoxExtent = FVector(30.f, 36.f, 40.f);     
-        HurtAbdomen->DamageMultiplier = 0.9f;                  
-        HurtBoxes.Add(HurtAbdomen);
+        FBMHurtBoxDefinition Def;
+        Def.Name = TEXT("Abdomen");
+        Def.AttachSocketOrBone = TEXT("spine_01");
+        Def.BoxExtent = FVector(30.f, 36.f, 40.f);
+        Def.DamageMultiplier = 0.9f;
+        RegisterVirtualHurtBox(Def);
     }
 
-    if (!HurtHead)
     {
-        HurtHead = CreateDefaultSubobject<UBMHurtBoxComponent>(TEXT("HB_Head"));
-        HurtHead->AttachSocketOrBone = TEXT("head");
-        HurtHead->BoxExtent = FVector(22.f, 22.f, 22.f);     
-        HurtHead->DamageMultiplier = 1.25f;                  
-        HurtBoxes.Add(HurtHead);
+        FBMHurtBoxDefinition Def;
+        Def.Name = TEXT("Head");
+        Def.AttachSocketOrBone = TEXT("head");
+        Def.BoxExtent = FVector(22.f, 22.f, 22.f);
+        Def.DamageMultiplier = 1.25f;
+        RegisterVirtualHurtBox(Def);
     }
 }
 
@@ -409,7 +418,7 @@ void ABMEnemyBoss::HandleDeath(const FBMDamageInfo& LastHitInfo)
         // 进过渡状态
         if (UBMStateMachineComponent* Machine = GetFSM())
         {
-            Machine->ChangeStateByName(BMEnemyStateNames::PhaseChange);
+            Machine->ChangeStateById(EBMStateId::PhaseChange);
         }
         return;
     }
@@ -569,6 +578,9 @@ void ABMEnemyBoss::AddPhase2AttackSpecs()
 
         if (S.Anim) AttackSpecs.Add(S);
     }
+
+    // 二阶段新增的攻击规格需要重新预编译 HitBox 掩码
+    CompileAttackSpecHitBoxMasks();
 }
 
 /*
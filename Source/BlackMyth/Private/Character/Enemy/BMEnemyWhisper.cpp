@@ -86,31 +86,32 @@ void ABMEnemyWhisper::ApplyConfiguredAssets()
  */
 void ABMEnemyWhisper::BuildHurtBoxes()
 {
-    if (!HurtBody)
+    // 虚拟 HurtBox：只注册骨骼空间描述符，不创建碰撞组件
     {
-        HurtBody = CreateDefaultSubobject<UBMHurtBoxComponent>(TEXT("HB_Body"));
-        HurtBody->AttachSocketOrBone = TEXT("spine_03");
-        HurtBody->BoxExtent = FVector(20.f, 25.f, 40.f);
-        HurtBody->DamageMultiplier = 1.0f;
-        HurtBoxes.Add(HurtBody);
+        FBMHurtBoxDefinition Def;
+        Def.Name = TEXT("Body");
+        Def.AttachSocketOrBone = TEXT("spine_03");
+        Def.BoxExtent = FVector(20.f, 25.f, 40.f);
+        Def.DamageMultiplier = 1.0f;
+        RegisterVirtualHurtBox(Def);
     }
 
-    if (!HurtAbdomen)
     {
-        HurtAbdomen = CreateDefaultSubobject<UBMHurtBoxComponent>(TEXT("HB_Abdomen"));
-        HurtAbdomen->AttachSocketOrBone = TEXT("spine_01");
-        HurtAbdomen->BoxExtent = FVector(20.f, 40.f, 25.f);
-        HurtAbdomen->DamageMultiplier = 0.9f;
-        HurtBoxes.Add(HurtAbdomen);
+        FBMHurtBoxDefinition Def;
+        Def.Name = TEXT("Abdomen");
+        Def.AttachSocketOrBone = TEXT("spine_01");
+        Def.BoxExtent = FVector(20.f, 40.f, 25.f);
+        Def.DamageMultiplier = 0.9f;
+        RegisterVirtualHurtBox(Def);
     }
 
-    if (!HurtHead)
     {
-        HurtHead = CreateDefaultSubobject<UBMHurtBoxComponent>(TEXT("HB_Head"));
-        HurtHead->AttachSocketOrBone = TEXT("head");
-        HurtHead->BoxExtent = FVector(16.f, 16.f, 16.f);
-        HurtHead->DamageMultiplier = 1.4f;
-        HurtBoxes.Add(HurtHead);
+        FBMHurtBoxDefinition Def;
+        Def.Name = TEXT("Head");
+        Def.AttachSocketOrBone = TEXT("head");
+        Def.BoxExtent = FVector(16.f, 16.f, 16.f);
+        Def.DamageMultiplier = 1.4f;
+        RegisterVirtualHurtBox(Def);
     }
 }
 
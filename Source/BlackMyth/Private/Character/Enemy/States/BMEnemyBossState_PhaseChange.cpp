@@ -8,17 +8,14 @@
 
 /*
  * @brief On enter, it enters the phase change state
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyBossState_PhaseChange::OnEnter(float)
+void UBMEnemyBossState_PhaseChange::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(GetContext());
+    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(Ctx.Owner.Get());
     if (!Boss) return;
 
-    bFinished = false;
-
-    Boss->GetWorldTimerManager().ClearTimer(StepTimer);
-
     // ����������ֹ����״̬��ռ
     if (UBMCombatComponent* C = Boss->GetCombat())
     {
@@ -40,43 +37,35 @@ void UBMEnemyBossState_PhaseChange::OnEnter(float)
     const float DeathDur = Boss->PlayDeathOnce();
     if (DeathDur <= 0.f)
     {
-        StartHoldAfterDeath();
+        StartHoldAfterDeath(Ctx);
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-        {
-            StartHoldAfterDeath();
-        });
-
-    Boss->GetWorldTimerManager().SetTimer(StepTimer, D, DeathDur, false);
+    Ctx.SetDeadline(Event_HoldAfterDeath, DeathDur);
 }
 
-void UBMEnemyBossState_PhaseChange::StartHoldAfterDeath()
+void UBMEnemyBossState_PhaseChange::StartHoldAfterDeath(FBMStateContext& Ctx) const
 {
-    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(GetContext());
+    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(Ctx.Owner.Get());
     if (!Boss) return;
 
     const float Hold = FMath::Max(0.f, Boss->GetPhase2DeathHoldSeconds());
     if (Hold <= 0.f)
     {
-        StartDeathReverse();
+        StartDeathReverse(Ctx);
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-        {
-            StartDeathReverse();
-        });
-    Boss->GetWorldTimerManager().SetTimer(StepTimer, D, Hold, false);
+    Ctx.SetDeadline(Event_DeathReverse, Hold);
 }
 
 /*
  * @brief Start death reverse, it starts the death reverse, it plays the death reverse animation and starts the energize
+ * @param Ctx The state machine context
  */
-void UBMEnemyBossState_PhaseChange::StartDeathReverse()
+void UBMEnemyBossState_PhaseChange::StartDeathReverse(FBMStateContext& Ctx) const
 {
-    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(GetContext());
+    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(Ctx.Owner.Get());
     if (!Boss) return;
 
     const float Dur = Boss->PlayDeathReverseOnce(
@@ -86,73 +75,64 @@ void UBMEnemyBossState_PhaseChange::StartDeathReverse()
 
     if (Dur <= 0.f)
     {
-        StartEnergize();
+        StartEnergize(Ctx);
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-        {
-            StartEnergize();
-        });
-    Boss->GetWorldTimerManager().SetTimer(StepTimer, D, Dur, false);
+    Ctx.SetDeadline(Event_Energize, Dur);
 }
 
 /*
  * @brief On exit, it exits the phase change state
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyBossState_PhaseChange::OnExit(float)
+void UBMEnemyBossState_PhaseChange::OnExit(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(GetContext());
+    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(Ctx.Owner.Get());
     if (!Boss) return;
 
-    Boss->GetWorldTimerManager().ClearTimer(StepTimer);
-
     // ��������޵��� FinishPhaseChange ��ͳһ��
-    bFinished = false;
 }
 
 /*
- * @brief Can transition to, it checks if the state can transition to the given state
- * @param StateName The name of the state to transition to
- * @return True if the state can transition to the given state, false otherwise
+ * @brief Get transition rule, it returns the rule of transitioning to the given state
+ * @param Target The id of the state to transition to
+ * @return The transition rule
  */
-bool UBMEnemyBossState_PhaseChange::CanTransitionTo(FName StateName) const
+EBMStateTransitionRule UBMEnemyBossState_PhaseChange::GetTransitionRule(EBMStateId Target) const
 {
     // �����ڼ䲻�ɱ����
-    if (StateName == BMEnemyStateNames::Death) return true;
-    return bFinished;
+    if (Target == EBMStateId::Death) return EBMStateTransitionRule::Allow;
+    return EBMStateTransitionRule::WhenFinished;
 }
 
 /*
  * @brief Start energize, it starts the energize
+ * @param Ctx The state machine context
  */
-void UBMEnemyBossState_PhaseChange::StartEnergize()
+void UBMEnemyBossState_PhaseChange::StartEnergize(FBMStateContext& Ctx) const
 {
-    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(GetContext());
+    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(Ctx.Owner.Get());
     if (!Boss) return;
 
     const float EnergizeDur = Boss->PlayEnergizeOnce();
     if (EnergizeDur <= 0.f)
     {
-        FinishPhaseChange();
+        FinishPhaseChange(Ctx);
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-        {
-            FinishPhaseChange();
-        });
-
-    Boss->GetWorldTimerManager().SetTimer(StepTimer, D, EnergizeDur, false);
+    Ctx.SetDeadline(Event_Finish, EnergizeDur);
 }
 
 /*
  * @brief Finish phase change, it finishes the phase change
+ * @param Ctx The state machine context
  */
-void UBMEnemyBossState_PhaseChange::FinishPhaseChange()
+void UBMEnemyBossState_PhaseChange::FinishPhaseChange(FBMStateContext& Ctx) const
 {
-    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(GetContext());
+    ABMEnemyBoss* Boss = Cast<ABMEnemyBoss>(Ctx.Owner.Get());
     if (!Boss) return;
 
     // ������׶�
@@ -171,11 +151,37 @@ void UBMEnemyBossState_PhaseChange::FinishPhaseChange()
         C->SetActionLock(false);
     }
 
-    bFinished = true;
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
     // �ص� Idle
     if (UBMStateMachineComponent* FSM = Boss->GetFSM())
     {
-        FSM->ChangeStateByName(BMEnemyStateNames::Idle);
+        FSM->ChangeStateById(EBMStateId::Idle);
+    }
+}
+
+/*
+ * @brief On deadline, it runs the next step of the phase change when the previous one ends
+ * @param Ctx The state machine context
+ * @param EventId The id of the due event
+ */
+void UBMEnemyBossState_PhaseChange::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    switch (EventId)
+    {
+    case Event_HoldAfterDeath:
+        StartHoldAfterDeath(Ctx);
+        break;
+    case Event_DeathReverse:
+        StartDeathReverse(Ctx);
+        break;
+    case Event_Energize:
+        StartEnergize(Ctx);
+        break;
+    case Event_Finish:
+        FinishPhaseChange(Ctx);
+        break;
+    default:
+        break;
     }
 }
@@ -9,21 +9,20 @@
 
 /*
  * @brief On enter, it enters the attack state, it selects a random attack for the current target and sets the active attack spec
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Attack::OnEnter(float)
+void UBMEnemyState_Attack::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    bFinished = false;
-    E->GetWorldTimerManager().ClearTimer(AttackFinishHandle);
     E->ClearActiveAttackSpec();
 
     // ���������г���
     if (auto* Move = E->GetCharacterMovement(); Move && Move->IsFalling())
     {
-        if (E->GetFSM()) E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Chase);
+        FinishAttack(Ctx);
         return;
     }
 
@@ -31,9 +30,10 @@ void UBMEnemyState_Attack::OnEnter(float)
     E->RequestStopMovement();
 
     // ѡ���������
+    FBMEnemyAttackSpec ActiveAttack;
     if (!E->SelectRandomAttackForCurrentTarget(ActiveAttack))
     {
-        if (E->GetFSM()) E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Chase);
+        FinishAttack(Ctx);
         return;
     }
 
@@ -83,24 +83,21 @@ void UBMEnemyState_Attack::OnEnter(float)
 
     if (Duration <= 0.f)
     {
-        FinishAttack();
+        FinishAttack(Ctx);
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-        {
-            FinishAttack();
-        });
-    E->GetWorldTimerManager().SetTimer(AttackFinishHandle, D, Duration, false);
+    Ctx.SetDeadline(Event_Finish, Duration);
 }
 
 /*
  * @brief On exit, it exits the attack state, it clears the active attack spec and deactivates all hit boxes
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Attack::OnExit(float)
+void UBMEnemyState_Attack::OnExit(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     if (UBMCombatComponent* Combat = E->GetCombat())
@@ -112,18 +109,17 @@ void UBMEnemyState_Attack::OnExit(float)
     {
         HB->DeactivateAllHitBoxes();  
     }
-    E->GetWorldTimerManager().ClearTimer(AttackFinishHandle);
     E->ClearActiveAttackSpec();
-    bFinished = false;
 }
 
 /*
  * @brief On update, it updates the attack state, it faces the target
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Attack::OnUpdate(float DeltaTime)
+void UBMEnemyState_Attack::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     // �����ڼ�Ҳ���Գ���ת��
@@ -131,31 +127,45 @@ void UBMEnemyState_Attack::OnUpdate(float DeltaTime)
 }
 
 /*
- * @brief Can transition to, it checks if the state can transition to the given state
- * @param StateName The name of the state to transition to
- * @return True if the state can transition to the given state, false otherwise
+ * @brief On deadline, it finishes the attack when the attack animation ends
+ * @param Ctx The state machine context
+ * @param EventId The id of the due event
+ */
+void UBMEnemyState_Attack::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    if (EventId == Event_Finish)
+    {
+        FinishAttack(Ctx);
+    }
+}
+
+/*
+ * @brief Get transition rule, it returns the rule of transitioning to the given state
+ * @param Target The id of the state to transition to
+ * @return The transition rule
  */
-bool UBMEnemyState_Attack::CanTransitionTo(FName StateName) const
+EBMStateTransitionRule UBMEnemyState_Attack::GetTransitionRule(EBMStateId Target) const
 {
-    if (StateName == BMEnemyStateNames::Death)          return true;
-    if (StateName == BMEnemyStateNames::Hit)            return true; 
-    if (StateName == BMEnemyStateNames::PhaseChange)    return true; 
-	if (StateName == BMEnemyStateNames::Dodge)          return true;
-    return bFinished;
+    if (Target == EBMStateId::Death)          return EBMStateTransitionRule::Allow;
+    if (Target == EBMStateId::Hit)            return EBMStateTransitionRule::Allow;
+    if (Target == EBMStateId::PhaseChange)    return EBMStateTransitionRule::Allow;
+	if (Target == EBMStateId::Dodge)          return EBMStateTransitionRule::Allow;
+    return EBMStateTransitionRule::WhenFinished;
 }
 
 /*
  * @brief Finish attack, it finishes the attack, it changes the state to chase
+ * @param Ctx The state machine context
  */
-void UBMEnemyState_Attack::FinishAttack()
+void UBMEnemyState_Attack::FinishAttack(FBMStateContext& Ctx) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    bFinished = true;
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
     if (E->GetFSM())
     {
-        E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Chase);
+        E->GetFSM()->ChangeStateById(EBMStateId::Chase);
     }
 }
\ No newline at end of file
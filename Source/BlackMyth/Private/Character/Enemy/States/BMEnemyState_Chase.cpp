@@ -7,11 +7,12 @@
 
 /*
  * @brief On enter, it enters the chase state, it plays the run loop and sets the max walk speed to the chase speed
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Chase::OnEnter(float)
+void UBMEnemyState_Chase::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     E->PlayRunLoop();
@@ -22,16 +23,17 @@ void UBMEnemyState_Chase::OnEnter(float)
 /*
  * @brief On update, it updates the chase state, it checks if the enemy is alerted and has a valid target
  * if not, it changes the state to patrol or idle, if the enemy is in attack range, it changes the state to attack, if the enemy is not in attack range, it moves to the target
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Chase::OnUpdate(float DeltaTime)
+void UBMEnemyState_Chase::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     if (!E->IsAlerted() || !E->HasValidTarget())
     {
-        if (E->GetFSM()) E->GetFSM()->ChangeStateByName(E->GetPatrolRadius() > 0.f ? BMEnemyStateNames::Patrol : BMEnemyStateNames::Idle);
+        if (E->GetFSM()) E->GetFSM()->ChangeStateById(E->GetPatrolRadius() > 0.f ? EBMStateId::Patrol : EBMStateId::Idle);
         return;
     }
 
@@ -42,7 +44,7 @@ void UBMEnemyState_Chase::OnUpdate(float DeltaTime)
         E->FaceTarget(DeltaTime);
 
         if (E->CanStartAttack())
-            E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Attack);
+            E->GetFSM()->ChangeStateById(EBMStateId::Attack);
         else
             E->PlayIdleLoop();
 
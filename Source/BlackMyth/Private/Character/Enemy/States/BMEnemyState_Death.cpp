@@ -5,11 +5,12 @@
 
 /*
  * @brief On enter, it enters the death state, it stops the enemy movement, deactivates all hit boxes and sets the capsule component to no collision
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Death::OnEnter(float)
+void UBMEnemyState_Death::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     E->RequestStopMovement();
@@ -27,16 +28,29 @@ void UBMEnemyState_Death::OnEnter(float)
     const float Duration = E->PlayDeathOnce();
     const float Delay = (Duration > 0.f) ? (Duration + 0.2f) : 0.5f;
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]() { FinishDeath(); });
-    E->GetWorldTimerManager().SetTimer(DeathFinishHandle, D, Delay, false);
+    Ctx.SetDeadline(Event_Finish, Delay);
+}
+
+/*
+ * @brief On deadline, it finishes the death when the death animation ends
+ * @param Ctx The state machine context
+ * @param EventId The id of the due event
+ */
+void UBMEnemyState_Death::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    if (EventId == Event_Finish)
+    {
+        FinishDeath(Cast<ABMEnemyBase>(Ctx.Owner.Get()));
+    }
 }
 
 /*
  * @brief Finish death, it finishes the death, it sets the life span to 0.1 seconds
+ * @param E The dead enemy
  */
-void UBMEnemyState_Death::FinishDeath()
+void UBMEnemyState_Death::FinishDeath(ABMEnemyBase* E)
 {
-    if (ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext()))
+    if (E)
     {
         E->SetLifeSpan(0.1f);
     }
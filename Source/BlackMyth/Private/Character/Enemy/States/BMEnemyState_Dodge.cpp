@@ -8,17 +8,15 @@
 
 /*
  * @brief On enter, it enters the dodge state, it stops the enemy movement, deactivates all hurt boxes and sets the action lock to true
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Dodge::OnEnter(float)
+void UBMEnemyState_Dodge::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    E->GetWorldTimerManager().ClearTimer(TimerHandleFinish);
-    E->GetWorldTimerManager().ClearTimer(TimerHandleStep);
-
-    bFinished = false;
+    FBMEnemyDodgeStateData& Data = Ctx.EmplaceData<FBMEnemyDodgeStateData>();
 
     // ֹͣ AI ·���ƶ�
     E->RequestStopMovement();
@@ -45,35 +43,53 @@ void UBMEnemyState_Dodge::OnEnter(float)
         Dir = (-ToTarget);
     }
     Dir.Z = 0.f;
-    LockedDir = Dir.IsNearlyZero() ? (-E->GetActorForwardVector()) : Dir.GetSafeNormal();
+    Data.LockedDir = Dir.IsNearlyZero() ? (-E->GetActorForwardVector()) : Dir.GetSafeNormal();
 
 
     // �������ܶ���
-    WindowDuration = E->PlayDodgeOnce();  
-    if (WindowDuration <= 0.f)
+    Data.WindowDuration = E->PlayDodgeOnce();  
+    if (Data.WindowDuration <= 0.f)
     {
-        FinishDodge();
+        FinishDodge(Ctx);
         return;
     }
 
     // ������λ�ƾ���
-    TotalDistance = FMath::Max(0.f, E->DodgeDistance);
-    TraveledDistance = 0.f;
-
-    LastStepTime = E->GetWorld()->GetTimeSeconds();
+    Data.TotalDistance = FMath::Max(0.f, E->DodgeDistance);
+    Data.TraveledDistance = 0.f;
 
     // ���� Step �ƽ�
-    E->GetWorldTimerManager().SetTimer(
-        TimerHandleStep,
-        this,
-        &UBMEnemyState_Dodge::StepDodge,
-        1.0f / 60.0f,
-        true
-    );
+    Data.bStepping = true;
 
     // ��������
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]() { FinishDodge(); });
-    E->GetWorldTimerManager().SetTimer(TimerHandleFinish, D, WindowDuration, false);
+    Ctx.SetDeadline(Event_Finish, Data.WindowDuration);
+}
+
+/*
+ * @brief On update, it steps the dodge displacement while it is still in progress
+ * @param Ctx The state machine context
+ * @param DeltaTime The delta time
+ */
+void UBMEnemyState_Dodge::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
+{
+    const FBMEnemyDodgeStateData* Data = Ctx.FindData<FBMEnemyDodgeStateData>();
+    if (Data && Data->bStepping)
+    {
+        StepDodge(Ctx, DeltaTime);
+    }
+}
+
+/*
+ * @brief On deadline, it finishes the dodge when the dodge animation ends
+ * @param Ctx The state machine context
+ * @param EventId The id of the due event
+ */
+void UBMEnemyState_Dodge::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    if (EventId == Event_Finish)
+    {
+        FinishDodge(Ctx);
+    }
 }
 
 /*
@@ -106,47 +122,43 @@ bool UBMEnemyState_Dodge::HasWalkableFloorAt(const FVector& WorldPos, const ACha
 }
 
 /*
- * @brief Step dodge, it steps the dodge
+ * @brief Step dodge, it steps the dodge by the frame time
+ * @param Ctx The state machine context
+ * @param DeltaTime The delta time
  */
-void UBMEnemyState_Dodge::StepDodge()
+void UBMEnemyState_Dodge::StepDodge(FBMStateContext& Ctx, float DeltaTime) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
-    if (!E || bFinished) return;
-
-    UWorld* W = E->GetWorld();
-    if (!W) return;
-
-    const float Now = W->GetTimeSeconds();
-    float Dt = Now - LastStepTime;
-    LastStepTime = Now;
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
+    FBMEnemyDodgeStateData* Data = Ctx.FindData<FBMEnemyDodgeStateData>();
+    if (!E || !Data || Ctx.HasFlag(FBMStateContext::Flag_Finished)) return;
 
-    Dt = FMath::Clamp(Dt, 0.f, 0.05f);
+    const float Dt = FMath::Clamp(DeltaTime, 0.f, 0.05f);
 
-    if (TotalDistance <= 0.f || WindowDuration <= 0.f)
+    if (Data->TotalDistance <= 0.f || Data->WindowDuration <= 0.f)
     {
-        E->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
         return;
     }
 
-    const float Speed = TotalDistance / WindowDuration;
+    const float Speed = Data->TotalDistance / Data->WindowDuration;
     float Step = Speed * Dt;
 
-    const float Remaining = TotalDistance - TraveledDistance;
+    const float Remaining = Data->TotalDistance - Data->TraveledDistance;
     Step = FMath::Min(Step, Remaining);
     if (Step <= KINDA_SMALL_NUMBER)
     {
-        E->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
         return;
     }
 
     const FVector Cur = E->GetActorLocation();
-    const FVector Delta = LockedDir * Step;
+    const FVector Delta = Data->LockedDir * Step;
     const FVector Next = Cur + Delta;
 
     // ƽ̨��Ե����
     if (!HasWalkableFloorAt(Next, E))
     {
-        E->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
         return;
     }
 
@@ -155,26 +167,24 @@ void UBMEnemyState_Dodge::StepDodge()
     E->SetActorLocation(Next, true, &Hit, ETeleportType::None);
 
     const float Moved = FVector::Dist2D(Cur, E->GetActorLocation());
-    TraveledDistance += Moved;
+    Data->TraveledDistance += Moved;
 
-    if (TraveledDistance >= TotalDistance - 1.0f)
+    if (Data->TraveledDistance >= Data->TotalDistance - 1.0f)
     {
-        E->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
     }
 }
 
 /*
- * @brief On exit, it exits the dodge state, it clears the timers, enables all hurt boxes and sets the action lock to false
+ * @brief On exit, it exits the dodge state, it enables all hurt boxes and sets the action lock to false
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Dodge::OnExit(float)
+void UBMEnemyState_Dodge::OnExit(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    E->GetWorldTimerManager().ClearTimer(TimerHandleFinish);
-    E->GetWorldTimerManager().ClearTimer(TimerHandleStep);
-
     // �ָ� HurtBox
     E->SetAllHurtBoxesEnabled(true);
 
@@ -183,35 +193,34 @@ void UBMEnemyState_Dodge::OnExit(float)
     {
         C->SetActionLock(false);
     }
-
-    bFinished = false;
 }
 
 /*
- * @brief Can transition to, it checks if the state can transition to the given state
- * @param StateName The name of the state to transition to
- * @return True if the state can transition to the given state, false otherwise
+ * @brief Get transition rule, it returns the rule of transitioning to the given state
+ * @param Target The id of the state to transition to
+ * @return The transition rule
  */
-bool UBMEnemyState_Dodge::CanTransitionTo(FName StateName) const
+EBMStateTransitionRule UBMEnemyState_Dodge::GetTransitionRule(EBMStateId Target) const
 {
     // Dodge ���ɱ����
-    if (StateName == BMEnemyStateNames::Death) return true;
-    return bFinished;
+    if (Target == EBMStateId::Death) return EBMStateTransitionRule::Allow;
+    return EBMStateTransitionRule::WhenFinished;
 }
 
 /*
  * @brief Finish dodge, it finishes the dodge, it changes the state to chase or idle
+ * @param Ctx The state machine context
  */
-void UBMEnemyState_Dodge::FinishDodge()
+void UBMEnemyState_Dodge::FinishDodge(FBMStateContext& Ctx) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    bFinished = true;
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
     // �˳� Dodge ��ص� Idle �� Chase
     if (UBMStateMachineComponent* FSM = E->GetFSM())
     {
-        FSM->ChangeStateByName(E->IsAlerted() ? BMEnemyStateNames::Chase : BMEnemyStateNames::Idle);
+        FSM->ChangeStateById(E->IsAlerted() ? EBMStateId::Chase : EBMStateId::Idle);
     }
 }
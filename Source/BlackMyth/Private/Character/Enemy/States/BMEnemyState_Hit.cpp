@@ -4,73 +4,71 @@
 #include "Core/BMTypes.h"
 
 /*
- * @brief On enter, it enters the hit state, it stops the enemy movement, plays the hit animation and sets the hit finish handle
+ * @brief On enter, it enters the hit state, it stops the enemy movement, plays the hit animation and schedules the hit finish deadline
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Hit::OnEnter(float)
+void UBMEnemyState_Hit::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    bFinished = false;
-    E->GetWorldTimerManager().ClearTimer(HitFinishHandle);
-
     // �ܻ�ʱֹͣ·������
     E->RequestStopMovement();
 
     const float Duration = E->PlayHitOnce(E->GetLastDamageInfo());
     if (Duration <= 0.f)
     {
-        FinishHit();
+        FinishHit(Ctx);
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]() { FinishHit(); });
-    E->GetWorldTimerManager().SetTimer(HitFinishHandle, D, Duration, false);
+    Ctx.SetDeadline(Event_Finish, Duration);
 }
 
 /*
- * @brief On exit, it exits the hit state, it clears the hit finish handle
- * @param DeltaTime The delta time
+ * @brief On deadline, it finishes the hit when the hit animation ends
+ * @param Ctx The state machine context
+ * @param EventId The id of the due event
  */
-void UBMEnemyState_Hit::OnExit(float)
+void UBMEnemyState_Hit::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
 {
-    if (ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext()))
+    if (EventId == Event_Finish)
     {
-        E->GetWorldTimerManager().ClearTimer(HitFinishHandle);
+        FinishHit(Ctx);
     }
-    bFinished = false;
 }
 
 /*
- * @brief Can transition to, it checks if the state can transition to the given state
- * @param StateName The name of the state to transition to
- * @return True if the state can transition to the given state, false otherwise
+ * @brief Get transition rule, it returns the rule of transitioning to the given state
+ * @param Target The id of the state to transition to
+ * @return The transition rule
  */
-bool UBMEnemyState_Hit::CanTransitionTo(FName StateName) const
+EBMStateTransitionRule UBMEnemyState_Hit::GetTransitionRule(EBMStateId Target) const
 {
     // �ܻ����Ա�����ǿ�ƴ��
-    if (StateName == BMEnemyStateNames::Death) return true;
-    return bFinished;
+    if (Target == EBMStateId::Death) return EBMStateTransitionRule::Allow;
+    return EBMStateTransitionRule::WhenFinished;
 }
 
 /*
  * @brief Finish hit, it finishes the hit, it changes the state to chase or patrol or idle
+ * @param Ctx The state machine context
  */
-void UBMEnemyState_Hit::FinishHit()
+void UBMEnemyState_Hit::FinishHit(FBMStateContext& Ctx) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
-    bFinished = true;
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
     if (UBMStateMachineComponent* FSM = E->GetFSM())
     {
         if (E->IsAlerted() && E->HasValidTarget())
-            FSM->ChangeStateByName(BMEnemyStateNames::Chase);
+            FSM->ChangeStateById(EBMStateId::Chase);
         else if (E->GetPatrolRadius() > 0.f)
-            FSM->ChangeStateByName(BMEnemyStateNames::Patrol);
+            FSM->ChangeStateById(EBMStateId::Patrol);
         else
-            FSM->ChangeStateByName(BMEnemyStateNames::Idle);
+            FSM->ChangeStateById(EBMStateId::Idle);
     }
 }
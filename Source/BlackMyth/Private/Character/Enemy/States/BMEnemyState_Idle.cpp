@@ -6,11 +6,12 @@
 
 /*
  * @brief On enter, it enters the idle state, it stops the enemy movement, plays the idle animation and sets the max walk speed to the patrol speed
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Idle::OnEnter(float)
+void UBMEnemyState_Idle::OnEnter(FBMStateContext& Ctx, float) const
 {
-    if (ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext()))
+    if (ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get()))
     {
         E->RequestStopMovement();
         E->PlayIdleLoop();
@@ -22,22 +23,23 @@ void UBMEnemyState_Idle::OnEnter(float)
 /*
  * @brief On update, it updates the idle state, it checks if the enemy is alerted and has a valid target
  * if not, it changes the state to patrol or chase
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Idle::OnUpdate(float)
+void UBMEnemyState_Idle::OnUpdate(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     if (E->IsAlerted() && E->HasValidTarget())
     {
-        if (E->GetFSM()) E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Chase);
+        if (E->GetFSM()) E->GetFSM()->ChangeStateById(EBMStateId::Chase);
         return;
     }
 
     if (!E->IsAlerted() && E->GetPatrolRadius() > 0.f)
     {
-        if (E->GetFSM()) E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Patrol);
+        if (E->GetFSM()) E->GetFSM()->ChangeStateById(EBMStateId::Patrol);
         return;
     }
 }
@@ -8,33 +8,37 @@
 
 /*
  * @brief On enter, it enters the patrol state, it plays the walk loop and sets the max walk speed to the patrol speed
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Patrol::OnEnter(float)
+void UBMEnemyState_Patrol::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
     if (!E) return;
 
     E->PlayWalkLoop();
     if (auto* Move = E->GetCharacterMovement()) Move->MaxWalkSpeed = E->GetPatrolSpeed();
 
-    RepathAccum = 999.f; // ����ѡ��
+    FBMEnemyPatrolStateData& Data = Ctx.EmplaceData<FBMEnemyPatrolStateData>();
+    Data.RepathAccum = 999.f; // ����ѡ��
 }
 
 /*
  * @brief On update, it updates the patrol state, it checks if the enemy is alerted and has a valid target
  * if not, it changes the state to chase
+ * @param Ctx The state machine context
  * @param DeltaTime The delta time
  */
-void UBMEnemyState_Patrol::OnUpdate(float DeltaTime)
+void UBMEnemyState_Patrol::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
 {
-    ABMEnemyBase* E = Cast<ABMEnemyBase>(GetContext());
-    if (!E) return;
+    ABMEnemyBase* E = Cast<ABMEnemyBase>(Ctx.Owner.Get());
+    FBMEnemyPatrolStateData* Data = Ctx.FindData<FBMEnemyPatrolStateData>();
+    if (!E || !Data) return;
 
     // ������� -> Chase
     if (E->IsAlerted() && E->HasValidTarget())
     {
-        E->GetFSM()->ChangeStateByName(BMEnemyStateNames::Chase);
+        E->GetFSM()->ChangeStateById(EBMStateId::Chase);
         return;
     }
 
@@ -46,9 +50,9 @@ void UBMEnemyState_Patrol::OnUpdate(float DeltaTime)
         E->PlayWalkLoop();
 
     // ��ÿ��һ��ʱ������ѡ�㲢�� MoveTo
-    RepathAccum += DeltaTime;
-    if (RepathAccum < 2.0f) return;
-    RepathAccum = 0.f;
+    Data->RepathAccum += DeltaTime;
+    if (Data->RepathAccum < 2.0f) return;
+    Data->RepathAccum = 0.f;
 
     UNavigationSystemV1* Nav = UNavigationSystemV1::GetCurrent(E->GetWorld());
     if (!Nav) return;
@@ -56,7 +60,7 @@ void UBMEnemyState_Patrol::OnUpdate(float DeltaTime)
     FNavLocation Out;
     if (Nav->GetRandomPointInNavigableRadius(E->GetHomeLocation(), E->GetPatrolRadius(), Out))
     {
-        PatrolDest = Out.Location;
-        E->RequestMoveToLocation(PatrolDest, 80.f);
+        Data->PatrolDest = Out.Location;
+        E->RequestMoveToLocation(Data->PatrolDest, 80.f);
     }
 }
\ No newline at end of file
@@ -7,25 +7,36 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "BMGameInstance.h"
 #include "Core/BMTypes.h"
-#include "System/Event/BMEventBusSubsystem.h"
 
-void UBMPlayerState_Attack::OnEnter(float)
+FBMComboStepTiming FBMComboStepTiming::Make(double StartTime, float Duration, float LinkWindowSeconds, float LinkWindowEndOffset)
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    //  LinkWindowSeconds 
+    const float OpenT = FMath::Max(0.f, Duration - LinkWindowSeconds);
+    const float CloseT = FMath::Max(OpenT, Duration - LinkWindowEndOffset);
+
+    FBMComboStepTiming Timing;
+    Timing.StartTime = StartTime;
+    Timing.LinkWindowOpenTime = StartTime + OpenT;
+    Timing.LinkWindowCloseTime = StartTime + CloseT;
+    Timing.EndTime = StartTime + Duration;
+    return Timing;
+}
+
+void UBMPlayerState_Attack::OnEnter(FBMStateContext& Ctx, float) const
+{
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerStepEnd);
-    PC->GetWorldTimerManager().ClearTimer(TimerWindowOpen);
-    PC->GetWorldTimerManager().ClearTimer(TimerWindowClose);
-    PC->GetWorldTimerManager().ClearTimer(TimerPollInput);
-    PC->GetWorldTimerManager().ClearTimer(TimerRecoverEnd);
+    FBMPlayerAttackStateData& Data = Ctx.EmplaceData<FBMPlayerAttackStateData>();
 
-    bFinished = false;
-	bRecover = false;
-    bIsCombo = false;
-    ComboIndex = -1;
-    bLinkWindowOpen = false;
-    bQueuedNext = false;
+    // ڵʱжѯ
+    Data.InputBufferedHandle = PC->OnInputBuffered.AddWeakLambda(PC, [this, PC](EBMCombatAction Action, double)
+        {
+            if (FBMStateContext* ActiveCtx = GetActiveContext(PC))
+            {
+                HandleInputBuffered(*ActiveCtx, Action);
+            }
+        });
 
     if (UBMCombatComponent* Combat = PC->GetCombat())
     {
@@ -35,24 +46,24 @@ void UBMPlayerState_Attack::OnEnter(float)
     // нֹ
     if (UCharacterMovementComponent* Move = PC->GetCharacterMovement(); Move && Move->IsFalling())
     {
-        FinishAttack(true);
+        FinishAttack(Ctx, true);
         return;
     }
 
     // Բ
-    ApplyAttackInertiaSettings(PC->GetCharacterMovement());
+    ApplyAttackInertiaSettings(Data, PC->GetCharacterMovement());
 
     // Ӷȡһ
     EBMCombatAction Action = EBMCombatAction::None;
     if (!PC->ConsumeNextQueuedAction(Action))
     {
-        FinishAttack(true);
+        FinishAttack(Ctx, true);
         return;
     }
 
     if (Action == EBMCombatAction::NormalAttack)
     {
-        StartComboStep(0);
+        StartComboStep(Ctx, 0, PC->GetWorld() ? PC->GetWorld()->GetTimeSeconds() : 0.0);
         return;
     }
 
@@ -62,7 +73,7 @@ void UBMPlayerState_Attack::OnEnter(float)
         float StaminaCost = 0.f;
         if (!PC->SelectSkillSpec(Action, Spec, StaminaCost))
         {
-            FinishAttack(true);
+            FinishAttack(Ctx, true);
             return;
         }
 
@@ -71,7 +82,7 @@ void UBMPlayerState_Attack::OnEnter(float)
         {
             if (!Combat->IsCooldownReady(Spec.Id))
             {
-                FinishAttack(true);
+                FinishAttack(Ctx, true);
                 return;
             }
         }
@@ -80,32 +91,33 @@ void UBMPlayerState_Attack::OnEnter(float)
         {
             if (!Stats->TryConsumeStamina(StaminaCost))
             {
-                FinishAttack(true);
+                FinishAttack(Ctx, true);
                 if (UBMStateMachineComponent* M = PC->GetFSM())
                 {
-                    M->ChangeStateByName(BMStateNames::Idle);
+                    M->ChangeStateById(EBMStateId::Idle);
                 }
                 return;
             }
         }
 
-        StartSkill(Spec);
+        StartSkill(Ctx, Spec);
         return;
     }
 
-    FinishAttack(true);
+    FinishAttack(Ctx, true);
 }
 
-void UBMPlayerState_Attack::OnExit(float)
+void UBMPlayerState_Attack::OnExit(FBMStateContext& Ctx, float) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerStepEnd);
-    PC->GetWorldTimerManager().ClearTimer(TimerWindowOpen);
-    PC->GetWorldTimerManager().ClearTimer(TimerWindowClose);
-    PC->GetWorldTimerManager().ClearTimer(TimerPollInput);
-    PC->GetWorldTimerManager().ClearTimer(TimerRecoverEnd);
+    FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (Data)
+    {
+        PC->OnInputBuffered.Remove(Data->InputBufferedHandle);
+        Data->InputBufferedHandle.Reset();
+    }
 
     PC->ClearActiveAttackContext();
 
@@ -114,40 +126,58 @@ void UBMPlayerState_Attack::OnExit(float)
         Combat->SetActionLock(false);
     }
 
-    RestoreMovementSettings(PC->GetCharacterMovement());
-    bFinished = false;
+    if (Data)
+    {
+        RestoreMovementSettings(*Data, PC->GetCharacterMovement());
+    }
 }
 
-bool UBMPlayerState_Attack::CanTransitionTo(FName StateName) const
+void UBMPlayerState_Attack::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
 {
-    if (StateName == BMStateNames::Death) return true;
-    if (StateName == BMStateNames::Hit)   return true;
-    if (StateName == BMStateNames::Dodge) return bRecover;
-    return bFinished;
+    switch (EventId)
+    {
+    case Event_StepEnd:
+        OnStepFinished(Ctx);
+        break;
+    case Event_RecoverEnd:
+    case Event_SkillEnd:
+        OnRecoverFinished(Ctx);
+        break;
+    default:
+        break;
+    }
 }
 
-void UBMPlayerState_Attack::StartComboStep(int32 StepIndex)
+EBMStateTransitionRule UBMPlayerState_Attack::GetTransitionRule(EBMStateId Target) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
-    if (!PC) return;
+    if (Target == EBMStateId::Death) return EBMStateTransitionRule::Allow;
+    if (Target == EBMStateId::Hit)   return EBMStateTransitionRule::Allow;
+    if (Target == EBMStateId::Dodge) return EBMStateTransitionRule::WhenRecovering;
+    return EBMStateTransitionRule::WhenFinished;
+}
+
+void UBMPlayerState_Attack::StartComboStep(FBMStateContext& Ctx, int32 StepIndex, double StartTime) const
+{
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (!PC || !Data) return;
 
     FBMPlayerComboStep Step;
     if (!PC->GetComboStep(StepIndex, Step))
     {
         // ûиöΣֱ
-        OnRecoverFinished();
+        OnRecoverFinished(Ctx);
         return;
     }
 
-    bIsCombo = true;
-    ComboIndex = StepIndex;
+    Data->bIsCombo = true;
+    Data->ComboIndex = StepIndex;
 
-    bLinkWindowOpen = false;
-    bQueuedNext = false;
+    Data->bQueuedNext = false;
 
     // ù
     PC->SetActiveAttackContext(
-        Step.HitBoxNames,
+        Step.HitBoxMask,
         Step.HitBoxParams,
         Step.bUninterruptible,
         Step.InterruptChance,
@@ -158,131 +188,116 @@ void UBMPlayerState_Attack::StartComboStep(int32 StepIndex)
     const float Duration = PC->PlayNormalAttackOnce(Step.Anim, Step.PlayRate, Step.StartTime, Step.MaxPlayTime);
     if (Duration <= 0.f)
     {
-        OnRecoverFinished();
+        OnRecoverFinished(Ctx);
         return;
     }
 
-    //  LinkWindowSeconds 
-    float OpenT = FMath::Max(0.f, Duration - Step.LinkWindowSeconds);
-    float CloseT = FMath::Max(OpenT, Duration - Step.LinkWindowEndOffset);
-
-    // ʱ/ش
-    PC->GetWorldTimerManager().SetTimer(
-        TimerWindowOpen, this, &UBMPlayerState_Attack::OpenLinkWindow, OpenT, false);
-
-    PC->GetWorldTimerManager().SetTimer(
-        TimerWindowClose, this, &UBMPlayerState_Attack::CloseLinkWindow, CloseT, false);
-
-    // ѯ
-    PC->GetWorldTimerManager().SetTimer(
-        TimerPollInput, this, &UBMPlayerState_Attack::PollComboInput, 1.f / 60.f, true);
+    // ʱӼƻʼʱ𣬲ν¼ɷʱԴӱ֡ʼ
+    Data->Timing = FBMComboStepTiming::Make(StartTime, Duration, Step.LinkWindowSeconds, Step.LinkWindowEndOffset);
 
-    // ν
-    PC->GetWorldTimerManager().SetTimer(
-        TimerStepEnd, this, &UBMPlayerState_Attack::OnStepFinished, Duration, false);
+    // ν۳ƻʼʱ䵽֡ѾȥĲ
+    const double Now = PC->GetWorld() ? PC->GetWorld()->GetTimeSeconds() : StartTime;
+    Ctx.SetDeadline(Event_StepEnd, static_cast<float>(Data->Timing.EndTime - Now));
 }
 
-void UBMPlayerState_Attack::OpenLinkWindow()
+void UBMPlayerState_Attack::HandleInputBuffered(FBMStateContext& Ctx, EBMCombatAction Action) const
 {
-    bLinkWindowOpen = true;
-}
+    if (Action != EBMCombatAction::NormalAttack) return;
+    if (Ctx.HasFlag(FBMStateContext::Flag_Recovering | FBMStateContext::Flag_Finished)) return;
 
-void UBMPlayerState_Attack::CloseLinkWindow()
-{
-    bLinkWindowOpen = false;
+    const FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (!Data || !Data->bIsCombo) return;
+
+    TryQueueNextStep(Ctx);
 }
 
-void UBMPlayerState_Attack::PollComboInput()
+void UBMPlayerState_Attack::TryQueueNextStep(FBMStateContext& Ctx) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
-    if (!PC) return;
-
-    //  NormalAttack
-    const bool bPressed = PC->ConsumeOneQueuedNormalAttack();
-    if (!bPressed) return;
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (!PC || !Data || Data->bQueuedNext) return;
 
-    // ֻдڿʱЧ
-    if (bLinkWindowOpen)
-    {
-        bQueuedNext = true;
-    }
+    // ֻʱڴڵЧڻв
+    Data->bQueuedNext = PC->ConsumeBufferedAction(EBMCombatAction::NormalAttack, Data->Timing.LinkWindowOpenTime, Data->Timing.LinkWindowCloseTime);
 }
 
-void UBMPlayerState_Attack::OnStepFinished()
+void UBMPlayerState_Attack::OnStepFinished(FBMStateContext& Ctx) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
-    if (!PC) return;
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (!PC || !Data) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerPollInput);
+    // νʱжһΣνͬ֡
+    TryQueueNextStep(Ctx);
 
     const int32 MaxIdx = PC->GetComboStepCount() - 1;
-    const bool bHasNext = (ComboIndex >= 0 && ComboIndex < MaxIdx);
+    const bool bHasNext = (Data->ComboIndex >= 0 && Data->ComboIndex < MaxIdx);
 
-    if (bQueuedNext && bHasNext)
+    if (Data->bQueuedNext && bHasNext)
     {
-        StartComboStep(ComboIndex + 1);
+        // һνڱεļƻʱ
+        StartComboStep(Ctx, Data->ComboIndex + 1, Data->Timing.EndTime);
         return;
     }
 
-    StartRecoverForStep(ComboIndex);
+    StartRecoverForStep(Ctx, Data->ComboIndex);
 }
 
-void UBMPlayerState_Attack::StartRecoverForStep(int32 FromStepIndex)
+void UBMPlayerState_Attack::StartRecoverForStep(FBMStateContext& Ctx, int32 FromStepIndex) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
-    if (!PC) return;
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (!PC || !Data) return;
 
     // Recover Ӧ
     PC->ClearActiveAttackContext();
-
-    PC->GetWorldTimerManager().ClearTimer(TimerWindowOpen);
-    PC->GetWorldTimerManager().ClearTimer(TimerWindowClose);
-    PC->GetWorldTimerManager().ClearTimer(TimerPollInput);
+    Data->Timing.LinkWindowCloseTime = -1.0;
 
     FBMPlayerComboStep Step;
     if (!PC->GetComboStep(FromStepIndex, Step))
     {
-        OnRecoverFinished();
+        OnRecoverFinished(Ctx);
         return;
     }
 
     const float Dur = PC->PlayComboRecoverOnce(Step);
     if (Dur <= 0.f)
     {
-        OnRecoverFinished();
+        OnRecoverFinished(Ctx);
         return;
     }
-	bRecover = true;
-    PC->GetWorldTimerManager().SetTimer(
-        TimerRecoverEnd, this, &UBMPlayerState_Attack::OnRecoverFinished, Dur, false);
+	Ctx.SetFlag(FBMStateContext::Flag_Recovering);
+
+    Ctx.SetDeadline(Event_RecoverEnd, Dur);
 }
 
 
-void UBMPlayerState_Attack::OnRecoverFinished()
+void UBMPlayerState_Attack::OnRecoverFinished(FBMStateContext& Ctx) const
 {
-    FinishAttack(false);
+    FinishAttack(Ctx, false);
 
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     // ص Idle
     if (PC->GetFSM())
     {
-        PC->GetFSM()->ChangeStateByName(BMStateNames::Idle);
+        PC->GetFSM()->ChangeStateById(EBMStateId::Idle);
     }
 }
 
 
-void UBMPlayerState_Attack::StartSkill(const FBMPlayerAttackSpec& Spec)
+void UBMPlayerState_Attack::StartSkill(FBMStateContext& Ctx, const FBMPlayerAttackSpec& Spec) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
-    if (!PC) return;
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    FBMPlayerAttackStateData* Data = Ctx.FindData<FBMPlayerAttackStateData>();
+    if (!PC || !Data) return;
 
-    bIsCombo = false;
+    Data->bIsCombo = false;
 
     // active context
     PC->SetActiveAttackContext(
-        Spec.HitBoxNames,
+        Spec.HitBoxMask,
         Spec.HitBoxParams,
         Spec.bUninterruptible,
         Spec.InterruptChance,
@@ -292,40 +307,27 @@ void UBMPlayerState_Attack::StartSkill(const FBMPlayerAttackSpec& Spec)
     const float Duration = PC->PlayAttackOnce(Spec);
     if (Duration <= 0.f)
     {
-        FinishAttack(true);
+        FinishAttack(Ctx, true);
         return;
     }
 
     // ύȴ
     if (UBMCombatComponent* Combat = PC->GetCombat())
     {
+        // ȴʼ/¼ CombatComponent ͳһ㲥 EventBus
         Combat->CommitCooldown(Spec.Id, Spec.Cooldown);
-        
-        // ֪ͨUIʾȴ
-        if (UWorld* World = PC->GetWorld())
-        {
-            if (UGameInstance* GameInstance = World->GetGameInstance())
-            {
-                if (UBMEventBusSubsystem* EventBus = GameInstance->GetSubsystem<UBMEventBusSubsystem>())
-                {
-                    EventBus->EmitSkillCooldown(Spec.Id, Spec.Cooldown);
-                }
-            }
-        }
     }
 
-
-    PC->GetWorldTimerManager().SetTimer(
-        TimerStepEnd, this, &UBMPlayerState_Attack::OnRecoverFinished, Duration, false);
+    Ctx.SetDeadline(Event_SkillEnd, Duration);
 }
 
 
-void UBMPlayerState_Attack::FinishAttack(bool)
+void UBMPlayerState_Attack::FinishAttack(FBMStateContext& Ctx, bool) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    bFinished = true;
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
     if (UBMCombatComponent* Combat = PC->GetCombat())
     {
@@ -333,15 +335,16 @@ void UBMPlayerState_Attack::FinishAttack(bool)
     }
 }
 
-void UBMPlayerState_Attack::ApplyAttackInertiaSettings(UCharacterMovementComponent* Move)
+void UBMPlayerState_Attack::ApplyAttackInertiaSettings(FBMPlayerAttackStateData& Data, UCharacterMovementComponent* Move)
 {
     if (!Move) return;
 
-    SavedGroundFriction = Move->GroundFriction;
-    SavedBrakingDecelWalking = Move->BrakingDecelerationWalking;
-    SavedBrakingFrictionFactor = Move->BrakingFrictionFactor;
-    bSavedUseSeparateBrakingFriction = Move->bUseSeparateBrakingFriction;
-    SavedBrakingFriction = Move->BrakingFriction;
+    Data.bSavedMovement = true;
+    Data.SavedGroundFriction = Move->GroundFriction;
+    Data.SavedBrakingDecelWalking = Move->BrakingDecelerationWalking;
+    Data.SavedBrakingFrictionFactor = Move->BrakingFrictionFactor;
+    Data.bSavedUseSeparateBrakingFriction = Move->bUseSeparateBrakingFriction;
+    Data.SavedBrakingFriction = Move->BrakingFriction;
 
     Move->GroundFriction = 2.0f;
     Move->BrakingDecelerationWalking = 350.f;
@@ -350,13 +353,13 @@ void UBMPlayerState_Attack::ApplyAttackInertiaSettings(UCharacterMovementCompone
     Move->BrakingFriction = 2.0f;
 }
 
-void UBMPlayerState_Attack::RestoreMovementSettings(UCharacterMovementComponent* Move)
+void UBMPlayerState_Attack::RestoreMovementSettings(const FBMPlayerAttackStateData& Data, UCharacterMovementComponent* Move)
 {
-    if (!Move) return;
+    if (!Move || !Data.bSavedMovement) return;
 
-    Move->GroundFriction = SavedGroundFriction;
-    Move->BrakingDecelerationWalking = SavedBrakingDecelWalking;
-    Move->BrakingFrictionFactor = SavedBrakingFrictionFactor;
-    Move->bUseSeparateBrakingFriction = bSavedUseSeparateBrakingFriction;
-    Move->BrakingFriction = SavedBrakingFriction;
+    Move->GroundFriction = Data.SavedGroundFriction;
+    Move->BrakingDecelerationWalking = Data.SavedBrakingDecelWalking;
+    Move->BrakingFrictionFactor = Data.SavedBrakingFrictionFactor;
+    Move->bUseSeparateBrakingFriction = Data.bSavedUseSeparateBrakingFriction;
+    Move->BrakingFriction = Data.SavedBrakingFriction;
 }
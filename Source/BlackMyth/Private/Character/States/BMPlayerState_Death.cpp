@@ -4,9 +4,9 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 
-void UBMPlayerState_Death::OnEnter(float)
+void UBMPlayerState_Death::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     if (UBMCombatComponent* Combat = PC->GetCombat())
@@ -5,21 +5,21 @@
 #include "Character/Components/BMStateMachineComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
-void UBMPlayerState_Dodge::OnEnter(float)
+void UBMPlayerState_Dodge::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerHandleFinish);
-    PC->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+    FBMPlayerDodgeStateData& Data = Ctx.EmplaceData<FBMPlayerDodgeStateData>();
 
     if (UBMStatsComponent* Stats = PC->GetStats())
     {
         if (!Stats->TryConsumeStamina(40.f))
         {
+            Ctx.SetFlag(FBMStateContext::Flag_Finished);
             if (UBMStateMachineComponent* M = PC->GetFSM())
             {
-                M->ChangeStateByName(PC->HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
+                M->ChangeStateById(PC->HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
             }
             return;
         }
@@ -31,8 +31,9 @@ void UBMPlayerState_Dodge::OnEnter(float)
         if (!Combat->TryCommitCooldown(PC->DodgeCooldownKey, PC->DodgeCooldown))
         {
             // ȴδãֱӻ
+            Ctx.SetFlag(FBMStateContext::Flag_Finished);
             if (UBMStateMachineComponent* M = PC->GetFSM())
-                M->ChangeStateByName(PC->HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
+                M->ChangeStateById(PC->HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
             return;
         }
 
@@ -40,57 +41,63 @@ void UBMPlayerState_Dodge::OnEnter(float)
         Combat->SetActionLock(true);
     }
 
-    bFinished = false;
-
     // ر HurtBox
     PC->SetAllHurtBoxesEnabled(false);
 
     // 
-    LockedDir = PC->ComputeDodgeDirectionLocked();
+    FVector LockedDir = PC->ComputeDodgeDirectionLocked();
     LockedDir.Z = 0.f;
-    LockedDir = LockedDir.IsNearlyZero() ? PC->GetActorForwardVector() : LockedDir.GetSafeNormal();
+    Data.LockedDir = LockedDir.IsNearlyZero() ? PC->GetActorForwardVector() : LockedDir.GetSafeNormal();
 
     // ܷ
-    PC->SetActorRotation(LockedDir.Rotation());
+    PC->SetActorRotation(Data.LockedDir.Rotation());
     // óƶת
     if (UCharacterMovementComponent* Move = PC->GetCharacterMovement())
     {
-        bSavedOrientToMovement = Move->bOrientRotationToMovement;
-        SavedMaxWalkSpeed = Move->MaxWalkSpeed;
+        Data.bSavedMovement = true;
+        Data.bSavedOrientToMovement = Move->bOrientRotationToMovement;
+        Data.SavedMaxWalkSpeed = Move->MaxWalkSpeed;
 
         Move->bOrientRotationToMovement = false;
-        Move->MaxWalkSpeed = FMath::Max(SavedMaxWalkSpeed, PC->DodgeSpeed);
+        Move->MaxWalkSpeed = FMath::Max(Data.SavedMaxWalkSpeed, PC->DodgeSpeed);
 
         Move->StopMovementImmediately();
     }
 
 
     // Ŷ
-    WindowDuration = PC->PlayDodgeOnce(); 
-    if (WindowDuration <= 0.f)
+    Data.WindowDuration = PC->PlayDodgeOnce(); 
+    if (Data.WindowDuration <= 0.f)
     {
-        FinishDodge();
+        FinishDodge(Ctx);
         return;
     }
     // λ
-    TotalDistance = FMath::Max(0.f, PC->DodgeDistance);
-    TraveledDistance = 0.f;
-
-    // ʼʱ
-    LastStepTime = PC->GetWorld()->GetTimeSeconds();
+    Data.TotalDistance = FMath::Max(0.f, PC->DodgeDistance);
+    Data.TraveledDistance = 0.f;
 
-    // λƲ
-    PC->GetWorldTimerManager().SetTimer(
-        TimerHandleStep,
-        this,
-        &UBMPlayerState_Dodge::StepDodge,
-        1.0f / 60.0f,
-        true
-    );
+    // λƲ OnUpdate ֡ƽ
+    Data.bStepping = true;
 
     //  -> ״̬
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]() { FinishDodge(); });
-    PC->GetWorldTimerManager().SetTimer(TimerHandleFinish, D, WindowDuration, false);
+    Ctx.SetDeadline(Event_Finish, Data.WindowDuration);
+}
+
+void UBMPlayerState_Dodge::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
+{
+    const FBMPlayerDodgeStateData* Data = Ctx.FindData<FBMPlayerDodgeStateData>();
+    if (Data && Data->bStepping)
+    {
+        StepDodge(Ctx, DeltaTime);
+    }
+}
+
+void UBMPlayerState_Dodge::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    if (EventId == Event_Finish)
+    {
+        FinishDodge(Ctx);
+    }
 }
 
 bool UBMPlayerState_Dodge::HasWalkableFloorAt(const FVector& WorldPos, const ACharacter* Char) const
@@ -117,47 +124,41 @@ bool UBMPlayerState_Dodge::HasWalkableFloorAt(const FVector& WorldPos, const ACh
     return Hit.ImpactNormal.Z >= WalkableZ;
 }
 
-void UBMPlayerState_Dodge::StepDodge()
+void UBMPlayerState_Dodge::StepDodge(FBMStateContext& Ctx, float DeltaTime) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
-    if (!PC || bFinished) return;
-
-    UWorld* W = PC->GetWorld();
-    if (!W) return;
-
-    const float Now = W->GetTimeSeconds();
-    float Dt = Now - LastStepTime;
-    LastStepTime = Now;
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    FBMPlayerDodgeStateData* Data = Ctx.FindData<FBMPlayerDodgeStateData>();
+    if (!PC || !Data || Ctx.HasFlag(FBMStateContext::Flag_Finished)) return;
 
-    Dt = FMath::Clamp(Dt, 0.f, 0.05f); // ֹʱһ̫Զ
+    const float Dt = FMath::Clamp(DeltaTime, 0.f, 0.05f); // ֹʱһ̫Զ
 
-    if (TotalDistance <= 0.f || WindowDuration <= 0.f)
+    if (Data->TotalDistance <= 0.f || Data->WindowDuration <= 0.f)
     {
         // Ҫλ
-        PC->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
         return;
     }
 
     // ٶλ/ʱƵ
-    const float Speed = TotalDistance / WindowDuration;
+    const float Speed = Data->TotalDistance / Data->WindowDuration;
     float Step = Speed * Dt;
 
-    const float Remaining = TotalDistance - TraveledDistance;
+    const float Remaining = Data->TotalDistance - Data->TraveledDistance;
     Step = FMath::Min(Step, Remaining);
     if (Step <= KINDA_SMALL_NUMBER)
     {
-        PC->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
         return;
     }
 
     const FVector Cur = PC->GetActorLocation();
-    const FVector Delta = LockedDir * Step;
+    const FVector Delta = Data->LockedDir * Step;
     const FVector Next = Cur + Delta;
 
     // ƽ̨Ե  һûпߵֹͣλ
     if (!HasWalkableFloorAt(Next, PC))
     {
-        PC->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
         return;
     }
 
@@ -167,22 +168,21 @@ void UBMPlayerState_Dodge::StepDodge()
 
     // ͳʵλ
     const float Moved = FVector::Dist2D(Cur, PC->GetActorLocation());
-    TraveledDistance += Moved;
+    Data->TraveledDistance += Moved;
 
     // ﵽλֹͣλƽ
-    if (TraveledDistance >= TotalDistance - 1.0f)
+    if (Data->TraveledDistance >= Data->TotalDistance - 1.0f)
     {
-        PC->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+        Data->bStepping = false;
     }
 }
 
-void UBMPlayerState_Dodge::OnExit(float)
+void UBMPlayerState_Dodge::OnExit(FBMStateContext& Ctx, float) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerHandleFinish);
-    PC->GetWorldTimerManager().ClearTimer(TimerHandleStep);
+    const FBMPlayerDodgeStateData* Data = Ctx.FindData<FBMPlayerDodgeStateData>();
 
     // ָ HurtBox
     PC->SetAllHurtBoxesEnabled(true);
@@ -194,30 +194,31 @@ void UBMPlayerState_Dodge::OnExit(float)
     }
 
     // ָƶ
-    if (UCharacterMovementComponent* Move = PC->GetCharacterMovement())
+    if (Data && Data->bSavedMovement)
     {
-        Move->bOrientRotationToMovement = bSavedOrientToMovement;
-        Move->MaxWalkSpeed = SavedMaxWalkSpeed;
+        if (UCharacterMovementComponent* Move = PC->GetCharacterMovement())
+        {
+            Move->bOrientRotationToMovement = Data->bSavedOrientToMovement;
+            Move->MaxWalkSpeed = Data->SavedMaxWalkSpeed;
+        }
     }
-
-    bFinished = false;
 }
 
-bool UBMPlayerState_Dodge::CanTransitionTo(FName StateName) const
+EBMStateTransitionRule UBMPlayerState_Dodge::GetTransitionRule(EBMStateId Target) const
 {
-	if (StateName == BMStateNames::Death) return true;
-    return bFinished;
+	if (Target == EBMStateId::Death) return EBMStateTransitionRule::Allow;
+    return EBMStateTransitionRule::WhenFinished;
 }
 
-void UBMPlayerState_Dodge::FinishDodge()
+void UBMPlayerState_Dodge::FinishDodge(FBMStateContext& Ctx) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    bFinished = true;
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
     if (UBMStateMachineComponent* M = PC->GetFSM())
     {
-        M->ChangeStateByName(PC->HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
+        M->ChangeStateById(PC->HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
     }
 }
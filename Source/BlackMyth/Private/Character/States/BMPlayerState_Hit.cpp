@@ -5,15 +5,11 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Core/BMTypes.h"
 
-void UBMPlayerState_Hit::OnEnter(float)
+void UBMPlayerState_Hit::OnEnter(FBMStateContext& Ctx, float) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerHandle);
-
-    bFinished = false;
-
     if (UBMCombatComponent* Combat = PC->GetCombat())
     {
         Combat->SetActionLock(true);
@@ -22,58 +18,62 @@ void UBMPlayerState_Hit::OnEnter(float)
     const float Duration = PC->PlayHitOnce(PC->GetLastDamageInfo());
     if (Duration <= 0.f)
     {
-        bFinished = true;
+        Ctx.SetFlag(FBMStateContext::Flag_Finished);
         if (PC->GetFSM())
         {
-            PC->GetFSM()->ChangeStateByName(PC->HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
+            PC->GetFSM()->ChangeStateById(PC->HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
         }
         return;
     }
 
-    FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-        {
-            ABMPlayerCharacter* PC2 = Cast<ABMPlayerCharacter>(GetContext());
-            if (!PC2) return;
+    Ctx.SetDeadline(Event_Finish, Duration);
+}
 
-            bFinished = true;
+void UBMPlayerState_Hit::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    if (EventId == Event_Finish)
+    {
+        FinishHit(Ctx);
+    }
+}
+
+void UBMPlayerState_Hit::FinishHit(FBMStateContext& Ctx) const
+{
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
+    if (!PC) return;
 
-            if (UBMCombatComponent* Combat2 = PC2->GetCombat())
-            {
-                Combat2->SetActionLock(false);
-            }
+    Ctx.SetFlag(FBMStateContext::Flag_Finished);
 
-            if (UCharacterMovementComponent* Move = PC2->GetCharacterMovement(); Move && Move->IsFalling())
-            {
-                if (PC2->GetFSM()) PC2->GetFSM()->ChangeStateByName(BMStateNames::Jump);
-                return;
-            }
+    if (UBMCombatComponent* Combat = PC->GetCombat())
+    {
+        Combat->SetActionLock(false);
+    }
 
-            if (PC2->GetFSM())
-            {
-                PC2->GetFSM()->ChangeStateByName(PC2->HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
-            }
-        });
+    if (UCharacterMovementComponent* Move = PC->GetCharacterMovement(); Move && Move->IsFalling())
+    {
+        if (PC->GetFSM()) PC->GetFSM()->ChangeStateById(EBMStateId::Jump);
+        return;
+    }
 
-    PC->GetWorldTimerManager().SetTimer(TimerHandle, D, Duration, false);
+    if (PC->GetFSM())
+    {
+        PC->GetFSM()->ChangeStateById(PC->HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
+    }
 }
 
-void UBMPlayerState_Hit::OnExit(float)
+void UBMPlayerState_Hit::OnExit(FBMStateContext& Ctx, float) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(TimerHandle);
-
     if (UBMCombatComponent* Combat = PC->GetCombat())
     {
         Combat->SetActionLock(false);
     }
-
-    bFinished = false;
 }
 
-bool UBMPlayerState_Hit::CanTransitionTo(FName StateName) const
+EBMStateTransitionRule UBMPlayerState_Hit::GetTransitionRule(EBMStateId Target) const
 {
-    if (StateName == BMStateNames::Death) return true;
-    return bFinished;
+    if (Target == EBMStateId::Death) return EBMStateTransitionRule::Allow;
+    return EBMStateTransitionRule::WhenFinished;
 }
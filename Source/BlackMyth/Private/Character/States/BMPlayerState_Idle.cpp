@@ -5,32 +5,32 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Core/BMTypes.h"
 
-void UBMPlayerState_Idle::OnUpdate(float DeltaTime)
+void UBMPlayerState_Idle::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
 
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     if (UCharacterMovementComponent* Move = PC->GetCharacterMovement())
     {
         if (Move->IsFalling())
         {
-            if (PC->GetFSM()) PC->GetFSM()->ChangeStateByName(BMStateNames::Jump);
+            if (PC->GetFSM()) PC->GetFSM()->ChangeStateById(EBMStateId::Jump);
             return;
         }
     }
 
     if (PC->HasMoveIntent())
     {
-        if (PC->GetFSM()) PC->GetFSM()->ChangeStateByName(BMStateNames::Move);
+        if (PC->GetFSM()) PC->GetFSM()->ChangeStateById(EBMStateId::Move);
     }
 }
 
-void UBMPlayerState_Idle::OnEnter(float DeltaTime)
+void UBMPlayerState_Idle::OnEnter(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
-    if (ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext()))
+    if (ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get()))
     {
         PC->PlayIdleLoop();
     }
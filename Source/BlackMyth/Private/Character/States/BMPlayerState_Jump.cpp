@@ -5,17 +5,14 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Core/BMTypes.h"
 
-void UBMPlayerState_Jump::OnEnter(float DeltaTime)
+void UBMPlayerState_Jump::OnEnter(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
 
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    bInFallLoop = false;
-    bDidPlayJumpStart = false;
-
-    PC->GetWorldTimerManager().ClearTimer(JumpToFallHandle);
+    FBMPlayerJumpStateData& Data = Ctx.EmplaceData<FBMPlayerJumpStateData>();
 
     UCharacterMovementComponent* Move = PC->GetCharacterMovement();
     if (!Move)
@@ -28,7 +25,7 @@ void UBMPlayerState_Jump::OnEnter(float DeltaTime)
 
     if (bWantsJumpStart)
     {
-        bDidPlayJumpStart = true;
+        Data.bDidPlayJumpStart = true;
         PC->Jump();
 
         const float JumpStartDuration = PC->PlayJumpStartOnce(1.0f);
@@ -36,45 +33,36 @@ void UBMPlayerState_Jump::OnEnter(float DeltaTime)
         // Jump ڿУ FallLoop
         if (JumpStartDuration > 0.f)
         {
-            FTimerDelegate D = FTimerDelegate::CreateWeakLambda(this, [this]()
-                {
-                    StartFallLoopIfStillInAir();
-                });
-            PC->GetWorldTimerManager().SetTimer(JumpToFallHandle, D, JumpStartDuration, false);
+            Ctx.SetDeadline(Event_JumpStartEnd, JumpStartDuration);
         }
         else
         {
-            StartFallLoopIfStillInAir();
+            StartFallLoopIfStillInAir(Ctx);
         }
     }
     else
     {
         // µֱ FallLoop
-        EnterFallLoop();
+        EnterFallLoop(Ctx);
     }
 }
 
-void UBMPlayerState_Jump::OnExit(float DeltaTime)
+void UBMPlayerState_Jump::OnExit(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
 
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
-    PC->GetWorldTimerManager().ClearTimer(JumpToFallHandle);
-
     PC->StopJumping();
-
-    bInFallLoop = false;
-    bDidPlayJumpStart = false;
 }
 
-void UBMPlayerState_Jump::OnUpdate(float DeltaTime)
+void UBMPlayerState_Jump::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
 
     // ص״̬
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     UCharacterMovementComponent* Move = PC->GetCharacterMovement();
@@ -84,20 +72,29 @@ void UBMPlayerState_Jump::OnUpdate(float DeltaTime)
     {
         if (PC->GetFSM())
         {
-            PC->GetFSM()->ChangeStateByName(PC->HasMoveIntent() ? BMStateNames::Move : BMStateNames::Idle);
+            PC->GetFSM()->ChangeStateById(PC->HasMoveIntent() ? EBMStateId::Move : EBMStateId::Idle);
         }
         return;
     }
     //  Jump ״̬
-    if (!bDidPlayJumpStart && !bInFallLoop)
+    const FBMPlayerJumpStateData* Data = Ctx.FindData<FBMPlayerJumpStateData>();
+    if (Data && !Data->bDidPlayJumpStart && !Data->bInFallLoop)
+    {
+        EnterFallLoop(Ctx);
+    }
+}
+
+void UBMPlayerState_Jump::OnDeadline(FBMStateContext& Ctx, uint8 EventId) const
+{
+    if (EventId == Event_JumpStartEnd)
     {
-        EnterFallLoop();
+        StartFallLoopIfStillInAir(Ctx);
     }
 }
 
-void UBMPlayerState_Jump::StartFallLoopIfStillInAir()
+void UBMPlayerState_Jump::StartFallLoopIfStillInAir(FBMStateContext& Ctx) const
 {
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     UCharacterMovementComponent* Move = PC->GetCharacterMovement();
@@ -105,17 +102,18 @@ void UBMPlayerState_Jump::StartFallLoopIfStillInAir()
 
     if (Move->IsFalling())
     {
-        EnterFallLoop();
+        EnterFallLoop(Ctx);
     }
 }
 
-void UBMPlayerState_Jump::EnterFallLoop()
+void UBMPlayerState_Jump::EnterFallLoop(FBMStateContext& Ctx) const
 {
-    if (bInFallLoop) return;
+    FBMPlayerJumpStateData* Data = Ctx.FindData<FBMPlayerJumpStateData>();
+    if (!Data || Data->bInFallLoop) return;
 
-    if (ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext()))
+    if (ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get()))
     {
         PC->PlayFallLoop();
-        bInFallLoop = true;
+        Data->bInFallLoop = true;
     }
 }
@@ -6,11 +6,11 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Core/BMTypes.h"
 
-void UBMPlayerState_Move::OnEnter(float DeltaTime)
+void UBMPlayerState_Move::OnEnter(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
 
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     //  Move ʱͬƶٶ
@@ -25,11 +25,11 @@ void UBMPlayerState_Move::OnEnter(float DeltaTime)
     PC->PlayMoveLoop();
 }
 
-void UBMPlayerState_Move::OnUpdate(float DeltaTime)
+void UBMPlayerState_Move::OnUpdate(FBMStateContext& Ctx, float DeltaTime) const
 {
     (void)DeltaTime;
 
-    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(GetContext());
+    ABMPlayerCharacter* PC = Cast<ABMPlayerCharacter>(Ctx.Owner.Get());
     if (!PC) return;
 
     UCharacterMovementComponent* Move = PC->GetCharacterMovement();
@@ -37,13 +37,13 @@ void UBMPlayerState_Move::OnUpdate(float DeltaTime)
 
     if (Move->IsFalling())
     {
-        if (PC->GetFSM()) PC->GetFSM()->ChangeStateByName(BMStateNames::Jump);
+        if (PC->GetFSM()) PC->GetFSM()->ChangeStateById(EBMStateId::Jump);
         return;
     }
 
     const float Speed2D = Move->Velocity.Size2D();
     if (!PC->HasMoveIntent() && Speed2D <= StopSpeedThreshold)
     {
-        if (PC->GetFSM()) PC->GetFSM()->ChangeStateByName(BMStateNames::Idle);
+        if (PC->GetFSM()) PC->GetFSM()->ChangeStateById(EBMStateId::Idle);
     }
 }
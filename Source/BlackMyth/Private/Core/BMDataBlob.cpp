@@ -0,0 +1,759 @@
+#include "Core/BMDataBlob.h"
+
+#include "Engine/DataTable.h"
+#include "Internationalization/TextNamespaceUtil.h"
+#include "Misc/Crc.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    using EFieldType = FBMDataBlob::EFieldType;
+
+    // 行结构体的一个字段：反射属性与其在 blob 中的槽位类型
+    struct FFieldBinding
+    {
+        const FProperty* Property = nullptr;
+        EFieldType Type = EFieldType::Int;
+    };
+
+    // 去重的字符串表，偏移 0 固定为空串
+    struct FStringTableBuilder
+    {
+        TArray<uint8> Data;
+        TMap<FString, uint32> Offsets;
+        TMap<FString, uint32> TextOffsets;
+
+        FStringTableBuilder()
+        {
+            Add(FString());
+        }
+
+        uint32 Add(const FString& String)
+        {
+            if (const uint32* Existing = Offsets.Find(String))
+            {
+                return *Existing;
+            }
+
+            const uint32 Offset = Append(String);
+            Offsets.Add(String, Offset);
+            return Offset;
+        }
+
+        // 文本写成连续三段：命名空间、键、源字符串；本地化查找按前两段进行
+        uint32 AddText(const FText& Text)
+        {
+            const TOptional<FString> Namespace = FTextInspector::GetNamespace(Text);
+            const TOptional<FString> Key = FTextInspector::GetKey(Text);
+            const FString* Source = FTextInspector::GetSourceString(Text);
+
+            const FString NamespaceString = Namespace.IsSet() ? TextNamespaceUtil::StripPackageNamespace(Namespace.GetValue()) : FString();
+            const FString KeyString = Key.IsSet() ? Key.GetValue() : FString();
+            const FString SourceString = Source ? *Source : Text.ToString();
+
+            const FString Combined = NamespaceString + TEXT("\x1F") + KeyString + TEXT("\x1F") + SourceString;
+            if (const uint32* Existing = TextOffsets.Find(Combined))
+            {
+                return *Existing;
+            }
+
+            const uint32 Offset = Append(NamespaceString);
+            Append(KeyString);
+            Append(SourceString);
+            TextOffsets.Add(Combined, Offset);
+            return Offset;
+        }
+
+    private:
+        uint32 Append(const FString& String)
+        {
+            const uint32 Offset = Data.Num();
+            const FTCHARToUTF8 Utf8(*String);
+            Data.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+            Data.Add(0);
+            return Offset;
+        }
+    };
+
+    static bool IsStringType(EFieldType Type)
+    {
+        return Type == EFieldType::Text || Type == EFieldType::Name || Type == EFieldType::String || Type == EFieldType::SoftPath;
+    }
+
+    static const TCHAR* GetFieldTypeName(EFieldType Type)
+    {
+        switch (Type)
+        {
+        case EFieldType::Float: return TEXT("Float");
+        case EFieldType::Int: return TEXT("Int");
+        case EFieldType::Bool: return TEXT("Bool");
+        case EFieldType::Enum: return TEXT("Enum");
+        case EFieldType::Text: return TEXT("Text");
+        case EFieldType::Name: return TEXT("Name");
+        case EFieldType::String: return TEXT("String");
+        case EFieldType::SoftPath: return TEXT("SoftPath");
+        default: return TEXT("Unknown");
+        }
+    }
+
+    /*
+     * @brief Classify property, it maps a reflected property to its slot type
+     * @param Property The property
+     * @param OutType The slot type
+     * @return True if the property can be stored in the blob
+     */
+    static bool ClassifyProperty(const FProperty* Property, EFieldType& OutType)
+    {
+        if (Property->ArrayDim != 1) return false;
+
+        if (Property->IsA<FFloatProperty>()) { OutType = EFieldType::Float; return true; }
+        if (Property->IsA<FIntProperty>()) { OutType = EFieldType::Int; return true; }
+        if (Property->IsA<FBoolProperty>()) { OutType = EFieldType::Bool; return true; }
+        if (Property->IsA<FEnumProperty>() || Property->IsA<FByteProperty>()) { OutType = EFieldType::Enum; return true; }
+        if (Property->IsA<FTextProperty>()) { OutType = EFieldType::Text; return true; }
+        if (Property->IsA<FNameProperty>()) { OutType = EFieldType::Name; return true; }
+        if (Property->IsA<FStrProperty>()) { OutType = EFieldType::String; return true; }
+        if (Property->IsA<FSoftObjectProperty>()) { OutType = EFieldType::SoftPath; return true; }
+
+        const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+        if (StructProperty && StructProperty->Struct == TBaseStructure<FSoftObjectPath>::Get())
+        {
+            OutType = EFieldType::SoftPath;
+            return true;
+        }
+        return false;
+    }
+
+    /*
+     * @brief Gather fields, it lists the properties of the row struct in declaration order
+     * @param Struct The row struct
+     * @param OutFields The fields
+     * @param OutError The unsupported property, if any
+     * @return True if every property can be stored in the blob
+     */
+    static bool GatherFields(const UScriptStruct* Struct, TArray<FFieldBinding>& OutFields, FString& OutError)
+    {
+        OutFields.Reset();
+        for (TFieldIterator<FProperty> It(Struct); It; ++It)
+        {
+            FFieldBinding& Field = OutFields.AddDefaulted_GetRef();
+            Field.Property = *It;
+            if (!ClassifyProperty(*It, Field.Type))
+            {
+                OutError = FString::Printf(TEXT("%s.%s: unsupported property type %s"), *Struct->GetName(), *It->GetName(), *It->GetCPPType());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * @brief Hash schema, it hashes the field names and slot types (stable across runs, unlike FName hashes)
+     * @param Fields The fields
+     * @return The schema hash
+     */
+    static uint32 HashSchema(TConstArrayView<FFieldBinding> Fields)
+    {
+        uint32 Hash = FBMDataBlob::Version;
+        for (const FFieldBinding& Field : Fields)
+        {
+            Hash = FCrc::StrCrc32(*Field.Property->GetName(), Hash);
+            Hash = FCrc::MemCrc32(&Field.Type, sizeof(Field.Type), Hash);
+        }
+        return Hash;
+    }
+
+    static const FNumericProperty* GetEnumValueProperty(const FProperty* Property)
+    {
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+        {
+            return EnumProperty->GetUnderlyingProperty();
+        }
+        return CastField<FNumericProperty>(Property);
+    }
+
+    /*
+     * @brief Read field, it reads one field of a row as slot bits or as a string
+     * @param Field The field
+     * @param Row The row
+     * @param OutBits The slot bits of a numeric field
+     * @param OutString The value of a string field
+     */
+    static void ReadField(const FFieldBinding& Field, const void* Row, uint32& OutBits, FString& OutString)
+    {
+        OutBits = 0;
+        OutString.Reset();
+
+        const FProperty* Property = Field.Property;
+        const void* Value = Property->ContainerPtrToValuePtr<void>(Row);
+        switch (Field.Type)
+        {
+        case EFieldType::Float:
+            FMemory::Memcpy(&OutBits, Value, sizeof(float));
+            break;
+        case EFieldType::Int:
+            OutBits = static_cast<uint32>(*static_cast<const int32*>(Value));
+            break;
+        case EFieldType::Bool:
+            OutBits = CastFieldChecked<FBoolProperty>(Property)->GetPropertyValue(Value) ? 1u : 0u;
+            break;
+        case EFieldType::Enum:
+            OutBits = static_cast<uint32>(static_cast<int32>(GetEnumValueProperty(Property)->GetSignedIntPropertyValue(Value)));
+            break;
+        case EFieldType::Text:
+        {
+            // 按源字符串比较，与当前语言无关
+            const FText& Text = *static_cast<const FText*>(Value);
+            const FString* Source = FTextInspector::GetSourceString(Text);
+            OutString = Source ? *Source : Text.ToString();
+            break;
+        }
+        case EFieldType::Name:
+            OutString = static_cast<const FName*>(Value)->ToString();
+            break;
+        case EFieldType::String:
+            OutString = *static_cast<const FString*>(Value);
+            break;
+        case EFieldType::SoftPath:
+            if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(Property))
+            {
+                OutString = SoftProperty->GetPropertyValue(Value).ToSoftObjectPath().ToString();
+            }
+            else
+            {
+                OutString = static_cast<const FSoftObjectPath*>(Value)->ToString();
+            }
+            break;
+        }
+    }
+
+    /*
+     * @brief Write field, it writes one slot of a blob row into a row struct
+     * @param Field The field
+     * @param Row The row
+     * @param Bits The slot bits
+     * @param String The string of a string field
+     * @param Text The text of a text field
+     */
+    static void WriteField(const FFieldBinding& Field, void* Row, uint32 Bits, const FString& String, const FText& Text)
+    {
+        const FProperty* Property = Field.Property;
+        void* Value = Property->ContainerPtrToValuePtr<void>(Row);
+        switch (Field.Type)
+        {
+        case EFieldType::Float:
+            FMemory::Memcpy(Value, &Bits, sizeof(float));
+            break;
+        case EFieldType::Int:
+            *static_cast<int32*>(Value) = static_cast<int32>(Bits);
+            break;
+        case EFieldType::Bool:
+            CastFieldChecked<FBoolProperty>(Property)->SetPropertyValue(Value, Bits != 0);
+            break;
+        case EFieldType::Enum:
+            GetEnumValueProperty(Property)->SetIntPropertyValue(Value, static_cast<int64>(static_cast<int32>(Bits)));
+            break;
+        case EFieldType::Text:
+            *static_cast<FText*>(Value) = Text;
+            break;
+        case EFieldType::Name:
+            *static_cast<FName*>(Value) = FName(*String);
+            break;
+        case EFieldType::String:
+            *static_cast<FString*>(Value) = String;
+            break;
+        case EFieldType::SoftPath:
+            if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(Property))
+            {
+                SoftProperty->SetPropertyValue(Value, FSoftObjectPtr(FSoftObjectPath(String)));
+            }
+            else
+            {
+                *static_cast<FSoftObjectPath*>(Value) = FSoftObjectPath(String);
+            }
+            break;
+        }
+    }
+
+    template <typename T>
+    static uint32 AppendArray(TArray<uint8>& Out, const T* Data, int32 Num)
+    {
+        const uint32 Offset = Out.Num();
+        Out.Append(reinterpret_cast<const uint8*>(Data), Num * sizeof(T));
+        return Offset;
+    }
+}
+
+/*
+ * @brief Constructor of the FRowComparer class, it gathers the fields of the row struct once
+ * @param Struct The row struct
+ */
+FBMDataBlob::FRowComparer::FRowComparer(const UScriptStruct* Struct)
+{
+    TArray<FFieldBinding> Bindings;
+    FString Error;
+    bValid = Struct && GatherFields(Struct, Bindings, Error);
+    for (const FFieldBinding& Binding : Bindings)
+    {
+        Fields.Emplace(Binding.Property, Binding.Type);
+    }
+}
+
+/*
+ * @brief Equals, it compares two rows field by field
+ * @param RowA The first row
+ * @param RowB The second row
+ * @return True if every field matches
+ */
+bool FBMDataBlob::FRowComparer::Equals(const void* RowA, const void* RowB) const
+{
+    uint32 BitsA = 0;
+    uint32 BitsB = 0;
+    FString StringA;
+    FString StringB;
+    for (const TPair<const FProperty*, EFieldType>& Field : Fields)
+    {
+        const FFieldBinding Binding{ Field.Key, Field.Value };
+        ReadField(Binding, RowA, BitsA, StringA);
+        ReadField(Binding, RowB, BitsB, StringB);
+        if (BitsA != BitsB || !StringA.Equals(StringB, ESearchCase::CaseSensitive))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief Compile, it compiles the data tables into one blob
+ * @param Tables The data tables
+ * @param OutBytes The blob
+ * @param OutError The error
+ * @return True if the blob was compiled
+ */
+bool FBMDataBlob::Compile(TConstArrayView<const UDataTable*> Tables, TArray<uint8>& OutBytes, FString& OutError)
+{
+    OutBytes.Reset();
+
+    TArray<FTable> Directory;
+    TArray<uint8> Body;
+    FStringTableBuilder Strings;
+    TSet<const UScriptStruct*> SeenStructs;
+
+    TArray<FFieldBinding> Fields;
+    TArray<FField> BlobFields;
+    TArray<uint32> RowNames;
+    TArray<uint32> Slots;
+    FString StringValue;
+
+    for (const UDataTable* DataTable : Tables)
+    {
+        if (!DataTable)
+        {
+            OutError = TEXT("a configured table could not be loaded");
+            return false;
+        }
+
+        const UScriptStruct* Struct = DataTable->GetRowStruct();
+        if (!Struct)
+        {
+            OutError = FString::Printf(TEXT("%s has no row struct"), *GetPathNameSafe(DataTable));
+            return false;
+        }
+        if (SeenStructs.Contains(Struct))
+        {
+            OutError = FString::Printf(TEXT("%s: another table already uses row struct %s"), *DataTable->GetPathName(), *Struct->GetName());
+            return false;
+        }
+        SeenStructs.Add(Struct);
+
+        if (!GatherFields(Struct, Fields, OutError))
+        {
+            return false;
+        }
+
+        const TMap<FName, uint8*>& RowMap = DataTable->GetRowMap();
+
+        BlobFields.Reset(Fields.Num());
+        for (const FFieldBinding& Field : Fields)
+        {
+            BlobFields.Add({ Strings.Add(Field.Property->GetName()), Field.Type });
+        }
+
+        RowNames.Reset(RowMap.Num());
+        Slots.Reset(RowMap.Num() * Fields.Num());
+        for (const TPair<FName, uint8*>& Pair : RowMap)
+        {
+            RowNames.Add(Strings.Add(Pair.Key.ToString()));
+            for (const FFieldBinding& Field : Fields)
+            {
+                if (Field.Type == EFieldType::Text)
+                {
+                    Slots.Add(Strings.AddText(*Field.Property->ContainerPtrToValuePtr<FText>(Pair.Value)));
+                    continue;
+                }
+
+                uint32 Bits = 0;
+                ReadField(Field, Pair.Value, Bits, StringValue);
+                Slots.Add(IsStringType(Field.Type) ? Strings.Add(StringValue) : Bits);
+            }
+        }
+
+        // 偏移先相对 Body，写出时再加上目录末尾的位置
+        FTable& Table = Directory.AddZeroed_GetRef();
+        Table.StructName = Strings.Add(Struct->GetName());
+        Table.SchemaHash = HashSchema(Fields);
+        Table.NumFields = Fields.Num();
+        Table.NumRows = RowMap.Num();
+        Table.FieldsOffset = AppendArray(Body, BlobFields.GetData(), BlobFields.Num());
+        Table.RowNamesOffset = AppendArray(Body, RowNames.GetData(), RowNames.Num());
+        Table.RowsOffset = AppendArray(Body, Slots.GetData(), Slots.Num());
+    }
+
+    const uint32 BodyOffset = sizeof(FHeader) + Directory.Num() * sizeof(FTable);
+    for (FTable& Table : Directory)
+    {
+        Table.FieldsOffset += BodyOffset;
+        Table.RowNamesOffset += BodyOffset;
+        Table.RowsOffset += BodyOffset;
+    }
+
+    // 字符串表放在末尾，补齐到 4 字节
+    while (Strings.Data.Num() % 4 != 0)
+    {
+        Strings.Data.Add(0);
+    }
+
+    FHeader Header = {};
+    Header.Magic = Magic;
+    Header.Version = Version;
+    Header.NumTables = Directory.Num();
+    Header.TablesOffset = sizeof(FHeader);
+    Header.StringsOffset = BodyOffset + Body.Num();
+    Header.StringsSize = Strings.Data.Num();
+    Header.TotalSize = Header.StringsOffset + Header.StringsSize;
+
+    OutBytes.Reserve(Header.TotalSize);
+    AppendArray(OutBytes, &Header, 1);
+    AppendArray(OutBytes, Directory.GetData(), Directory.Num());
+    OutBytes.Append(Body);
+    OutBytes.Append(Strings.Data);
+    check(OutBytes.Num() == static_cast<int32>(Header.TotalSize));
+
+    reinterpret_cast<FHeader*>(OutBytes.GetData())->Checksum = FCrc::MemCrc32(OutBytes.GetData() + sizeof(FHeader), OutBytes.Num() - sizeof(FHeader));
+    return true;
+}
+
+/*
+ * @brief Initialize, it validates the blob and points the view at it
+ * @param InBytes The blob
+ * @param OutError The error
+ * @return True if the blob can be used
+ */
+bool FBMDataBlob::Initialize(TConstArrayView<uint8> InBytes, FString& OutError)
+{
+    Bytes = TConstArrayView<uint8>();
+
+    if (InBytes.Num() < static_cast<int32>(sizeof(FHeader)) || !IsAligned(InBytes.GetData(), alignof(uint32)))
+    {
+        OutError = TEXT("too small or misaligned");
+        return false;
+    }
+
+    const FHeader& Header = *reinterpret_cast<const FHeader*>(InBytes.GetData());
+    if (Header.Magic != Magic)
+    {
+        OutError = TEXT("bad magic");
+        return false;
+    }
+    if (Header.Version != Version)
+    {
+        OutError = FString::Printf(TEXT("version %u, expected %u"), Header.Version, Version);
+        return false;
+    }
+    if (Header.TotalSize != static_cast<uint32>(InBytes.Num()))
+    {
+        OutError = FString::Printf(TEXT("size %d, header says %u"), InBytes.Num(), Header.TotalSize);
+        return false;
+    }
+    if (Header.Checksum != FCrc::MemCrc32(InBytes.GetData() + sizeof(FHeader), InBytes.Num() - sizeof(FHeader)))
+    {
+        OutError = TEXT("checksum mismatch");
+        return false;
+    }
+
+    // 目录与各段都必须落在字符串表之前，字符串表必须以 0 结尾
+    const uint64 Total = Header.TotalSize;
+    const uint64 StringsBegin = Header.StringsOffset;
+    if (StringsBegin + Header.StringsSize != Total || Header.StringsSize == 0 || InBytes[Total - 1] != 0
+        || Header.TablesOffset % 4 != 0 || Header.TablesOffset + (uint64)Header.NumTables * sizeof(FTable) > StringsBegin)
+    {
+        OutError = TEXT("bad section layout");
+        return false;
+    }
+
+    const FTable* Tables = reinterpret_cast<const FTable*>(InBytes.GetData() + Header.TablesOffset);
+    for (uint32 i = 0; i < Header.NumTables; ++i)
+    {
+        const FTable& Table = Tables[i];
+        const bool bAligned = Table.FieldsOffset % 4 == 0 && Table.RowNamesOffset % 4 == 0 && Table.RowsOffset % 4 == 0;
+        const bool bInRange = Table.FieldsOffset + (uint64)Table.NumFields * sizeof(FField) <= StringsBegin
+            && Table.RowNamesOffset + (uint64)Table.NumRows * sizeof(uint32) <= StringsBegin
+            && Table.RowsOffset + (uint64)Table.NumRows * Table.NumFields * sizeof(uint32) <= StringsBegin;
+        if (!bAligned || !bInRange || Table.StructName >= Header.StringsSize)
+        {
+            OutError = FString::Printf(TEXT("table %u out of range"), i);
+            return false;
+        }
+    }
+
+    Bytes = InBytes;
+    return true;
+}
+
+/*
+ * @brief Get string, it decodes a string table entry
+ * @param Offset The offset in the string table
+ * @return The string
+ */
+FString FBMDataBlob::GetString(uint32 Offset) const
+{
+    const FHeader& Header = GetHeader();
+    if (Offset >= Header.StringsSize)
+    {
+        return FString();
+    }
+    return FString(FUTF8ToTCHAR(At<ANSICHAR>(Header.StringsOffset + Offset)));
+}
+
+/*
+ * @brief Get text parts, it decodes the three consecutive strings of a text slot
+ * @param Offset The offset of the namespace in the string table
+ * @param OutNamespace The namespace
+ * @param OutKey The key
+ * @param OutSource The source string
+ * @return True if all three strings lie inside the string table
+ */
+bool FBMDataBlob::GetTextParts(uint32 Offset, FString& OutNamespace, FString& OutKey, FString& OutSource) const
+{
+    const FHeader& Header = GetHeader();
+    const ANSICHAR* Strings = At<ANSICHAR>(Header.StringsOffset);
+
+    // 字符串表以 0 结尾（Initialize 已校验），每段都不会读出表外
+    uint32 Parts[3];
+    for (uint32& Part : Parts)
+    {
+        if (Offset >= Header.StringsSize)
+        {
+            return false;
+        }
+        Part = Offset;
+        Offset += FCStringAnsi::Strlen(Strings + Offset) + 1;
+    }
+
+    OutNamespace = FString(FUTF8ToTCHAR(Strings + Parts[0]));
+    OutKey = FString(FUTF8ToTCHAR(Strings + Parts[1]));
+    OutSource = FString(FUTF8ToTCHAR(Strings + Parts[2]));
+    return true;
+}
+
+/*
+ * @brief Get text, it rebuilds the text of a text slot, localizable when it has a key
+ * @param Offset The offset of the text in the string table
+ * @return The text
+ */
+FText FBMDataBlob::GetText(uint32 Offset) const
+{
+    FString Namespace;
+    FString Key;
+    FString Source;
+    if (!GetTextParts(Offset, Namespace, Key, Source))
+    {
+        return FText::GetEmpty();
+    }
+
+    // 有键的文本按命名空间与键查找当前语言的译文，找不到时显示源字符串
+    if (Key.IsEmpty())
+    {
+        return FText::AsCultureInvariant(MoveTemp(Source));
+    }
+    return FText::AsLocalizable_Advanced(*Namespace, *Key, MoveTemp(Source));
+}
+
+/*
+ * @brief Find table, it finds the table compiled from the row struct
+ * @param Struct The row struct
+ * @return The table, nullptr if none
+ */
+const FBMDataBlob::FTable* FBMDataBlob::FindTable(const UScriptStruct* Struct) const
+{
+    if (!IsValid() || !Struct) return nullptr;
+
+    const FString StructName = Struct->GetName();
+    const FTable* Tables = At<FTable>(GetHeader().TablesOffset);
+    for (uint32 i = 0; i < GetHeader().NumTables; ++i)
+    {
+        if (GetString(Tables[i].StructName) == StructName)
+        {
+            return &Tables[i];
+        }
+    }
+    return nullptr;
+}
+
+/*
+ * @brief Get the number of rows, it gets the row count of the table compiled from the row struct
+ * @param Struct The row struct
+ * @return The number of rows
+ */
+int32 FBMDataBlob::GetNumRows(const UScriptStruct* Struct) const
+{
+    const FTable* Table = FindTable(Struct);
+    return Table ? static_cast<int32>(Table->NumRows) : 0;
+}
+
+/*
+ * @brief Decode rows, it writes every row of the table into rows supplied by the caller
+ * @param Struct The row struct
+ * @param EmplaceRow The row factory
+ * @param OutError The error
+ * @return The number of rows, INDEX_NONE on a schema mismatch
+ */
+int32 FBMDataBlob::DecodeRows(const UScriptStruct* Struct, TFunctionRef<void*(FName RowName)> EmplaceRow, FString& OutError) const
+{
+    const FTable* Table = FindTable(Struct);
+    if (!Table)
+    {
+        return 0;
+    }
+
+    TArray<FFieldBinding> Fields;
+    if (!GatherFields(Struct, Fields, OutError))
+    {
+        return INDEX_NONE;
+    }
+    if (Table->SchemaHash != HashSchema(Fields) || Table->NumFields != static_cast<uint32>(Fields.Num()))
+    {
+        OutError = FString::Printf(TEXT("%s changed since the blob was compiled"), *Struct->GetName());
+        return INDEX_NONE;
+    }
+
+    const uint32* RowNames = At<uint32>(Table->RowNamesOffset);
+    const uint32* Slots = At<uint32>(Table->RowsOffset);
+    const int32 NumFields = Fields.Num();
+
+    FString StringValue;
+    FText TextValue;
+    for (uint32 RowIndex = 0; RowIndex < Table->NumRows; ++RowIndex)
+    {
+        void* Row = EmplaceRow(FName(*GetString(RowNames[RowIndex])));
+        const uint32* RowSlots = Slots + RowIndex * NumFields;
+        for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+        {
+            const FFieldBinding& Field = Fields[FieldIndex];
+            if (Field.Type == EFieldType::Text)
+            {
+                TextValue = GetText(RowSlots[FieldIndex]);
+            }
+            else if (IsStringType(Field.Type))
+            {
+                StringValue = GetString(RowSlots[FieldIndex]);
+            }
+            WriteField(Field, Row, RowSlots[FieldIndex], StringValue, TextValue);
+        }
+    }
+    return static_cast<int32>(Table->NumRows);
+}
+
+/*
+ * @brief Compare with table, it compares the blob table with every row of the data table
+ * @param Source The data table
+ * @param OutReport The mismatches
+ * @return The number of mismatches
+ */
+int32 FBMDataBlob::CompareWithTable(const UDataTable* Source, TArray<FString>& OutReport) const
+{
+    const UScriptStruct* Struct = Source ? Source->GetRowStruct() : nullptr;
+    const FTable* Table = FindTable(Struct);
+    if (!Table)
+    {
+        OutReport.Add(FString::Printf(TEXT("%s: no table for row struct %s"), *GetPathNameSafe(Source), *GetNameSafe(Struct)));
+        return 1;
+    }
+
+    FString Error;
+    TArray<FFieldBinding> Fields;
+    if (!GatherFields(Struct, Fields, Error) || Table->SchemaHash != HashSchema(Fields))
+    {
+        OutReport.Add(FString::Printf(TEXT("%s: schema mismatch %s"), *Struct->GetName(), *Error));
+        return 1;
+    }
+
+    const uint32* RowNames = At<uint32>(Table->RowNamesOffset);
+    const uint32* Slots = At<uint32>(Table->RowsOffset);
+    const int32 NumFields = Fields.Num();
+
+    TMap<FName, uint32> BlobRowByName;
+    for (uint32 RowIndex = 0; RowIndex < Table->NumRows; ++RowIndex)
+    {
+        BlobRowByName.Add(FName(*GetString(RowNames[RowIndex])), RowIndex);
+    }
+
+    int32 NumMismatches = 0;
+    FString SourceString;
+    for (const TPair<FName, uint8*>& Pair : Source->GetRowMap())
+    {
+        const uint32* BlobRow = BlobRowByName.Find(Pair.Key);
+        if (!BlobRow)
+        {
+            OutReport.Add(FString::Printf(TEXT("%s.%s: row missing from the blob"), *Struct->GetName(), *Pair.Key.ToString()));
+            ++NumMismatches;
+            continue;
+        }
+
+        const uint32* RowSlots = Slots + *BlobRow * NumFields;
+        for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+        {
+            const FFieldBinding& Field = Fields[FieldIndex];
+            uint32 SourceBits = 0;
+            ReadField(Field, Pair.Value, SourceBits, SourceString);
+
+            // 数值按位比较，字符串区分大小写比较（文本比较源字符串；CSV 导入的文本键与资产不同）
+            if (IsStringType(Field.Type))
+            {
+                FString BlobString;
+                if (Field.Type == EFieldType::Text)
+                {
+                    FString Namespace;
+                    FString Key;
+                    GetTextParts(RowSlots[FieldIndex], Namespace, Key, BlobString);
+                }
+                else
+                {
+                    BlobString = GetString(RowSlots[FieldIndex]);
+                }
+                if (!BlobString.Equals(SourceString, ESearchCase::CaseSensitive))
+                {
+                    OutReport.Add(FString::Printf(TEXT("%s.%s.%s (%s): source '%s', blob '%s'"), *Struct->GetName(), *Pair.Key.ToString(),
+                        *Field.Property->GetName(), GetFieldTypeName(Field.Type), *SourceString, *BlobString));
+                    ++NumMismatches;
+                }
+            }
+            else if (SourceBits != RowSlots[FieldIndex])
+            {
+                OutReport.Add(FString::Printf(TEXT("%s.%s.%s (%s): source 0x%08x, blob 0x%08x"), *Struct->GetName(), *Pair.Key.ToString(),
+                    *Field.Property->GetName(), GetFieldTypeName(Field.Type), SourceBits, RowSlots[FieldIndex]));
+                ++NumMismatches;
+            }
+        }
+        BlobRowByName.Remove(Pair.Key);
+    }
+
+    for (const TPair<FName, uint32>& Extra : BlobRowByName)
+    {
+        OutReport.Add(FString::Printf(TEXT("%s.%s: row only in the blob"), *Struct->GetName(), *Extra.Key.ToString()));
+        ++NumMismatches;
+    }
+    return NumMismatches;
+}
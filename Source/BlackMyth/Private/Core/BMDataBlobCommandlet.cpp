@@ -0,0 +1,262 @@
+#include "Core/BMDataBlobCommandlet.h"
+#include "Core/BMDataBlob.h"
+#include "Core/BMDataSubsystem.h"
+#include "Config/BMGameSettings.h"
+
+#include "Engine/DataTable.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBMDataBlob, Log, All);
+
+namespace
+{
+#if WITH_EDITOR
+    /*
+     * @brief Import table, it imports a configured table whose asset does not exist yet from its source CSV and saves the asset
+     * @param Table The configured table
+     * @param RowStruct The row struct of the table
+     * @return The saved table, nullptr when there is no CSV or the asset cannot be saved
+     */
+    static UDataTable* ImportTable(const TSoftObjectPtr<UDataTable>& Table, const UScriptStruct* RowStruct)
+    {
+        const FString PackageName = Table.GetLongPackageName();
+        UPackage* Package = CreatePackage(*PackageName);
+        UDataTable* Imported = UBMDataSubsystem::ImportTableFromSourceCsv(Table, RowStruct, Package, RF_Public | RF_Standalone);
+        if (!Imported)
+        {
+            return nullptr;
+        }
+
+        Package->MarkPackageDirty();
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+        const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+        if (!UPackage::SavePackage(Package, Imported, *Filename, SaveArgs))
+        {
+            UE_LOG(LogBMDataBlob, Error, TEXT("Cannot save %s"), *Filename);
+            return nullptr;
+        }
+
+        UE_LOG(LogBMDataBlob, Display, TEXT("Imported %s from its source CSV into %s."), *Table.ToString(), *Filename);
+        return Imported;
+    }
+#endif
+
+    /*
+     * @brief Load tables, it loads every table configured in the game settings
+     * @param OutTables The loaded tables
+     * @param OutSeconds The load time in seconds
+     * @return True if every configured table was loaded
+     */
+    static bool LoadTables(TArray<UDataTable*>& OutTables, double& OutSeconds)
+    {
+        const double Start = FPlatformTime::Seconds();
+        bool bAllLoaded = true;
+
+        const UBMGameSettings* Settings = GetDefault<UBMGameSettings>();
+        const TPair<const TSoftObjectPtr<UDataTable>*, const UScriptStruct*> Configured[] = {
+            { &Settings->SkillDataTable, FBMSkillData::StaticStruct() },
+            { &Settings->SceneDataTable, FBMSceneData::StaticStruct() },
+            { &Settings->ElementDataTable, FBMElementalData::StaticStruct() },
+            { &Settings->PlayerGrowthTable, FBMPlayerGrowthData::StaticStruct() },
+            { &Settings->EnemyDataTable, FBMEnemyData::StaticStruct() },
+            { &Settings->ItemDataTable, FBMItemData::StaticStruct() },
+            { &Settings->ProjectileDataTable, FBMProjectileData::StaticStruct() } };
+
+        for (const TPair<const TSoftObjectPtr<UDataTable>*, const UScriptStruct*>& Entry : Configured)
+        {
+            const TSoftObjectPtr<UDataTable>* Table = Entry.Key;
+            if (Table->IsNull()) continue;
+
+            UDataTable* Loaded = Table->LoadSynchronous();
+#if WITH_EDITOR
+            // 资产还不存在时先从 CSV 源导入并保存
+            if (!Loaded)
+            {
+                Loaded = ImportTable(*Table, Entry.Value);
+            }
+#endif
+            if (Loaded)
+            {
+                OutTables.Add(Loaded);
+            }
+            else
+            {
+                // 缺表的 blob 在运行时无法与 DataTable 区分，宁可不生成
+                UE_LOG(LogBMDataBlob, Error, TEXT("%s is configured but could not be loaded."), *Table->ToString());
+                bAllLoaded = false;
+            }
+        }
+
+        OutSeconds = FPlatformTime::Seconds() - Start;
+        return bAllLoaded;
+    }
+
+    /*
+     * @brief Time decode, it reads the blob file and decodes every table into scratch rows, the way the runtime does
+     * @param Path The blob file
+     * @param Tables The tables whose row structs are decoded
+     * @param OutResidentBytes The blob plus the decoded rows
+     * @return The read and decode time in seconds, negative if the blob cannot be used
+     */
+    static double TimeDecode(const FString& Path, TConstArrayView<UDataTable*> Tables, int64& OutResidentBytes)
+    {
+        const double Start = FPlatformTime::Seconds();
+
+        TArray<uint8> Bytes;
+        FBMDataBlob Blob;
+        FString Error;
+        if (!FFileHelper::LoadFileToArray(Bytes, *Path) || !Blob.Initialize(Bytes, Error))
+        {
+            UE_LOG(LogBMDataBlob, Error, TEXT("%s cannot be used: %s"), *Path, *Error);
+            return -1.0;
+        }
+
+        OutResidentBytes = Bytes.Num();
+        for (const UDataTable* Table : Tables)
+        {
+            const UScriptStruct* Struct = Table->GetRowStruct();
+            const int32 Stride = Align(Struct->GetStructureSize(), Struct->GetMinAlignment());
+
+            // 与运行时相同：按行数一次分配，逐行默认构造后写入字段
+            TArray<uint8> Rows;
+            Rows.SetNumUninitialized(Blob.GetNumRows(Struct) * Stride);
+            int32 NumRows = 0;
+            Blob.DecodeRows(Struct, [&](FName) -> void*
+            {
+                void* Row = Rows.GetData() + NumRows++ * Stride;
+                Struct->InitializeStruct(Row);
+                return Row;
+            }, Error);
+
+            for (int32 i = 0; i < NumRows; ++i)
+            {
+                Struct->DestroyStruct(Rows.GetData() + i * Stride);
+            }
+            OutResidentBytes += Rows.Num();
+        }
+
+        return FPlatformTime::Seconds() - Start;
+    }
+}
+
+/*
+ * @brief Constructor of the UBMDataBlobCommandlet class
+ */
+UBMDataBlobCommandlet::UBMDataBlobCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+/*
+ * @brief Main, it compiles the tables into the blob and optionally verifies it against the CSV sources
+ * @param Params The command line
+ * @return 0 on success, 1 on failure or mismatch
+ */
+int32 UBMDataBlobCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    const bool bVerifyOnly = Switches.Contains(TEXT("VerifyOnly"));
+    const bool bVerify = bVerifyOnly || Switches.Contains(TEXT("Verify"));
+
+    const FString* OutParam = ParamValues.Find(TEXT("Out"));
+    const FString OutPath = OutParam ? *OutParam : FPaths::ProjectContentDir() / GetDefault<UBMGameSettings>()->GameplayDataBlobPath;
+    const FString* CsvParam = ParamValues.Find(TEXT("CsvDir"));
+    const FString CsvDir = CsvParam ? *CsvParam : FPaths::ProjectContentDir() / TEXT("Data/Tables");
+
+    TArray<UDataTable*> Tables;
+    double TableLoadSeconds = 0.0;
+    if (!LoadTables(Tables, TableLoadSeconds))
+    {
+        UE_LOG(LogBMDataBlob, Error, TEXT("Not every configured table could be loaded, %s was not written."), *OutPath);
+        return 1;
+    }
+
+    if (!bVerifyOnly)
+    {
+        TArray<uint8> Bytes;
+        FString Error;
+        if (!FBMDataBlob::Compile(Tables, Bytes, Error))
+        {
+            UE_LOG(LogBMDataBlob, Error, TEXT("Compile failed: %s"), *Error);
+            return 1;
+        }
+        if (!FFileHelper::SaveArrayToFile(Bytes, *OutPath))
+        {
+            UE_LOG(LogBMDataBlob, Error, TEXT("Cannot write %s"), *OutPath);
+            return 1;
+        }
+        UE_LOG(LogBMDataBlob, Display, TEXT("Wrote %s: %d tables, %d bytes."), *OutPath, Tables.Num(), Bytes.Num());
+    }
+
+    if (!bVerify)
+    {
+        return 0;
+    }
+
+    TArray<uint8> Bytes;
+    FBMDataBlob Blob;
+    FString Error;
+    if (!FFileHelper::LoadFileToArray(Bytes, *OutPath) || !Blob.Initialize(Bytes, Error))
+    {
+        UE_LOG(LogBMDataBlob, Error, TEXT("%s cannot be used: %s"), *OutPath, *Error);
+        return 1;
+    }
+
+    int32 NumMismatches = 0;
+    int64 TableResidentBytes = 0;
+    for (const UDataTable* Table : Tables)
+    {
+        TableResidentBytes += Table->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+        // 以 CSV 源为准；没有 CSV 的表退回与资产本身比较
+        const UDataTable* Source = Table;
+        const FString CsvPath = CsvDir / Table->GetName() + TEXT(".csv");
+        FString Csv;
+#if WITH_EDITOR
+        if (FFileHelper::LoadFileToString(Csv, *CsvPath))
+        {
+            UDataTable* FromCsv = NewObject<UDataTable>(GetTransientPackage());
+            FromCsv->RowStruct = const_cast<UScriptStruct*>(Table->GetRowStruct());
+            for (const FString& Problem : FromCsv->CreateTableFromCSVString(Csv))
+            {
+                UE_LOG(LogBMDataBlob, Warning, TEXT("%s: %s"), *CsvPath, *Problem);
+            }
+            Source = FromCsv;
+        }
+        else
+#endif
+        {
+            UE_LOG(LogBMDataBlob, Warning, TEXT("%s not found, verifying %s against the asset instead."), *CsvPath, *Table->GetName());
+        }
+
+        TArray<FString> Report;
+        const int32 TableMismatches = Blob.CompareWithTable(Source, Report);
+        for (const FString& Line : Report)
+        {
+            UE_LOG(LogBMDataBlob, Error, TEXT("%s"), *Line);
+        }
+        UE_LOG(LogBMDataBlob, Display, TEXT("%-16s %4d rows, %d mismatches"), *Table->GetName(), Source->GetRowMap().Num(), TableMismatches);
+        NumMismatches += TableMismatches;
+    }
+
+    int64 BlobResidentBytes = 0;
+    const double BlobLoadSeconds = TimeDecode(OutPath, Tables, BlobResidentBytes);
+    UE_LOG(LogBMDataBlob, Display, TEXT("Load: tables %.2f ms, blob read + decode %.2f ms. Resident: tables %.1f KB, blob + rows %.1f KB."),
+        TableLoadSeconds * 1000.0, BlobLoadSeconds * 1000.0, TableResidentBytes / 1024.0, BlobResidentBytes / 1024.0);
+
+    UE_LOG(LogBMDataBlob, Display, TEXT("Verify %s: %d mismatches."), NumMismatches == 0 ? TEXT("passed") : TEXT("FAILED"), NumMismatches);
+    return NumMismatches == 0 ? 0 : 1;
+}
@@ -1,7 +1,180 @@
 #include "Core/BMDataSubsystem.h"
 #include "Config/BMGameSettings.h"
 
+#include "Engine/AssetManager.h"
 #include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBMData, Log, All);
+
+namespace
+{
+    // C++ fallback: allow running without configuring Project Settings -> Black Myth Settings.
+    // Update path here if the asset moves.
+    static const TCHAR* DefaultItemTablePath = TEXT("/Game/Data/Tables/DT_Items.DT_Items");
+
+    static TAutoConsoleVariable<int32> CVarBMDataAsyncPreload(
+        TEXT("bm.Data.AsyncPreload"),
+        1,
+        TEXT("1: request the data tables as one async batch in Initialize (default). 0: load them synchronously, as before, to compare startup times."),
+        ECVF_Default);
+
+    static TAutoConsoleVariable<int32> CVarBMDataUseBlob(
+        TEXT("bm.Data.UseBlob"),
+        1,
+        TEXT("1: outside the editor, decode the row caches from the cooked data blob when it is present and up to date (default). 0: always load the data tables."),
+        ECVF_Default);
+
+    /*
+     * @brief Run bench, it runs the lookup benchmark of the data subsystem
+     * @param Args The command arguments: [Iterations]
+     * @param World The world
+     */
+    static void RunDataLookupBenchmark(const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+        const UBMDataSubsystem* Data = GI ? GI->GetSubsystem<UBMDataSubsystem>() : nullptr;
+        if (!Data)
+        {
+            UE_LOG(LogBMData, Warning, TEXT("bm.Data.Bench: no data subsystem in this world."));
+            return;
+        }
+
+        const int32 Iterations = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000);
+        Data->RunLookupBenchmark(Iterations);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMDataBenchCommand(
+        TEXT("bm.Data.Bench"),
+        TEXT("bm.Data.Bench [Iterations]: time UDataTable::FindRow against the typed row caches for every loaded table and log ns per lookup."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunDataLookupBenchmark));
+
+    static TAutoConsoleVariable<float> CVarBMDataHotReloadPoll(
+        TEXT("bm.Data.HotReloadPoll"),
+        1.0f,
+        TEXT("Seconds between checks of the source CSV timestamps for hot reload (read when the data becomes ready). <= 0 disables polling; table edits and reimports are still picked up."),
+        ECVF_Default);
+
+    /*
+     * @brief Reload, it reimports every source CSV and merges the changed rows
+     * @param Args The command arguments
+     * @param World The world
+     */
+    static void ReloadSourceCsvs(const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+        if (UBMDataSubsystem* Data = GI ? GI->GetSubsystem<UBMDataSubsystem>() : nullptr)
+        {
+            const int32 NumRows = Data->PollSourceCsvs(true);
+            UE_LOG(LogBMData, Log, TEXT("bm.Data.Reload: %d rows changed."), NumRows);
+        }
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMDataReloadCommand(
+        TEXT("bm.Data.Reload"),
+        TEXT("bm.Data.Reload: reimport every source CSV now and merge the rows that changed (editor builds)."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ReloadSourceCsvs));
+
+    static const TCHAR* GetTableLabel(EBMDataTable Table)
+    {
+        switch (Table)
+        {
+        case EBMDataTable::Skill: return TEXT("Skill");
+        case EBMDataTable::Scene: return TEXT("Scene");
+        case EBMDataTable::Element: return TEXT("Element");
+        case EBMDataTable::PlayerGrowth: return TEXT("PlayerGrowth");
+        case EBMDataTable::Enemy: return TEXT("Enemy");
+        case EBMDataTable::Item: return TEXT("Item");
+        case EBMDataTable::Projectile: return TEXT("Projectile");
+        default: return TEXT("Unknown");
+        }
+    }
+
+    static const UScriptStruct* GetTableRowStruct(EBMDataTable Table)
+    {
+        switch (Table)
+        {
+        case EBMDataTable::Skill: return FBMSkillData::StaticStruct();
+        case EBMDataTable::Scene: return FBMSceneData::StaticStruct();
+        case EBMDataTable::Element: return FBMElementalData::StaticStruct();
+        case EBMDataTable::PlayerGrowth: return FBMPlayerGrowthData::StaticStruct();
+        case EBMDataTable::Enemy: return FBMEnemyData::StaticStruct();
+        case EBMDataTable::Item: return FBMItemData::StaticStruct();
+        case EBMDataTable::Projectile: return FBMProjectileData::StaticStruct();
+        default: return nullptr;
+        }
+    }
+
+    static const TSoftObjectPtr<UDataTable>* GetTableSetting(const UBMGameSettings* Settings, EBMDataTable Table)
+    {
+        switch (Table)
+        {
+        case EBMDataTable::Skill: return &Settings->SkillDataTable;
+        case EBMDataTable::Scene: return &Settings->SceneDataTable;
+        case EBMDataTable::Element: return &Settings->ElementDataTable;
+        case EBMDataTable::PlayerGrowth: return &Settings->PlayerGrowthTable;
+        case EBMDataTable::Enemy: return &Settings->EnemyDataTable;
+        case EBMDataTable::Item: return &Settings->ItemDataTable;
+        case EBMDataTable::Projectile: return &Settings->ProjectileDataTable;
+        default: return nullptr;
+        }
+    }
+
+    /*
+     * @brief Bench table, it times the lookups of every row of one table with both paths
+     * @param Label The table label
+     * @param Table The data table
+     * @param Cached The cached lookup
+     * @param Iterations The number of passes over the rows
+     */
+    template <typename RowType, typename CachedLookupType>
+    static void BenchTable(const TCHAR* Label, UDataTable* Table, CachedLookupType&& Cached, int32 Iterations)
+    {
+        if (!Table || Table->GetRowMap().Num() == 0)
+        {
+            UE_LOG(LogBMData, Log, TEXT("bm.Data.Bench: %-12s not loaded"), Label);
+            return;
+        }
+
+        const TArray<FName> Names = Table->GetRowNames();
+        const FString ContextString(TEXT("BMDataSubsystem Lookup"));
+
+        // 防止查找被优化掉
+        uintptr_t Sink = 0;
+
+        const double TableStart = FPlatformTime::Seconds();
+        for (int32 It = 0; It < Iterations; ++It)
+        {
+            for (const FName& Name : Names)
+            {
+                Sink += reinterpret_cast<uintptr_t>(Table->FindRow<RowType>(Name, ContextString));
+            }
+        }
+        const double TableSeconds = FPlatformTime::Seconds() - TableStart;
+
+        const double CacheStart = FPlatformTime::Seconds();
+        for (int32 It = 0; It < Iterations; ++It)
+        {
+            for (const FName& Name : Names)
+            {
+                Sink += reinterpret_cast<uintptr_t>(Cached(Name));
+            }
+        }
+        const double CacheSeconds = FPlatformTime::Seconds() - CacheStart;
+
+        const double Lookups = (double)Iterations * Names.Num();
+        UE_LOG(LogBMData, Log, TEXT("bm.Data.Bench: %-12s %4d rows, FindRow %7.1f ns, cache %7.1f ns, x%.1f (sink %llu)"),
+            Label, Names.Num(), TableSeconds * 1e9 / Lookups, CacheSeconds * 1e9 / Lookups,
+            CacheSeconds > 0.0 ? TableSeconds / CacheSeconds : 0.0, (uint64)(Sink & 0xff));
+    }
+}
 
 /*
  * @brief Initialize, it initializes the data subsystem
@@ -11,6 +184,113 @@ void UBMDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
 
+    LoadRequestTime = FPlatformTime::Seconds();
+    LoadState = EBMDataLoadState::Loading;
+
+    // 记录进程启动到第一帧结束的时间，以及此时数据是否已就绪
+    FirstFrameHandle = FCoreDelegates::OnEndFrame.AddWeakLambda(this, [this]()
+    {
+        UE_LOG(LogBMData, Log, TEXT("Startup: first frame at %.3f s, data %s, %d forced waits blocked %.1f ms."),
+            FPlatformTime::Seconds() - GStartTime, IsDataReady() ? TEXT("ready") : TEXT("still loading"),
+            NumForcedWaits, ForcedWaitSeconds * 1000.0);
+        FCoreDelegates::OnEndFrame.Remove(FirstFrameHandle);
+        FirstFrameHandle.Reset();
+    });
+
+    // 打包版本优先使用烘焙好的数据 blob，编辑器中始终读 DataTable
+    if (!GIsEditor && CVarBMDataUseBlob.GetValueOnGameThread() != 0 && LoadFromBlob())
+    {
+        return;
+    }
+
+    TArray<FSoftObjectPath> Paths;
+    GatherTablePaths(Paths);
+
+    if (CVarBMDataAsyncPreload.GetValueOnGameThread() == 0 || !UAssetManager::IsInitialized() || Paths.Num() == 0)
+    {
+        HandleTablesLoaded();
+        return;
+    }
+
+    // 全部表作为一批异步请求；已在内存中时回调可能在请求内直接触发
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        MoveTemp(Paths), FStreamableDelegate::CreateUObject(this, &UBMDataSubsystem::HandleTablesLoaded));
+    if (LoadState != EBMDataLoadState::Ready)
+    {
+        LoadHandle = MoveTemp(Handle);
+    }
+}
+
+/*
+ * @brief Deinitialize, it cancels a pending load and removes the startup hook
+ */
+void UBMDataSubsystem::Deinitialize()
+{
+    if (LoadHandle.IsValid())
+    {
+        LoadHandle->CancelHandle();
+        LoadHandle.Reset();
+    }
+    if (FirstFrameHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(FirstFrameHandle);
+        FirstFrameHandle.Reset();
+    }
+#if BM_DATA_HOT_RELOAD
+    StopWatchingSources();
+#endif
+    OnDataReady.Clear();
+    OnDataDelta.Clear();
+    for (TMap<FName, FOnBMDataRowChanged>& Subscribers : RowSubscribers)
+    {
+        Subscribers.Reset();
+    }
+    LoadState = EBMDataLoadState::NotStarted;
+
+    Super::Deinitialize();
+}
+
+/*
+ * @brief Gather table paths, it collects the soft paths of every configured table
+ * @param OutPaths The table paths
+ */
+void UBMDataSubsystem::GatherTablePaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+    OutPaths.Reset();
+
+    if (const UBMGameSettings* Settings = GetDefault<UBMGameSettings>())
+    {
+        for (const TSoftObjectPtr<UDataTable>* Table : { &Settings->SkillDataTable, &Settings->SceneDataTable, &Settings->ElementDataTable,
+            &Settings->PlayerGrowthTable, &Settings->EnemyDataTable, &Settings->ItemDataTable, &Settings->ProjectileDataTable })
+        {
+            if (!Table->IsNull())
+            {
+                OutPaths.Add(Table->ToSoftObjectPath());
+            }
+        }
+
+        if (Settings->ItemDataTable.IsNull())
+        {
+            OutPaths.Add(FSoftObjectPath(DefaultItemTablePath));
+        }
+    }
+    else
+    {
+        OutPaths.Add(FSoftObjectPath(DefaultItemTablePath));
+    }
+}
+
+/*
+ * @brief Handle tables loaded, it resolves the tables, builds the caches and broadcasts OnDataReady
+ */
+void UBMDataSubsystem::HandleTablesLoaded()
+{
+    if (LoadState == EBMDataLoadState::Ready)
+    {
+        return;
+    }
+
+    // 批量请求完成后这里只是解析已加载的对象；同步模式或被强制等待时才真正阻塞加载
     const UBMGameSettings* Settings = GetDefault<UBMGameSettings>();
 
     if (Settings)
@@ -21,42 +301,584 @@ void UBMDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
         PlayerGrowthTableCache = Settings->PlayerGrowthTable.LoadSynchronous();
         EnemyTableCache = Settings->EnemyDataTable.LoadSynchronous();
         ItemTableCache = Settings->ItemDataTable.LoadSynchronous();
+        ProjectileTableCache = Settings->ProjectileDataTable.LoadSynchronous();
     }
 
-	// C++ fallback: allow running without configuring Project Settings -> Black Myth Settings.
-	// Update path here if the asset moves.
 	if (!ItemTableCache)
 	{
-		static const TCHAR* DefaultItemTablePath = TEXT("/Game/Data/Tables/DT_Items.DT_Items");
 		ItemTableCache = LoadObject<UDataTable>(nullptr, DefaultItemTablePath);
 	}
+
+#if WITH_EDITOR
+    // 已配置但资产尚未导入的表从 CSV 源临时构建；-run=BMDataBlob 会导入并保存为资产
+    if (Settings)
+    {
+        UDataTable** Caches[] = { &SkillTableCache, &SceneTableCache, &ElementTableCache, &PlayerGrowthTableCache, &EnemyTableCache, &ItemTableCache, &ProjectileTableCache };
+        for (int32 i = 0; i < static_cast<int32>(EBMDataTable::Count); ++i)
+        {
+            const EBMDataTable Table = static_cast<EBMDataTable>(i);
+            const TSoftObjectPtr<UDataTable>& Setting = *GetTableSetting(Settings, Table);
+            if (!*Caches[i] && !Setting.IsNull())
+            {
+                *Caches[i] = ImportTableFromSourceCsv(Setting, GetTableRowStruct(Table), GetTransientPackage());
+            }
+        }
+    }
+#endif
     
     // Debug Log
     if(!SkillTableCache) UE_LOG(LogTemp, Error, TEXT("BMDataSubsystem: Failed to load Skill Table!"));
 	if(!ItemTableCache) UE_LOG(LogTemp, Error, TEXT("BMDataSubsystem: Failed to load Item Table! (Check Project Settings -> Black Myth Settings -> ItemDataTable)"));
+
+    RebuildRowCaches();
+
+    int64 TableBytes = 0;
+    for (const UDataTable* Table : { SkillTableCache, SceneTableCache, ElementTableCache, PlayerGrowthTableCache, EnemyTableCache, ItemTableCache, ProjectileTableCache })
+    {
+        TableBytes += Table ? Table->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) : 0;
+    }
+
+    CompleteLoad(CVarBMDataAsyncPreload.GetValueOnGameThread() != 0 ? TEXT("tables (async)") : TEXT("tables (sync)"), TableBytes);
 }
 
+#if WITH_EDITOR
 /*
- * @brief Get the item table path debug, it gets the item table path debug
- * @return The item table path debug
+ * @brief Import table from source CSV, it builds a table from the CSV the asset is imported from
+ * @param Table The configured table, whose asset name names the CSV
+ * @param RowStruct The row struct of the table
+ * @param Outer The outer of the new table (the asset package when the caller saves it)
+ * @param Flags The object flags of the new table
+ * @return The table, nullptr when there is no CSV
  */
-FString UBMDataSubsystem::GetItemTablePathDebug() const
+UDataTable* UBMDataSubsystem::ImportTableFromSourceCsv(const TSoftObjectPtr<UDataTable>& Table, const UScriptStruct* RowStruct, UObject* Outer, EObjectFlags Flags)
 {
-	return GetPathNameSafe(ItemTableCache);
+    const FString CsvPath = FPaths::ProjectContentDir() / TEXT("Data/Tables") / Table.GetAssetName() + TEXT(".csv");
+    FString Text;
+    if (Table.IsNull() || !RowStruct || !FFileHelper::LoadFileToString(Text, *CsvPath))
+    {
+        return nullptr;
+    }
+
+    const FName Name = MakeUniqueObjectName(Outer, UDataTable::StaticClass(), FName(*Table.GetAssetName()));
+    UDataTable* Imported = NewObject<UDataTable>(Outer, Name, Flags);
+    Imported->RowStruct = const_cast<UScriptStruct*>(RowStruct);
+    for (const FString& Problem : Imported->CreateTableFromCSVString(Text))
+    {
+        UE_LOG(LogBMData, Warning, TEXT("Import %s: %s"), *CsvPath, *Problem);
+    }
+
+    UE_LOG(LogBMData, Log, TEXT("%s is not imported yet, built %d rows from %s."), *Table.ToString(), Imported->GetRowMap().Num(), *CsvPath);
+    return Imported;
 }
+#endif
 
 /*
- * @brief Find row, it finds the row
+ * @brief Load from blob, it reads the cooked data blob in one go and decodes every table into the row caches
+ * @return True if the caches were decoded and the data is ready
+ */
+bool UBMDataSubsystem::LoadFromBlob()
+{
+    const FString Path = FPaths::ProjectContentDir() / GetDefault<UBMGameSettings>()->GameplayDataBlobPath;
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+    {
+        UE_LOG(LogBMData, Log, TEXT("No data blob at %s, loading the data tables."), *Path);
+        return false;
+    }
+
+    FBMDataBlob Blob;
+    FString Error;
+    TBMRowCache<FBMPlayerGrowthData> GrowthSource;
+    bool bDecoded = Blob.Initialize(Bytes, Error)
+        && SkillRows.Build(Blob, Error)
+        && SceneRows.Build(Blob, Error)
+        && ElementRows.Build(Blob, Error)
+        && EnemyRows.Build(Blob, Error)
+        && ItemRows.Build(Blob, Error)
+        && ProjectileRows.Build(Blob, Error)
+        && GrowthSource.Build(Blob, Error);
+
+    // 已配置的表在 blob 中缺失说明 blob 过期，不能当作空表使用
+    if (bDecoded)
+    {
+        const UBMGameSettings* Settings = GetDefault<UBMGameSettings>();
+        for (int32 i = 0; i < static_cast<int32>(EBMDataTable::Count); ++i)
+        {
+            const EBMDataTable Table = static_cast<EBMDataTable>(i);
+            if (!GetTableSetting(Settings, Table)->IsNull() && !Blob.HasTable(GetTableRowStruct(Table)))
+            {
+                Error = FString::Printf(TEXT("the %s table is configured but missing"), GetTableLabel(Table));
+                bDecoded = false;
+                break;
+            }
+        }
+    }
+
+    if (!bDecoded)
+    {
+        UE_LOG(LogBMData, Warning, TEXT("Data blob %s cannot be used (%s), loading the data tables. Rebuild it with -run=BMDataBlob."), *Path, *Error);
+        SkillRows.Reset();
+        SceneRows.Reset();
+        ElementRows.Reset();
+        EnemyRows.Reset();
+        ItemRows.Reset();
+        ProjectileRows.Reset();
+        return false;
+    }
+
+    RebuildGrowthIndex(GrowthSource);
+    LoadedBlobPath = Path;
+
+    // 行已全部解码为结构体，blob 本身不再保留
+    CompleteLoad(TEXT("blob"), Bytes.Num());
+    return true;
+}
+
+/*
+ * @brief Complete load, it builds the element matrix, enters the ready state and broadcasts OnDataReady
+ * @param Source The source of the caches, for the log
+ * @param SourceBytes The resident size of the source (tables, or the blob while decoding)
+ */
+void UBMDataSubsystem::CompleteLoad(const TCHAR* Source, int64 SourceBytes)
+{
+    // 先置为就绪，构建过程中的自检读取不会再进入等待
+    LoadState = EBMDataLoadState::Ready;
+    LoadHandle.Reset();
+
+    RebuildElementMatrix();
+
+    const SIZE_T CacheBytes = SkillRows.GetAllocatedSize() + SceneRows.GetAllocatedSize() + ElementRows.GetAllocatedSize() + EnemyRows.GetAllocatedSize()
+        + ItemRows.GetAllocatedSize() + ProjectileRows.GetAllocatedSize() + GrowthRows.GetAllocatedSize() + GrowthIndexByLevel.GetAllocatedSize();
+
+    UE_LOG(LogBMData, Log, TEXT("Data ready from %s %.1f ms after request (%d forced waits), %.3f s after process start; source %.1f KB, caches %.1f KB."),
+        Source, (FPlatformTime::Seconds() - LoadRequestTime) * 1000.0, NumForcedWaits, FPlatformTime::Seconds() - GStartTime,
+        SourceBytes / 1024.0, CacheBytes / 1024.0);
+
+#if BM_DATA_HOT_RELOAD
+    StartWatchingSources();
+#endif
+
+    OnDataReady.Broadcast();
+}
+
+/*
+ * @brief Get the table cache, it gets the loaded table of the given kind
+ * @param Table The table
+ * @return The loaded table, nullptr if none
+ */
+UDataTable* UBMDataSubsystem::GetTableCache(EBMDataTable Table) const
+{
+    switch (Table)
+    {
+    case EBMDataTable::Skill: return SkillTableCache;
+    case EBMDataTable::Scene: return SceneTableCache;
+    case EBMDataTable::Element: return ElementTableCache;
+    case EBMDataTable::PlayerGrowth: return PlayerGrowthTableCache;
+    case EBMDataTable::Enemy: return EnemyTableCache;
+    case EBMDataTable::Item: return ItemTableCache;
+    case EBMDataTable::Projectile: return ProjectileTableCache;
+    default: return nullptr;
+    }
+}
+
+/*
+ * @brief Subscribe row, it registers a callback for reloads of one row
+ * @param Table The table
+ * @param RowName The row name
+ * @param Callback The callback
+ * @return The handle for UnsubscribeRow
+ */
+FDelegateHandle UBMDataSubsystem::SubscribeRow(EBMDataTable Table, FName RowName, FOnBMDataRowChanged::FDelegate&& Callback)
+{
+    if (Table >= EBMDataTable::Count) return FDelegateHandle();
+    return RowSubscribers[static_cast<int32>(Table)].FindOrAdd(RowName).Add(MoveTemp(Callback));
+}
+
+/*
+ * @brief Unsubscribe row, it removes a callback registered with SubscribeRow
  * @param Table The table
  * @param RowName The row name
- * @return The row
+ * @param Handle The handle
+ */
+void UBMDataSubsystem::UnsubscribeRow(EBMDataTable Table, FName RowName, FDelegateHandle Handle)
+{
+    if (Table >= EBMDataTable::Count) return;
+
+    // 只移除回调、保留条目：回调中取消订阅时不会销毁正在广播的委托
+    if (FOnBMDataRowChanged* Subscribers = RowSubscribers[static_cast<int32>(Table)].Find(RowName))
+    {
+        Subscribers->Remove(Handle);
+    }
+}
+
+/*
+ * @brief Reload table, it merges a new version of the table into its cache and notifies the dependent consumers
+ * @param Table The table
+ * @param Source The new version of the table
+ * @return The number of changed, added and removed rows
+ */
+int32 UBMDataSubsystem::ReloadTable(EBMDataTable Table, const UDataTable* Source)
+{
+    if (!IsDataReady() || !Source || Table >= EBMDataTable::Count)
+    {
+        return 0;
+    }
+
+    const double Start = FPlatformTime::Seconds();
+
+    FBMDataDelta Delta;
+    Delta.Table = Table;
+    switch (Table)
+    {
+    case EBMDataTable::Skill: SkillRows.ApplyDelta(Source, Delta); break;
+    case EBMDataTable::Scene: SceneRows.ApplyDelta(Source, Delta); break;
+    case EBMDataTable::Enemy: EnemyRows.ApplyDelta(Source, Delta); break;
+    case EBMDataTable::Item: ItemRows.ApplyDelta(Source, Delta); break;
+    case EBMDataTable::Projectile: ProjectileRows.ApplyDelta(Source, Delta); break;
+    case EBMDataTable::PlayerGrowth: ApplyGrowthDelta(Source, Delta); break;
+    case EBMDataTable::Element:
+        ElementRows.ApplyDelta(Source, Delta);
+        if (!Delta.IsEmpty())
+        {
+            RebuildElementMatrix();
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (Delta.IsEmpty())
+    {
+        return 0;
+    }
+
+    // 只通知依赖变化行的消费者；行数组搬迁时该表的全部订阅者都要重新取指针
+    TArray<FName> RowsToNotify;
+    TMap<FName, FOnBMDataRowChanged>& Subscribers = RowSubscribers[static_cast<int32>(Table)];
+    if (Delta.bRowsMoved)
+    {
+        Subscribers.GetKeys(RowsToNotify);
+    }
+    else
+    {
+        RowsToNotify.Append(Delta.ChangedRows);
+        RowsToNotify.Append(Delta.AddedRows);
+        RowsToNotify.Append(Delta.RemovedRows);
+    }
+
+    int32 NumNotified = 0;
+    for (const FName& RowName : RowsToNotify)
+    {
+        // 回调中可能订阅其他行导致映射扩容，广播副本
+        if (const FOnBMDataRowChanged* RowDelegate = Subscribers.Find(RowName))
+        {
+            if (RowDelegate->IsBound())
+            {
+                const FOnBMDataRowChanged Callbacks = *RowDelegate;
+                Callbacks.Broadcast(Table, RowName);
+                ++NumNotified;
+            }
+        }
+    }
+
+    OnDataDelta.Broadcast(Delta);
+
+    const int32 NumRows = Delta.ChangedRows.Num() + Delta.AddedRows.Num() + Delta.RemovedRows.Num();
+    UE_LOG(LogBMData, Log, TEXT("Hot reload %s: %d changed, %d added, %d removed%s; %d rows with subscribers notified in %.2f ms."),
+        GetTableLabel(Table), Delta.ChangedRows.Num(), Delta.AddedRows.Num(), Delta.RemovedRows.Num(),
+        Delta.bRowsMoved ? TEXT(" (rows moved)") : TEXT(""), NumNotified, (FPlatformTime::Seconds() - Start) * 1000.0);
+    return NumRows;
+}
+
+/*
+ * @brief Apply growth delta, it updates changed levels in place and reindexes only when levels are added or removed
+ * @param Source The new version of the growth table
+ * @param OutDelta The delta
+ */
+void UBMDataSubsystem::ApplyGrowthDelta(const UDataTable* Source, FBMDataDelta& OutDelta)
+{
+    if (!Source || !Source->GetRowStruct() || !Source->GetRowStruct()->IsChildOf(FBMPlayerGrowthData::StaticStruct())) return;
+
+    const FBMDataBlob::FRowComparer Comparer(FBMPlayerGrowthData::StaticStruct());
+    const TMap<FName, uint8*>& RowMap = Source->GetRowMap();
+
+    bool bReindex = false;
+    int32 NumSourceLevels = 0;
+    for (const TPair<FName, uint8*>& Pair : RowMap)
+    {
+        const FString RowString = Pair.Key.ToString();
+        if (!RowString.IsNumeric()) continue;
+        const int32 Level = FCString::Atoi(*RowString);
+        if (Level < 0) continue;
+        ++NumSourceLevels;
+
+        const FBMPlayerGrowthData& NewRow = *reinterpret_cast<const FBMPlayerGrowthData*>(Pair.Value);
+        const int32 Index = GrowthIndexByLevel.IsValidIndex(Level) ? GrowthIndexByLevel[Level] : INDEX_NONE;
+        if (Index == INDEX_NONE)
+        {
+            OutDelta.AddedRows.Add(Pair.Key);
+            bReindex = true;
+        }
+        else if (!Comparer.Equals(&GrowthRows[Index], &NewRow))
+        {
+            GrowthRows[Index] = NewRow;
+            OutDelta.ChangedRows.Add(Pair.Key);
+        }
+    }
+
+    if (bReindex || NumSourceLevels != GrowthRows.Num())
+    {
+        for (int32 Level = 0; Level < GrowthIndexByLevel.Num(); ++Level)
+        {
+            const FName LevelName(*FString::FromInt(Level));
+            if (GrowthIndexByLevel[Level] != INDEX_NONE && !RowMap.Contains(LevelName))
+            {
+                OutDelta.RemovedRows.Add(LevelName);
+                bReindex = true;
+            }
+        }
+    }
+
+    // 增删等级时重建等级索引（成长表很小），已有指针需要重新获取
+    if (bReindex)
+    {
+        TBMRowCache<FBMPlayerGrowthData> GrowthSource;
+        GrowthSource.Build(Source);
+        RebuildGrowthIndex(GrowthSource);
+        OutDelta.bRowsMoved = true;
+    }
+}
+
+/*
+ * @brief Poll source CSVs, it reimports the CSVs that changed and merges their rows
+ * @param bForce Reimport every CSV regardless of its timestamp
+ * @return The number of rows that changed
+ */
+int32 UBMDataSubsystem::PollSourceCsvs(bool bForce)
+{
+    int32 NumRows = 0;
+#if BM_DATA_HOT_RELOAD
+    for (FWatchedCsv& Csv : WatchedCsvs)
+    {
+        const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*Csv.Path);
+        if (TimeStamp == FDateTime::MinValue() || (!bForce && TimeStamp == Csv.TimeStamp))
+        {
+            continue;
+        }
+        Csv.TimeStamp = TimeStamp;
+
+        FString Text;
+        if (!FFileHelper::LoadFileToString(Text, *Csv.Path))
+        {
+            continue;
+        }
+
+        // 导入到临时表，再与缓存逐行比较
+        UDataTable* Imported = NewObject<UDataTable>(GetTransientPackage());
+        Imported->RowStruct = const_cast<UScriptStruct*>(GetTableRowStruct(Csv.Table));
+        for (const FString& Problem : Imported->CreateTableFromCSVString(Text))
+        {
+            UE_LOG(LogBMData, Warning, TEXT("Hot reload %s: %s"), *Csv.Path, *Problem);
+        }
+
+        NumRows += ReloadTable(Csv.Table, Imported);
+    }
+#endif
+    return NumRows;
+}
+
+#if BM_DATA_HOT_RELOAD
+/*
+ * @brief Start watching sources, it binds the loaded tables and records the source CSV timestamps
  */
-template <typename T>
-T* UBMDataSubsystem::FindRow(UDataTable* Table, FName RowName) const
+void UBMDataSubsystem::StartWatchingSources()
 {
-    if (!Table) return nullptr;
-    static const FString ContextString(TEXT("BMDataSubsystem Lookup"));
-    return Table->FindRow<T>(RowName, ContextString);
+    StopWatchingSources();
+
+    const UBMGameSettings* Settings = GetDefault<UBMGameSettings>();
+    const FString CsvDir = FPaths::ProjectContentDir() / TEXT("Data/Tables");
+    for (int32 i = 0; i < static_cast<int32>(EBMDataTable::Count); ++i)
+    {
+        const EBMDataTable Table = static_cast<EBMDataTable>(i);
+
+        // 编辑器内修改或重新导入表
+        if (UDataTable* Cache = GetTableCache(Table))
+        {
+            const FDelegateHandle Handle = Cache->OnDataTableChanged().AddUObject(this, &UBMDataSubsystem::HandleSourceTableChanged, Table);
+            TableChangedHandles.Emplace(Cache, Handle);
+        }
+
+        // 直接修改 CSV 源文件
+        const TSoftObjectPtr<UDataTable>* Setting = Settings ? GetTableSetting(Settings, Table) : nullptr;
+        const FString AssetName = Setting && !Setting->IsNull() ? Setting->GetAssetName() : (Table == EBMDataTable::Item ? FString(TEXT("DT_Items")) : FString());
+        if (AssetName.IsEmpty()) continue;
+
+        FWatchedCsv& Csv = WatchedCsvs.AddDefaulted_GetRef();
+        Csv.Table = Table;
+        Csv.Path = CsvDir / AssetName + TEXT(".csv");
+        Csv.TimeStamp = IFileManager::Get().GetTimeStamp(*Csv.Path);
+    }
+
+    const float PollSeconds = CVarBMDataHotReloadPoll.GetValueOnGameThread();
+    if (PollSeconds > 0.f)
+    {
+        SourcePollHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UBMDataSubsystem::TickSourcePoll), PollSeconds);
+    }
+}
+
+/*
+ * @brief Stop watching sources, it unbinds the tables and stops the CSV poll
+ */
+void UBMDataSubsystem::StopWatchingSources()
+{
+    for (const TPair<TWeakObjectPtr<UDataTable>, FDelegateHandle>& Binding : TableChangedHandles)
+    {
+        if (UDataTable* Table = Binding.Key.Get())
+        {
+            Table->OnDataTableChanged().Remove(Binding.Value);
+        }
+    }
+    TableChangedHandles.Reset();
+    WatchedCsvs.Reset();
+
+    if (SourcePollHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SourcePollHandle);
+        SourcePollHandle.Reset();
+    }
+}
+
+/*
+ * @brief Handle source table changed, it merges the edited or reimported table
+ * @param Table The table
+ */
+void UBMDataSubsystem::HandleSourceTableChanged(EBMDataTable Table)
+{
+    ReloadTable(Table, GetTableCache(Table));
+}
+
+/*
+ * @brief Tick source poll, it checks the source CSV timestamps
+ * @param DeltaTime The delta time
+ * @return True to keep ticking
+ */
+bool UBMDataSubsystem::TickSourcePoll(float DeltaTime)
+{
+    PollSourceCsvs(false);
+    return true;
+}
+#endif
+
+/*
+ * @brief Call or register on data ready, it runs the callback now or once the data is ready
+ * @param Callback The callback
+ * @return The handle of the registered callback, invalid when it ran at once
+ */
+FDelegateHandle UBMDataSubsystem::CallOrRegisterOnDataReady(FOnBMDataReady::FDelegate&& Callback)
+{
+    if (IsDataReady())
+    {
+        Callback.ExecuteIfBound();
+        return FDelegateHandle();
+    }
+    return OnDataReady.Add(MoveTemp(Callback));
+}
+
+/*
+ * @brief Wait for data, it blocks on the pending load and reports the caller that forced it
+ * @param Caller The accessor or system that needs the data now
+ */
+void UBMDataSubsystem::WaitForData(const TCHAR* Caller) const
+{
+    if (LoadState == EBMDataLoadState::Ready)
+    {
+        return;
+    }
+
+    UBMDataSubsystem* MutableThis = const_cast<UBMDataSubsystem*>(this);
+    ++MutableThis->NumForcedWaits;
+
+    UE_LOG(LogBMData, Warning, TEXT("%s forced a blocking load of the data tables %.1f ms after the request; use OnDataReady or CallOrRegisterOnDataReady instead."),
+        Caller ? Caller : TEXT("Unknown"), (FPlatformTime::Seconds() - LoadRequestTime) * 1000.0);
+#if !UE_BUILD_SHIPPING
+    FDebug::DumpStackTraceToLog(ELogVerbosity::Warning);
+#endif
+
+    const double WaitStart = FPlatformTime::Seconds();
+    if (MutableThis->LoadHandle.IsValid())
+    {
+        MutableThis->LoadHandle->WaitUntilComplete();
+    }
+    // 句柄完成时通常已回调；未回调（被取消或尚未请求）时在这里同步补齐
+    MutableThis->HandleTablesLoaded();
+    MutableThis->ForcedWaitSeconds += FPlatformTime::Seconds() - WaitStart;
+}
+
+/*
+ * @brief Rebuild row caches, it copies the loaded tables into the typed row caches
+ */
+void UBMDataSubsystem::RebuildRowCaches()
+{
+    SkillRows.Build(SkillTableCache);
+    SceneRows.Build(SceneTableCache);
+    ElementRows.Build(ElementTableCache);
+    EnemyRows.Build(EnemyTableCache);
+    ItemRows.Build(ItemTableCache);
+    ProjectileRows.Build(ProjectileTableCache);
+
+    TBMRowCache<FBMPlayerGrowthData> GrowthSource;
+    GrowthSource.Build(PlayerGrowthTableCache);
+    RebuildGrowthIndex(GrowthSource);
+
+    UE_LOG(LogBMData, Log, TEXT("Row caches built: %d skills, %d scenes, %d enemies, %d items, %d projectiles, %d growth levels."),
+        SkillRows.Num(), SceneRows.Num(), EnemyRows.Num(), ItemRows.Num(), ProjectileRows.Num(), GrowthRows.Num());
+}
+
+/*
+ * @brief Rebuild growth index, it sorts the player growth rows by level and indexes them
+ * @param Source The player growth rows by row name
+ */
+void UBMDataSubsystem::RebuildGrowthIndex(const TBMRowCache<FBMPlayerGrowthData>& Source)
+{
+    // 成长表行名即等级（"1"、"2"...），按等级排序后建立等级 -> 下标
+    GrowthRows.Reset();
+    GrowthIndexByLevel.Reset();
+
+    TArray<TPair<int32, const FBMPlayerGrowthData*>> ByLevel;
+    for (const TPair<FName, int32>& Pair : Source.IndexByName)
+    {
+        const FString RowString = Pair.Key.ToString();
+        if (!RowString.IsNumeric())
+        {
+            UE_LOG(LogBMData, Warning, TEXT("Player growth row '%s' is not a level number, skipped."), *RowString);
+            continue;
+        }
+        const int32 Level = FCString::Atoi(*RowString);
+        if (Level < 0) continue;
+        ByLevel.Emplace(Level, &Source.Rows[Pair.Value]);
+    }
+    ByLevel.Sort([](const TPair<int32, const FBMPlayerGrowthData*>& A, const TPair<int32, const FBMPlayerGrowthData*>& B) { return A.Key < B.Key; });
+
+    if (ByLevel.Num() > 0)
+    {
+        GrowthRows.Reserve(ByLevel.Num());
+        GrowthIndexByLevel.Init(INDEX_NONE, ByLevel.Last().Key + 1);
+        for (const TPair<int32, const FBMPlayerGrowthData*>& Entry : ByLevel)
+        {
+            GrowthIndexByLevel[Entry.Key] = GrowthRows.Add(*Entry.Value);
+        }
+    }
+}
+
+/*
+ * @brief Get the item table path debug, it gets the item table path debug
+ * @return The item table path debug
+ */
+FString UBMDataSubsystem::GetItemTablePathDebug() const
+{
+    EnsureDataReady(TEXT("GetItemTablePathDebug"));
+	return LoadedBlobPath.IsEmpty() ? GetPathNameSafe(ItemTableCache) : LoadedBlobPath;
 }
 
 /*
@@ -66,7 +888,8 @@ T* UBMDataSubsystem::FindRow(UDataTable* Table, FName RowName) const
  */
 const FBMSkillData* UBMDataSubsystem::GetSkillData(FName SkillID) const
 {
-    return FindRow<FBMSkillData>(SkillTableCache, SkillID);
+    EnsureDataReady(TEXT("GetSkillData"));
+    return SkillRows.Find(SkillID);
 }
 
 /*
@@ -76,7 +899,8 @@ const FBMSkillData* UBMDataSubsystem::GetSkillData(FName SkillID) const
  */
 const FBMSceneData* UBMDataSubsystem::GetSceneData(FName SceneID) const
 {
-    return FindRow<FBMSceneData>(SceneTableCache, SceneID);
+    EnsureDataReady(TEXT("GetSceneData"));
+    return SceneRows.Find(SceneID);
 }
 
 /*
@@ -86,7 +910,8 @@ const FBMSceneData* UBMDataSubsystem::GetSceneData(FName SceneID) const
  */
 const FBMPlayerGrowthData* UBMDataSubsystem::GetPlayerGrowthData(int32 Level) const
 {
-    return FindRow<FBMPlayerGrowthData>(PlayerGrowthTableCache, *FString::FromInt(Level));
+    EnsureDataReady(TEXT("GetPlayerGrowthData"));
+    return GrowthIndexByLevel.IsValidIndex(Level) && GrowthIndexByLevel[Level] != INDEX_NONE ? &GrowthRows[GrowthIndexByLevel[Level]] : nullptr;
 }
 
 /*
@@ -96,7 +921,8 @@ const FBMPlayerGrowthData* UBMDataSubsystem::GetPlayerGrowthData(int32 Level) co
  */
 const FBMEnemyData* UBMDataSubsystem::GetEnemyData(FName EnemyID) const
 {
-    return FindRow<FBMEnemyData>(EnemyTableCache, EnemyID);
+    EnsureDataReady(TEXT("GetEnemyData"));
+    return EnemyRows.Find(EnemyID);
 }
 
 /*
@@ -106,39 +932,155 @@ const FBMEnemyData* UBMDataSubsystem::GetEnemyData(FName EnemyID) const
  */
 const FBMItemData* UBMDataSubsystem::GetItemData(FName ItemID) const
 {
-    return FindRow<FBMItemData>(ItemTableCache, ItemID);
+    EnsureDataReady(TEXT("GetItemData"));
+    return ItemRows.Find(ItemID);
+}
+
+/*
+ * @brief Get the projectile data, it gets the projectile data
+ * @param ProjectileID The projectile id
+ * @return The projectile data
+ */
+const FBMProjectileData* UBMDataSubsystem::GetProjectileData(FName ProjectileID) const
+{
+    EnsureDataReady(TEXT("GetProjectileData"));
+    return ProjectileRows.Find(ProjectileID);
 }
 
 /*
- * @brief Get the elemental multiplier, it gets the elemental multiplier
+ * @brief Get the elemental multiplier, it maps the names to elements and reads the matrix
  * @param AttackElement The attack element
  * @param DefendElement The defend element
- * @return The elemental multiplier
+ * @return The elemental multiplier, 1.0 for names that are not elements
  */
 float UBMDataSubsystem::GetElementalMultiplier(FName AttackElement, FName DefendElement) const
 {
-    // Attacker 
-    const FBMElementalData* Row = FindRow<FBMElementalData>(ElementTableCache, AttackElement);
-    if (!Row)
+    EnsureDataReady(TEXT("GetElementalMultiplier"));
+    int32 Attack = INDEX_NONE;
+    int32 Defend = INDEX_NONE;
+    for (int32 i = 0; i < NumElements; ++i)
+    {
+        if (ElementNames[i] == AttackElement) Attack = i;
+        if (ElementNames[i] == DefendElement) Defend = i;
+    }
+
+    if (Attack == INDEX_NONE || Defend == INDEX_NONE)
     {
         return 1.0f;
     }
+    return ElementMatrix[Attack][Defend];
+}
+
+/*
+ * @brief Rebuild element matrix, it compiles the element table into the multiplier matrix
+ */
+void UBMDataSubsystem::RebuildElementMatrix()
+{
+    const UEnum* ElementEnum = StaticEnum<EBMElementType>();
+    for (int32 i = 0; i < NumElements; ++i)
+    {
+        ElementNames[i] = ElementEnum ? FName(*ElementEnum->GetNameStringByValue(i)) : NAME_None;
+        for (int32 j = 0; j < NumElements; ++j)
+        {
+            ElementMatrix[i][j] = 1.0f;
+        }
+    }
+
+    if (ElementRows.Num() == 0)
+    {
+        UE_LOG(LogBMData, Warning, TEXT("Element table missing, every elemental multiplier is 1.0."));
+        return;
+    }
 
-    // Defender
+    // 每个防御元素对应的列属性只查找一次
     const UScriptStruct* Struct = FBMElementalData::StaticStruct();
+    const FFloatProperty* Columns[NumElements] = {};
+    for (int32 Defend = 0; Defend < NumElements; ++Defend)
+    {
+        Columns[Defend] = FindFProperty<FFloatProperty>(Struct, ElementNames[Defend]);
+    }
 
-    // Find the property corresponding to the defend element
-    const FFloatProperty* FloatProp = FindFProperty<FFloatProperty>(Struct, DefendElement);
+    // None 不要求有行或列，其余元素缺失时报告（按 1.0 处理，与反射查找一致）
+    const int32 NoneIndex = static_cast<int32>(EBMElementType::None);
+    int32 NumMissing = 0;
+    for (int32 Defend = 0; Defend < NumElements; ++Defend)
+    {
+        if (!Columns[Defend] && Defend != NoneIndex)
+        {
+            UE_LOG(LogBMData, Warning, TEXT("FBMElementalData has no column for %s, attacks against it stay 1.0."), *ElementNames[Defend].ToString());
+            NumMissing += NumElements - 1;
+        }
+    }
 
-    // Return the multiplier value
-    if (FloatProp)
+    for (int32 Attack = 0; Attack < NumElements; ++Attack)
     {
-        return FloatProp->GetFloatingPointPropertyValue(FloatProp->ContainerPtrToValuePtr<void>(Row));
+        const FBMElementalData* Row = ElementRows.Find(ElementNames[Attack]);
+        if (!Row)
+        {
+            if (Attack != NoneIndex)
+            {
+                UE_LOG(LogBMData, Warning, TEXT("Element table has no row for %s, its multipliers stay 1.0."), *ElementNames[Attack].ToString());
+                NumMissing += NumElements - 1;
+            }
+            continue;
+        }
+
+        for (int32 Defend = 0; Defend < NumElements; ++Defend)
+        {
+            if (Columns[Defend])
+            {
+                ElementMatrix[Attack][Defend] = Columns[Defend]->GetFloatingPointPropertyValue(Columns[Defend]->ContainerPtrToValuePtr<void>(Row));
+            }
+        }
     }
-    // If property not found, log a warning and return default multiplier
-    else
+
+    UE_LOG(LogBMData, Log, TEXT("Element matrix built: %d x %d, %d missing pairs."), NumElements, NumElements, NumMissing);
+
+}
+
+/*
+ * @brief Run lookup benchmark, it times UDataTable::FindRow against the row caches for every row of each table
+ * @param Iterations The number of passes over the rows of each table
+ */
+void UBMDataSubsystem::RunLookupBenchmark(int32 Iterations) const
+{
+    EnsureDataReady(TEXT("bm.Data.Bench"));
+    BenchTable<FBMSkillData>(TEXT("Skill"), SkillTableCache, [this](FName Name) { return GetSkillData(Name); }, Iterations);
+    BenchTable<FBMSceneData>(TEXT("Scene"), SceneTableCache, [this](FName Name) { return GetSceneData(Name); }, Iterations);
+    BenchTable<FBMEnemyData>(TEXT("Enemy"), EnemyTableCache, [this](FName Name) { return GetEnemyData(Name); }, Iterations);
+    BenchTable<FBMItemData>(TEXT("Item"), ItemTableCache, [this](FName Name) { return GetItemData(Name); }, Iterations);
+    BenchTable<FBMProjectileData>(TEXT("Projectile"), ProjectileTableCache, [this](FName Name) { return GetProjectileData(Name); }, Iterations);
+
+    // 成长表按原来的方式构造行名字符串再查表，与按等级下标取行比较
+    if (PlayerGrowthTableCache && GrowthIndexByLevel.Num() > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Elemental Multiplier not found for Defense: %s"), *DefendElement.ToString());
-        return 1.0f;
+        const FString ContextString(TEXT("BMDataSubsystem Lookup"));
+        const int32 MaxLevel = GrowthIndexByLevel.Num() - 1;
+        uintptr_t Sink = 0;
+
+        const double TableStart = FPlatformTime::Seconds();
+        for (int32 It = 0; It < Iterations; ++It)
+        {
+            for (int32 Level = 0; Level <= MaxLevel; ++Level)
+            {
+                Sink += reinterpret_cast<uintptr_t>(PlayerGrowthTableCache->FindRow<FBMPlayerGrowthData>(*FString::FromInt(Level), ContextString, false));
+            }
+        }
+        const double TableSeconds = FPlatformTime::Seconds() - TableStart;
+
+        const double CacheStart = FPlatformTime::Seconds();
+        for (int32 It = 0; It < Iterations; ++It)
+        {
+            for (int32 Level = 0; Level <= MaxLevel; ++Level)
+            {
+                Sink += reinterpret_cast<uintptr_t>(GetPlayerGrowthData(Level));
+            }
+        }
+        const double CacheSeconds = FPlatformTime::Seconds() - CacheStart;
+
+        const double Lookups = (double)Iterations * (MaxLevel + 1);
+        UE_LOG(LogBMData, Log, TEXT("bm.Data.Bench: %-12s %4d rows, FindRow %7.1f ns, cache %7.1f ns, x%.1f (sink %llu)"),
+            TEXT("Growth"), GrowthRows.Num(), TableSeconds * 1e9 / Lookups, CacheSeconds * 1e9 / Lookups,
+            CacheSeconds > 0.0 ? TableSeconds / CacheSeconds : 0.0, (uint64)(Sink & 0xff));
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,78 @@
+#include "Core/BMTagRegistry.h"
+
+DEFINE_LOG_CATEGORY(LogBMTagRegistry);
+
+/*
+ * @brief Constructor of the FBMTagRegistry class, it registers the predefined gameplay tags
+ */
+FBMTagRegistry::FBMTagRegistry()
+{
+    TagNames.Reserve(MaxTags);
+    TagToIndex.Reserve(MaxTags);
+
+    FindOrAddTag(BMGameplayTags::Boss);
+}
+
+/*
+ * @brief Get the tag registry
+ * @return The tag registry
+ */
+FBMTagRegistry& FBMTagRegistry::Get()
+{
+    static FBMTagRegistry Registry;
+    return Registry;
+}
+
+/*
+ * @brief Find or add tag, it finds the bit index of the tag and registers it if missing
+ * @param Tag The tag
+ * @return The bit index, INDEX_NONE if the tag is none or the registry is full
+ */
+int32 FBMTagRegistry::FindOrAddTag(FName Tag)
+{
+    if (Tag.IsNone())
+    {
+        return INDEX_NONE;
+    }
+
+    if (const int32* Found = TagToIndex.Find(Tag))
+    {
+        return *Found;
+    }
+
+    if (TagNames.Num() >= MaxTags)
+    {
+        UE_LOG(LogBMTagRegistry, Error, TEXT("Tag registry is full (%d), cannot register '%s'."), MaxTags, *Tag.ToString());
+        return INDEX_NONE;
+    }
+
+    const int32 Index = TagNames.Add(Tag);
+    TagToIndex.Add(Tag, Index);
+    return Index;
+}
+
+/*
+ * @brief Find tag, it finds the bit index of the tag
+ * @param Tag The tag
+ * @return The bit index, INDEX_NONE if the tag is not registered
+ */
+int32 FBMTagRegistry::FindTag(FName Tag) const
+{
+    const int32* Found = Tag.IsNone() ? nullptr : TagToIndex.Find(Tag);
+    return Found ? *Found : INDEX_NONE;
+}
+
+/*
+ * @brief Make tag bits, it builds the bit set of the tags and registers the missing ones
+ * @param Tags The tags
+ * @return The tag bits
+ */
+FBMTagBits FBMTagRegistry::MakeTagBits(const TArray<FName>& Tags)
+{
+    FBMTagBits Result;
+    for (const FName& Tag : Tags)
+    {
+        Result.Add(FBMTagBits::FromIndex(FindOrAddTag(Tag)));
+    }
+    return Result;
+}
@@ -0,0 +1,621 @@
+#include "System/BMProjectileSubsystem.h"
+
+#include "Character/BMCharacterBase.h"
+#include "Character/Components/BMStatsComponent.h"
+#include "Character/Components/BMHurtBoxComponent.h"
+#include "Character/Components/BMCombatComponent.h"
+#include "Core/BMDataSubsystem.h"
+#include "Core/BMTagRegistry.h"
+
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY(LogBMProjectile);
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Tick"), STAT_BMProjectileTick, STATGROUP_BMCombat);
+DECLARE_CYCLE_STAT(TEXT("Projectile Visuals"), STAT_BMProjectileVisuals, STATGROUP_BMCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Live"), STAT_BMProjectilesLive, STATGROUP_BMCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectile Hits"), STAT_BMProjectileHits, STATGROUP_BMCombat);
+
+namespace
+{
+    // 角色包围球在胶囊半高之外的外扩量（覆盖伸出胶囊的肢体）
+    static constexpr float TargetBoundsPadding = 30.f;
+
+    // 压测用的内置类型（无网格，仅模拟）
+    static const FName StressTypeId = TEXT("BM_StressTest");
+
+    /*
+     * @brief Stress projectiles, it spawns projectiles around the player and optionally runs synthetic ticks to measure the simulation cost
+     * @param Args The command arguments: <Count> [Ticks]
+     * @param World The world
+     */
+    static void StressProjectiles(const TArray<FString>& Args, UWorld* World)
+    {
+        UBMProjectileSubsystem* Projectiles = World ? World->GetSubsystem<UBMProjectileSubsystem>() : nullptr;
+        if (!Projectiles)
+        {
+            UE_LOG(LogBMProjectile, Warning, TEXT("bm.Projectile.Stress: no projectile subsystem in this world."));
+            return;
+        }
+
+        const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 2000;
+        const int32 Ticks = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+
+        FBMProjectileData StressType;
+        StressType.Speed = 1200.f;
+        StressType.LifeSeconds = 10.f;
+        StressType.BaseDamage = 1.f;
+        StressType.bCollideWithWorld = true;
+        Projectiles->RegisterProjectileType(StressTypeId, StressType);
+
+        const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+        const FVector Origin = Player ? Player->GetActorLocation() + FVector(0.f, 0.f, 200.f) : FVector::ZeroVector;
+
+        int32 Spawned = 0;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            Spawned += Projectiles->SpawnProjectile(StressTypeId, nullptr, Origin, FMath::VRand()) ? 1 : 0;
+        }
+
+        UE_LOG(LogBMProjectile, Log, TEXT("bm.Projectile.Stress: spawned %d/%d, live %d."), Spawned, Count, Projectiles->GetLiveProjectileCount());
+
+        if (Ticks <= 0)
+        {
+            return;
+        }
+
+        // 无渲染压测：以固定步长同步推进，统计每帧模拟耗时
+        const double Start = FPlatformTime::Seconds();
+        for (int32 t = 0; t < Ticks; ++t)
+        {
+            Projectiles->Tick(1.f / 60.f);
+        }
+        const double ElapsedUs = (FPlatformTime::Seconds() - Start) * 1e6;
+
+        UE_LOG(LogBMProjectile, Log, TEXT("bm.Projectile.Stress: %d ticks, %.1f us/tick, %d live at end."),
+            Ticks, ElapsedUs / Ticks, Projectiles->GetLiveProjectileCount());
+
+        Projectiles->ClearAllProjectiles();
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMProjectileStressCommand(
+        TEXT("bm.Projectile.Stress"),
+        TEXT("bm.Projectile.Stress <Count> [Ticks]: spawn Count projectiles around the player; with Ticks, run that many synthetic 60Hz ticks and log the cost per tick."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StressProjectiles));
+}
+
+/*
+ * @brief Initialize, it initializes the projectile subsystem
+ * @param Collection The collection
+ */
+void UBMProjectileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Types.Reset();
+    TypeIndexById.Reset();
+    ClearAllProjectiles();
+
+    UE_LOG(LogBMProjectile, Log, TEXT("[BMProjectileSubsystem] Initialized"));
+}
+
+/*
+ * @brief Deinitialize, it clears the projectiles and destroys the visual host
+ */
+void UBMProjectileSubsystem::Deinitialize()
+{
+    ClearAllProjectiles();
+
+    if (VisualHost)
+    {
+        VisualHost->Destroy();
+        VisualHost = nullptr;
+    }
+
+    Types.Reset();
+    TypeIndexById.Reset();
+
+    UE_LOG(LogBMProjectile, Log, TEXT("[BMProjectileSubsystem] Deinitialized"));
+
+    Super::Deinitialize();
+}
+
+/*
+ * @brief Does support world type, it only runs in game worlds
+ * @param WorldType The world type
+ * @return True if the world type is supported, false otherwise
+ */
+bool UBMProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/*
+ * @brief Get stat id, it gets the stat id of the tickable subsystem
+ * @return The stat id
+ */
+TStatId UBMProjectileSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UBMProjectileSubsystem, STATGROUP_Tickables);
+}
+
+/*
+ * @brief Spawn projectile, it appends a projectile to the simulation arrays
+ * @param TypeId The projectile type id
+ * @param Instigator The instigator
+ * @param Location The spawn location
+ * @param Direction The flight direction
+ * @param DamageOverride The damage override, negative to use the type config
+ * @return True if the projectile is spawned, false otherwise
+ */
+bool UBMProjectileSubsystem::SpawnProjectile(FName TypeId, ABMCharacterBase* Instigator, const FVector& Location, const FVector& Direction, float DamageOverride)
+{
+    if (Positions.Num() >= MaxLiveProjectiles)
+    {
+        UE_LOG(LogBMProjectile, Verbose, TEXT("Projectile '%s' dropped: live limit %d reached."), *TypeId.ToString(), MaxLiveProjectiles);
+        return false;
+    }
+
+    const int32 TypeIndex = ResolveType(TypeId);
+    if (TypeIndex == INDEX_NONE)
+    {
+        UE_LOG(LogBMProjectile, Warning, TEXT("Projectile type '%s' not found."), *TypeId.ToString());
+        return false;
+    }
+
+    const FBMProjectileData& Data = Types[TypeIndex].Data;
+
+    float Damage = DamageOverride;
+    if (Damage < 0.f)
+    {
+        Damage = Data.BaseDamage;
+        if (Damage <= 0.f && Instigator)
+        {
+            if (const UBMStatsComponent* S = Instigator->GetStats())
+            {
+                Damage = S->GetStatBlock().Attack * S->GetAttackMultiplier();
+            }
+        }
+        Damage *= Data.DamageMult;
+    }
+
+    Positions.Add(Location);
+    Velocities.Add(Direction.GetSafeNormal() * Data.Speed);
+    RemainingLife.Add(Data.LifeSeconds);
+    Damages.Add(Damage);
+    TypeIndices.Add(TypeIndex);
+    RemainingHits.Add(FMath::Max(1, Data.MaxHits));
+    Teams.Add(Instigator ? Instigator->Team : EBMTeam::Neutral);
+    Instigators.Add(Instigator);
+    TArray<TWeakObjectPtr<ABMCharacterBase>>& Victims = HitVictims.Add_GetRef(
+        FreeVictimLists.Num() > 0 ? FreeVictimLists.Pop(EAllowShrinking::No) : TArray<TWeakObjectPtr<ABMCharacterBase>>());
+    Victims.Reserve(RemainingHits.Last());
+    WorldTraces.Add(FTraceHandle());
+
+    return true;
+}
+
+/*
+ * @brief Register projectile type, it registers or overrides a projectile type from code
+ * @param TypeId The type id
+ * @param Data The type config
+ */
+void UBMProjectileSubsystem::RegisterProjectileType(FName TypeId, const FBMProjectileData& Data)
+{
+    if (const int32* Existing = TypeIndexById.Find(TypeId))
+    {
+        FBMProjectileType& Type = Types[*Existing];
+        Type.Data = Data;
+        if (!Type.Visual.IsValid())
+        {
+            CreateVisual(Type);
+        }
+        return;
+    }
+
+    const int32 Index = Types.AddDefaulted();
+    FBMProjectileType& Type = Types[Index];
+    Type.Id = TypeId;
+    Type.Data = Data;
+    CreateVisual(Type);
+
+    TypeIndexById.Add(TypeId, Index);
+}
+
+/*
+ * @brief Resolve type, it finds the projectile type or resolves it from the projectile data table once
+ * @param TypeId The type id
+ * @return The type index, INDEX_NONE if not found
+ */
+int32 UBMProjectileSubsystem::ResolveType(FName TypeId)
+{
+    if (const int32* Found = TypeIndexById.Find(TypeId))
+    {
+        return *Found;
+    }
+
+    const UWorld* World = GetWorld();
+    const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+    const UBMDataSubsystem* DataSubsystem = GI ? GI->GetSubsystem<UBMDataSubsystem>() : nullptr;
+    const FBMProjectileData* Row = DataSubsystem ? DataSubsystem->GetProjectileData(TypeId) : nullptr;
+    if (!Row)
+    {
+        return INDEX_NONE;
+    }
+
+    RegisterProjectileType(TypeId, *Row);
+    return TypeIndexById.FindChecked(TypeId);
+}
+
+/*
+ * @brief Create visual, it creates the instanced static mesh component of the projectile type
+ * @param Type The projectile type
+ */
+void UBMProjectileSubsystem::CreateVisual(FBMProjectileType& Type)
+{
+    UWorld* World = GetWorld();
+    UStaticMesh* Mesh = Type.Data.MeshPath.IsNull() ? nullptr : Type.Data.MeshPath.LoadSynchronous();
+    if (!World || !Mesh)
+    {
+        return;
+    }
+
+    if (!VisualHost)
+    {
+        FActorSpawnParameters Params;
+        Params.ObjectFlags |= RF_Transient;
+        Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        VisualHost = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+        if (!VisualHost)
+        {
+            return;
+        }
+
+        USceneComponent* Root = NewObject<USceneComponent>(VisualHost, TEXT("Root"));
+        VisualHost->SetRootComponent(Root);
+        Root->RegisterComponent();
+    }
+
+    const FName CompName = MakeUniqueObjectName(VisualHost, UInstancedStaticMeshComponent::StaticClass(), *FString::Printf(TEXT("BM_Projectile_%s"), *Type.Id.ToString()));
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(VisualHost, CompName);
+    ISM->SetStaticMesh(Mesh);
+    ISM->SetMobility(EComponentMobility::Movable);
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->SetGenerateOverlapEvents(false);
+    ISM->SetCastShadow(false);
+    ISM->SetupAttachment(VisualHost->GetRootComponent());
+    VisualHost->AddInstanceComponent(ISM);
+    ISM->RegisterComponent();
+
+    Type.Visual = ISM;
+    Type.UsedInstances = 0;
+}
+
+/*
+ * @brief Clear all projectiles, it removes every live projectile and hides their instances
+ */
+void UBMProjectileSubsystem::ClearAllProjectiles()
+{
+    Positions.Reset();
+    Velocities.Reset();
+    RemainingLife.Reset();
+    Damages.Reset();
+    TypeIndices.Reset();
+    RemainingHits.Reset();
+    Teams.Reset();
+    Instigators.Reset();
+    WorldTraces.Reset();
+
+    for (TArray<TWeakObjectPtr<ABMCharacterBase>>& Victims : HitVictims)
+    {
+        Victims.Reset();
+        FreeVictimLists.Add(MoveTemp(Victims));
+    }
+    HitVictims.Reset();
+
+    UpdateVisuals();
+}
+
+/*
+ * @brief Remove projectile, it swap removes a projectile so the arrays stay contiguous
+ * @param Index The projectile index
+ */
+void UBMProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+    Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    RemainingLife.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Damages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    TypeIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    RemainingHits.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Teams.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    // 命中列表连同容量归还池中
+    HitVictims[Index].Reset();
+    FreeVictimLists.Add(MoveTemp(HitVictims[Index]));
+    HitVictims.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    WorldTraces.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+/*
+ * @brief Gather targets, it collects the bounding spheres of all living characters once per tick
+ */
+void UBMProjectileSubsystem::GatherTargets()
+{
+    Targets.Reset();
+
+    for (TActorIterator<ABMCharacterBase> It(GetWorld()); It; ++It)
+    {
+        ABMCharacterBase* Character = *It;
+        const UBMStatsComponent* S = Character ? Character->GetStats() : nullptr;
+        if (!S || S->IsDead())
+        {
+            continue;
+        }
+
+        FBMProjectileTarget& Target = Targets.AddDefaulted_GetRef();
+        Target.Character = Character;
+        Target.Center = Character->GetActorLocation();
+        Target.Radius = Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + TargetBoundsPadding;
+        Target.Team = Character->Team;
+    }
+}
+
+/*
+ * @brief Tick, it integrates all projectiles, runs the batched sweep tests and updates the visuals
+ * @param DeltaTime The delta time
+ */
+void UBMProjectileSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SCOPE_CYCLE_COUNTER(STAT_BMProjectileTick);
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    if (Positions.Num() > 0)
+    {
+        GatherTargets();
+
+        const float GravityZ = World->GetGravityZ();
+        const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(BMProjectileWorld), false);
+
+        // 倒序遍历：交换删除时换过来的元素已处理过
+        for (int32 i = Positions.Num() - 1; i >= 0; --i)
+        {
+            if (i >= Positions.Num())
+            {
+                continue;
+            }
+
+            // 上一帧发出的场景射线：被静态几何阻挡则销毁
+            if (WorldTraces[i].IsValid())
+            {
+                FTraceDatum Datum;
+                if (World->QueryTraceData(WorldTraces[i], Datum) && Datum.OutHits.Num() > 0)
+                {
+                    RemoveProjectile(i);
+                    continue;
+                }
+            }
+
+            RemainingLife[i] -= DeltaTime;
+            if (RemainingLife[i] <= 0.f)
+            {
+                RemoveProjectile(i);
+                continue;
+            }
+
+            const int32 TypeIndex = TypeIndices[i];
+            Velocities[i].Z += GravityZ * Types[TypeIndex].Data.GravityScale * DeltaTime;
+
+            const FVector Start = Positions[i];
+            const FVector End = Start + Velocities[i] * DeltaTime;
+            Positions[i] = End;
+
+            if (SweepCharacters(i, Start, End))
+            {
+                RemoveProjectile(i);
+                continue;
+            }
+
+            // 场景阻挡走批量异步射线，结果在下一帧读取
+            WorldTraces[i] = Types[TypeIndex].Data.bCollideWithWorld
+                ? World->AsyncLineTraceByChannel(EAsyncTraceType::Test, Start, End, ECC_WorldStatic, TraceParams)
+                : FTraceHandle();
+        }
+    }
+
+    UpdateVisuals();
+
+    SET_DWORD_STAT(STAT_BMProjectilesLive, Positions.Num());
+}
+
+/*
+ * @brief Sweep characters, it tests the swept segment of a projectile against the character bounds and then the hurt boxes
+ * @param Index The projectile index
+ * @param Start The segment start
+ * @param End The segment end
+ * @return True if the projectile should be destroyed, false otherwise
+ */
+bool UBMProjectileSubsystem::SweepCharacters(int32 Index, const FVector& Start, const FVector& End)
+{
+    if (Targets.Num() == 0)
+    {
+        return false;
+    }
+
+    const float Radius = Types[TypeIndices[Index]].Data.Radius;
+    const uint8 HostileTeams = BMGameplayBits::HostileTeamsOf(Teams[Index]);
+    const ABMCharacterBase* Instigator = Instigators[Index].Get();
+
+    const FVector Segment = End - Start;
+    const float HalfLength = Segment.Size() * 0.5f;
+
+    // 扫掠体：沿飞行方向拉长的 OBB，与 HurtBox 走同一套 OBB 相交测试
+    const FTransform SweptToWorld(FRotationMatrix::MakeFromX(Segment).ToQuat(), (Start + End) * 0.5f);
+    const FVector SweptExtent(HalfLength + Radius, Radius, Radius);
+
+    for (const FBMProjectileTarget& Target : Targets)
+    {
+        if (Target.Character == Instigator) continue;
+        if (!(HostileTeams & BMGameplayBits::TeamBit(Target.Team))) continue;
+        if (HitVictims[Index].Contains(Target.Character)) continue;
+
+        // 粗筛：线段到包围球心的距离
+        const FVector Closest = FMath::ClosestPointOnSegment(Target.Center, Start, End);
+        if (FVector::DistSquared(Closest, Target.Center) > FMath::Square(Target.Radius + Radius)) continue;
+
+        ABMCharacterBase* Victim = Target.Character;
+
+        // 细筛：组件 HurtBox
+        UPrimitiveComponent* HitComp = nullptr;
+        for (const TObjectPtr<UBMHurtBoxComponent>& HB : Victim->GetHurtBoxes())
+        {
+            const UBoxComponent* Box = HB ? Cast<UBoxComponent>(HB->GetBoundComponent()) : nullptr;
+            if (!Box || !HB->IsHurtBoxEnabled()) continue;
+
+            if (BMHurtBoxUtils::OverlapOBB(SweptToWorld, SweptExtent, Box->GetComponentTransform(), Box->GetUnscaledBoxExtent()))
+            {
+                HitComp = HB->GetBoundComponent();
+                break;
+            }
+        }
+
+        int32 VirtualIndex = INDEX_NONE;
+        FVector HitLocation = Closest;
+        if (HitComp)
+        {
+            HitLocation = HitComp->GetComponentLocation();
+        }
+        else if (Victim->HasVirtualHurtBoxes())
+        {
+            // 细筛：虚拟 HurtBox（骨骼空间 OBB）
+            FTransform HurtToWorld;
+            VirtualIndex = Victim->FindOverlappingVirtualHurtBox(SweptToWorld, SweptExtent, &HurtToWorld);
+            if (VirtualIndex == INDEX_NONE) continue;
+
+            HitComp = Victim->GetVirtualHurtBoxProxy();
+            HitLocation = HurtToWorld.GetLocation();
+        }
+        else if (Victim->GetHurtBoxes().Num() > 0)
+        {
+            // 配置了组件 HurtBox 但都未命中（或已关闭，如闪避无敌帧）
+            continue;
+        }
+
+        ApplyHit(Index, Victim, HitComp, VirtualIndex, HitLocation);
+        HitVictims[Index].Add(Victim);
+
+        if (--RemainingHits[Index] <= 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * @brief Apply hit, it builds the damage info and settles it through the shared hurt box damage path
+ * @param Index The projectile index
+ * @param Victim The victim
+ * @param HitComp The hit hurt box component
+ * @param VirtualHurtBoxIndex The hit virtual hurt box index
+ * @param HitLocation The hit location
+ */
+void UBMProjectileSubsystem::ApplyHit(int32 Index, ABMCharacterBase* Victim, UPrimitiveComponent* HitComp, int32 VirtualHurtBoxIndex, const FVector& HitLocation)
+{
+    const FBMProjectileData& Data = Types[TypeIndices[Index]].Data;
+
+    FBMDamageInfo Info;
+    Info.InstigatorActor = Instigators[Index].Get();
+    Info.TargetActor = Victim;
+    Info.RawDamageValue = Damages[Index];
+    Info.DamageValue = Damages[Index];
+    Info.DamageType = Data.DamageType;
+    Info.ElementType = Data.ElementType;
+    Info.HitReaction = Data.HitReaction;
+    Info.HitComponent = HitComp;
+    Info.VirtualHurtBoxIndex = VirtualHurtBoxIndex;
+    Info.HitLocation = HitLocation;
+    Info.HitNormal = -Velocities[Index].GetSafeNormal();
+
+    INC_DWORD_STAT(STAT_BMProjectileHits);
+
+    Victim->TakeDamageFromHit(Info);
+}
+
+/*
+ * @brief Update visuals, it writes the transforms of every projectile type into its pooled instances in one batch
+ */
+void UBMProjectileSubsystem::UpdateVisuals()
+{
+    SCOPE_CYCLE_COUNTER(STAT_BMProjectileVisuals);
+
+    for (FBMProjectileType& Type : Types)
+    {
+        Type.VisualScratch.Reset();
+    }
+
+    // 投射物只遍历一次，按类型分桶
+    for (int32 i = 0; i < Positions.Num(); ++i)
+    {
+        FBMProjectileType& Type = Types[TypeIndices[i]];
+        if (Type.Visual.IsValid())
+        {
+            Type.VisualScratch.Emplace(Velocities[i].Rotation(), Positions[i], FVector(Type.Data.MeshScale));
+        }
+    }
+
+    for (FBMProjectileType& Type : Types)
+    {
+        UInstancedStaticMeshComponent* ISM = Type.Visual.Get();
+        if (!ISM)
+        {
+            continue;
+        }
+
+        TArray<FTransform>& VisualScratch = Type.VisualScratch;
+        const int32 Used = VisualScratch.Num();
+        if (Used == 0 && Type.UsedInstances == 0)
+        {
+            continue;
+        }
+
+        // 上一帧用过、本帧空闲的实例缩放为 0 隐藏，留在池中复用
+        for (int32 i = Used; i < Type.UsedInstances; ++i)
+        {
+            VisualScratch.Emplace(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+        }
+
+        // 池不足时扩容（实例只增不删）
+        const int32 PoolSize = ISM->GetInstanceCount();
+        if (VisualScratch.Num() > PoolSize)
+        {
+            const TArray<FTransform> NewInstances(VisualScratch.GetData() + PoolSize, VisualScratch.Num() - PoolSize);
+            ISM->AddInstances(NewInstances, false, true);
+        }
+
+        const int32 UpdateCount = FMath::Min(PoolSize, VisualScratch.Num());
+        if (UpdateCount > 0)
+        {
+            ISM->BatchUpdateInstancesTransforms(0, MakeArrayView(VisualScratch.GetData(), UpdateCount), true, true, true);
+        }
+
+        Type.UsedInstances = Used;
+    }
+}
@@ -0,0 +1,647 @@
+#include "System/BMStatusEffectSubsystem.h"
+
+#include "Character/BMCharacterBase.h"
+#include "Character/Components/BMStatsComponent.h"
+#include "Character/Components/BMCombatComponent.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogBMStatusEffect);
+
+DECLARE_CYCLE_STAT(TEXT("Status Effect Tick"), STAT_BMStatusEffectTick, STATGROUP_BMCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Status Effects Live"), STAT_BMStatusEffectsLive, STATGROUP_BMCombat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Status Effect Ticks"), STAT_BMStatusEffectTicks, STATGROUP_BMCombat);
+
+namespace
+{
+    /*
+     * @brief Apply stress effects, it spreads pairs of damage and healing effects with staggered periods and durations over the characters
+     * @param StatusEffects The status effect subsystem
+     * @param Characters The target characters
+     * @param Count The number of effects
+     * @return The number of effects applied
+     */
+    static int32 ApplyStressEffects(UBMStatusEffectSubsystem& StatusEffects, TConstArrayView<ABMCharacterBase*> Characters, int32 Count)
+    {
+        // 数值非零，每次结算都真正走受击/回复路径；同一目标上的伤害与回复成对、周期相同，生命值大致持平
+        // 周期与时长错开，让事件分散到各层时间轮
+        FBMStatusEffectSpec Spec;
+        Spec.MagnitudePerTick = 1.f;
+
+        int32 Applied = 0;
+        for (int32 i = 0; i < Count; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                Spec.Period = FMath::FRandRange(0.1f, 2.f);
+                Spec.Duration = FMath::FRandRange(1.f, 300.f);
+            }
+            Spec.EffectId = FName(TEXT("BM_Stress"), i);
+            Spec.bHeal = (i % 2) != 0;
+            Applied += StatusEffects.ApplyStatusEffect(Characters[(i / 2) % Characters.Num()], Spec) ? 1 : 0;
+        }
+        return Applied;
+    }
+
+    /*
+     * @brief Stress status effects, it spreads effects over the characters in the world and optionally runs synthetic ticks to measure the scheduling cost
+     * @param Args The command arguments: <Count> [Ticks]
+     * @param World The world
+     */
+    static void StressStatusEffects(const TArray<FString>& Args, UWorld* World)
+    {
+        UBMStatusEffectSubsystem* StatusEffects = World ? World->GetSubsystem<UBMStatusEffectSubsystem>() : nullptr;
+        if (!StatusEffects)
+        {
+            UE_LOG(LogBMStatusEffect, Warning, TEXT("bm.StatusEffect.Stress: no status effect subsystem in this world."));
+            return;
+        }
+
+        const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+        const int32 Ticks = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+
+        TArray<ABMCharacterBase*> Characters;
+        for (TActorIterator<ABMCharacterBase> It(World); It; ++It)
+        {
+            Characters.Add(*It);
+        }
+        if (Characters.Num() == 0)
+        {
+            UE_LOG(LogBMStatusEffect, Warning, TEXT("bm.StatusEffect.Stress: no characters in this world."));
+            return;
+        }
+
+        // 不推进：效果留在实时状态中，随真实帧观察 stat BMCombat
+        if (Ticks <= 0)
+        {
+            const int32 Applied = ApplyStressEffects(*StatusEffects, Characters, Count);
+            UE_LOG(LogBMStatusEffect, Log, TEXT("bm.StatusEffect.Stress: applied %d/%d on %d characters, live %d."),
+                Applied, Count, Characters.Num(), StatusEffects->GetActiveEffectCount());
+            return;
+        }
+
+        // 同步推进在独立的调度状态上进行，不改变实时效果与时钟
+        const FBMStatusEffectStressResult Result = StatusEffects->RunIsolatedStress(Characters, Count, Ticks);
+        UE_LOG(LogBMStatusEffect, Log, TEXT("bm.StatusEffect.Stress: %d effects on %d characters, %d ticks, %d settled, avg %.1f / p99 %.1f / max %.1f us per tick, budget %.1f us (isolated, live %d untouched)."),
+            Count, Characters.Num(), Ticks, Result.SettledTicks, Result.AverageMicroseconds, Result.P99Microseconds, Result.MaxMicroseconds,
+            StatusEffects->TickBudgetMicroseconds, StatusEffects->GetActiveEffectCount());
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMStatusEffectStressCommand(
+        TEXT("bm.StatusEffect.Stress"),
+        TEXT("bm.StatusEffect.Stress <Count> [Ticks]: apply Count paired damage/heal effects (1 per tick) spread over the characters; with Ticks, run that many synthetic 60Hz ticks on a separate scheduler state and log the cost per tick against TickBudgetMicroseconds."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StressStatusEffects));
+}
+
+/*
+ * @brief Initialize, it initializes the status effect subsystem
+ * @param Collection The collection
+ */
+void UBMStatusEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    SimTime = 0.0;
+    CurrentTick = 0;
+    ClearAllStatusEffects();
+
+    UE_LOG(LogBMStatusEffect, Log, TEXT("[BMStatusEffectSubsystem] Initialized"));
+}
+
+/*
+ * @brief Deinitialize, it clears the status effects
+ */
+void UBMStatusEffectSubsystem::Deinitialize()
+{
+    ClearAllStatusEffects();
+
+    UE_LOG(LogBMStatusEffect, Log, TEXT("[BMStatusEffectSubsystem] Deinitialized"));
+
+    Super::Deinitialize();
+}
+
+/*
+ * @brief Does support world type, it only runs in game worlds
+ * @param WorldType The world type
+ * @return True if the world type is supported, false otherwise
+ */
+bool UBMStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/*
+ * @brief Get stat id, it returns the stat id of the status effect subsystem
+ * @return The stat id
+ */
+TStatId UBMStatusEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UBMStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+/*
+ * @brief Tick, it advances the timing wheel to the current time and applies the collected ticks in one batch
+ * @param DeltaTime The delta time
+ */
+void UBMStatusEffectSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SCOPE_CYCLE_COUNTER(STAT_BMStatusEffectTick);
+    SET_DWORD_STAT(STAT_BMStatusEffectsLive, NumActiveEffects);
+
+    SimTime += DeltaTime;
+    const uint64 TargetTick = NowTick();
+
+    // 没有任何效果：时间轮已清空，直接跳到当前刻度
+    if (NumActiveEffects == 0 && PendingTicks.Num() == 0)
+    {
+        CurrentTick = TargetTick;
+        return;
+    }
+
+    const double Start = FPlatformTime::Seconds();
+
+    while (CurrentTick < TargetTick && NumActiveEffects > 0)
+    {
+        AdvanceOneTick();
+    }
+    CurrentTick = FMath::Max(CurrentTick, TargetTick);
+
+    FlushPendingTicks();
+
+    if (TickBudgetMicroseconds > 0.f)
+    {
+        const double ElapsedUs = (FPlatformTime::Seconds() - Start) * 1e6;
+        if (ElapsedUs > TickBudgetMicroseconds)
+        {
+            UE_LOG(LogBMStatusEffect, Warning, TEXT("[BMStatusEffectSubsystem] Tick took %.1f us (budget %.1f us), %d live effects."),
+                ElapsedUs, TickBudgetMicroseconds, NumActiveEffects);
+        }
+    }
+}
+
+/*
+ * @brief Apply status effect, it creates an effect instance or refreshes and stacks the existing one
+ * @param Target The target character
+ * @param Spec The effect spec
+ * @param Instigator The instigator character
+ * @return True if the effect was applied or refreshed, false otherwise
+ */
+bool UBMStatusEffectSubsystem::ApplyStatusEffect(ABMCharacterBase* Target, const FBMStatusEffectSpec& Spec, ABMCharacterBase* Instigator)
+{
+    if (!Target || Spec.EffectId.IsNone())
+    {
+        return false;
+    }
+
+    const UBMStatsComponent* TargetStats = Target->GetStats();
+    if (TargetStats && TargetStats->IsDead())
+    {
+        return false;
+    }
+
+    const uint64 DurationTicks = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Spec.Duration / WheelTickSeconds));
+    const uint64 PeriodTicks = FMath::Max<uint64>(1, (uint64)FMath::RoundToDouble(FMath::Max(Spec.Period, 0.05f) / WheelTickSeconds));
+
+    const TTuple<FObjectKey, FName> Key(FObjectKey(Target), Spec.EffectId);
+
+    // 已存在：刷新到期时间（取较晚者）并叠层；时间轮中的节点无需改动，到期时会按新的时间重新挂入
+    if (const int32* Found = EffectIndexByKey.Find(Key))
+    {
+        FBMStatusEffectInstance& Effect = Effects[*Found];
+        Effect.ExpireTick = FMath::Max(Effect.ExpireTick, CurrentTick + DurationTicks);
+        Effect.Stacks = FMath::Min(Effect.Stacks + 1, Effect.MaxStacks);
+        Effect.MagnitudePerTick = Spec.MagnitudePerTick;
+        if (Instigator)
+        {
+            Effect.Instigator = Instigator;
+        }
+        return true;
+    }
+
+    int32 Index = INDEX_NONE;
+    if (FreeEffectIndices.Num() > 0)
+    {
+        Index = FreeEffectIndices.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Index = Effects.AddDefaulted();
+    }
+
+    FBMStatusEffectInstance& Effect = Effects[Index];
+    const uint32 Serial = Effect.Serial + 1;
+    Effect = FBMStatusEffectInstance();
+    Effect.Serial = Serial;
+    Effect.Target = Target;
+    Effect.Instigator = Instigator;
+    Effect.TargetKey = FObjectKey(Target);
+    Effect.EffectId = Spec.EffectId;
+    Effect.MagnitudePerTick = Spec.MagnitudePerTick;
+    Effect.MaxStacks = FMath::Max(1, Spec.MaxStacks);
+    Effect.Stacks = 1;
+    Effect.bHeal = Spec.bHeal;
+    Effect.DamageType = Spec.DamageType;
+    Effect.ElementType = Spec.ElementType;
+    Effect.PeriodTicks = PeriodTicks;
+    Effect.NextPeriodicTick = CurrentTick + PeriodTicks;
+    Effect.ExpireTick = CurrentTick + DurationTicks;
+    Effect.bActive = true;
+
+    EffectIndexByKey.Add(Key, Index);
+    ++NumActiveEffects;
+
+    // 立即结算的一次同样进入待结算列表，在下一次 Tick 中批量处理
+    if (Spec.bTickOnApply)
+    {
+        QueueEffectTick(Effect);
+    }
+
+    ScheduleEffect(Index, NextEventTick(Effect));
+    return true;
+}
+
+/*
+ * @brief Remove status effect, it removes the effect with the id from the target
+ * @param Target The target character
+ * @param EffectId The effect id
+ * @return True if the effect existed and was removed, false otherwise
+ */
+bool UBMStatusEffectSubsystem::RemoveStatusEffect(const ABMCharacterBase* Target, FName EffectId)
+{
+    if (!Target)
+    {
+        return false;
+    }
+
+    const int32* Found = EffectIndexByKey.Find(TTuple<FObjectKey, FName>(FObjectKey(Target), EffectId));
+    if (!Found)
+    {
+        return false;
+    }
+
+    ReleaseEffect(*Found);
+    return true;
+}
+
+/*
+ * @brief Remove all status effects, it removes every effect on the target
+ * @param Target The target character
+ */
+void UBMStatusEffectSubsystem::RemoveAllStatusEffects(const ABMCharacterBase* Target)
+{
+    if (!Target)
+    {
+        return;
+    }
+
+    const FObjectKey TargetKey(Target);
+    for (int32 i = 0; i < Effects.Num(); ++i)
+    {
+        if (Effects[i].bActive && Effects[i].TargetKey == TargetKey)
+        {
+            ReleaseEffect(i);
+        }
+    }
+}
+
+/*
+ * @brief Has status effect, it checks whether the target has the effect
+ * @param Target The target character
+ * @param EffectId The effect id
+ * @return True if the target has the effect, false otherwise
+ */
+bool UBMStatusEffectSubsystem::HasStatusEffect(const ABMCharacterBase* Target, FName EffectId) const
+{
+    return Target && EffectIndexByKey.Contains(TTuple<FObjectKey, FName>(FObjectKey(Target), EffectId));
+}
+
+/*
+ * @brief Clear all status effects, it drops every effect and empties the timing wheel
+ */
+void UBMStatusEffectSubsystem::ClearAllStatusEffects()
+{
+    Effects.Reset();
+    FreeEffectIndices.Reset();
+    EffectIndexByKey.Reset();
+    PendingTicks.Reset();
+    NumActiveEffects = 0;
+    ResetWheel();
+}
+
+/*
+ * @brief Run isolated stress, it swaps the live scheduler state out, times each synthetic tick on a blank one and swaps it back
+ * @param Characters The target characters
+ * @param Count The number of effects
+ * @param Ticks The number of 60Hz ticks
+ * @return The per tick cost and the number of settled ticks
+ */
+FBMStatusEffectStressResult UBMStatusEffectSubsystem::RunIsolatedStress(TConstArrayView<ABMCharacterBase*> Characters, int32 Count, int32 Ticks)
+{
+    FBMStatusEffectStressResult Result;
+    if (Characters.Num() == 0 || Ticks <= 0)
+    {
+        return Result;
+    }
+
+    // 实时状态整体换出，压测结束前不会被推进或结算
+    FBMSchedulerState LiveState;
+    SwapSchedulerState(LiveState);
+
+    ApplyStressEffects(*this, Characters, Count);
+
+    // 逐帧计时，预算按单帧判定
+    TArray<double> FrameUs;
+    FrameUs.Reserve(Ticks);
+    const int32 SettledBefore = NumSettledTicks;
+    for (int32 t = 0; t < Ticks; ++t)
+    {
+        const double Start = FPlatformTime::Seconds();
+        Tick(1.f / 60.f);
+        FrameUs.Add((FPlatformTime::Seconds() - Start) * 1e6);
+    }
+    Result.SettledTicks = NumSettledTicks - SettledBefore;
+
+    // 丢弃压测状态，换回实时状态
+    ClearAllStatusEffects();
+    SwapSchedulerState(LiveState);
+
+    double TotalUs = 0.0;
+    for (const double Us : FrameUs)
+    {
+        TotalUs += Us;
+    }
+    FrameUs.Sort();
+    Result.AverageMicroseconds = TotalUs / Ticks;
+    Result.P99Microseconds = FrameUs[FMath::Min(Ticks - 1, Ticks * 99 / 100)];
+    Result.MaxMicroseconds = FrameUs.Last();
+    return Result;
+}
+
+/*
+ * @brief Swap scheduler state, it exchanges the effects, timing wheel and clock with the other state
+ * @param Other The other state
+ */
+void UBMStatusEffectSubsystem::SwapSchedulerState(FBMSchedulerState& Other)
+{
+    Swap(Effects, Other.Effects);
+    Swap(FreeEffectIndices, Other.FreeEffectIndices);
+    Swap(NumActiveEffects, Other.NumActiveEffects);
+    Swap(EffectIndexByKey, Other.EffectIndexByKey);
+    for (int32 Level = 0; Level < WheelNumLevels; ++Level)
+    {
+        for (int32 Slot = 0; Slot < WheelSlotsPerLevel; ++Slot)
+        {
+            Swap(Wheel[Level][Slot], Other.Wheel[Level][Slot]);
+        }
+    }
+    Swap(SimTime, Other.SimTime);
+    Swap(CurrentTick, Other.CurrentTick);
+    Swap(PendingTicks, Other.PendingTicks);
+}
+
+/*
+ * @brief Schedule effect, it inserts the next event of the effect into the timing wheel
+ * @param EffectIndex The effect index
+ * @param TargetTick The tick of the next event
+ */
+void UBMStatusEffectSubsystem::ScheduleEffect(int32 EffectIndex, uint64 TargetTick)
+{
+    FBMWheelEntry Entry;
+    Entry.EffectIndex = EffectIndex;
+    Entry.Serial = Effects[EffectIndex].Serial;
+
+    InsertWheelEntry(Entry, FMath::Max(TargetTick, CurrentTick + 1), CurrentTick);
+}
+
+/*
+ * @brief Insert wheel entry, it picks the level by the distance to the base tick and the slot by the target tick bits
+ * @param Entry The wheel entry
+ * @param TargetTick The target tick
+ * @param BaseTick The base tick
+ */
+void UBMStatusEffectSubsystem::InsertWheelEntry(const FBMWheelEntry& Entry, uint64 TargetTick, uint64 BaseTick)
+{
+    // 下沉时可能恰好落在当前刻度，放入第 0 层当前槽位，随后本刻度即处理
+    TargetTick = FMath::Max(TargetTick, BaseTick);
+
+    // 超出最高层范围：先挂到最远处，届时发现未到期会重新挂入
+    constexpr uint64 MaxRange = uint64(1) << (WheelBitsPerLevel * WheelNumLevels);
+    if (TargetTick - BaseTick >= MaxRange)
+    {
+        TargetTick = BaseTick + MaxRange - 1;
+    }
+
+    const uint64 Delta = TargetTick - BaseTick;
+    int32 Level = 0;
+    while (Level < WheelNumLevels - 1 && Delta >= (uint64(1) << (WheelBitsPerLevel * (Level + 1))))
+    {
+        ++Level;
+    }
+
+    const int32 Slot = int32((TargetTick >> (WheelBitsPerLevel * Level)) & (WheelSlotsPerLevel - 1));
+    Wheel[Level][Slot].Add(Entry);
+}
+
+/*
+ * @brief Advance one tick, it cascades the higher level slots that come due and processes the current slot of level 0
+ */
+void UBMStatusEffectSubsystem::AdvanceOneTick()
+{
+    ++CurrentTick;
+
+    // 高层槽位下沉：从高到低，保证下沉到低层的节点在本刻度内继续下沉
+    for (int32 Level = WheelNumLevels - 1; Level >= 1; --Level)
+    {
+        const uint64 LowerMask = (uint64(1) << (WheelBitsPerLevel * Level)) - 1;
+        if ((CurrentTick & LowerMask) != 0)
+        {
+            continue;
+        }
+
+        const int32 Slot = int32((CurrentTick >> (WheelBitsPerLevel * Level)) & (WheelSlotsPerLevel - 1));
+        if (Wheel[Level][Slot].Num() == 0)
+        {
+            continue;
+        }
+
+        SlotScratch.Reset();
+        Swap(SlotScratch, Wheel[Level][Slot]);
+
+        for (const FBMWheelEntry& Entry : SlotScratch)
+        {
+            const FBMStatusEffectInstance& Effect = Effects[Entry.EffectIndex];
+            if (!Effect.bActive || Effect.Serial != Entry.Serial)
+            {
+                continue;
+            }
+            InsertWheelEntry(Entry, NextEventTick(Effect), CurrentTick);
+        }
+    }
+
+    const int32 Slot = int32(CurrentTick & (WheelSlotsPerLevel - 1));
+    if (Wheel[0][Slot].Num() == 0)
+    {
+        return;
+    }
+
+    SlotScratch.Reset();
+    Swap(SlotScratch, Wheel[0][Slot]);
+
+    for (const FBMWheelEntry& Entry : SlotScratch)
+    {
+        const FBMStatusEffectInstance& Effect = Effects[Entry.EffectIndex];
+        if (!Effect.bActive || Effect.Serial != Entry.Serial)
+        {
+            continue;
+        }
+
+        // 被刷新延后或超出范围被截断的节点：未到期则重新挂入
+        if (NextEventTick(Effect) > CurrentTick)
+        {
+            ScheduleEffect(Entry.EffectIndex, NextEventTick(Effect));
+            continue;
+        }
+
+        ProcessEffectEvent(Entry.EffectIndex);
+    }
+}
+
+/*
+ * @brief Process effect event, it queues the periodic tick, removes the expired effect or schedules the next event
+ * @param EffectIndex The effect index
+ */
+void UBMStatusEffectSubsystem::ProcessEffectEvent(int32 EffectIndex)
+{
+    FBMStatusEffectInstance& Effect = Effects[EffectIndex];
+
+    // 目标已销毁或死亡：直接移除
+    const ABMCharacterBase* Target = Effect.Target.Get();
+    const UBMStatsComponent* TargetStats = Target ? Target->GetStats() : nullptr;
+    if (!Target || (TargetStats && TargetStats->IsDead()))
+    {
+        ReleaseEffect(EffectIndex);
+        return;
+    }
+
+    if (Effect.NextPeriodicTick <= CurrentTick)
+    {
+        QueueEffectTick(Effect);
+        Effect.NextPeriodicTick += Effect.PeriodTicks;
+    }
+
+    if (Effect.ExpireTick <= CurrentTick)
+    {
+        ReleaseEffect(EffectIndex);
+        return;
+    }
+
+    ScheduleEffect(EffectIndex, NextEventTick(Effect));
+}
+
+/*
+ * @brief Queue effect tick, it copies one application of the effect into the pending list
+ * @param Effect The effect instance
+ */
+void UBMStatusEffectSubsystem::QueueEffectTick(const FBMStatusEffectInstance& Effect)
+{
+    const float Amount = Effect.MagnitudePerTick * Effect.Stacks;
+    if (Amount <= 0.f)
+    {
+        return;
+    }
+
+    FBMPendingEffectTick& Pending = PendingTicks.AddDefaulted_GetRef();
+    Pending.Target = Effect.Target;
+    Pending.Instigator = Effect.Instigator;
+    Pending.Amount = Amount;
+    Pending.bHeal = Effect.bHeal;
+    Pending.DamageType = Effect.DamageType;
+    Pending.ElementType = Effect.ElementType;
+}
+
+/*
+ * @brief Flush pending ticks, it applies the collected damage and healing through the common hit path
+ */
+void UBMStatusEffectSubsystem::FlushPendingTicks()
+{
+    // 按下标遍历：结算回调中可能施加新效果并追加到列表
+    for (int32 i = 0; i < PendingTicks.Num(); ++i)
+    {
+        const FBMPendingEffectTick Pending = PendingTicks[i];
+
+        ABMCharacterBase* Target = Pending.Target.Get();
+        UBMStatsComponent* TargetStats = Target ? Target->GetStats() : nullptr;
+        if (!TargetStats || TargetStats->IsDead())
+        {
+            continue;
+        }
+
+        INC_DWORD_STAT(STAT_BMStatusEffectTicks);
+        ++NumSettledTicks;
+
+        if (Pending.bHeal)
+        {
+            TargetStats->HealByAmount(Pending.Amount);
+            continue;
+        }
+
+        FBMDamageInfo Info;
+        Info.InstigatorActor = Pending.Instigator.Get();
+        Info.TargetActor = Target;
+        Info.DamageValue = Pending.Amount;
+        Info.RawDamageValue = Pending.Amount;
+        Info.DamageType = Pending.DamageType;
+        Info.ElementType = Pending.ElementType;
+        Info.HitReaction = EBMHitReaction::None;
+        Info.HitLocation = Target->GetActorLocation();
+
+        Target->TakeDamageFromHit(Info);
+    }
+
+    PendingTicks.Reset();
+}
+
+/*
+ * @brief Release effect, it deactivates the effect and recycles its index
+ * @param EffectIndex The effect index
+ */
+void UBMStatusEffectSubsystem::ReleaseEffect(int32 EffectIndex)
+{
+    FBMStatusEffectInstance& Effect = Effects[EffectIndex];
+    if (!Effect.bActive)
+    {
+        return;
+    }
+
+    // 时间轮中残留的节点通过 bActive / Serial 识别为过期，无需查找删除
+    EffectIndexByKey.Remove(TTuple<FObjectKey, FName>(Effect.TargetKey, Effect.EffectId));
+    Effect.bActive = false;
+    Effect.Target.Reset();
+    Effect.Instigator.Reset();
+    FreeEffectIndices.Add(EffectIndex);
+    --NumActiveEffects;
+
+    // 最后一个效果移除后清空时间轮，空闲时 Tick 可直接跳过
+    if (NumActiveEffects == 0)
+    {
+        ResetWheel();
+    }
+}
+
+/*
+ * @brief Reset wheel, it empties every slot of the timing wheel
+ */
+void UBMStatusEffectSubsystem::ResetWheel()
+{
+    for (int32 Level = 0; Level < WheelNumLevels; ++Level)
+    {
+        for (int32 Slot = 0; Slot < WheelSlotsPerLevel; ++Slot)
+        {
+            Wheel[Level][Slot].Reset();
+        }
+    }
+}
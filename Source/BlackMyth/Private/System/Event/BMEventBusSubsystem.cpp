@@ -2,4 +2,1019 @@
 
 
 #include "System/Event/BMEventBusSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 
+DEFINE_LOG_CATEGORY(LogBMEventBus);
+
+struct FBMEventRecordPayload
+{
+    FText Text;
+    FBMNotifyPayload Notify;
+};
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Emits"), STAT_BMEventBusEmits, STATGROUP_BMEventBus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Emits Coalesced"), STAT_BMEventBusCoalesced, STATGROUP_BMEventBus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Broadcasts"), STAT_BMEventBusBroadcasts, STATGROUP_BMEventBus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Records Drained"), STAT_BMEventBusDrained, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("EventBus Flush"), STAT_BMEventBusFlush, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("EventBus Drain"), STAT_BMEventBusDrain, STATGROUP_BMEventBus);
+
+#if BM_EVENTBUS_INSTRUMENTATION
+DECLARE_DWORD_COUNTER_STAT(TEXT("Redundant Broadcasts"), STAT_BMEventBusRedundant, STATGROUP_BMEventBus);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Subscriber Calls"), STAT_BMEventBusSubscriberCalls, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel PlayerHealth"), STAT_BMEventBusChannel_PlayerHealth, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel PlayerMana"), STAT_BMEventBusChannel_PlayerMana, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel PlayerStamina"), STAT_BMEventBusChannel_PlayerStamina, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel SkillCooldownStarted"), STAT_BMEventBusChannel_SkillCooldownStarted, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel SkillCooldownReady"), STAT_BMEventBusChannel_SkillCooldownReady, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel BossPhase"), STAT_BMEventBusChannel_BossPhase, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel BossHealth"), STAT_BMEventBusChannel_BossHealth, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel Notify"), STAT_BMEventBusChannel_Notify, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel PlayerDied"), STAT_BMEventBusChannel_PlayerDied, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel PlayerLevelUp"), STAT_BMEventBusChannel_PlayerLevelUp, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel PlayerXP"), STAT_BMEventBusChannel_PlayerXP, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel SkillPoints"), STAT_BMEventBusChannel_SkillPoints, STATGROUP_BMEventBus);
+DECLARE_CYCLE_STAT(TEXT("Channel AttributePoints"), STAT_BMEventBusChannel_AttributePoints, STATGROUP_BMEventBus);
+#endif
+
+namespace
+{
+    static TAutoConsoleVariable<int32> CVarBMEventBusDeferred(
+        TEXT("bm.EventBus.Deferred"),
+        1,
+        TEXT("1: event bus emits are coalesced and broadcast once per frame after the actor tick. 0: broadcast immediately."),
+        ECVF_Default);
+
+    // Listeners may emit again while a flush is broadcasting; bound the number of passes in one frame
+    static constexpr int32 MaxFlushPasses = 4;
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    static TAutoConsoleVariable<int32> CVarBMEventBusProfile(
+        TEXT("bm.EventBus.Profile"),
+        0,
+        TEXT("1: count emits and broadcasts per event bus channel and time the handlers per channel and per subscriber (see bm.EventBus.ProfileDump)."),
+        ECVF_Default);
+
+    static const TCHAR* ChannelNames[] =
+    {
+        TEXT("PlayerHealth"),
+        TEXT("PlayerMana"),
+        TEXT("PlayerStamina"),
+        TEXT("SkillCooldownStarted"),
+        TEXT("SkillCooldownReady"),
+        TEXT("BossPhase"),
+        TEXT("BossHealth"),
+        TEXT("Notify"),
+        TEXT("PlayerDied"),
+        TEXT("PlayerLevelUp"),
+        TEXT("PlayerXP"),
+        TEXT("SkillPoints"),
+        TEXT("AttributePoints"),
+    };
+    static_assert(UE_ARRAY_COUNT(ChannelNames) == static_cast<int32>(EBMEventChannel::Count), "ChannelNames must match EBMEventChannel");
+
+    /*
+     * @brief Get channel stat id, it returns the cycle stat that times the broadcasts of the channel
+     * @param Channel The channel
+     * @return The stat id
+     */
+    static TStatId GetChannelStatId(EBMEventChannel Channel)
+    {
+        static const TStatId StatIds[] =
+        {
+            GET_STATID(STAT_BMEventBusChannel_PlayerHealth),
+            GET_STATID(STAT_BMEventBusChannel_PlayerMana),
+            GET_STATID(STAT_BMEventBusChannel_PlayerStamina),
+            GET_STATID(STAT_BMEventBusChannel_SkillCooldownStarted),
+            GET_STATID(STAT_BMEventBusChannel_SkillCooldownReady),
+            GET_STATID(STAT_BMEventBusChannel_BossPhase),
+            GET_STATID(STAT_BMEventBusChannel_BossHealth),
+            GET_STATID(STAT_BMEventBusChannel_Notify),
+            GET_STATID(STAT_BMEventBusChannel_PlayerDied),
+            GET_STATID(STAT_BMEventBusChannel_PlayerLevelUp),
+            GET_STATID(STAT_BMEventBusChannel_PlayerXP),
+            GET_STATID(STAT_BMEventBusChannel_SkillPoints),
+            GET_STATID(STAT_BMEventBusChannel_AttributePoints),
+        };
+        static_assert(UE_ARRAY_COUNT(StatIds) == static_cast<int32>(EBMEventChannel::Count), "StatIds must match EBMEventChannel");
+        return StatIds[static_cast<int32>(Channel)];
+    }
+
+    // 参数哈希，用于判断一次广播是否与上一次完全相同；FText 不参与比较
+    static void HashEventArg(uint32& Hash, bool& bComparable, float Value) { Hash = HashCombineFast(Hash, GetTypeHash(Value)); }
+    static void HashEventArg(uint32& Hash, bool& bComparable, int32 Value) { Hash = HashCombineFast(Hash, GetTypeHash(Value)); }
+    static void HashEventArg(uint32& Hash, bool& bComparable, FName Value) { Hash = HashCombineFast(Hash, GetTypeHash(Value)); }
+    static void HashEventArg(uint32& Hash, bool& bComparable, const FText& Value) { bComparable = false; }
+    static void HashEventArg(uint32& Hash, bool& bComparable, const FBMNotifyPayload& Value)
+    {
+        if (Value.Message == EBMNotifyMessage::Text)
+        {
+            bComparable = false;
+            return;
+        }
+        Hash = HashCombineFast(Hash, GetTypeHash(static_cast<uint8>(Value.Message)));
+        for (int32 i = 0; i < Value.NumArgs; ++i)
+        {
+            const FBMNotifyArg& Arg = Value.Args[i];
+            Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Arg.Int), HashCombineFast(GetTypeHash(Arg.Float), GetTypeHash(Arg.Name))));
+        }
+    }
+
+    static double CyclesToMicroseconds(uint64 Cycles)
+    {
+        return FPlatformTime::ToSeconds64(Cycles) * 1e6;
+    }
+
+    /*
+     * @brief Dump profile, it logs the event bus instrumentation tables
+     * @param Args The command arguments
+     * @param World The world
+     */
+    static void DumpEventBusProfile(const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+        const UBMEventBusSubsystem* Bus = GI ? GI->GetSubsystem<UBMEventBusSubsystem>() : nullptr;
+        if (!Bus)
+        {
+            UE_LOG(LogBMEventBus, Warning, TEXT("bm.EventBus.ProfileDump: no event bus in this world."));
+            return;
+        }
+        Bus->DumpProfile();
+    }
+
+    /*
+     * @brief Reset profile, it zeroes the event bus instrumentation
+     * @param Args The command arguments
+     * @param World The world
+     */
+    static void ResetEventBusProfile(const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+        if (UBMEventBusSubsystem* Bus = GI ? GI->GetSubsystem<UBMEventBusSubsystem>() : nullptr)
+        {
+            Bus->ResetProfile();
+        }
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMEventBusProfileDumpCommand(
+        TEXT("bm.EventBus.ProfileDump"),
+        TEXT("bm.EventBus.ProfileDump: log emits, coalesced emits, broadcasts, redundant broadcasts and handler time per channel, then the subscribers sorted by handler time."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DumpEventBusProfile));
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMEventBusProfileResetCommand(
+        TEXT("bm.EventBus.ProfileReset"),
+        TEXT("bm.EventBus.ProfileReset: zero the event bus instrumentation."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ResetEventBusProfile));
+#endif
+
+    /*
+     * @brief Log stats, it logs the lifetime emit counters of the event bus
+     * @param Args The command arguments
+     * @param World The world
+     */
+    static void LogEventBusStats(const TArray<FString>& Args, UWorld* World)
+    {
+        UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+        const UBMEventBusSubsystem* Bus = GI ? GI->GetSubsystem<UBMEventBusSubsystem>() : nullptr;
+        if (!Bus)
+        {
+            UE_LOG(LogBMEventBus, Warning, TEXT("bm.EventBus.Stats: no event bus in this world."));
+            return;
+        }
+
+        const uint64 Emits = Bus->GetTotalEmitCount();
+        const uint64 Coalesced = Bus->GetCoalescedEmitCount();
+        UE_LOG(LogBMEventBus, Log, TEXT("bm.EventBus.Stats: deferred %d, %llu emits, %llu coalesced (%.1f%%), %llu broadcasts."),
+            Bus->IsDeferredDispatch() ? 1 : 0,
+            Emits,
+            Coalesced,
+            Emits > 0 ? 100.0 * (double)Coalesced / (double)Emits : 0.0,
+            Bus->GetBroadcastCount());
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs GBMEventBusStatsCommand(
+        TEXT("bm.EventBus.Stats"),
+        TEXT("bm.EventBus.Stats: log how many event bus emits were made, coalesced and broadcast since the game instance started."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&LogEventBusStats));
+}
+
+/*
+ * @brief Initialize, it hooks the flush point after the actor tick of the owning world
+ * @param Collection The collection
+ */
+void UBMEventBusSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UBMEventBusSubsystem::HandleWorldPostActorTick);
+}
+
+/*
+ * @brief Deinitialize, it removes the flush hook and drops the pending events
+ */
+void UBMEventBusSubsystem::Deinitialize()
+{
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+    PostActorTickHandle.Reset();
+
+    DirtyValues = 0;
+    PendingCooldowns.Reset();
+    QueuedEvents.Reset();
+
+    // 未派发的记录仍持有负载
+    FBMEventRecord Record;
+    while (IncomingRecords.Dequeue(Record))
+    {
+        delete Record.Payload;
+    }
+    NumIncomingRecords.store(0, std::memory_order_relaxed);
+
+    Super::Deinitialize();
+}
+
+/*
+ * @brief Is deferred dispatch, it checks the console variable
+ * @return True if the emits are deferred, false otherwise
+ */
+bool UBMEventBusSubsystem::IsDeferredDispatch() const
+{
+    return CVarBMEventBusDeferred.GetValueOnGameThread() != 0;
+}
+
+/*
+ * @brief Begin emit, it counts the emit and decides whether it should be recorded or broadcast
+ * @param Channel The channel of the emit
+ * @return True if the emit should be recorded for the flush, false if it should be broadcast now
+ */
+bool UBMEventBusSubsystem::BeginEmit(EBMEventChannel Channel)
+{
+    ++TotalEmits;
+    INC_DWORD_STAT(STAT_BMEventBusEmits);
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    if (IsProfiling())
+    {
+        ++ChannelProfiles[static_cast<int32>(Channel)].Emits;
+    }
+#endif
+
+    if (IsDeferredDispatch())
+    {
+        return true;
+    }
+
+    // 从延迟模式切回时先交付残留事件，保持顺序
+    if (HasPending())
+    {
+        Flush();
+    }
+
+    ++TotalBroadcasts;
+    INC_DWORD_STAT(STAT_BMEventBusBroadcasts);
+    return false;
+}
+
+/*
+ * @brief Mark value dirty, it marks the channel dirty, an already dirty channel counts as coalesced
+ * @param ValueBit The dirty bit of the value channel
+ * @param Channel The channel
+ */
+void UBMEventBusSubsystem::MarkValueDirty(uint32 ValueBit, EBMEventChannel Channel)
+{
+    if (DirtyValues & ValueBit)
+    {
+        NoteCoalesced(Channel);
+    }
+    DirtyValues |= ValueBit;
+}
+
+/*
+ * @brief Accept value sequence, it stamps a value emit and drops it when a newer value of the channel was already emitted,
+ *        a worker value drained after a game thread emit of the same frame must not overwrite it
+ * @param ValueBit The dirty bit of the value channel
+ * @param Channel The channel
+ * @return True if the emit is the newest of the channel, false if it was dropped
+ */
+bool UBMEventBusSubsystem::AcceptValueSequence(uint32 ValueBit, EBMEventChannel Channel)
+{
+    // 派发中的记录沿用入队时的序号，游戏线程直接发出的取新序号
+    const uint64 Sequence = DispatchingSequence != 0 ? DispatchingSequence : NextEmitSequence.fetch_add(1, std::memory_order_relaxed);
+    uint64& Newest = ValueSequences[FMath::CountTrailingZeros(ValueBit)];
+    if (Sequence < Newest)
+    {
+        // 旧值仍计为一次发出，并视为被更新的值合并
+        ++TotalEmits;
+        INC_DWORD_STAT(STAT_BMEventBusEmits);
+        NoteCoalesced(Channel);
+        return false;
+    }
+    Newest = Sequence;
+    return true;
+}
+
+/*
+ * @brief Note coalesced, it counts one emit that overwrote a pending one
+ * @param Channel The channel
+ */
+void UBMEventBusSubsystem::NoteCoalesced(EBMEventChannel Channel)
+{
+    ++TotalCoalesced;
+    INC_DWORD_STAT(STAT_BMEventBusCoalesced);
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    if (IsProfiling())
+    {
+        ++ChannelProfiles[static_cast<int32>(Channel)].Coalesced;
+    }
+#endif
+}
+
+/*
+ * @brief Set pending cooldown, it keeps only the latest cooldown event of the skill
+ * @param SkillId The skill id
+ * @param bReady True for a ready event, false for a started event
+ * @param EndTime The world time at which the cooldown ends
+ * @param Duration The cooldown duration
+ */
+void UBMEventBusSubsystem::SetPendingCooldown(FName SkillId, bool bReady, float EndTime, float Duration)
+{
+    FPendingCooldown* Pending = PendingCooldowns.FindByPredicate([SkillId](const FPendingCooldown& C) { return C.SkillId == SkillId; });
+    if (Pending)
+    {
+        NoteCoalesced(bReady ? EBMEventChannel::SkillCooldownReady : EBMEventChannel::SkillCooldownStarted);
+    }
+    else
+    {
+        Pending = &PendingCooldowns.AddDefaulted_GetRef();
+        Pending->SkillId = SkillId;
+    }
+
+    Pending->bReady = bReady;
+    Pending->EndTime = EndTime;
+    Pending->Duration = Duration;
+}
+
+/*
+ * @brief Broadcast channel, it broadcasts one dispatcher, counted and timed per channel while profiling
+ * @param Channel The channel
+ * @param Delegate The dispatcher of the channel
+ * @param Args The broadcast arguments
+ */
+template <typename DelegateType, typename... ArgTypes>
+void UBMEventBusSubsystem::BroadcastChannel(EBMEventChannel Channel, DelegateType& Delegate, const ArgTypes&... Args)
+{
+#if BM_EVENTBUS_INSTRUMENTATION
+    if (!IsProfiling())
+    {
+        Delegate.Broadcast(Args...);
+        return;
+    }
+
+    FChannelProfile& Profile = ChannelProfiles[static_cast<int32>(Channel)];
+    ++Profile.Broadcasts;
+
+    // 与上一次广播参数相同的视为冗余（监听者拿到的是同一份数据）
+    uint32 ArgsHash = 0;
+    bool bComparable = sizeof...(Args) > 0;
+    (HashEventArg(ArgsHash, bComparable, Args), ...);
+    if (bComparable && Profile.bHasLastArgs && Profile.LastArgsHash == ArgsHash)
+    {
+        ++Profile.Redundant;
+        INC_DWORD_STAT(STAT_BMEventBusRedundant);
+    }
+    Profile.LastArgsHash = ArgsHash;
+    Profile.bHasLastArgs = bComparable;
+
+    TGuardValue<bool> ProfilingGuard(bProfilingBroadcast, true);
+    FScopeCycleCounter ChannelScope(GetChannelStatId(Channel));
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    Delegate.Broadcast(Args...);
+    const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+    Profile.Cycles += Cycles;
+    Profile.MaxCycles = FMath::Max(Profile.MaxCycles, Cycles);
+#else
+    Delegate.Broadcast(Args...);
+#endif
+}
+
+/*
+ * @brief Emit player health, it records the latest player health
+ * @param Normalized The normalized health
+ */
+void UBMEventBusSubsystem::EmitPlayerHealth(float Normalized)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::PlayerHealth, NAME_None, Normalized)); return; }
+    if (!AcceptValueSequence(Value_PlayerHealth, EBMEventChannel::PlayerHealth)) return;
+    if (!BeginEmit(EBMEventChannel::PlayerHealth)) { BroadcastChannel(EBMEventChannel::PlayerHealth, OnPlayerHealthChanged, Normalized); return; }
+    PendingPlayerHealth = Normalized;
+    MarkValueDirty(Value_PlayerHealth, EBMEventChannel::PlayerHealth);
+}
+
+/*
+ * @brief Emit player mana, it records the latest player mana
+ * @param Normalized The normalized mana
+ */
+void UBMEventBusSubsystem::EmitPlayerMana(float Normalized)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::PlayerMana, NAME_None, Normalized)); return; }
+    if (!AcceptValueSequence(Value_PlayerMana, EBMEventChannel::PlayerMana)) return;
+    if (!BeginEmit(EBMEventChannel::PlayerMana)) { BroadcastChannel(EBMEventChannel::PlayerMana, OnPlayerManaChanged, Normalized); return; }
+    PendingPlayerMana = Normalized;
+    MarkValueDirty(Value_PlayerMana, EBMEventChannel::PlayerMana);
+}
+
+/*
+ * @brief Emit player stamina, it records the latest player stamina
+ * @param Normalized The normalized stamina
+ */
+void UBMEventBusSubsystem::EmitPlayerStamina(float Normalized)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::PlayerStamina, NAME_None, Normalized)); return; }
+    if (!AcceptValueSequence(Value_PlayerStamina, EBMEventChannel::PlayerStamina)) return;
+    if (!BeginEmit(EBMEventChannel::PlayerStamina)) { BroadcastChannel(EBMEventChannel::PlayerStamina, OnPlayerStaminaChanged, Normalized); return; }
+    PendingPlayerStamina = Normalized;
+    MarkValueDirty(Value_PlayerStamina, EBMEventChannel::PlayerStamina);
+}
+
+/*
+ * @brief Emit skill cooldown started, it records the latest cooldown event of the skill
+ * @param SkillId The skill id
+ * @param EndTime The world time at which the cooldown ends
+ * @param Duration The cooldown duration
+ */
+void UBMEventBusSubsystem::EmitSkillCooldownStarted(FName SkillId, float EndTime, float Duration)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::SkillCooldownStarted, SkillId, EndTime, Duration)); return; }
+    if (!BeginEmit(EBMEventChannel::SkillCooldownStarted)) { BroadcastChannel(EBMEventChannel::SkillCooldownStarted, OnSkillCooldownStarted, SkillId, EndTime, Duration); return; }
+    SetPendingCooldown(SkillId, false, EndTime, Duration);
+}
+
+/*
+ * @brief Emit skill cooldown ready, it records the latest cooldown event of the skill
+ * @param SkillId The skill id
+ */
+void UBMEventBusSubsystem::EmitSkillCooldownReady(FName SkillId)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::SkillCooldownReady, SkillId)); return; }
+    if (!BeginEmit(EBMEventChannel::SkillCooldownReady)) { BroadcastChannel(EBMEventChannel::SkillCooldownReady, OnSkillCooldownReady, SkillId); return; }
+    SetPendingCooldown(SkillId, true, 0.f, 0.f);
+}
+
+/*
+ * @brief Emit boss phase, it queues the boss phase event
+ * @param Phase The new phase
+ * @param Hint The phase hint
+ */
+void UBMEventBusSubsystem::EmitBossPhase(int32 Phase, const FText& Hint)
+{
+    if (!IsInGameThread())
+    {
+        // 与其他事件走同一队列，保持同一生产者的顺序
+        FBMEventRecord Record(EBMEventRecordType::BossPhase, NAME_None, 0.f, 0.f, 0.f, Phase);
+        Record.Payload = new FBMEventRecordPayload{ Hint, FBMNotifyPayload() };
+        EnqueueEvent(Record);
+        return;
+    }
+    if (!BeginEmit(EBMEventChannel::BossPhase)) { BroadcastChannel(EBMEventChannel::BossPhase, OnBossPhaseChanged, Phase, Hint); return; }
+    FQueuedEvent& E = QueuedEvents.AddDefaulted_GetRef();
+    E.Type = EQueuedEventType::BossPhase;
+    E.IntA = Phase;
+    E.Text = Hint;
+}
+
+/*
+ * @brief Emit boss health, it records the latest boss health
+ * @param Normalized The normalized health
+ */
+void UBMEventBusSubsystem::EmitBossHealth(float Normalized)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::BossHealth, NAME_None, Normalized)); return; }
+    if (!AcceptValueSequence(Value_BossHealth, EBMEventChannel::BossHealth)) return;
+    if (!BeginEmit(EBMEventChannel::BossHealth)) { BroadcastChannel(EBMEventChannel::BossHealth, OnBossHealthChanged, Normalized); return; }
+    PendingBossHealth = Normalized;
+    MarkValueDirty(Value_BossHealth, EBMEventChannel::BossHealth);
+}
+
+/*
+ * @brief Emit notify, it queues a preformatted notify message
+ * @param Msg The message
+ */
+void UBMEventBusSubsystem::EmitNotify(const FText& Msg)
+{
+    EmitNotify(FBMNotifyPayload::MakeText(Msg));
+}
+
+/*
+ * @brief Emit notify, it queues a structured notification, dropped when nobody listens
+ * @param Payload The notification
+ */
+void UBMEventBusSubsystem::EmitNotify(const FBMNotifyPayload& Payload)
+{
+    if (!IsInGameThread())
+    {
+        // 监听者只能在游戏线程检查，派发时再决定是否丢弃
+        FBMEventRecord Record(EBMEventRecordType::Notify);
+        Record.Payload = new FBMEventRecordPayload{ FText::GetEmpty(), Payload };
+        EnqueueEvent(Record);
+        return;
+    }
+    if (!OnNotifyMessage.IsBound()) return;
+    if (!BeginEmit(EBMEventChannel::Notify)) { BroadcastChannel(EBMEventChannel::Notify, OnNotifyMessage, Payload); return; }
+    FQueuedEvent& E = QueuedEvents.AddDefaulted_GetRef();
+    E.Type = EQueuedEventType::Notify;
+    E.Notify = Payload;
+}
+
+/*
+ * @brief Emit player died, it queues the player died event
+ */
+void UBMEventBusSubsystem::EmitPlayerDied()
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::PlayerDied)); return; }
+    if (!BeginEmit(EBMEventChannel::PlayerDied)) { BroadcastChannel(EBMEventChannel::PlayerDied, OnPlayerDied); return; }
+    QueuedEvents.AddDefaulted_GetRef().Type = EQueuedEventType::PlayerDied;
+}
+
+/*
+ * @brief Emit player level up, it queues the level up event
+ * @param OldLevel The old level
+ * @param NewLevel The new level
+ */
+void UBMEventBusSubsystem::EmitPlayerLevelUp(int32 OldLevel, int32 NewLevel)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::PlayerLevelUp, NAME_None, 0.f, 0.f, 0.f, OldLevel, NewLevel)); return; }
+    if (!BeginEmit(EBMEventChannel::PlayerLevelUp)) { BroadcastChannel(EBMEventChannel::PlayerLevelUp, OnPlayerLevelUp, OldLevel, NewLevel); return; }
+    FQueuedEvent& E = QueuedEvents.AddDefaulted_GetRef();
+    E.Type = EQueuedEventType::PlayerLevelUp;
+    E.IntA = OldLevel;
+    E.IntB = NewLevel;
+}
+
+/*
+ * @brief Emit player XP changed, it records the latest XP values
+ * @param CurrentXP The current XP
+ * @param MaxXP The XP needed for the next level
+ * @param Percent The progress to the next level
+ */
+void UBMEventBusSubsystem::EmitPlayerXPChanged(float CurrentXP, float MaxXP, float Percent)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::PlayerXP, NAME_None, CurrentXP, MaxXP, Percent)); return; }
+    if (!AcceptValueSequence(Value_PlayerXP, EBMEventChannel::PlayerXP)) return;
+    if (!BeginEmit(EBMEventChannel::PlayerXP)) { BroadcastChannel(EBMEventChannel::PlayerXP, OnPlayerXPChanged, CurrentXP, MaxXP, Percent); return; }
+    PendingXPCurrent = CurrentXP;
+    PendingXPMax = MaxXP;
+    PendingXPPercent = Percent;
+    MarkValueDirty(Value_PlayerXP, EBMEventChannel::PlayerXP);
+}
+
+/*
+ * @brief Emit player skill points changed, it records the latest skill points
+ * @param NewSkillPoints The skill points
+ */
+void UBMEventBusSubsystem::EmitPlayerSkillPointsChanged(int32 NewSkillPoints)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::SkillPoints, NAME_None, 0.f, 0.f, 0.f, NewSkillPoints)); return; }
+    if (!AcceptValueSequence(Value_SkillPoints, EBMEventChannel::SkillPoints)) return;
+    if (!BeginEmit(EBMEventChannel::SkillPoints)) { BroadcastChannel(EBMEventChannel::SkillPoints, OnPlayerSkillPointsChanged, NewSkillPoints); return; }
+    PendingSkillPoints = NewSkillPoints;
+    MarkValueDirty(Value_SkillPoints, EBMEventChannel::SkillPoints);
+}
+
+/*
+ * @brief Emit player attribute points changed, it records the latest attribute points
+ * @param NewAttributePoints The attribute points
+ */
+void UBMEventBusSubsystem::EmitPlayerAttributePointsChanged(int32 NewAttributePoints)
+{
+    if (!IsInGameThread()) { EnqueueEvent(FBMEventRecord(EBMEventRecordType::AttributePoints, NAME_None, 0.f, 0.f, 0.f, NewAttributePoints)); return; }
+    if (!AcceptValueSequence(Value_AttributePoints, EBMEventChannel::AttributePoints)) return;
+    if (!BeginEmit(EBMEventChannel::AttributePoints)) { BroadcastChannel(EBMEventChannel::AttributePoints, OnPlayerAttributePointsChanged, NewAttributePoints); return; }
+    PendingAttributePoints = NewAttributePoints;
+    MarkValueDirty(Value_AttributePoints, EBMEventChannel::AttributePoints);
+}
+
+/*
+ * @brief Handle world post actor tick, it flushes the pending events once the owning world has ticked
+ * @param World The world that ticked
+ * @param TickType The tick type
+ * @param DeltaSeconds The delta seconds
+ */
+void UBMEventBusSubsystem::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (!World || World != GetGameInstance()->GetWorld()) return;
+
+    DrainQueuedEvents();
+    Flush();
+}
+
+/*
+ * @brief Enqueue event, it stamps the record with the emit sequence and posts it to the lock-free queue, safe from any thread
+ * @param Record The event record
+ */
+void UBMEventBusSubsystem::EnqueueEvent(const FBMEventRecord& Record)
+{
+    FBMEventRecord Stamped = Record;
+    Stamped.Sequence = NextEmitSequence.fetch_add(1, std::memory_order_relaxed);
+    IncomingRecords.Enqueue(Stamped);
+    NumIncomingRecords.fetch_add(1, std::memory_order_release);
+}
+
+/*
+ * @brief Drain queued events, it dispatches the records that were counted when the drain started,
+ *        records posted during the drain wait for the next one so a busy producer cannot starve the frame
+ * @return The number of records dispatched
+ */
+int32 UBMEventBusSubsystem::DrainQueuedEvents()
+{
+    check(IsInGameThread());
+    SCOPE_CYCLE_COUNTER(STAT_BMEventBusDrain);
+
+    const int64 Available = NumIncomingRecords.load(std::memory_order_acquire);
+    if (Available <= 0) return 0;
+
+    int32 Drained = 0;
+    FBMEventRecord Record;
+    // 生产者先链接节点再增加计数（release），读到的计数只会落后于队列：
+    // 计入 Available 的记录都已可见，Dequeue 不会在此之前失败，之后入队的留到下一次
+    while (Drained < Available && IncomingRecords.Dequeue(Record))
+    {
+        ++Drained;
+        DispatchRecord(Record);
+    }
+
+    NumIncomingRecords.fetch_sub(Drained, std::memory_order_relaxed);
+    INC_DWORD_STAT_BY(STAT_BMEventBusDrained, Drained);
+    return Drained;
+}
+
+/*
+ * @brief Dispatch record, it feeds one drained record into the game thread emit path
+ * @param Record The event record
+ */
+void UBMEventBusSubsystem::DispatchRecord(const FBMEventRecord& Record)
+{
+    TGuardValue<uint64> SequenceGuard(DispatchingSequence, Record.Sequence);
+
+    switch (Record.Type)
+    {
+    case EBMEventRecordType::PlayerHealth:          EmitPlayerHealth(Record.Float0); break;
+    case EBMEventRecordType::PlayerMana:            EmitPlayerMana(Record.Float0); break;
+    case EBMEventRecordType::PlayerStamina:         EmitPlayerStamina(Record.Float0); break;
+    case EBMEventRecordType::BossHealth:            EmitBossHealth(Record.Float0); break;
+    case EBMEventRecordType::PlayerXP:              EmitPlayerXPChanged(Record.Float0, Record.Float1, Record.Float2); break;
+    case EBMEventRecordType::SkillPoints:           EmitPlayerSkillPointsChanged(Record.Int0); break;
+    case EBMEventRecordType::AttributePoints:       EmitPlayerAttributePointsChanged(Record.Int0); break;
+    case EBMEventRecordType::SkillCooldownStarted:  EmitSkillCooldownStarted(Record.Name, Record.Float0, Record.Float1); break;
+    case EBMEventRecordType::SkillCooldownReady:    EmitSkillCooldownReady(Record.Name); break;
+    case EBMEventRecordType::PlayerDied:            EmitPlayerDied(); break;
+    case EBMEventRecordType::PlayerLevelUp:         EmitPlayerLevelUp(Record.Int0, Record.Int1); break;
+    case EBMEventRecordType::BossPhase:
+    {
+        const TUniquePtr<FBMEventRecordPayload> Payload(Record.Payload);
+        EmitBossPhase(Record.Int0, Payload ? Payload->Text : FText::GetEmpty());
+        break;
+    }
+    case EBMEventRecordType::Notify:
+    {
+        const TUniquePtr<FBMEventRecordPayload> Payload(Record.Payload);
+        if (Payload) EmitNotify(Payload->Notify);
+        break;
+    }
+    case EBMEventRecordType::Probe:
+    {
+        ++ProbeReceived;
+        if (ProbeLastSequence.IsValidIndex(Record.Int0))
+        {
+            // 同一生产者的序号必须逐一递增：不大于上一个为重复，跳号为丢失
+            int32& Last = ProbeLastSequence[Record.Int0];
+            if (Record.Int1 <= Last)
+            {
+                ++ProbeDuplicates;
+            }
+            else
+            {
+                if (Record.Int1 != Last + 1)
+                {
+                    ++ProbeGaps;
+                }
+                Last = Record.Int1;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/*
+ * @brief Reset probe validation, it prepares the per producer sequence check of the stress test
+ * @param NumProducers The number of producers
+ */
+void UBMEventBusSubsystem::ResetProbeValidation(int32 NumProducers)
+{
+    ProbeLastSequence.Init(-1, FMath::Max(0, NumProducers));
+    ProbeReceived = 0;
+    ProbeDuplicates = 0;
+    ProbeGaps = 0;
+}
+
+/*
+ * @brief Get probe results, it returns the stress test counters
+ * @param OutReceived The number of probe records dispatched
+ * @param OutDuplicates The number of probe records repeated or behind their producer
+ * @param OutGaps The number of probe records that skipped sequences
+ */
+void UBMEventBusSubsystem::GetProbeResults(int64& OutReceived, int64& OutDuplicates, int64& OutGaps) const
+{
+    OutReceived = ProbeReceived;
+    OutDuplicates = ProbeDuplicates;
+    OutGaps = ProbeGaps;
+}
+
+/*
+ * @brief Flush, it broadcasts the pending events, events emitted by the listeners are delivered in further passes
+ */
+void UBMEventBusSubsystem::Flush()
+{
+    for (int32 Pass = 0; Pass < MaxFlushPasses && HasPending(); ++Pass)
+    {
+        FlushOnce();
+    }
+}
+
+/*
+ * @brief Flush once, it takes a snapshot of the pending values and events and broadcasts it
+ */
+void UBMEventBusSubsystem::FlushOnce()
+{
+    SCOPE_CYCLE_COUNTER(STAT_BMEventBusFlush);
+
+    // 先取出快照再广播，监听者在广播中发出的事件进入下一轮
+    const uint32 Dirty = DirtyValues;
+    DirtyValues = 0;
+
+    FlushCooldowns.Reset();
+    Swap(FlushCooldowns, PendingCooldowns);
+
+    FlushEvents.Reset();
+    Swap(FlushEvents, QueuedEvents);
+
+    const int32 NumBroadcasts = FMath::CountBits(Dirty) + FlushCooldowns.Num() + FlushEvents.Num();
+    TotalBroadcasts += NumBroadcasts;
+    INC_DWORD_STAT_BY(STAT_BMEventBusBroadcasts, NumBroadcasts);
+
+    // ===== Latest values =====
+
+    if (Dirty & Value_PlayerHealth)     BroadcastChannel(EBMEventChannel::PlayerHealth, OnPlayerHealthChanged, PendingPlayerHealth);
+    if (Dirty & Value_PlayerMana)       BroadcastChannel(EBMEventChannel::PlayerMana, OnPlayerManaChanged, PendingPlayerMana);
+    if (Dirty & Value_PlayerStamina)    BroadcastChannel(EBMEventChannel::PlayerStamina, OnPlayerStaminaChanged, PendingPlayerStamina);
+    if (Dirty & Value_BossHealth)       BroadcastChannel(EBMEventChannel::BossHealth, OnBossHealthChanged, PendingBossHealth);
+    if (Dirty & Value_PlayerXP)         BroadcastChannel(EBMEventChannel::PlayerXP, OnPlayerXPChanged, PendingXPCurrent, PendingXPMax, PendingXPPercent);
+    if (Dirty & Value_SkillPoints)      BroadcastChannel(EBMEventChannel::SkillPoints, OnPlayerSkillPointsChanged, PendingSkillPoints);
+    if (Dirty & Value_AttributePoints)  BroadcastChannel(EBMEventChannel::AttributePoints, OnPlayerAttributePointsChanged, PendingAttributePoints);
+
+    for (const FPendingCooldown& C : FlushCooldowns)
+    {
+        if (C.bReady)
+        {
+            BroadcastChannel(EBMEventChannel::SkillCooldownReady, OnSkillCooldownReady, C.SkillId);
+        }
+        else
+        {
+            BroadcastChannel(EBMEventChannel::SkillCooldownStarted, OnSkillCooldownStarted, C.SkillId, C.EndTime, C.Duration);
+        }
+    }
+
+    // ===== Discrete events, in emit order =====
+
+    for (const FQueuedEvent& E : FlushEvents)
+    {
+        switch (E.Type)
+        {
+        case EQueuedEventType::PlayerDied:
+            BroadcastChannel(EBMEventChannel::PlayerDied, OnPlayerDied);
+            break;
+        case EQueuedEventType::PlayerLevelUp:
+            BroadcastChannel(EBMEventChannel::PlayerLevelUp, OnPlayerLevelUp, E.IntA, E.IntB);
+            break;
+        case EQueuedEventType::BossPhase:
+            BroadcastChannel(EBMEventChannel::BossPhase, OnBossPhaseChanged, E.IntA, E.Text);
+            break;
+        case EQueuedEventType::Notify:
+            BroadcastChannel(EBMEventChannel::Notify, OnNotifyMessage, E.Notify);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+#if BM_EVENTBUS_INSTRUMENTATION
+/*
+ * @brief Is profiling, it checks the console variable
+ * @return True if the instrumentation is collecting, false otherwise
+ */
+bool UBMEventBusSubsystem::IsProfiling() const
+{
+    return CVarBMEventBusProfile.GetValueOnGameThread() != 0;
+}
+
+/*
+ * @brief Get channel of, it maps a dispatcher of this bus to its channel
+ * @param Delegate The dispatcher
+ * @return The channel, Count if the dispatcher does not belong to this bus
+ */
+EBMEventChannel UBMEventBusSubsystem::GetChannelOf(const void* Delegate) const
+{
+    if (Delegate == &OnPlayerHealthChanged)             return EBMEventChannel::PlayerHealth;
+    if (Delegate == &OnPlayerManaChanged)               return EBMEventChannel::PlayerMana;
+    if (Delegate == &OnPlayerStaminaChanged)            return EBMEventChannel::PlayerStamina;
+    if (Delegate == &OnSkillCooldownStarted)            return EBMEventChannel::SkillCooldownStarted;
+    if (Delegate == &OnSkillCooldownReady)              return EBMEventChannel::SkillCooldownReady;
+    if (Delegate == &OnBossPhaseChanged)                return EBMEventChannel::BossPhase;
+    if (Delegate == &OnBossHealthChanged)               return EBMEventChannel::BossHealth;
+    if (Delegate == &OnNotifyMessage)                   return EBMEventChannel::Notify;
+    if (Delegate == &OnPlayerDied)                      return EBMEventChannel::PlayerDied;
+    if (Delegate == &OnPlayerLevelUp)                   return EBMEventChannel::PlayerLevelUp;
+    if (Delegate == &OnPlayerXPChanged)                 return EBMEventChannel::PlayerXP;
+    if (Delegate == &OnPlayerSkillPointsChanged)        return EBMEventChannel::SkillPoints;
+    if (Delegate == &OnPlayerAttributePointsChanged)    return EBMEventChannel::AttributePoints;
+    return EBMEventChannel::Count;
+}
+
+/*
+ * @brief Is subscriber bound, it checks whether the subscriber still has a binding on the channel's dispatcher
+ * @param Channel The channel
+ * @param Subscriber The subscriber object
+ * @return True if bound, false otherwise
+ */
+bool UBMEventBusSubsystem::IsSubscriberBound(EBMEventChannel Channel, const UObject* Subscriber) const
+{
+    if (!Subscriber) return false;
+
+    switch (Channel)
+    {
+    case EBMEventChannel::PlayerHealth:         return OnPlayerHealthChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::PlayerMana:           return OnPlayerManaChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::PlayerStamina:        return OnPlayerStaminaChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::SkillCooldownStarted: return OnSkillCooldownStarted.IsBoundToObject(Subscriber);
+    case EBMEventChannel::SkillCooldownReady:   return OnSkillCooldownReady.IsBoundToObject(Subscriber);
+    case EBMEventChannel::BossPhase:            return OnBossPhaseChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::BossHealth:           return OnBossHealthChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::Notify:               return OnNotifyMessage.IsBoundToObject(Subscriber);
+    case EBMEventChannel::PlayerDied:           return OnPlayerDied.IsBoundToObject(Subscriber);
+    case EBMEventChannel::PlayerLevelUp:        return OnPlayerLevelUp.IsBoundToObject(Subscriber);
+    case EBMEventChannel::PlayerXP:             return OnPlayerXPChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::SkillPoints:          return OnPlayerSkillPointsChanged.IsBoundToObject(Subscriber);
+    case EBMEventChannel::AttributePoints:      return OnPlayerAttributePointsChanged.IsBoundToObject(Subscriber);
+    default:                                    return false;
+    }
+}
+
+/*
+ * @brief Register subscriber, it finds or adds the profile entry for a Subscribe() binding,
+ *        reusing the entry of the same (channel, object) or the slot of a destroyed subscriber
+ * @param Delegate The dispatcher the subscriber binds to
+ * @param Subscriber The subscriber object
+ * @return The index of the profile entry, INDEX_NONE if the dispatcher does not belong to this bus
+ */
+int32 UBMEventBusSubsystem::RegisterSubscriber(const void* Delegate, const UObject* Subscriber)
+{
+    const EBMEventChannel Channel = GetChannelOf(Delegate);
+    if (!ensureMsgf(Channel != EBMEventChannel::Count, TEXT("Subscribe() called with a delegate that is not a dispatcher of the event bus")))
+    {
+        return INDEX_NONE;
+    }
+
+    // 同一对象在同一通道上重复绑定通常是漏了解绑，每次广播会被调用多次
+    if (IsSubscriberBound(Channel, Subscriber))
+    {
+        UE_LOG(LogBMEventBus, Warning, TEXT("%s subscribes to %s more than once, its handler will run once per binding."),
+            *GetNameSafe(Subscriber), ChannelNames[static_cast<int32>(Channel)]);
+    }
+
+    // 下标被绑定的 lambda 持有，条目不能删除或移动：同一对象重新订阅时复用其条目，
+    // 已销毁对象的条目不会再被调用（AddWeakLambda 不再执行），其槽位留给新的订阅者
+    int32 StaleIndex = INDEX_NONE;
+    for (int32 i = 0; i < SubscriberProfiles.Num(); ++i)
+    {
+        const FSubscriberProfile& Existing = SubscriberProfiles[i];
+        if (Existing.Object.IsStale())
+        {
+            if (StaleIndex == INDEX_NONE) StaleIndex = i;
+            continue;
+        }
+        if (Existing.Channel == Channel && Existing.Object.Get() == Subscriber)
+        {
+            return i;
+        }
+    }
+
+    const int32 Index = StaleIndex != INDEX_NONE ? StaleIndex : SubscriberProfiles.AddDefaulted();
+    FSubscriberProfile& Entry = SubscriberProfiles[Index];
+    Entry = FSubscriberProfile();
+    Entry.Channel = Channel;
+    Entry.Object = Subscriber;
+    Entry.Label = Subscriber ? FString::Printf(TEXT("%s (%s)"), *Subscriber->GetName(), *Subscriber->GetClass()->GetName()) : TEXT("None");
+    return Index;
+}
+
+/*
+ * @brief End subscriber call, it adds the time of one subscriber call to its profile entry
+ * @param ProfileIndex The index of the profile entry
+ * @param StartCycles The cycle counter when the call started, 0 if the call was not profiled
+ */
+void UBMEventBusSubsystem::EndSubscriberCall(int32 ProfileIndex, uint64 StartCycles)
+{
+    if (StartCycles == 0 || !SubscriberProfiles.IsValidIndex(ProfileIndex)) return;
+
+    const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+    FSubscriberProfile& Entry = SubscriberProfiles[ProfileIndex];
+    ++Entry.Calls;
+    Entry.Cycles += Cycles;
+    Entry.MaxCycles = FMath::Max(Entry.MaxCycles, Cycles);
+    INC_DWORD_STAT(STAT_BMEventBusSubscriberCalls);
+}
+
+/*
+ * @brief Dump profile, it logs the per channel table and the subscribers sorted by handler time
+ */
+void UBMEventBusSubsystem::DumpProfile() const
+{
+    if (!IsProfiling())
+    {
+        UE_LOG(LogBMEventBus, Log, TEXT("bm.EventBus.Profile is 0, the tables below only cover the time it was on."));
+    }
+
+    // 通过 Subscribe() 绑定的监听者耗时，剩余部分归到未接入的监听者
+    uint64 SubscriberCycles[static_cast<int32>(EBMEventChannel::Count)] = {};
+    int32 LiveSubscribers[static_cast<int32>(EBMEventChannel::Count)] = {};
+    for (const FSubscriberProfile& Entry : SubscriberProfiles)
+    {
+        const int32 Index = static_cast<int32>(Entry.Channel);
+        SubscriberCycles[Index] += Entry.Cycles;
+        if (IsSubscriberBound(Entry.Channel, Entry.Object.Get()))
+        {
+            ++LiveSubscribers[Index];
+        }
+    }
+
+    UE_LOG(LogBMEventBus, Log, TEXT("%-22s %10s %10s %10s %10s %5s %10s %10s %10s %10s"),
+        TEXT("Channel"), TEXT("Emits"), TEXT("Coalesced"), TEXT("Broadcasts"), TEXT("Redundant"), TEXT("Subs"),
+        TEXT("Total ms"), TEXT("Avg us"), TEXT("Max us"), TEXT("Other ms"));
+    for (int32 i = 0; i < static_cast<int32>(EBMEventChannel::Count); ++i)
+    {
+        const FChannelProfile& P = ChannelProfiles[i];
+        if (P.Emits == 0 && P.Broadcasts == 0 && LiveSubscribers[i] == 0) continue;
+
+        UE_LOG(LogBMEventBus, Log, TEXT("%-22s %10llu %10llu %10llu %10llu %5d %10.3f %10.2f %10.2f %10.3f"),
+            ChannelNames[i], P.Emits, P.Coalesced, P.Broadcasts, P.Redundant, LiveSubscribers[i],
+            CyclesToMicroseconds(P.Cycles) / 1000.0,
+            P.Broadcasts > 0 ? CyclesToMicroseconds(P.Cycles) / (double)P.Broadcasts : 0.0,
+            CyclesToMicroseconds(P.MaxCycles),
+            CyclesToMicroseconds(P.Cycles > SubscriberCycles[i] ? P.Cycles - SubscriberCycles[i] : 0) / 1000.0);
+    }
+
+    TArray<const FSubscriberProfile*> Sorted;
+    Sorted.Reserve(SubscriberProfiles.Num());
+    for (const FSubscriberProfile& Entry : SubscriberProfiles)
+    {
+        Sorted.Add(&Entry);
+    }
+    Sorted.Sort([](const FSubscriberProfile& A, const FSubscriberProfile& B) { return A.Cycles > B.Cycles; });
+
+    UE_LOG(LogBMEventBus, Log, TEXT("%-22s %-48s %10s %10s %10s %10s %s"),
+        TEXT("Channel"), TEXT("Subscriber"), TEXT("Calls"), TEXT("Total ms"), TEXT("Avg us"), TEXT("Max us"), TEXT("Bound"));
+    for (const FSubscriberProfile* Entry : Sorted)
+    {
+        UE_LOG(LogBMEventBus, Log, TEXT("%-22s %-48s %10llu %10.3f %10.2f %10.2f %s"),
+            ChannelNames[static_cast<int32>(Entry->Channel)], *Entry->Label, Entry->Calls,
+            CyclesToMicroseconds(Entry->Cycles) / 1000.0,
+            Entry->Calls > 0 ? CyclesToMicroseconds(Entry->Cycles) / (double)Entry->Calls : 0.0,
+            CyclesToMicroseconds(Entry->MaxCycles),
+            IsSubscriberBound(Entry->Channel, Entry->Object.Get()) ? TEXT("yes") : TEXT("no"));
+    }
+}
+
+/*
+ * @brief Reset profile, it zeroes the collected counters and times, subscribers stay registered
+ */
+void UBMEventBusSubsystem::ResetProfile()
+{
+    for (FChannelProfile& P : ChannelProfiles)
+    {
+        P = FChannelProfile();
+    }
+    for (FSubscriberProfile& Entry : SubscriberProfiles)
+    {
+        Entry.Calls = 0;
+        Entry.Cycles = 0;
+        Entry.MaxCycles = 0;
+    }
+}
+#endif
@@ -12,6 +12,7 @@
 #include "Blueprint/UserWidget.h"
 #include "System/Event/BMEventBusSubsystem.h"
 #include "BMGameInstance.h"
+#include "Core/BMDataSubsystem.h"
 
 namespace
 {
@@ -114,6 +115,16 @@ void UBMUIManagerSubsystem::ShowMainMenu(TSubclassOf<UBMMainWidget> MainClass)
         if (UUserWidget* W = CreateAndAdd(MainClass, World))
         {
             MainMenu = Cast<UBMMainWidget>(W);
+
+            // 启动耗时：只记录进程内第一次显示主菜单
+            static bool bLoggedStartup = false;
+            if (!bLoggedStartup)
+            {
+                bLoggedStartup = true;
+                const UBMDataSubsystem* Data = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBMDataSubsystem>() : nullptr;
+                UE_LOG(LogTemp, Log, TEXT("Startup: main menu shown at %.3f s, data %s."),
+                    FPlatformTime::Seconds() - GStartTime, Data && Data->IsDataReady() ? TEXT("ready") : TEXT("still loading"));
+            }
         }
     }
 }
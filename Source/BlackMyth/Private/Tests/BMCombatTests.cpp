@@ -0,0 +1,188 @@
+#include "Character/Components/BMCombatComponent.h"
+#include "Character/Components/BMStatsComponent.h"
+#include "Character/Enemy/BMEnemyDummy.h"
+#include "Core/BMTypes.h"
+
+#include "Engine/Engine.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // 每种规模重复的次数，取平均
+    static constexpr int32 AoERepeats = 20;
+
+    /*
+     * @brief Spawn dummy, it spawns a dummy of the team with enough HP that the benchmark never kills it
+     * @param World The world
+     * @param Location The location
+     * @param Team The team, set before BeginPlay so the hurt boxes take the team's channel
+     * @return The dummy, nullptr if it failed to spawn
+     */
+    static ABMEnemyDummy* SpawnDummy(UWorld* World, const FVector& Location, EBMTeam Team)
+    {
+        ABMEnemyDummy* Dummy = World->SpawnActorDeferred<ABMEnemyDummy>(ABMEnemyDummy::StaticClass(), FTransform(Location),
+            nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Dummy)
+        {
+            return nullptr;
+        }
+
+        Dummy->Team = Team;
+        Dummy->FinishSpawning(FTransform(Location));
+
+        if (UBMStatsComponent* Stats = Dummy->GetStats())
+        {
+            FBMStatBlock& Block = Stats->GetStatBlockMutable();
+            Block.MaxHP = 1e9f;
+            Block.HP = 1e9f;
+        }
+        return Dummy;
+    }
+
+    /*
+     * @brief Apply per hit overlap damage, it settles the area the way hit box overlaps did before the batched query:
+     *        one overlap query per hit, and one damage call per hurt box overlap with the part modifiers applied by the victim
+     * @param Attacker The attacker
+     * @param Spec The area damage spec, sphere only
+     * @param OutNumOverlaps Accumulates the number of overlaps returned by the queries
+     * @return The total damage dealt
+     */
+    static float ApplyPerHitOverlapDamage(ABMCharacterBase* Attacker, const FBMAoEDamageSpec& Spec, int32& OutNumOverlaps)
+    {
+        UWorld* World = Attacker->GetWorld();
+
+        FCollisionObjectQueryParams ObjectParams;
+        ObjectParams.AddObjectTypesToQuery(Attacker->Team == EBMTeam::Player ? ECC_GameTraceChannel5 : ECC_GameTraceChannel4);
+        const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BMAoEPerHitReference), false, Attacker);
+
+        float TotalDamage = 0.f;
+        TArray<FOverlapResult> Overlaps;
+        TSet<const AActor*> HitThisSegment;
+        for (int32 Hit = 0; Hit < FMath::Max(1, Spec.HitCount); ++Hit)
+        {
+            Overlaps.Reset();
+            World->OverlapMultiByObjectType(Overlaps, Spec.Origin, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Spec.Radius), QueryParams);
+            OutNumOverlaps += Overlaps.Num();
+
+            // 每段一个判定窗口，同一角色每段只结算一次（PerWindow，MaxHitsPerTarget = 1）
+            HitThisSegment.Reset();
+            for (const FOverlapResult& Overlap : Overlaps)
+            {
+                ABMCharacterBase* Victim = Cast<ABMCharacterBase>(Overlap.GetActor());
+                if (!Victim || Victim == Attacker) continue;
+
+                bool bAlreadyHit = false;
+                HitThisSegment.Add(Victim, &bAlreadyHit);
+                if (bAlreadyHit) continue;
+
+                FBMDamageInfo Info;
+                Info.InstigatorActor = Attacker;
+                Info.TargetActor = Victim;
+                Info.RawDamageValue = Spec.BaseDamage;
+                Info.DamageValue = Spec.BaseDamage * Spec.DamageScale;
+                Info.DamageType = Spec.DamageType;
+                Info.ElementType = Spec.ElementType;
+                Info.HitReaction = Spec.HitReaction;
+                Info.HitComponent = Overlap.GetComponent();
+                Info.HitLocation = Overlap.GetComponent()->GetComponentLocation();
+                Info.HitNormal = FVector::UpVector;
+                TotalDamage += Victim->TakeDamageFromHit(Info);
+            }
+        }
+        return TotalDamage;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMAoEBatchedVsPerHitTest, "BlackMyth.Combat.AoEBatchedVsPerHit",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it times ApplyAreaDamage against the per hit overlap path on 8, 32 and 64 victims with a three hit sphere,
+ *        and fails when the batched call misses a victim or is slower
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMAoEBatchedVsPerHitTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    // 开始游戏后再生成，HurtBox 在 BeginPlay 中创建碰撞
+    World->GetWorldSettings()->NotifyBeginPlay();
+
+    ABMEnemyDummy* Attacker = SpawnDummy(World, FVector::ZeroVector, EBMTeam::Player);
+    UBMCombatComponent* Combat = Attacker ? Attacker->GetCombat() : nullptr;
+    if (TestNotNull(TEXT("Attacker combat component"), Combat))
+    {
+        // 关闭预算告警，测试自己计时
+        Combat->AoEBudgetMicroseconds = 0.f;
+
+        FBMAoEDamageSpec Spec;
+        Spec.AttackId = TEXT("BMAoETest");
+        Spec.Shape = EBMAoEShape::Sphere;
+        Spec.Origin = FVector::ZeroVector;
+        Spec.Radius = 600.f;
+        Spec.BaseDamage = 1.f;
+        Spec.HitCount = 3;
+        Spec.MaxTargets = UBMCombatComponent::MaxAoETargets;
+
+        TArray<ABMEnemyDummy*> Victims;
+        for (const int32 NumVictims : { 8, 32, 64 })
+        {
+            // 8 列网格，间距 100，都在半径内
+            while (Victims.Num() < NumVictims)
+            {
+                const int32 i = Victims.Num();
+                const FVector Location(((i % 8) - 3.5f) * 100.f, ((i / 8) - 3.5f) * 100.f, 0.f);
+                if (ABMEnemyDummy* Victim = SpawnDummy(World, Location, EBMTeam::Enemy))
+                {
+                    Victims.Add(Victim);
+                }
+                else
+                {
+                    break;
+                }
+            }
+            if (!TestEqual(TEXT("Spawned victims"), Victims.Num(), NumVictims))
+            {
+                break;
+            }
+
+            FBMAoEDamageResult Batched;
+            const double BatchedStart = FPlatformTime::Seconds();
+            for (int32 Repeat = 0; Repeat < AoERepeats; ++Repeat)
+            {
+                Batched = Combat->ApplyAreaDamage(Spec);
+            }
+            const double BatchedUs = (FPlatformTime::Seconds() - BatchedStart) * 1e6 / AoERepeats;
+
+            int32 NumOverlaps = 0;
+            const double PerHitStart = FPlatformTime::Seconds();
+            for (int32 Repeat = 0; Repeat < AoERepeats; ++Repeat)
+            {
+                ApplyPerHitOverlapDamage(Attacker, Spec, NumOverlaps);
+            }
+            const double PerHitUs = (FPlatformTime::Seconds() - PerHitStart) * 1e6 / AoERepeats;
+
+            AddInfo(FString::Printf(TEXT("%2d victims x %d hits: batched %.1f us (%d candidates), per hit %.1f us (%d overlaps per call), x%.1f."),
+                NumVictims, Spec.HitCount, BatchedUs, Batched.NumCandidates, PerHitUs, NumOverlaps / AoERepeats,
+                BatchedUs > 0.0 ? PerHitUs / BatchedUs : 0.0));
+
+            TestEqual(FString::Printf(TEXT("%d victims: batched victims"), NumVictims), Batched.NumVictims, NumVictims);
+            TestTrue(FString::Printf(TEXT("%d victims: batched %.1f us not slower than per hit %.1f us"), NumVictims, BatchedUs, PerHitUs),
+                BatchedUs <= PerHitUs);
+        }
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -0,0 +1,309 @@
+#include "Core/BMDataSubsystem.h"
+#include "Core/BMDataBlob.h"
+#include "Config/BMGameSettings.h"
+#include "Data/BMElementalData.h"
+
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /*
+     * @brief Create data game instance, it starts a standalone game instance whose data subsystem loads the tables synchronously
+     * @return The game instance, shut down by the caller
+     */
+    static UGameInstance* CreateDataGameInstance()
+    {
+        // 同步加载，测试中不触发 WaitForData 的告警
+        IConsoleVariable* AsyncPreload = IConsoleManager::Get().FindConsoleVariable(TEXT("bm.Data.AsyncPreload"));
+        const int32 PreviousAsyncPreload = AsyncPreload ? AsyncPreload->GetInt() : 0;
+        if (AsyncPreload)
+        {
+            AsyncPreload->Set(0, ECVF_SetByCode);
+        }
+
+        UGameInstance* GI = NewObject<UGameInstance>(GEngine);
+        GI->InitializeStandalone();
+
+        if (AsyncPreload)
+        {
+            AsyncPreload->Set(PreviousAsyncPreload, ECVF_SetByCode);
+        }
+        return GI;
+    }
+
+    /*
+     * @brief Time lookups, it runs the lookup over every name for the given passes and returns the best ns per lookup of three runs
+     * @param Names The row names
+     * @param Passes The number of passes over the names per run
+     * @param Lookup The lookup, returns the row pointer
+     * @param Sink Accumulates the results so the lookups are not optimized away
+     * @return The ns per lookup
+     */
+    template <typename LookupType>
+    static double TimeLookups(const TArray<FName>& Names, int32 Passes, LookupType&& Lookup, uintptr_t& Sink)
+    {
+        double Best = TNumericLimits<double>::Max();
+        for (int32 Run = 0; Run < 3; ++Run)
+        {
+            const double Start = FPlatformTime::Seconds();
+            for (int32 Pass = 0; Pass < Passes; ++Pass)
+            {
+                for (const FName& Name : Names)
+                {
+                    Sink += reinterpret_cast<uintptr_t>(Lookup(Name));
+                }
+            }
+            Best = FMath::Min(Best, (FPlatformTime::Seconds() - Start) * 1e9 / ((double)Passes * Names.Num()));
+        }
+        return Best;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMElementMatrixTest, "BlackMyth.Data.ElementMatrix",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it compares the element matrix with the element table for every attack/defend pair
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMElementMatrixTest::RunTest(const FString& Parameters)
+{
+    const UDataTable* Table = GetDefault<UBMGameSettings>()->ElementDataTable.LoadSynchronous();
+    if (!TestNotNull(TEXT("Element table"), Table))
+    {
+        return false;
+    }
+
+    UGameInstance* GI = CreateDataGameInstance();
+    const UBMDataSubsystem* Data = GI->GetSubsystem<UBMDataSubsystem>();
+    if (TestNotNull(TEXT("Data subsystem"), Data) && TestTrue(TEXT("Data ready"), Data->IsDataReady()))
+    {
+        // 期望值按原来的方式取：攻击元素行 + 防御元素列属性，缺行缺列为 1.0
+        const UEnum* ElementEnum = StaticEnum<EBMElementType>();
+        const int32 NumElements = ElementEnum->NumEnums() - 1;
+        for (int32 Attack = 0; Attack < NumElements; ++Attack)
+        {
+            const FName AttackName(*ElementEnum->GetNameStringByIndex(Attack));
+            const FBMElementalData* Row = Table->FindRow<FBMElementalData>(AttackName, TEXT("BMElementMatrixTest"), false);
+
+            for (int32 Defend = 0; Defend < NumElements; ++Defend)
+            {
+                const FName DefendName(*ElementEnum->GetNameStringByIndex(Defend));
+                const FFloatProperty* Column = FindFProperty<FFloatProperty>(FBMElementalData::StaticStruct(), DefendName);
+                const float Expected = (Row && Column) ? Column->GetFloatingPointPropertyValue(Column->ContainerPtrToValuePtr<void>(Row)) : 1.0f;
+
+                const float Actual = Data->GetElementalMultiplier(
+                    static_cast<EBMElementType>(ElementEnum->GetValueByIndex(Attack)),
+                    static_cast<EBMElementType>(ElementEnum->GetValueByIndex(Defend)));
+                TestEqual(FString::Printf(TEXT("%s -> %s"), *AttackName.ToString(), *DefendName.ToString()), Actual, Expected, 0.0f);
+            }
+        }
+    }
+
+    GI->Shutdown();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMRowCacheLookupTest, "BlackMyth.Data.RowCacheLookup",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it times TBMRowCache::Find against UDataTable::FindRow on generated skill tables of several sizes,
+ *        checks that both return the same rows and that the cache is not slower
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMRowCacheLookupTest::RunTest(const FString& Parameters)
+{
+    // 每种规模约一百万次查找
+    constexpr int32 LookupsPerSize = 1 << 20;
+    const FString ContextString(TEXT("BMRowCacheLookupTest"));
+    uintptr_t Sink = 0;
+
+    for (const int32 NumRows : { 16, 128, 1024 })
+    {
+        UDataTable* Table = NewObject<UDataTable>(GetTransientPackage());
+        Table->RowStruct = FBMSkillData::StaticStruct();
+        for (int32 i = 0; i < NumRows; ++i)
+        {
+            FBMSkillData Row;
+            Row.Cooldown = static_cast<float>(i);
+            Table->AddRow(FName(TEXT("Skill"), i + 1), Row);
+        }
+
+        TBMRowCache<FBMSkillData> Cache;
+        Cache.Build(Table);
+        const TArray<FName> Names = Table->GetRowNames();
+        if (!TestEqual(FString::Printf(TEXT("%d rows cached"), NumRows), Cache.Num(), NumRows))
+        {
+            continue;
+        }
+
+        for (const FName& Name : Names)
+        {
+            const FBMSkillData* Expected = Table->FindRow<FBMSkillData>(Name, ContextString);
+            const FBMSkillData* Actual = Cache.Find(Name);
+            if (!TestNotNull(*Name.ToString(), Actual) || !Expected)
+            {
+                continue;
+            }
+            TestEqual(*Name.ToString(), Actual->Cooldown, Expected->Cooldown);
+        }
+
+        const int32 Passes = FMath::Max(1, LookupsPerSize / NumRows);
+        const double FindRowNs = TimeLookups(Names, Passes, [&](FName Name) { return Table->FindRow<FBMSkillData>(Name, ContextString); }, Sink);
+        const double CacheNs = TimeLookups(Names, Passes, [&](FName Name) { return Cache.Find(Name); }, Sink);
+
+        AddInfo(FString::Printf(TEXT("%4d rows: FindRow %.1f ns, cache %.1f ns, x%.1f (sink %llu)."),
+            NumRows, FindRowNs, CacheNs, CacheNs > 0.0 ? FindRowNs / CacheNs : 0.0, (uint64)(Sink & 0xff)));
+
+        // 缓存少了上下文字符串和行结构检查，任何规模下都不应更慢
+        TestTrue(FString::Printf(TEXT("%d rows: cache %.1f ns not slower than FindRow %.1f ns"), NumRows, CacheNs, FindRowNs), CacheNs <= FindRowNs);
+    }
+
+    return true;
+}
+
+#if WITH_EDITOR
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMDataBlobCsvTest, "BlackMyth.Data.BlobMatchesCsv",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it compiles the configured tables into a blob and checks it, and the rows decoded from it, against the source CSVs
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMDataBlobCsvTest::RunTest(const FString& Parameters)
+{
+    const UBMGameSettings* Settings = GetDefault<UBMGameSettings>();
+    const TPair<const TSoftObjectPtr<UDataTable>*, const UScriptStruct*> Configured[] = {
+        { &Settings->SkillDataTable, FBMSkillData::StaticStruct() },
+        { &Settings->SceneDataTable, FBMSceneData::StaticStruct() },
+        { &Settings->ElementDataTable, FBMElementalData::StaticStruct() },
+        { &Settings->PlayerGrowthTable, FBMPlayerGrowthData::StaticStruct() },
+        { &Settings->EnemyDataTable, FBMEnemyData::StaticStruct() },
+        { &Settings->ItemDataTable, FBMItemData::StaticStruct() },
+        { &Settings->ProjectileDataTable, FBMProjectileData::StaticStruct() } };
+
+    TArray<const UDataTable*> Tables;
+    for (const TPair<const TSoftObjectPtr<UDataTable>*, const UScriptStruct*>& Entry : Configured)
+    {
+        if (Entry.Key->IsNull()) continue;
+
+        const UDataTable* Table = Entry.Key->LoadSynchronous();
+        if (!Table)
+        {
+            Table = UBMDataSubsystem::ImportTableFromSourceCsv(*Entry.Key, Entry.Value, GetTransientPackage());
+        }
+        if (TestNotNull(*Entry.Key->ToString(), Table))
+        {
+            Tables.Add(Table);
+        }
+    }
+
+    TArray<uint8> Bytes;
+    FString Error;
+    const bool bCompiled = FBMDataBlob::Compile(Tables, Bytes, Error);
+    if (!TestTrue(FString::Printf(TEXT("Compile %s"), *Error), bCompiled))
+    {
+        return false;
+    }
+
+    FBMDataBlob Blob;
+    const bool bInitialized = Blob.Initialize(Bytes, Error);
+    if (!TestTrue(FString::Printf(TEXT("Initialize %s"), *Error), bInitialized))
+    {
+        return false;
+    }
+
+    const FString CsvDir = FPaths::ProjectContentDir() / TEXT("Data/Tables");
+    for (const UDataTable* Table : Tables)
+    {
+        const FString CsvPath = CsvDir / Table->GetName() + TEXT(".csv");
+        FString Csv;
+        if (!FFileHelper::LoadFileToString(Csv, *CsvPath))
+        {
+            AddInfo(FString::Printf(TEXT("%s has no source CSV, skipped."), *Table->GetName()));
+            continue;
+        }
+
+        const UScriptStruct* Struct = Table->GetRowStruct();
+        UDataTable* FromCsv = NewObject<UDataTable>(GetTransientPackage());
+        FromCsv->RowStruct = const_cast<UScriptStruct*>(Struct);
+        for (const FString& Problem : FromCsv->CreateTableFromCSVString(Csv))
+        {
+            AddWarning(FString::Printf(TEXT("%s: %s"), *CsvPath, *Problem));
+        }
+
+        // 逐字段比较 blob 与 CSV
+        TArray<FString> Report;
+        const int32 NumMismatches = Blob.CompareWithTable(FromCsv, Report);
+        for (const FString& Line : Report)
+        {
+            AddError(Line);
+        }
+        TestEqual(FString::Printf(TEXT("%s blob mismatches"), *Table->GetName()), NumMismatches, 0);
+
+        // 再按运行时的方式解码，逐行与 CSV 比较（文本比较源字符串）
+        const int32 Stride = Align(Struct->GetStructureSize(), Struct->GetMinAlignment());
+        TArray<uint8> Rows;
+        Rows.SetNumUninitialized(Blob.GetNumRows(Struct) * Stride);
+        TArray<FName> RowNames;
+        const int32 NumDecoded = Blob.DecodeRows(Struct, [&](FName RowName) -> void*
+        {
+            void* Row = Rows.GetData() + RowNames.Num() * Stride;
+            RowNames.Add(RowName);
+            Struct->InitializeStruct(Row);
+            return Row;
+        }, Error);
+        TestEqual(FString::Printf(TEXT("%s decoded rows"), *Table->GetName()), NumDecoded, FromCsv->GetRowMap().Num());
+
+        for (int32 i = 0; i < RowNames.Num(); ++i)
+        {
+            const uint8* Decoded = Rows.GetData() + i * Stride;
+            const uint8* Expected = FromCsv->FindRowUnchecked(RowNames[i]);
+            if (!TestNotNull(FString::Printf(TEXT("%s.%s in CSV"), *Table->GetName(), *RowNames[i].ToString()), Expected))
+            {
+                continue;
+            }
+
+            for (TFieldIterator<FProperty> It(Struct); It; ++It)
+            {
+                const FProperty* Property = *It;
+                bool bSame = false;
+                if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+                {
+                    const FText& A = *TextProperty->ContainerPtrToValuePtr<FText>(Decoded);
+                    const FText& B = *TextProperty->ContainerPtrToValuePtr<FText>(Expected);
+                    bSame = FTextInspector::GetSourceString(A) && FTextInspector::GetSourceString(B)
+                        && FTextInspector::GetSourceString(A)->Equals(*FTextInspector::GetSourceString(B), ESearchCase::CaseSensitive);
+                }
+                else
+                {
+                    bSame = Property->Identical_InContainer(Decoded, Expected, 0, PPF_None);
+                }
+                TestTrue(FString::Printf(TEXT("%s.%s.%s"), *Table->GetName(), *RowNames[i].ToString(), *Property->GetName()), bSame);
+            }
+        }
+
+        for (int32 i = 0; i < RowNames.Num(); ++i)
+        {
+            Struct->DestroyStruct(Rows.GetData() + i * Stride);
+        }
+    }
+
+    return true;
+}
+#endif
+
+#endif
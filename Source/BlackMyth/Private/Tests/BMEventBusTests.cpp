@@ -0,0 +1,134 @@
+#include "System/Event/BMEventBusSubsystem.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMEventQueueTest, "BlackMyth.EventBus.QueueNoLossNoDuplicates",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it posts probe records from several worker threads while the game thread drains
+ *        and fails when a record of any producer is lost, repeated or reordered
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMEventQueueTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumProducers = 4;
+    constexpr int32 PerProducer = 250000;
+
+    UGameInstance* GI = NewObject<UGameInstance>(GEngine);
+    GI->InitializeStandalone();
+
+    UBMEventBusSubsystem* Bus = GI->GetSubsystem<UBMEventBusSubsystem>();
+    if (TestNotNull(TEXT("Event bus"), Bus))
+    {
+        // 先交付正常事件，避免与探针记录混在一起
+        Bus->DrainQueuedEvents();
+        Bus->ResetProbeValidation(NumProducers);
+
+        std::atomic<int32> NumFinished { 0 };
+        TArray<TFuture<void>> Producers;
+        Producers.Reserve(NumProducers);
+
+        const double Start = FPlatformTime::Seconds();
+        for (int32 p = 0; p < NumProducers; ++p)
+        {
+            Producers.Add(Async(EAsyncExecution::Thread, [Bus, p, &NumFinished]()
+                {
+                    for (int32 i = 0; i < PerProducer; ++i)
+                    {
+                        Bus->EnqueueEvent(FBMEventRecord(EBMEventRecordType::Probe, NAME_None, 0.f, 0.f, 0.f, p, i));
+                    }
+                    NumFinished.fetch_add(1, std::memory_order_release);
+                }));
+        }
+
+        // 游戏线程作为唯一消费者与生产者并发排空
+        int32 MaxBatch = 0;
+        for (;;)
+        {
+            const bool bAllFinished = NumFinished.load(std::memory_order_acquire) == NumProducers;
+            const int32 Drained = Bus->DrainQueuedEvents();
+            MaxBatch = FMath::Max(MaxBatch, Drained);
+
+            if (bAllFinished && Drained == 0) break;
+            if (Drained == 0) FPlatformProcess::YieldThread();
+        }
+
+        for (TFuture<void>& Producer : Producers)
+        {
+            Producer.Wait();
+        }
+        const double Elapsed = FPlatformTime::Seconds() - Start;
+
+        int64 Received = 0;
+        int64 Duplicates = 0;
+        int64 Gaps = 0;
+        Bus->GetProbeResults(Received, Duplicates, Gaps);
+
+        const int64 Expected = (int64)NumProducers * PerProducer;
+        AddInfo(FString::Printf(TEXT("%d producers x %d: largest drain %d, %.1f ms (%.1f M records/s)."),
+            NumProducers, PerProducer, MaxBatch, Elapsed * 1000.0, Elapsed > 0.0 ? (double)Received / Elapsed / 1e6 : 0.0));
+
+        // 无重复、无跳号且总数相符，即每个生产者的记录都按序完整到达
+        TestEqual(TEXT("Records received"), Received, Expected);
+        TestEqual(TEXT("Duplicated or reordered records"), Duplicates, (int64)0);
+        TestEqual(TEXT("Skipped records"), Gaps, (int64)0);
+
+        Bus->ResetProbeValidation(0);
+    }
+
+    GI->Shutdown();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMEventStaleValueTest, "BlackMyth.EventBus.StaleWorkerValue",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it checks that a worker value drained after a newer game thread emit of the same frame does not overwrite it,
+ *        while a worker value posted after the game thread emit still wins
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMEventStaleValueTest::RunTest(const FString& Parameters)
+{
+    UGameInstance* GI = NewObject<UGameInstance>(GEngine);
+    GI->InitializeStandalone();
+
+    UBMEventBusSubsystem* Bus = GI->GetSubsystem<UBMEventBusSubsystem>();
+    if (TestNotNull(TEXT("Event bus"), Bus))
+    {
+        Bus->DrainQueuedEvents();
+        Bus->Flush();
+
+        float LastHealth = -1.f;
+        const FDelegateHandle Handle = Bus->OnPlayerHealthChanged.AddLambda([&LastHealth](float Normalized) { LastHealth = Normalized; });
+
+        // 工作线程先发出旧值，游戏线程在排空前发出新值
+        Async(EAsyncExecution::Thread, [Bus]() { Bus->EmitPlayerHealth(0.25f); }).Wait();
+        Bus->EmitPlayerHealth(0.75f);
+        Bus->DrainQueuedEvents();
+        Bus->Flush();
+        TestEqual(TEXT("Game thread value kept"), LastHealth, 0.75f);
+
+        // 游戏线程之后发出的工作线程值是最新的，照常交付
+        Async(EAsyncExecution::Thread, [Bus]() { Bus->EmitPlayerHealth(0.5f); }).Wait();
+        Bus->DrainQueuedEvents();
+        Bus->Flush();
+        TestEqual(TEXT("Later worker value delivered"), LastHealth, 0.5f);
+
+        Bus->OnPlayerHealthChanged.Remove(Handle);
+    }
+
+    GI->Shutdown();
+    return true;
+}
+
+#endif
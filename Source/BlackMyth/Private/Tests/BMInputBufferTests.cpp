@@ -0,0 +1,141 @@
+#include "Character/BMPlayerCharacter.h"
+#include "Character/States/BMPlayerState_Attack.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // 三段连招，每段 0.6 秒，最后 0.3 秒为连段窗口
+    static constexpr int32 ComboStepCount = 3;
+    static constexpr float ComboStepDuration = 0.6f;
+    static constexpr float ComboLinkWindowSeconds = 0.3f;
+    static constexpr float ComboLinkWindowEndOffset = 0.f;
+    static constexpr float ComboRecoverDuration = 0.5f;
+
+    /** 一次模拟的结果 */
+    struct FBMComboRun
+    {
+        /** 每一段的开始时间 */
+        TArray<double> StepStartTimes;
+
+        /** 时间戳与真实按下时间的最大偏差 */
+        double MaxStampError = 0.0;
+    };
+
+    /*
+     * @brief Simulate combo, it replays the press times through the input buffer and the combo timing at a fixed tick rate
+     * @param PressTimes The real press times, ascending
+     * @param TickRate The tick rate in Hz
+     * @param EndTime The simulated duration
+     * @return The step start times and the stamp error
+     */
+    static FBMComboRun SimulateCombo(const TArray<double>& PressTimes, int32 TickRate, double EndTime)
+    {
+        FBMComboRun Run;
+        FBMInputBuffer Buffer;
+        FBMComboStepTiming Timing;
+
+        const double Dt = 1.0 / TickRate;
+        int32 NextPress = 0;
+        int32 ComboIndex = -1;
+        bool bQueuedNext = false;
+        double RecoverEndTime = -1.0;
+
+        const int32 NumTicks = FMath::CeilToInt(EndTime * TickRate);
+        for (int32 Tick = 0; Tick <= NumTicks; ++Tick)
+        {
+            const double Now = static_cast<double>(Tick) / TickRate;
+
+            // 输入先于状态机派发：上一帧到本帧之间的按键都在本帧到达
+            while (NextPress < PressTimes.Num() && PressTimes[NextPress] <= Now)
+            {
+                const double Stamp = Buffer.StampSubFrame(Now, Dt);
+                Run.MaxStampError = FMath::Max(Run.MaxStampError, FMath::Abs(Stamp - PressTimes[NextPress]));
+                Buffer.Push(EBMCombatAction::NormalAttack, Stamp);
+                ++NextPress;
+
+                if (ComboIndex < 0 && RecoverEndTime < 0.0)
+                {
+                    // 进入攻击状态：从本帧开始第一段
+                    EBMCombatAction Action = EBMCombatAction::None;
+                    Buffer.ConsumeLatest(Action);
+                    ComboIndex = 0;
+                    bQueuedNext = false;
+                    Timing = FBMComboStepTiming::Make(Now, ComboStepDuration, ComboLinkWindowSeconds, ComboLinkWindowEndOffset);
+                    Run.StepStartTimes.Add(Timing.StartTime);
+                }
+                else if (ComboIndex >= 0 && !bQueuedNext)
+                {
+                    bQueuedNext = Buffer.ConsumeInWindow(EBMCombatAction::NormalAttack, Timing.LinkWindowOpenTime, Timing.LinkWindowCloseTime);
+                }
+            }
+
+            // 段结束事件
+            if (ComboIndex >= 0 && Timing.EndTime <= Now)
+            {
+                if (!bQueuedNext)
+                {
+                    bQueuedNext = Buffer.ConsumeInWindow(EBMCombatAction::NormalAttack, Timing.LinkWindowOpenTime, Timing.LinkWindowCloseTime);
+                }
+
+                if (bQueuedNext && ComboIndex < ComboStepCount - 1)
+                {
+                    ++ComboIndex;
+                    bQueuedNext = false;
+                    Timing = FBMComboStepTiming::Make(Timing.EndTime, ComboStepDuration, ComboLinkWindowSeconds, ComboLinkWindowEndOffset);
+                    Run.StepStartTimes.Add(Timing.StartTime);
+                }
+                else
+                {
+                    ComboIndex = -1;
+                    RecoverEndTime = Timing.EndTime + ComboRecoverDuration;
+                }
+            }
+
+            // 收招结束
+            if (RecoverEndTime >= 0.0 && RecoverEndTime <= Now)
+            {
+                RecoverEndTime = -1.0;
+            }
+        }
+        return Run;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMComboDeterminismTest, "BlackMyth.Input.ComboDeterminism",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it steps the same press timeline at 30, 60 and 120 Hz and expects the same combo steps at the same times
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMComboDeterminismTest::RunTest(const FString& Parameters)
+{
+    // 0.59 落在第一段窗口末尾，0.7 早于第二段窗口，1.03 落在第二段窗口，1.75 落在最后一段窗口（无下一段），2.5 重新起手
+    const TArray<double> PressTimes = { 0.0, 0.59, 0.7, 1.03, 1.75, 2.5 };
+    const TArray<double> Expected = { 0.0, 0.6, 1.2, 2.5 };
+
+    for (const int32 TickRate : { 30, 60, 120 })
+    {
+        const FBMComboRun Run = SimulateCombo(PressTimes, TickRate, 3.5);
+
+        if (TestEqual(FString::Printf(TEXT("%d Hz step count"), TickRate), Run.StepStartTimes.Num(), Expected.Num()))
+        {
+            for (int32 i = 0; i < Expected.Num(); ++i)
+            {
+                TestEqual(FString::Printf(TEXT("%d Hz step %d start"), TickRate, i), Run.StepStartTimes[i], Expected[i], 1e-4);
+            }
+        }
+
+        // 插值后的时间戳距真实按下时间不超过半帧
+        TestTrue(FString::Printf(TEXT("%d Hz stamp error %.4f within half a frame"), TickRate, Run.MaxStampError),
+            Run.MaxStampError <= 0.5 / TickRate + 1e-9);
+    }
+
+    return true;
+}
+
+#endif
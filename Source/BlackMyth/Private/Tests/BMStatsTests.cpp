@@ -0,0 +1,115 @@
+#include "Character/Components/BMStatsComponent.h"
+#include "Character/Enemy/BMEnemyDummy.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // 与解析值允许的最大偏差：逐帧 float 累加的舍入随帧数增长，144 Hz 回满约 1.6e-3
+    static constexpr float RegenTolerance = 1e-2f;
+
+    /*
+     * @brief Make constant deltas, it builds a fixed rate frame sequence
+     * @param Seconds The duration
+     * @param TickRate The tick rate in Hz
+     * @return The frame deltas
+     */
+    static TArray<float> MakeConstantDeltas(float Seconds, float TickRate)
+    {
+        TArray<float> Deltas;
+        Deltas.Init(1.f / TickRate, FMath::CeilToInt(Seconds * TickRate));
+        return Deltas;
+    }
+
+    /*
+     * @brief Make jittered deltas, it builds a frame sequence whose deltas vary randomly between 240 Hz and 20 Hz
+     * @param Seconds The duration
+     * @param Seed The random seed
+     * @return The frame deltas
+     */
+    static TArray<float> MakeJitteredDeltas(float Seconds, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        TArray<float> Deltas;
+        for (float Elapsed = 0.f; Elapsed < Seconds; Elapsed += Deltas.Last())
+        {
+            Deltas.Add(Random.FRandRange(1.f / 240.f, 1.f / 20.f));
+        }
+        return Deltas;
+    }
+
+    /*
+     * @brief Make hitched deltas, it builds a 60 Hz frame sequence with a long frame every second
+     * @param Seconds The duration
+     * @param HitchSeconds The length of the long frames
+     * @return The frame deltas
+     */
+    static TArray<float> MakeHitchedDeltas(float Seconds, float HitchSeconds)
+    {
+        TArray<float> Deltas;
+        float Elapsed = 0.f;
+        for (int32 Frame = 1; Elapsed < Seconds; ++Frame)
+        {
+            Deltas.Add(Frame % 60 == 0 ? HitchSeconds : 1.f / 60.f);
+            Elapsed += Deltas.Last();
+        }
+        return Deltas;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMStaminaRegenTest, "BlackMyth.Stats.StaminaRegenMatchesPerTick",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it spends stamina and compares the analytic regen with a per-tick integration over constant, jittered and hitched delta sequences
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMStaminaRegenTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ABMEnemyDummy* Dummy = World->SpawnActor<ABMEnemyDummy>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+    UBMStatsComponent* Stats = Dummy ? Dummy->GetStats() : nullptr;
+
+    if (TestNotNull(TEXT("Stats component"), Stats) && TestTrue(TEXT("Stamina regenerates"), Stats->GetStaminaRegenRate() > 0.f))
+    {
+        FBMStatBlock& Block = Stats->GetStatBlockMutable();
+        Block.MaxStamina = 100.f;
+        Block.Stamina = 100.f;
+
+        // 走正常的消耗路径，恢复的起点和延迟与游戏中一致
+        TestTrue(TEXT("Stamina spent"), Stats->TryConsumeStamina(80.f));
+
+        // 覆盖回满前后：时长取回满所需时间再加 2 秒
+        const float Seconds = 80.f / Stats->GetStaminaRegenRate() + 2.f;
+        const TPair<const TCHAR*, TArray<float>> Sequences[] = {
+            { TEXT("30 Hz"), MakeConstantDeltas(Seconds, 30.f) },
+            { TEXT("60 Hz"), MakeConstantDeltas(Seconds, 60.f) },
+            { TEXT("144 Hz"), MakeConstantDeltas(Seconds, 144.f) },
+            { TEXT("Jittered"), MakeJitteredDeltas(Seconds, 1337) },
+            { TEXT("Hitched"), MakeHitchedDeltas(Seconds, 0.5f) } };
+
+        for (const TPair<const TCHAR*, TArray<float>>& Sequence : Sequences)
+        {
+            const float MaxError = Stats->MeasureStaminaRegenError(Sequence.Value);
+            AddInfo(FString::Printf(TEXT("%s: %d frames, max |per tick - analytic| = %g."), Sequence.Key, Sequence.Value.Num(), MaxError));
+            TestTrue(FString::Printf(TEXT("%s error %g within %g"), Sequence.Key, MaxError, RegenTolerance), MaxError <= RegenTolerance);
+        }
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "System/BMStatusEffectSubsystem.h"
+#include "Character/Enemy/BMEnemyDummy.h"
+#include "Character/Components/BMStatsComponent.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBMStatusEffectBudgetTest, "BlackMyth.StatusEffect.TickBudget",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/*
+ * @brief Run test, it settles 10,000 damage and healing effects on 100 characters and fails when a frame goes over the tick budget
+ * @param Parameters The test parameters
+ * @return True when the test ran
+ */
+bool FBMStatusEffectBudgetTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumCharacters = 100;
+    constexpr int32 NumEffects = 10000;
+    constexpr int32 NumTicks = 600;
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    UBMStatusEffectSubsystem* StatusEffects = World->GetSubsystem<UBMStatusEffectSubsystem>();
+    if (TestNotNull(TEXT("Status effect subsystem"), StatusEffects))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        // 生命值足够大，压测期间不会有目标死亡导致效果提前移除
+        TArray<ABMCharacterBase*> Characters;
+        for (int32 i = 0; i < NumCharacters; ++i)
+        {
+            ABMEnemyDummy* Dummy = World->SpawnActor<ABMEnemyDummy>(FVector(i * 200.f, 0.f, 0.f), FRotator::ZeroRotator, SpawnParams);
+            if (Dummy && Dummy->GetStats())
+            {
+                FBMStatBlock& Block = Dummy->GetStats()->GetStatBlockMutable();
+                Block.MaxHP = 1e9f;
+                Block.HP = 0.5e9f;
+                Characters.Add(Dummy);
+            }
+        }
+
+        if (TestEqual(TEXT("Spawned characters"), Characters.Num(), NumCharacters))
+        {
+            const FBMStatusEffectStressResult Result = StatusEffects->RunIsolatedStress(Characters, NumEffects, NumTicks);
+            AddInfo(FString::Printf(TEXT("%d effects, %d ticks, %d settled: avg %.1f / p99 %.1f / max %.1f us per tick, budget %.1f us."),
+                NumEffects, NumTicks, Result.SettledTicks, Result.AverageMicroseconds, Result.P99Microseconds, Result.MaxMicroseconds,
+                StatusEffects->TickBudgetMicroseconds));
+
+            // 零数值效果不会进入结算路径，确认压测确实在结算
+            TestTrue(TEXT("Effects settled"), Result.SettledTicks > 0);
+
+            // 单帧预算按 99 分位判定，个别被系统调度打断的帧不计入
+            TestTrue(FString::Printf(TEXT("p99 frame %.1f us within the %.1f us budget"), Result.P99Microseconds, StatusEffects->TickBudgetMicroseconds),
+                Result.P99Microseconds <= StatusEffects->TickBudgetMicroseconds);
+            TestEqual(TEXT("Live effects untouched"), StatusEffects->GetActiveEffectCount(), 0);
+        }
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -35,14 +35,14 @@ void UBMBossBarBase::BindEventBus(UBMEventBusSubsystem* EventBus)
 
     if (!BossHealthHandle.IsValid())
     {
-        BossHealthHandle = EventBus->OnBossHealthChanged.AddWeakLambda(this, [this](float Normalized)
+        BossHealthHandle = EventBus->Subscribe(EventBus->OnBossHealthChanged, this, [this](float Normalized)
         {
             HandleBossHealth(Normalized);
         });
     }
     if (!BossPhaseHandle.IsValid())
     {
-        BossPhaseHandle = EventBus->OnBossPhaseChanged.AddWeakLambda(this, [this](int32 Phase, const FText& Hint)
+        BossPhaseHandle = EventBus->Subscribe(EventBus->OnBossPhaseChanged, this, [this](int32 Phase, const FText& Hint)
         {
             HandleBossPhase(Phase, Hint);
         });
@@ -9,6 +9,7 @@
 #include "Kismet/GameplayStatics.h"
 #define LOCTEXT_NAMESPACE "BMHUD"
 #include "Character/Components/BMStatsComponent.h"
+#include "Character/Components/BMCombatComponent.h"
 
 /*
  * @brief Bind event bus, it bind event bus
@@ -20,30 +21,37 @@ void UBMHUDWidget::BindEventBus(UBMEventBusSubsystem* EventBus)
 
     if (!HealthChangedHandle.IsValid())
     {
-        HealthChangedHandle = EventBus->OnPlayerHealthChanged.AddWeakLambda(this, [this](float Normalized)
+        HealthChangedHandle = EventBus->Subscribe(EventBus->OnPlayerHealthChanged, this, [this](float Normalized)
         {
             HandleHealthChanged(Normalized);
         });
     }
     if (!StaminaChangedHandle.IsValid())
     {
-        StaminaChangedHandle = EventBus->OnPlayerStaminaChanged.AddWeakLambda(this, [this](float Normalized)
+        StaminaChangedHandle = EventBus->Subscribe(EventBus->OnPlayerStaminaChanged, this, [this](float Normalized)
         {
             HandleStaminaChanged(Normalized);
         });
     }
-    if (!SkillCooldownHandle.IsValid())
+    if (!SkillCooldownStartedHandle.IsValid())
     {
-        SkillCooldownHandle = EventBus->OnSkillCooldownChanged.AddWeakLambda(this, [this](FName SkillId, float RemainingSeconds)
+        SkillCooldownStartedHandle = EventBus->Subscribe(EventBus->OnSkillCooldownStarted, this, [this](FName SkillId, float EndTime, float Duration)
         {
-            HandleSkillCooldownChanged(SkillId, RemainingSeconds);
+            HandleSkillCooldownStarted(SkillId, EndTime, Duration);
+        });
+    }
+    if (!SkillCooldownReadyHandle.IsValid())
+    {
+        SkillCooldownReadyHandle = EventBus->Subscribe(EventBus->OnSkillCooldownReady, this, [this](FName SkillId)
+        {
+            HandleSkillCooldownReady(SkillId);
         });
     }
 
     // Bind level change from experience component via EventBus
     if (!LevelChangedHandle.IsValid())
     {
-        LevelChangedHandle = EventBus->OnPlayerLevelUp.AddWeakLambda(this, [this](int32 OldLevel, int32 NewLevel)
+        LevelChangedHandle = EventBus->Subscribe(EventBus->OnPlayerLevelUp, this, [this](int32 OldLevel, int32 NewLevel)
         {
             HandleLevelChanged(NewLevel);
         });
@@ -89,10 +97,15 @@ void UBMHUDWidget::UnbindEventBus(UBMEventBusSubsystem* EventBus)
         EventBus->OnPlayerStaminaChanged.Remove(StaminaChangedHandle);
         StaminaChangedHandle.Reset();
     }
-    if (SkillCooldownHandle.IsValid())
+    if (SkillCooldownStartedHandle.IsValid())
     {
-        EventBus->OnSkillCooldownChanged.Remove(SkillCooldownHandle);
-        SkillCooldownHandle.Reset();
+        EventBus->OnSkillCooldownStarted.Remove(SkillCooldownStartedHandle);
+        SkillCooldownStartedHandle.Reset();
+    }
+    if (SkillCooldownReadyHandle.IsValid())
+    {
+        EventBus->OnSkillCooldownReady.Remove(SkillCooldownReadyHandle);
+        SkillCooldownReadyHandle.Reset();
     }
     if (LevelChangedHandle.IsValid())
     {
@@ -153,46 +166,82 @@ void UBMHUDWidget::HandleStaminaChanged(float Normalized)
 }
 
 /*
- * @brief Handle skill cooldown changed, it handle skill cooldown changed
+ * @brief Handle skill cooldown started, it stores the absolute end time, the remaining time is computed every tick
  * @param SkillId The skill id
- * @param RemainingSeconds The remaining seconds
+ * @param EndTime The cooldown end time (world time)
+ * @param Duration The total cooldown
  */
-void UBMHUDWidget::HandleSkillCooldownChanged(FName SkillId, float RemainingSeconds)
+void UBMHUDWidget::HandleSkillCooldownStarted(FName SkillId, float EndTime, float Duration)
 {
     FSkillCooldownData& CooldownData = SkillCooldowns.FindOrAdd(SkillId);
-    
-    if (RemainingSeconds > 0.f)
-    {
-        CooldownData.CooldownEndTime = GetCurrentWorldTime() + RemainingSeconds;
-        CooldownData.TotalCooldown = RemainingSeconds;
-        CooldownData.bIsCoolingDown = true;
-    }
-    else
+    CooldownData.CooldownEndTime = EndTime;
+    CooldownData.TotalCooldown = Duration;
+    CooldownData.bIsCoolingDown = true;
+
+    if (UTextBlock* TextWidget = FindCooldownText(SkillId))
     {
-        CooldownData.bIsCoolingDown = false;
-        CooldownData.CooldownEndTime = 0.f;
+        UpdateSingleCooldownDisplay(SkillId, CooldownData, TextWidget);
     }
-    
-    UTextBlock* TextWidget = nullptr;
-    if (SkillId == TEXT("Skill1"))
+}
+
+/*
+ * @brief Handle skill cooldown ready, it shows the ready text
+ * @param SkillId The skill id
+ */
+void UBMHUDWidget::HandleSkillCooldownReady(FName SkillId)
+{
+    if (FSkillCooldownData* CooldownData = SkillCooldowns.Find(SkillId))
     {
-        TextWidget = Skill1CooldownText;
+        CooldownData->bIsCoolingDown = false;
+        CooldownData->CooldownEndTime = 0.f;
     }
-    else if (SkillId == TEXT("Skill2"))
+
+    if (UTextBlock* TextWidget = FindCooldownText(SkillId))
     {
-        TextWidget = Skill2CooldownText;
+        TextWidget->SetText(FormatCooldownText(0.f));
+        TextWidget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
     }
-    else if (SkillId == TEXT("Skill3"))
+}
+
+/*
+ * @brief Sync active cooldowns, it picks up cooldowns committed before the HUD was bound
+ * @param PlayerPawn The player pawn
+ */
+void UBMHUDWidget::SyncActiveCooldowns(APawn* PlayerPawn)
+{
+    const UBMCombatComponent* Combat = PlayerPawn ? PlayerPawn->FindComponentByClass<UBMCombatComponent>() : nullptr;
+    if (!Combat)
     {
-        TextWidget = Skill3CooldownText;
+        return;
     }
-    
-    if (TextWidget)
+
+    const float Now = GetCurrentWorldTime();
+    for (const FBMCooldownEntry& Entry : Combat->GetCooldownEntries())
     {
-        UpdateSingleCooldownDisplay(SkillId, CooldownData, TextWidget);
+        if (Entry.bActive && Entry.EndTime > Now)
+        {
+            HandleSkillCooldownStarted(Entry.Key, Entry.EndTime, Entry.Duration);
+        }
     }
 }
 
+/*
+ * @brief Find cooldown text, it maps the skill id to the bound text widget
+ * @param SkillId The skill id
+ * @return The text widget, nullptr if the skill has no cooldown text
+ */
+UTextBlock* UBMHUDWidget::FindCooldownText(FName SkillId) const
+{
+    static const FName Skill1Id(TEXT("Skill1"));
+    static const FName Skill2Id(TEXT("Skill2"));
+    static const FName Skill3Id(TEXT("Skill3"));
+
+    if (SkillId == Skill1Id) return Skill1CooldownText;
+    if (SkillId == Skill2Id) return Skill2CooldownText;
+    if (SkillId == Skill3Id) return Skill3CooldownText;
+    return nullptr;
+}
+
 /*
  * @brief Format cooldown text, it format cooldown text
  * @param RemainingSeconds The remaining seconds
@@ -246,8 +295,11 @@ void UBMHUDWidget::SyncInitialValues()
         return;
     }
 
+    SyncActiveCooldowns(PlayerPawn);
+
     if (UBMStatsComponent* Stats = PlayerPawn->FindComponentByClass<UBMStatsComponent>())
     {
+        CachedPlayerStats = Stats;
         const FBMStatBlock& Block = Stats->GetStatBlock();
         const float HealthNormalized = Block.MaxHP > 0.f ? Block.HP / Block.MaxHP : 0.f;
         const float StaminaNormalized = Block.MaxStamina > 0.f ? Block.Stamina / Block.MaxStamina : 0.f;
@@ -269,9 +321,27 @@ void UBMHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
     Super::NativeTick(MyGeometry, InDeltaTime);
     
+    UpdateRegeneratingBars();
     UpdateCooldownDisplays(InDeltaTime);
 }
 
+/*
+ * @brief Update regenerating bars, it reads the analytic health and stamina while they regenerate
+ */
+void UBMHUDWidget::UpdateRegeneratingBars()
+{
+    const UBMStatsComponent* Stats = CachedPlayerStats.Get();
+    if (!Stats || !Stats->IsRegenerating())
+    {
+        return;
+    }
+
+    const float MaxHp = Stats->GetEffectiveMaxHp();
+    const float MaxStamina = Stats->GetStatBlock().MaxStamina;
+    HandleHealthChanged(MaxHp > 0.f ? Stats->GetCurrentHP() / MaxHp : 0.f);
+    HandleStaminaChanged(MaxStamina > 0.f ? Stats->GetCurrentStamina() / MaxStamina : 0.f);
+}
+
 /*
  * @brief Update cooldown displays, it update cooldown displays
  * @param DeltaTime The delta time
@@ -288,21 +358,7 @@ void UBMHUDWidget::UpdateCooldownDisplays(float DeltaTime)
             continue;
         }
         
-        UTextBlock* TextWidget = nullptr;
-        if (SkillId == TEXT("Skill1"))
-        {
-            TextWidget = Skill1CooldownText;
-        }
-        else if (SkillId == TEXT("Skill2"))
-        {
-            TextWidget = Skill2CooldownText;
-        }
-        else if (SkillId == TEXT("Skill3"))
-        {
-            TextWidget = Skill3CooldownText;
-        }
-        
-        if (TextWidget)
+        if (UTextBlock* TextWidget = FindCooldownText(SkillId))
         {
             UpdateSingleCooldownDisplay(SkillId, CooldownData, TextWidget);
         }
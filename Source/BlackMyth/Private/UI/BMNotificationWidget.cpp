@@ -6,6 +6,72 @@
 #include "Components/TextBlock.h"
 #include "System/Event/BMEventBusSubsystem.h"
 #include "Blueprint/WidgetTree.h"
+#include "Core/BMDataSubsystem.h"
+
+namespace
+{
+    /*
+     * @brief Get format pattern, it returns the cached localized pattern of the message
+     * @param Message The message id
+     * @return The pattern, compiled once and recompiled by the engine when the culture changes
+     */
+    static const FTextFormat& GetFormatPattern(EBMNotifyMessage Message)
+    {
+        static const FTextFormat Patterns[] =
+        {
+            FTextFormat(),
+            FTextFormat(NSLOCTEXT("BMNotification", "LootCurrency", "Currency: +{0}")),
+            FTextFormat(NSLOCTEXT("BMNotification", "LootXP", "XP: +{0}")),
+            FTextFormat(NSLOCTEXT("BMNotification", "LootItem", "Item: {0} x{1}")),
+        };
+        static_assert(UE_ARRAY_COUNT(Patterns) == static_cast<int32>(EBMNotifyMessage::Count), "Patterns must match EBMNotifyMessage");
+        return Patterns[static_cast<int32>(Message)];
+    }
+
+    /*
+     * @brief Get summed arg, it returns the argument that merging adds up (loot amounts)
+     * @param Message The message id
+     * @return The argument index, INDEX_NONE if identical messages are counted instead
+     */
+    static int32 GetSummedArg(EBMNotifyMessage Message)
+    {
+        switch (Message)
+        {
+        case EBMNotifyMessage::LootCurrency:    return 0;
+        case EBMNotifyMessage::LootXP:          return 0;
+        case EBMNotifyMessage::LootItem:        return 1;
+        default:                                return INDEX_NONE;
+        }
+    }
+
+    /*
+     * @brief Can merge, it checks whether two payloads show the same thing apart from the summed argument
+     * @param A The first payload
+     * @param B The second payload
+     * @return True if B can be merged into A
+     */
+    static bool CanMerge(const FBMNotifyPayload& A, const FBMNotifyPayload& B)
+    {
+        if (A.Message != B.Message || A.NumArgs != B.NumArgs) return false;
+
+        if (A.Message == EBMNotifyMessage::Text)
+        {
+            return A.Text.ToString().Equals(B.Text.ToString(), ESearchCase::CaseSensitive);
+        }
+
+        const int32 SummedArg = GetSummedArg(A.Message);
+        for (int32 i = 0; i < A.NumArgs; ++i)
+        {
+            if (i == SummedArg)
+            {
+                if (A.Args[i].Type != B.Args[i].Type) return false;
+                continue;
+            }
+            if (!(A.Args[i] == B.Args[i])) return false;
+        }
+        return true;
+    }
+}
 
 
 /*
@@ -17,9 +83,9 @@ void UBMNotificationWidget::BindEventBus(UBMEventBusSubsystem* EventBus)
     if (!EventBus) return;
     if (!NotifyHandle.IsValid())
     {
-        NotifyHandle = EventBus->OnNotifyMessage.AddWeakLambda(this, [this](const FText& Msg)
+        NotifyHandle = EventBus->Subscribe(EventBus->OnNotifyMessage, this, [this](const FBMNotifyPayload& Payload)
         {
-            HandleNotify(Msg);
+            HandleNotify(Payload);
         });
     }
 }
@@ -45,91 +111,292 @@ void UBMNotificationWidget::UnbindEventBus(UBMEventBusSubsystem* EventBus)
 void UBMNotificationWidget::ShowNotification(const FString& Message)
 {
     if (Message.IsEmpty()) return;
-    HandleNotify(FText::FromString(Message));
+    HandleNotify(FBMNotifyPayload::MakeText(FText::FromString(Message)));
 }
 
 /*
- * @brief Handle notify, it handle notify
- * @param Msg The message
+ * @brief Native on initialized, it builds the pool of rows once
  */
-void UBMNotificationWidget::HandleNotify(const FText& Msg)
+void UBMNotificationWidget::NativeOnInitialized()
 {
+    Super::NativeOnInitialized();
+
     if (!MessageList) return;
-    // Create a text block via WidgetTree so it is properly initialized for UMG
-    UTextBlock* Text = WidgetTree ? WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass()) : NewObject<UTextBlock>(this);
-    if (!Text) return;
-    Text->SetText(Msg);
-    Text->SetOpacity(1.f);
-    MessageList->AddChildToVerticalBox(Text);
-
-    // Track it for delayed fade-out
-    ActiveTextWidgets.Add(Text);
-    ActiveTimeRemaining.Add(InitialDelay);
-    ActiveOpacity.Add(1.f);
+
+    const int32 NumRows = FMath::Max(1, MaxVisibleRows);
+    RowPool.Reset(NumRows);
+    RowOpacity.Init(1.f, NumRows);
+    ActiveEntries.Reserve(NumRows);
+    QueuedEntries.Reserve(FMath::Max(0, MaxQueuedMessages));
+
+    for (int32 i = 0; i < NumRows; ++i)
+    {
+        // Create a text block via WidgetTree so it is properly initialized for UMG
+        UTextBlock* Text = WidgetTree ? WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass()) : NewObject<UTextBlock>(this);
+        if (!Text) continue;
+        Text->SetVisibility(ESlateVisibility::Collapsed);
+        MessageList->AddChildToVerticalBox(Text);
+        RowPool.Add(Text);
+    }
 }
 
 /*
- * @brief Native tick, it native tick
- * @param MyGeometry The geometry
- * @param InDeltaTime The delta time
+ * @brief Handle notify, it merges the message into a matching entry or shows/queues a new one
+ * @param Payload The notification
  */
-void UBMNotificationWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UBMNotificationWidget::HandleNotify(const FBMNotifyPayload& Payload)
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    if (!MessageList || RowPool.Num() == 0) return;
+    if (Payload.Message == EBMNotifyMessage::Text && Payload.Text.IsEmpty()) return;
 
-    // If there are no active text widgets, return
-    if (ActiveTextWidgets.Num() == 0) return;
+    // 窗口内可合并的消息并入已有条目，已显示的重新计时
+    if (FNotificationEntry* Target = FindMergeTarget(ActiveEntries, Payload, FeedTime, MergeWindow))
+    {
+        MergeInto(*Target, Payload, FeedTime);
+        RefreshRows();
+        return;
+    }
+    if (FNotificationEntry* Target = FindMergeTarget(QueuedEntries, Payload, FeedTime, MergeWindow))
+    {
+        MergeInto(*Target, Payload, FeedTime);
+        return;
+    }
+
+    PushEntry(Payload);
+}
+
+/*
+ * @brief Find merge target, it finds an entry the payload can merge into that was shown or merged within the window
+ * @param Entries The entries to search
+ * @param Payload The notification
+ * @param Now The feed time
+ * @param Window The merge window
+ * @return The entry, nullptr if none
+ */
+UBMNotificationWidget::FNotificationEntry* UBMNotificationWidget::FindMergeTarget(TArray<FNotificationEntry>& Entries, const FBMNotifyPayload& Payload, double Now, float Window)
+{
+    if (Window <= 0.f) return nullptr;
 
-    // Loop through the active text widgets and handle the notifications
-    for (int32 i = ActiveTextWidgets.Num() - 1; i >= 0; --i)
+    for (FNotificationEntry& Entry : Entries)
     {
-        // Get the text block pointer
-        TWeakObjectPtr<UTextBlock>& TextPtr = ActiveTextWidgets[i];
-        if (!TextPtr.IsValid())
+        if (Now - Entry.ShowTime <= Window && CanMerge(Entry.Payload, Payload))
         {
-            ActiveTextWidgets.RemoveAt(i);
-            ActiveTimeRemaining.RemoveAt(i);
-            ActiveOpacity.RemoveAt(i);
-            continue;
+            return &Entry;
         }
+    }
+    return nullptr;
+}
+
+/*
+ * @brief Merge into, it sums the summed argument of the payload into the entry, or bumps its counter
+ * @param Entry The entry
+ * @param Payload The notification
+ * @param Now The feed time
+ */
+void UBMNotificationWidget::MergeInto(FNotificationEntry& Entry, const FBMNotifyPayload& Payload, double Now)
+{
+    const int32 SummedArg = GetSummedArg(Payload.Message);
+    if (SummedArg != INDEX_NONE && SummedArg < Payload.NumArgs)
+    {
+        FBMNotifyArg& Arg = Entry.Payload.Args[SummedArg];
+        Arg.Int += Payload.Args[SummedArg].Int;
+        Arg.Float += Payload.Args[SummedArg].Float;
+    }
+    else
+    {
+        ++Entry.Count;
+    }
+
+    Entry.Payload.Priority = FMath::Max(Entry.Payload.Priority, Payload.Priority);
+    Entry.ShowTime = Now;
+    Entry.bDisplayDirty = true;
+}
+
+/*
+ * @brief Push entry, it shows the message on a free row, or queues it by priority when all rows are in use
+ * @param Payload The notification
+ */
+void UBMNotificationWidget::PushEntry(const FBMNotifyPayload& Payload)
+{
+    FNotificationEntry Entry;
+    Entry.Payload = Payload;
+    Entry.ShowTime = FeedTime;
+
+    if (ActiveEntries.Num() < RowPool.Num())
+    {
+        ActiveEntries.Add(MoveTemp(Entry));
+        RefreshRows();
+        return;
+    }
+
+    if (MaxQueuedMessages <= 0) return;
 
-        float& TimeRem = ActiveTimeRemaining[i];
-        float& Op = ActiveOpacity[i];
-        if (TimeRem > 0.f)
+    // 队列已满时丢弃优先级最低的最旧一条；队列中全部消息优先级都高于新消息时丢弃新消息
+    if (QueuedEntries.Num() >= MaxQueuedMessages)
+    {
+        int32 DropIndex = 0;
+        for (int32 i = 1; i < QueuedEntries.Num(); ++i)
         {
-            TimeRem -= InDeltaTime;
-            continue;
+            if (QueuedEntries[i].Payload.Priority < QueuedEntries[DropIndex].Payload.Priority)
+            {
+                DropIndex = i;
+            }
         }
+        if (QueuedEntries[DropIndex].Payload.Priority > Payload.Priority) return;
+        QueuedEntries.RemoveAt(DropIndex, 1, EAllowShrinking::No);
+    }
+
+    // 排在所有不低于它优先级的消息之后
+    int32 InsertIndex = QueuedEntries.Num();
+    while (InsertIndex > 0 && QueuedEntries[InsertIndex - 1].Payload.Priority < Payload.Priority)
+    {
+        --InsertIndex;
+    }
+    QueuedEntries.Insert(MoveTemp(Entry), InsertIndex);
+}
+
+/*
+ * @brief Format entry, it formats the entry with the cached pattern of its message
+ * @param Entry The entry
+ * @return The text to show
+ */
+FText UBMNotificationWidget::FormatEntry(const FNotificationEntry& Entry) const
+{
+    const FBMNotifyPayload& Payload = Entry.Payload;
 
-        // Update the opacity
-        Op = FMath::Max(0.f, Op - FadeSpeed * InDeltaTime);
-        // Get the text block pointer
-        if (UTextBlock* TB = TextPtr.Get())
+    FText Result;
+    switch (Payload.Message)
+    {
+    case EBMNotifyMessage::LootCurrency:
+        Result = FText::Format(GetFormatPattern(Payload.Message), FText::AsNumber(Payload.Args[0].Int));
+        break;
+    case EBMNotifyMessage::LootXP:
+        Result = FText::Format(GetFormatPattern(Payload.Message), FText::AsNumber(FMath::RoundToInt(Payload.Args[0].Float)));
+        break;
+    case EBMNotifyMessage::LootItem:
+    {
+        const FName ItemId = Payload.Args[0].Name;
+        FText ItemName;
+        if (const UGameInstance* GI = GetGameInstance())
         {
-            // Get the color and opacity
-            FSlateColor Color = TB->ColorAndOpacity;
-            FLinearColor Linear = Color.GetSpecifiedColor();
-            Linear.A = Op;
-            // Set the color and opacity
-            TB->SetColorAndOpacity(FSlateColor(Linear));
+            if (const UBMDataSubsystem* Data = GI->GetSubsystem<UBMDataSubsystem>())
+            {
+                if (const FBMItemData* Item = Data->GetItemData(ItemId))
+                {
+                    ItemName = Item->Name;
+                }
+            }
+        }
+        if (ItemName.IsEmpty())
+        {
+            // 表中没有显示名时退回到去掉前缀的 ID
+            FString IdString = ItemId.ToString();
+            IdString.RemoveFromStart(TEXT("Item_"));
+            ItemName = FText::FromString(IdString);
         }
+        Result = FText::Format(GetFormatPattern(Payload.Message), ItemName, FText::AsNumber(Payload.Args[1].Int));
+        break;
+    }
+    default:
+        Result = Payload.Text;
+        break;
+    }
 
-        // If the opacity is less than a small number, remove the text block
-        if (Op <= KINDA_SMALL_NUMBER)
+    if (Entry.Count > 1)
+    {
+        static const FTextFormat CountPattern(NSLOCTEXT("BMNotification", "Merged", "{0} x{1}"));
+        Result = FText::Format(CountPattern, Result, Entry.Count);
+    }
+    return Result;
+}
+
+/*
+ * @brief Refresh rows, it writes the active entries to the pooled rows and collapses the unused ones
+ */
+void UBMNotificationWidget::RefreshRows()
+{
+    for (int32 i = 0; i < RowPool.Num(); ++i)
+    {
+        UTextBlock* Row = RowPool[i];
+        if (!Row) continue;
+
+        if (ActiveEntries.IsValidIndex(i))
         {
-            // If the text block is valid, remove it from the message list
-            if (UWidget* W = TextPtr.Get())
+            // 只格式化实际上屏的条目
+            FNotificationEntry& Entry = ActiveEntries[i];
+            if (Entry.bDisplayDirty)
             {
-                MessageList->RemoveChild(W);
+                Entry.Display = FormatEntry(Entry);
+                Entry.bDisplayDirty = false;
             }
-            // Remove the text block from the active text widgets
-            ActiveTextWidgets.RemoveAt(i);
-            // Remove the time remaining from the active time remaining
-            ActiveTimeRemaining.RemoveAt(i);
-            // Remove the opacity from the active opacity
-            ActiveOpacity.RemoveAt(i);
+            Row->SetText(Entry.Display);
+            RowOpacity[i] = GetEntryOpacity(Entry);
+            Row->SetRenderOpacity(RowOpacity[i]);
+            Row->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+        }
+        else
+        {
+            Row->SetVisibility(ESlateVisibility::Collapsed);
         }
     }
 }
 
+/*
+ * @brief Get entry opacity, it computes the opacity of the entry from the feed clock
+ * @param Entry The entry
+ * @return The opacity, 0 once the entry has faded out
+ */
+float UBMNotificationWidget::GetEntryOpacity(const FNotificationEntry& Entry) const
+{
+    const double FadeTime = FeedTime - Entry.ShowTime - InitialDelay;
+    if (FadeTime <= 0.0) return 1.f;
+    return FMath::Max(0.f, 1.f - (float)FadeTime * FadeSpeed);
+}
+
+/*
+ * @brief Native tick, it advances the feed clock, fades the rows and recycles the faded ones
+ * @param MyGeometry The geometry
+ * @param InDeltaTime The delta time
+ */
+void UBMNotificationWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    // If there are no active entries, return
+    if (ActiveEntries.Num() == 0) return;
+
+    FeedTime += InDeltaTime;
 
+    bool bRowsChanged = false;
+    for (int32 i = ActiveEntries.Num() - 1; i >= 0; --i)
+    {
+        const float Opacity = GetEntryOpacity(ActiveEntries[i]);
+        if (Opacity <= KINDA_SMALL_NUMBER)
+        {
+            ActiveEntries.RemoveAt(i, 1, EAllowShrinking::No);
+            bRowsChanged = true;
+            continue;
+        }
+
+        // 只在渐隐阶段写入不透明度
+        if (!bRowsChanged && RowOpacity[i] != Opacity)
+        {
+            RowOpacity[i] = Opacity;
+            if (UTextBlock* Row = RowPool[i])
+            {
+                Row->SetRenderOpacity(Opacity);
+            }
+        }
+    }
+
+    if (!bRowsChanged) return;
+
+    // 腾出的行交给排队的消息，合并窗口从上屏时重新计算
+    while (ActiveEntries.Num() < RowPool.Num() && QueuedEntries.Num() > 0)
+    {
+        FNotificationEntry& Entry = ActiveEntries.Add_GetRef(MoveTemp(QueuedEntries[0]));
+        Entry.ShowTime = FeedTime;
+        QueuedEntries.RemoveAt(0, 1, EAllowShrinking::No);
+    }
+    RefreshRows();
+}
@@ -13,8 +13,8 @@ DECLARE_LOG_CATEGORY_EXTERN(LogBMHitBoxWindow, Log, All);
  * д NotifyState
  *
  * Ŀ꣺
- * -  CombatComponent ĵǰĶȡ HitBoxNames
- * - ڴ Begin/End ʱ/ر HitBox
+ * - ӽɫǰĶȡԤ HitBox 
+ * - ڴ Begin/End ʱ/ر HitBoxλƲң
  */
 UCLASS(meta = (DisplayName = "BM HitBox Window"))
 class BLACKMYTH_API UBMAnimNotifyState_HitBoxWindow : public UAnimNotifyState
@@ -28,6 +28,7 @@ public:
     UPROPERTY(EditAnywhere, Category = "BM|HitBoxWindow")
     bool bUseCombatContext = true;
 
+    /** ʹùʱ HitBox ƣ״δʱΪ룬ڽɫ HitBox ϣ */
     UPROPERTY(EditAnywhere, Category = "BM|HitBoxWindow", meta = (EditCondition = "!bUseCombatContext"))
     TArray<FName> HitBoxNamesOverride;
 
@@ -69,4 +70,15 @@ virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* An
 virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
     const FAnimNotifyEventReference& EventReference) override;
 
+#if WITH_EDITOR
+/**
+ * У鶯 HitBoxWindow ĸܷڸ HitBox н
+ *
+ * ڽɫԤ빥ʱãδ Warning
+ *
+ * @param Anim УĶ
+ * @param HitBox ɫ HitBox 
+ */
+static void ValidateAnimation(const UAnimSequenceBase* Anim, const UBMHitBoxComponent* HitBox);
+#endif
 };
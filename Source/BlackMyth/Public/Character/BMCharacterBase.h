@@ -4,6 +4,7 @@
 #include "GameFramework/Character.h"
 #include "Components/ActorComponent.h"
 #include "Core/BMTypes.h"
+#include "Character/Components/BMHurtBoxComponent.h"
 #include "BMCharacterBase.generated.h"
 
 class UBMStatsComponent;
@@ -13,7 +14,9 @@ class UBMAnimEventComponent;
 class UBMHitBoxComponent;
 class UBMHurtBoxComponent;
 class UAnimMontage;
+class UAnimSequenceBase;
 class UPrimitiveComponent;
+class UCapsuleComponent;
 
 /**
  * ɫϵͳ־
@@ -181,6 +184,14 @@ public:
     UPROPERTY(EditAnywhere, Category = "BM|Identity")
     EBMCharacterType CharacterType = EBMCharacterType::Enemy;
 
+    /**
+     * ɫԪ
+     *
+     * ܻʱΪԪزԪؿƾĬȫΪ 1.0
+     */
+    UPROPERTY(EditAnywhere, Category = "BM|Identity")
+    EBMElementType ElementType = EBMElementType::Physical;
+
     /**
      * ȡǰ HitBox 
      *
@@ -209,13 +220,13 @@ public:
      * ݴ ID ȡӦ HitBox ãдṩԶ߼
      *
      * @param WindowId  ID
-     * @param OutHitBoxNames  HitBox б
+     * @param OutHitBoxMask Ԥ HitBox 
      * @param OutParams  HitBox 
      * @return ɹ true
      */
     virtual bool ResolveHitBoxWindow(
         FName WindowId,
-        TArray<FName>& OutHitBoxNames,
+        uint64& OutHitBoxMask,
         FBMHitBoxActivationParams& OutParams
     ) const;
     
@@ -228,6 +239,68 @@ public:
      */
     void SetAllHurtBoxesEnabled(bool bEnabled);
 
+    /**
+     * ע HurtBoxռ OBB 
+     *
+     * Ӧڹ캯еã UBMHurtBoxComponent ͬᴴκ
+     *
+     * @param Def HurtBox 
+     */
+    void RegisterVirtualHurtBox(const FBMHurtBoxDefinition& Def);
+
+    /**
+     * ȡ HurtBox б
+     *
+     * @return  HurtBox ĳ
+     */
+    const TArray<FBMHurtBoxDefinition>& GetVirtualHurtBoxes() const { return VirtualHurtBoxes; }
+
+    /** Ƿ HurtBox */
+    bool HasVirtualHurtBoxes() const { return VirtualHurtBoxes.Num() > 0; }
+
+    /**
+     * ֵ HurtBox 任
+     *
+     *  SkeletalMesh ռ任㣬
+     *
+     * @param Index  HurtBox ±
+     * @param OutTransform 任
+     * @return ±Ч Mesh ʱ true
+     */
+    bool GetVirtualHurtBoxWorldTransform(int32 Index, FTransform& OutTransform) const;
+
+    /**
+     * ѯ OBB ཻ HurtBox
+     *
+     * ֻвѯʱãཻʱľһ
+     *
+     * @param BoxToWorld ѯ OBB 任
+     * @param BoxExtent ѯ OBB İߴ
+     * @param OutHurtBoxToWorld ѡ HurtBox 任
+     * @return ཻ HurtBox ±ꣻû򷵻 INDEX_NONE
+     */
+    int32 FindOverlappingVirtualHurtBox(const FTransform& BoxToWorld, const FVector& BoxExtent, FTransform* OutHurtBoxToWorld = nullptr) const;
+
+    /**
+     * ȡ HurtBox Ĵɸ
+     *
+     * λ HurtBox רͨĽ壬ֻежӪ HitBox ص
+     *
+     * @return δ HurtBox ʱΪ nullptr
+     */
+    UPrimitiveComponent* GetVirtualHurtBoxProxy() const;
+
+    /**
+     * ΪΧ˺Ӧòλ
+     *
+     * Χ˺ûоеײ壬ȡ Origin ܻλ HurtBox
+     * Ӧ䲿λ/
+     *
+     * @param InOutInfo ˺Ϣ
+     * @param Origin Χ˺ԭ
+     */
+    void ApplyAreaDamageModifiers(FBMDamageInfo& InOutInfo, const FVector& Origin) const;
+
 protected:
 
     /**
@@ -261,6 +334,19 @@ protected:
      * @return ɹܷ trueʧܷ false
      */
     virtual bool TryEvadeIncomingHit(const FBMDamageInfo& InInfo);
+
+    /**
+     * е HitBox бԤΪ
+     *
+     *  HitBox  BeginPlay ֮ãƵ±ӳʱѽ
+     * δƻ Warning༭»У鶯 HitBoxWindow ĸ
+     *
+     * @param HitBoxNames õ HitBox б
+     * @param Anim Ϊգڱ༭У飩
+     * @param Context ־ģ繥 Id
+     * @return Ԥõ HitBox 
+     */
+    uint64 CompileHitBoxMask(const TArray<FName>& HitBoxNames, const UAnimSequenceBase* Anim, const FString& Context) const;
 protected:
     /**
      * ֵStats
@@ -310,6 +396,30 @@ protected:
     UPROPERTY(VisibleAnywhere, Category = "BM|Components")
     TArray<TObjectPtr<UBMHurtBoxComponent>> HurtBoxes;
 
+    /**
+     *  HurtBox б
+     *
+     * ռ OBB вѯʱֵ
+     */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox")
+    TArray<FBMHurtBoxDefinition> VirtualHurtBoxes;
+
+    /**  HurtBox Ƿã޵еȳرգ */
+    UPROPERTY(Transient)
+    bool bVirtualHurtBoxesEnabled = true;
+
+    /**  HurtBox Խɫҵҵ֫壩λ */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox")
+    float VirtualHurtBoxProxyPadding = 20.f;
+
+    /**  HurtBox ɸʱ */
+    UPROPERTY(Transient)
+    TObjectPtr<UCapsuleComponent> VirtualHurtBoxProxy = nullptr;
+
+    /** Ƿ Tick л HurtBox Կ */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox|Debug")
+    bool bDebugDrawVirtualHurtBoxes = false;
+
     /** ǰ HitBox б */
     UPROPERTY(Transient)
     TArray<FName> ActiveHitWindowHitBoxes;
@@ -331,6 +441,21 @@ private:
      */
     void CacheHurtBoxes();
 
+    /**
+     *  HurtBox Ĺ±Ԫλ
+     *
+     *  BeginPlay еãѹһԽΪ±꣬вѯʱֱӰ±ȡռ任
+     * ͬʱ/תΪλ
+     */
+    void CacheVirtualHurtBoxBones();
+
+    /**
+     *  HurtBox Ĵɸ
+     *
+     *  BeginPlay еã HurtBox ʱʹñӪ HurtBox ײ Profile
+     */
+    void CreateVirtualHurtBoxProxy();
+
     /**
      *  Stats ص
      *
@@ -15,6 +15,82 @@ class USpringArmComponent;
 class UCameraComponent;
 class UBMInventoryComponent;
 
+// д뻷λ㲥, ʱʱ䣩
+DECLARE_MULTICAST_DELEGATE_TwoParams(FBMOnInputBuffered, EBMCombatAction /*Action*/, double /*Time*/);
+
+/**
+ * ʱ¼
+ *
+ * жֻȽʱδڵľʱ䣬֡ʺͶʱ޹
+ */
+struct FBMBufferedInput
+{
+    EBMCombatAction Action = EBMCombatAction::None;
+
+    /** ʱʱ */
+    double Time = 0.0;
+
+    /** Ƿѱ */
+    bool bConsumed = true;
+};
+
+/**
+ * 뻷λ
+ *
+ * ¼/ܰ밴ʱ䣬д󸲸ɵļ¼
+ */
+struct BLACKMYTH_API FBMInputBuffer
+{
+    static constexpr int32 Capacity = 16;
+
+    /**
+     * Ʊ֡ɷһİʱ
+     *
+     * ֡ɷʵʰ·һ֡뱾֮֡䣬ȡе㣻
+     * һ¼ͬһ֡ڵĶΰ±Ⱥ˳
+     *
+     * @param FrameTime ֡ʱ
+     * @param DeltaSeconds ֡֡
+     * @return ʱ
+     */
+    double StampSubFrame(double FrameTime, double DeltaSeconds) const;
+
+    /**
+     * дһ
+     *
+     * @param Action ս
+     * @param Time ʱ
+     */
+    void Push(EBMCombatAction Action, double Time);
+
+    /**
+     * µһδ룬ļ¼һΪ
+     *
+     * @param OutAction µĶ
+     * @return δѵ뷵 true
+     */
+    bool ConsumeLatest(EBMCombatAction& OutAction);
+
+    /**
+     * ʱ˳ѵһδѡƥʱ [WindowStart, WindowEnd] ڵ
+     *
+     * @param Action ս
+     * @param WindowStart ڿʼʱ
+     * @param WindowEnd ڽʱ
+     * @return ҵѷ true
+     */
+    bool ConsumeInWindow(EBMCombatAction Action, double WindowStart, double WindowEnd);
+
+private:
+    FBMBufferedInput Entries[Capacity];
+
+    // һдλ
+    int32 Head = 0;
+
+    // һ¼ʱ
+    double LatestTime = TNumericLimits<double>::Lowest();
+};
+
 UCLASS()
 /**
  * ҽɫ࣬롢ӽǿơ״̬ʼԼ
@@ -95,9 +171,10 @@ public:
      * ǷӦжϵǰлܻ״̬
      *
      * @param Incoming յ˺Ϣ˺͡Դ
+     * @param OutReason жݣд״̬л¼
      * @return Ӧϵǰ򷵻 true򷵻 false
      */
-    bool ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming) const;
+    bool ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming, EBMStateChangeReason& OutReason) const;
 
     /**
      * дڲ
@@ -106,13 +183,13 @@ public:
      * ֪ͨϵͳڲŹʱӦHitBox
      *
      * @param WindowId ڱʶ
-     * @param OutHitBoxNames ҪHitBoxб
+     * @param OutHitBoxMask ҪHitBox
      * @param OutParams HitBox
-     * @return ɹڲЧHitBoxб򷵻 true򷵻 false
+     * @return ɹڲطǿ򷵻 true򷵻 false
      */
     virtual bool ResolveHitBoxWindow(
         FName WindowId,
-        TArray<FName>& OutHitBoxNames,
+        uint64& OutHitBoxMask,
         FBMHitBoxActivationParams& OutParams
     ) const override;
 
@@ -122,14 +199,14 @@ public:
      * ڽ빥״̬ʱã¼ιʹõHitBoxԼϹ
      * ںܻжͶ֪ͨϵͳѯ
      *
-     * @param HitBoxNames ιHitBoxб
+     * @param HitBoxMask ιHitBox루ɹԤ룩
      * @param Params HitBox
      * @param bUninterruptible ǷΪɴϹ
      * @param InterruptChance ͨĴϸʣΧ [0.0, 1.0]
      * @param InterruptChanceOnHeavyHit عĴϸʣΧ [0.0, 1.0]
      */
     void SetActiveAttackContext(
-        const TArray<FName>& HitBoxNames,
+        uint64 HitBoxMask,
         const FBMHitBoxActivationParams& Params,
         bool bUninterruptible,
         float InterruptChance,
@@ -283,33 +360,39 @@ public:
     void  PlayFallLoop();
 
     /**
-     * ս
+     * սд뻷λ
      *
-     * ڹٴΰ¹ʱµĶУ
-     * ʵ뻺
+     * ¼밴ʱ䣨֡ڲֵ FBMInputBuffer::StampSubFrame㲥 OnInputBuffered
+     * ״̬ݴ뵽ʱжΣѯ
      *
-     * @param Action Ҫеս
+     * @param Action Ҫ¼ս
      */
     void EnqueueAction(EBMCombatAction Action);
 
     /**
-     * һеս
+     * µһλ
      *
-     * ͷȡƳһ״̬
+     * ȡһδѵĶļ¼һΪѣֻͼ
      *
-     * @param OutAction ضеһ
-     * @return зǿҳɹһ򷵻 true򷵻 false
+     * @param OutAction µĶ
+     * @return δѵ򷵻 true򷵻 false
      */
     bool ConsumeNextQueuedAction(EBMCombatAction& OutAction);
 
     /**
-     * Ѷеһͨ
+     * ʱ䴰ڵһָ
      *
-     * вҲƳһͨϵͳ
+     * ʱ˳ҵһδѡƥʱ [WindowStart, WindowEnd] ڵļ¼
      *
-     * @return дͨɹƳ򷵻 true򷵻 false
+     * @param Action Ҫҵս
+     * @param WindowStart ڿʼʱ
+     * @param WindowEnd ڽʱ
+     * @return ҵɹ򷵻 true򷵻 false
      */
-    bool ConsumeOneQueuedNormalAttack();
+    bool ConsumeBufferedAction(EBMCombatAction Action, double WindowStart, double WindowEnd);
+
+    /** д뻺㲥 */
+    FBMOnInputBuffered OnInputBuffered;
 
     /**
      * жǷڳ
@@ -565,8 +648,8 @@ void TriggerHotbarSlot(int32 SlotIndex);
     /**
      * ʼעص״̬״̬
      *
-     *  BeginPlay еã Idle/Move/Jump/Attack ״̬ʵ
-     * עᵽ UBMStateMachineComponent Уͬʱóʼ״̬
+     *  BeginPlay еãҹ״̬壨Idle/Move/Jump/Attack ȣҹһݣ
+     * 󶨵 UBMStateMachineComponent Уͬʱóʼ״̬
      */
     void InitFSMStates();
 
@@ -629,6 +712,14 @@ void TriggerHotbarSlot(int32 SlotIndex);
      */
     void BuildAttackSteps();
 
+    /**
+     * Ԥ뼼ܵ HitBox 
+     *
+     *  BeginPlay еãHitBox ѽӳ֮󣩣
+     * ڿʱֱӰ뼤Ʋ
+     */
+    void CompileHitBoxMasks();
+
 private:
     /**
      * 
@@ -760,14 +851,13 @@ public:
     UPROPERTY(EditAnywhere, Category = "BM|Player|Assets")
     TObjectPtr<UAnimSequence> AnimDeath = nullptr;
 
-    // 뻺壺֧ζΰ
-    UPROPERTY(Transient)
-    TArray<EBMCombatAction> ActionQueue;
+    // 뻷λ壺¼/ܰ밴ʱ䣨֡ڲֵʱ䣩
+    FBMInputBuffer InputBuffer;
 
     // ǰ
     bool bHasActiveAttackContext = false;
 
-    TArray<FName> ActiveHitBoxNames;
+    uint64 ActiveHitBoxMask = 0;
     FBMHitBoxActivationParams ActiveHitBoxParams;
 
     bool bActiveUninterruptible = false;
@@ -43,29 +43,10 @@ private:
     // Consume stamina test
     void ConsumeStaminaTest();
 
-    // Skill cooldown testing
-    void TriggerSkillCooldown(FName SkillId, float TotalSeconds);
-    void OnSkillCooldownTick_Skill1();
-    void OnSkillCooldownTick_Skill2();
-    void StartSkill1Cooldown();
-    void StartSkill2Cooldown();
-    void StartSkill3Cooldown();
-
     // Test: add enough XP to gain exactly one level for HUD verification
     void DebugGainOneLevel();
-    void OnSkillCooldownTick_Skill3();
     void Input_EnterPressed();
 
-    // Skill cooldown timers
-    FTimerHandle Skill1CooldownTimer;
-    FTimerHandle Skill2CooldownTimer;
-    // Skill 1 remaining time
-    float Skill1Remaining = 0.f;
-    // Skill 2 remaining time
-    float Skill2Remaining = 0.f;
-    FTimerHandle Skill3CooldownTimer;
-    float Skill3Remaining = 0.f;
-
     // Editable test message for notification
     UPROPERTY(EditAnywhere, Category="BM|Debug")
     FString MessageTest = TEXT("Test Notification");
@@ -2,42 +2,177 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Core/BMTypes.h"
+#include <type_traits>
 #include "BMCharacterState.generated.h"
 
 class ABMCharacterBase;
+class UBMStateMachineComponent;
 
 /**
- * ɫ״̬
+ * ״̬л
  *
- * ״̬ UObject ʽڣ״̬У
- * ͨ OnEnter/OnUpdate/OnExit ״̬
+ * ״̬ GetTransitionRule и״̬幹ʱԤչת
  */
-UCLASS(Abstract)
-class BLACKMYTH_API UBMCharacterState : public UObject
+enum class EBMStateTransitionRule : uint8
 {
-    GENERATED_BODY()
+    Allow,          // ʼ
+    Deny,           // ʼվܾ
+    WhenFinished,   // ǰ״̬ʱ
+    WhenRecovering  // ǰ״̬н׶ʱ
+};
+
+/**
+ * ״̬ÿɫ
+ *
+ * ״̬״̬нɫ乲ɫصʱȫ
+ * - Ownerɫ
+ * - Flagsתжõıλ/У
+ * - ݿ飺ǰ״̬˽ݣ״̬ʱ죬뿪״̬ʱ
+ * - ֹ¼ǰ״̬"㴥"¼/ȣ״̬ڸʱɷ뿪״̬ʱȫ
+ *
+ * ݿֻܴſƽͣίоֵȣ UObject 
+ */
+struct BLACKMYTH_API FBMStateContext
+{
+    static constexpr uint8 Flag_Finished = 1 << 0;
+    static constexpr uint8 Flag_Recovering = 1 << 1;
+
+    /** ݿֽڣ */
+    static constexpr int32 DataCapacity = 128;
+
+    /** ͬʱĽֹ¼ */
+    static constexpr int32 MaxDeadlines = 4;
+
+    /** ɫ */
+    TWeakObjectPtr<ABMCharacterBase> Owner;
+
+    /** תλ */
+    uint8 Flags = 0;
+
+    bool HasFlag(uint8 Flag) const { return (Flags & Flag) != 0; }
+    void SetFlag(uint8 Flag) { Flags |= Flag; }
+    void ClearFlag(uint8 Flag) { Flags &= ~Flag; }
+
+    /**
+     * ݿй쵱ǰ״̬˽
+     *
+     * @return ¹
+     */
+    template <typename T>
+    T& EmplaceData()
+    {
+        static_assert(sizeof(T) <= DataCapacity, "State data exceeds FBMStateContext::DataCapacity");
+        static_assert(alignof(T) <= 16, "State data alignment exceeds 16 bytes");
+        static_assert(std::is_trivially_destructible_v<T>, "State data must be trivially destructible");
+
+        DataType = GetDataTypeKey<T>();
+        return *new (Data) T();
+    }
 
-public:
     /**
-     * ʼ״̬
+     * ȡǰ״̬˽
      *
-     * ״̬עᵽ״̬ǰ/ãڰɫ
+     * @return ݿдŵ T ʱָ룬򷵻 nullptr
+     */
+    template <typename T>
+    T* FindData()
+    {
+        return DataType == GetDataTypeKey<T>() ? reinterpret_cast<T*>(Data) : nullptr;
+    }
+
+    /** ݿе */
+    void ResetData() { DataType = nullptr; }
+
+    /**
+     * ȡ״̬ʱӣ룩
      *
-     * @param Owner ״̬Ľɫָ롣
+     * ֻ״̬°֡ʱƽʱšɫֹͣͣ
      */
-    virtual void Init(ABMCharacterBase* Owner);
+    double GetTime() const { return Time; }
 
+    /**
+     * ýֹ¼
+     *
+     * ͬһ¼ѹʱΪµʱ䣻ں״̬ɷ UBMCharacterState::OnDeadline
+     *
+     * @param EventId ¼ʶ״̬ж壩
+     * @param Delay ӳ٣룩
+     * @return óɹ trueλ false
+     */
+    bool SetDeadline(uint8 EventId, float Delay);
+
+    /** ȡֹ¼ */
+    void ClearDeadline(uint8 EventId);
+
+    /** ֹ¼Ƿ */
+    bool HasDeadline(uint8 EventId) const;
+
+    /** ȡȫֹ¼ */
+    void ClearDeadlines() { NumDeadlines = 0; }
+
+private:
+    friend class UBMStateMachineComponent;
+
+    /** ֹ¼ */
+    struct FDeadline
+    {
+        double Time = 0.0;
+        uint8 EventId = 0;
+    };
+
+    /**
+     * ȡѵ¼
+     *
+     * @param OutEventId ¼ʶ
+     * @return е¼ true
+     */
+    bool PopDueDeadline(uint8& OutEventId);
+
+    /** ״̬ʱ */
+    double Time = 0.0;
+
+    /** Ľֹ¼ */
+    FDeadline Deadlines[MaxDeadlines];
+    int32 NumDeadlines = 0;
+
+    template <typename T>
+    static const void* GetDataTypeKey()
+    {
+        static const uint8 Key = 0;
+        return &Key;
+    }
+
+    /** ݿ鵱ǰŵͱʶ */
+    const void* DataType = nullptr;
+
+    alignas(16) uint8 Data[DataCapacity];
+};
+
+/**
+ * ɫ״̬
+ *
+ * ״̬Ĭ϶CDOʽнɫ乲κνɫݣ
+ * ͨ OnEnter/OnUpdate/OnExit ״̬ڣʱݴ FBMStateContext 
+ */
+UCLASS(Abstract)
+class BLACKMYTH_API UBMCharacterState : public UObject
+{
+    GENERATED_BODY()
+
+public:
     /**
      * ״̬ص
      *
      * ״̬л״̬ʱáڴִУ
      * - Ŷ
-     * - ñ
+     * - ״̬˽
      * - /
      *
+     * @param Ctx ɫ״̬
      * @param DeltaTime һθµʱ
      */
-    virtual void OnEnter(float DeltaTime) {}
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const {}
 
     /**
      * ״̬»ص
@@ -46,41 +181,65 @@ public:
      * - ״̬ڲжʱ
      * - ״̬л
      *
+     * @param Ctx ɫ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnUpdate(float DeltaTime) {}
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const {}
 
     /**
      * ״̬˳ص
      *
      * ״̬Ӹ״̬л뿪ʱáڴִУ
      * - ʱ
-     * - ʱ/¼
+     * - ¼
      *
+     * @param Ctx ɫ״̬
      * @param DeltaTime һθµʱ
      */
-    virtual void OnExit(float DeltaTime) {}
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const {}
 
     /**
-     * жǷӵǰ״̬лĿ״̬
+     * ֹ¼ص
      *
-     * д÷ʵ״̬лԼ
+     * ״̬ڸɷ״̬ͨ FBMStateContext::SetDeadline õĵ¼
+     * ڱ֡ OnUpdate ã뿪״̬δڵ¼ɷ
      *
-     * @param StateName Ŀ״̬
-     * @return л򷵻 true򷵻 false
+     * @param Ctx ɫ״̬
+     * @param EventId ¼ʶ
      */
-    virtual bool CanTransitionTo(FName StateName) const { return true; }
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const {}
 
     /**
-     * ȡ״̬󶨵Ľɫ
+     * ȡӸ״̬лĿ״̬Ĺ
      *
-     * @return 󶨵Ľɫָ
+     * ֻڹ״̬ʱһΣдת
+     *
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    ABMCharacterBase* GetContext() const { return Context.Get(); }
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const { return EBMStateTransitionRule::Allow; }
 
 protected:
     /**
-     * ״̬ɫ
+     * ȡɫǰڱ״̬ʱ
+     *
+     * ίлصʹãɫл״̬ʱ nullptr
+     *
+     * @param Owner ɫ
+     * @return ָ룻ڱ״̬ʱ nullptr
+     */
+    FBMStateContext* GetActiveContext(const ABMCharacterBase* Owner) const;
+
+    /**
+     * ȡɫǰڱ״̬ʱ˽
+     *
+     * @param Owner ɫ
+     * @return ָ룻ڱ״̬Ͳʱ nullptr
      */
-    TWeakObjectPtr<ABMCharacterBase> Context;
+    template <typename T>
+    T* GetActiveData(const ABMCharacterBase* Owner) const
+    {
+        FBMStateContext* Ctx = GetActiveContext(Owner);
+        return Ctx ? Ctx->FindData<T>() : nullptr;
+    }
 };
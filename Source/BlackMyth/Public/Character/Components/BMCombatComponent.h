@@ -7,11 +7,37 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogBMCombat, Log, All);
 
+// stat BMCombatHitBox/Χ˺ս·
+DECLARE_STATS_GROUP(TEXT("BMCombat"), STATGROUP_BMCombat, STATCAT_Advanced);
+
 DECLARE_MULTICAST_DELEGATE_OneParam(FBMOnActionRequested, EBMCombatAction /*Action*/);
 
 // ͳһ
 DECLARE_MULTICAST_DELEGATE_OneParam(FBMOnActionRequested, EBMCombatAction);
 
+// ȴʼ / ȴÿȴ㲥һΣ
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FBMOnCooldownStarted, FName /*Key*/, float /*EndTime*/, float /*Duration*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FBMOnCooldownReady, FName /*Key*/);
+
+/**
+ * ȴǼ
+ *
+ * ¼Խʱ䣨World Timeʣʱɲѯм
+ */
+struct FBMCooldownEntry
+{
+    FName Key = NAME_None;
+
+    /** ȴʱWorld Time */
+    float EndTime = 0.f;
+
+    /** ȴʱ */
+    float Duration = 0.f;
+
+    /** ǷȴУ¼㲥Ϊ false */
+    bool bActive = false;
+};
+
 UCLASS(ClassGroup = (BM), meta = (BlueprintSpawnableComponent))
 class BLACKMYTH_API UBMCombatComponent : public UActorComponent
 {
@@ -20,6 +46,8 @@ class BLACKMYTH_API UBMCombatComponent : public UActorComponent
 public:
     UBMCombatComponent();
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /**
      * ִս
      *
@@ -127,6 +155,48 @@ public:
      */
     void ResetAllCooldowns();
 
+    /**
+     * ȡȫȴǼ
+     *
+     *  HUD ڰʱͬڽеȴbActive  EndTime ڵǰʱ䣩
+     */
+    const TArray<FBMCooldownEntry>& GetCooldownEntries() const { return CooldownEntries; }
+
+    /** ȴʼύȴʱ㲥һΣ */
+    FBMOnCooldownStarted OnCooldownStarted;
+
+    /** ȴڻʱ㲥һΣ */
+    FBMOnCooldownReady OnCooldownReady;
+
+    /**
+     * Χ˺ĿӲ
+     *
+     * FBMAoEDamageSpec::MaxTargets ᱻضϵֵ֤νɱн
+     */
+    static constexpr int32 MaxAoETargets = 64;
+
+    /**
+     * 㷶Χ˺/׶/ң
+     *
+     * ̣
+     * - ڵжӪ HurtBox ͨһοռѯɫȥز״//Ӫ
+     * -  Spec.Priority 򲢽ضϵĿ
+     * - һԼȫܺߵĲλ//Ԫ
+     * - ÿֻܺһΣкϲ FBMDamageInfo::HitCount
+     *
+     * @param Spec Χ˺
+     * @return ν
+     */
+    FBMAoEDamageResult ApplyAreaDamage(const FBMAoEDamageSpec& Spec);
+
+    /**
+     * ηΧ˺ĺʱԤ㣨΢룩
+     *
+     * ʱ Warning stat BMCombat ۲죻<= 0 رռ
+     */
+    UPROPERTY(EditAnywhere, Category = "BM|Combat|AoE")
+    float AoEBudgetMicroseconds = 250.f;
+
 
 private:
     bool bActionLocked = false;
@@ -137,9 +207,26 @@ private:
     UPROPERTY(Transient)
     FBMHitBoxActivationParams ActiveHitBoxParams;
 
-    // Key -> CooldownEndTime (WorldSeconds)
-    UPROPERTY(Transient)
-    TMap<FName, float> CooldownEndTimes;
+    // ڶѽڵ㣺EndTime Ǽһ»ǼʧЧʱΪڽڵ㣬ʱ
+    struct FBMCooldownHeapNode
+    {
+        float EndTime = 0.f;
+        int32 EntryIndex = INDEX_NONE;
+
+        bool operator<(const FBMCooldownHeapNode& Other) const { return EndTime < Other.EndTime; }
+    };
+
+    // ȴǼ±ȶֻɾ
+    TArray<FBMCooldownEntry> CooldownEntries;
+
+    // Key -> CooldownEntries ±
+    TMap<FName, int32> CooldownIndexByKey;
+
+    //  EndTime еСѣֻ֪ͨ
+    TArray<FBMCooldownHeapNode> CooldownHeap;
+
+    // ΨһĵڶʱʼָѶ
+    FTimerHandle CooldownExpiryTimer;
 
     UPROPERTY(Transient)
     bool bHasActiveHitBoxContext = false;
@@ -154,4 +241,16 @@ private:
      * @return ǰʱ䣨룩
      */
     float GetWorldTimeSecondsSafe() const;
+
+    /** ѶĹڽڵ㣬ѵڶʱ׼µĶѶ */
+    void ScheduleCooldownExpiry();
+
+    /** ڶʱصѵڵȴ㲥 */
+    void HandleCooldownExpiry();
+
+    /** 㲥ȴʼҽɫͬʱת EventBus */
+    void BroadcastCooldownStarted(const FBMCooldownEntry& Entry);
+
+    /** 㲥ȴҽɫͬʱת EventBus */
+    void BroadcastCooldownReady(FName Key);
 };
@@ -5,6 +5,7 @@
 #include "BMExperienceComponent.generated.h"
 
 class UBMEventBusSubsystem;
+struct FBMDataDelta;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogBMExperience, Log, All);
 
@@ -152,6 +153,13 @@ public:
 protected:
     virtual void BeginPlay() override;
 
+    /**
+     * 游戏结束时调用
+     * 
+     * 取消数据就绪回调与数据热重载订阅
+     */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
     /**
      * 获取事件总线子系统（用于发送事件到UI）
@@ -194,6 +202,26 @@ private:
      */
     void ApplyLevelUpBonuses();
 
+    /**
+     * 数据热重载回调
+     * 
+     * 成长表中当前等级的行变化时重新应用属性（保持 HP/Stamina 比例），并刷新经验显示
+     */
+    void HandleDataDelta(const FBMDataDelta& Delta);
+
+    /** 数据热重载订阅句柄 */
+    FDelegateHandle DataDeltaHandle;
+
+    /**
+     * 数据就绪回调
+     *
+     * 经验上限来自成长表，就绪后再广播初始经验状态
+     */
+    void HandleDataReady();
+
+    /** 等待数据就绪的回调句柄 */
+    FDelegateHandle DataReadyHandle;
+
     /** 当前玩家等级 */
     UPROPERTY(VisibleAnywhere, Category = "BM|Experience", meta = (AllowPrivateAccess = "true"))
     int32 Level = 1;
@@ -4,6 +4,7 @@
 #include "Components/ActorComponent.h"
 #include "Core/BMTypes.h"
 #include "DrawDebugHelpers.h"
+#include "UObject/ObjectKey.h"
 #include "BMHitBoxComponent.generated.h"
 
 class UBoxComponent;
@@ -36,6 +37,30 @@ struct FBMHitRecord
 };
 
 
+/**
+ *  HurtBox ¼
+ *
+ * HitBox ܻߵ HurtBox صڼ䱣
+ * ÿܻ֡ߵ HurtBox һ OBB խ⣬л뿪Ƴ
+ */
+USTRUCT()
+struct FBMPendingVirtualHit
+{
+    GENERATED_BODY()
+
+    /**  HitBox ± */
+    int32 HitBoxIndex = INDEX_NONE;
+
+    /**  HitBox ײ */
+    TWeakObjectPtr<UBoxComponent> HitBoxComp;
+
+    /** ܻ */
+    TWeakObjectPtr<ABMCharacterBase> Victim;
+
+    /** ܻ߱صĴɸ */
+    TWeakObjectPtr<UPrimitiveComponent> VictimComp;
+};
+
 /**
  * HitBox ö
  *
@@ -122,6 +147,9 @@ public:
      */
     UBMHitBoxComponent();
 
+    /** ɫͬʱ HitBox ޣHitBox λ */
+    static constexpr int32 MaxHitBoxCount = 64;
+
     /**
      * ˺ֵ
      *
@@ -179,6 +207,65 @@ public:
      */
     void DeactivateHitBoxesByNames(const TArray<FName>& HitBoxNames);
 
+    /**
+     * Ԥ뼤 HitBox
+     *
+     *  ResolveHitBoxMask ڶ幹һɣڿֻλ㣬ڴ
+     *
+     * @param Mask HitBox 루 i λӦ Definitions[i]
+     * @param Params 
+     */
+    void ActivateHitBoxesByMask(uint64 Mask, const FBMHitBoxActivationParams& Params);
+
+    /**
+     * Ԥرն HitBox
+     *
+     * @param Mask HitBox 
+     */
+    void DeactivateHitBoxesByMask(uint64 Mask);
+
+    /**
+     *  HitBox бΪ
+     *
+     * Ӧڹ񹹽ɺһβ
+     *
+     * @param HitBoxNames HitBox б
+     * @param OutUnresolved ѡ޷
+     * @return HitBox 룻޷Ʋλ
+     */
+    uint64 ResolveHitBoxMask(const TArray<FName>& HitBoxNames, TArray<FName>* OutUnresolved = nullptr) const;
+
+    /**
+     * бΪ룬÷綯 Notifyڱ
+     *
+     * Notify ԴвŸöĽɫֻ HitBox ִϣ
+     * ע¶ʱʧЧ
+     *
+     * @param Key ͨΪ Notify
+     * @param HitBoxNames HitBox б
+     * @return HitBox 
+     */
+    uint64 ResolveCachedHitBoxMask(const UObject* Key, const TArray<FName>& HitBoxNames);
+
+    /**
+     *  HitBox ƶӦĶ±
+     *
+     * @param HitBoxName HitBox 
+     * @return ±ꣻڻ򳬳λʱ INDEX_NONE
+     */
+    int32 FindHitBoxIndex(FName HitBoxName) const;
+
+    /**
+     * ָ± HitBox Ƿڼ״̬
+     *
+     * @param Index HitBox ±
+     * @return  true
+     */
+    bool IsHitBoxActive(int32 Index) const
+    {
+        return Index >= 0 && Index < MaxHitBoxCount && (ActiveMask & (1ull << Index)) != 0;
+    }
+
     /**
      * ر HitBox
      *
@@ -260,9 +347,9 @@ static FName TypeToName(EBMHitBoxType Type);
 /**
  * ȷָӦ UBoxComponent Ѵɳʼ
  *
- * @param Def HitBox ö
+ * @param Index HitBox ±
  */
-void EnsureCreated(const FBMHitBoxDefinition& Def);
+void EnsureCreated(int32 Index);
 
 /**
  *  HitBox ͲҶ
@@ -275,10 +362,10 @@ const FBMHitBoxDefinition* FindDefByType(EBMHitBoxType Type) const;
 /**
  *  HitBox ײ״̬
  *
- * @param HitBoxName HitBox 
+ * @param Index HitBox ±
  * @param bEnabled Ƿײ
  */
-void SetHitBoxCollisionEnabled(FName HitBoxName, bool bEnabled);
+void SetHitBoxCollisionEnabled(int32 Index, bool bEnabled);
 
 /**
  * Ͳƥ HitBox 
@@ -288,6 +375,57 @@ void SetHitBoxCollisionEnabled(FName HitBoxName, bool bEnabled);
  */
 TArray<FName> FindNamesByType(EBMHitBoxType Type) const;
 
+/**
+ * λϲƥ HitBox 
+ *
+ * @param TypeMask HitBox λϣBMGameplayBits::HitBoxTypeBit İλ
+ * @return λڼе HitBox б
+ */
+TArray<FName> FindNamesByTypeMask(uint8 TypeMask) const;
+
+    /**
+     * һ
+     *
+     * ִȥزԼ飬 FBMDamageInfo  Victim->TakeDamageFromHit
+     *
+     * @param HitBoxIndex е HitBox ±
+     * @param Victim ܻ
+     * @param OtherComp е HurtBox  HurtBox 
+     * @param HitLocation λ
+     * @param HitNormal з
+     * @param VirtualHurtBoxIndex е HurtBox ±ꣻ HurtBox Ϊ INDEX_NONE
+     */
+    void ApplyHit(
+        int32 HitBoxIndex,
+        ABMCharacterBase* Victim,
+        UPrimitiveComponent* OtherComp,
+        const FVector& HitLocation,
+        const FVector& HitNormal,
+        int32 VirtualHurtBoxIndex);
+
+    /**
+     * һ¼ִ HurtBox խ
+     *
+     * @param Pending ¼
+     * @return ¼ɣ/ʧЧ true֡ⷵ false
+     */
+    bool TryVirtualHit(const FBMPendingVirtualHit& Pending);
+
+    /**
+     * д HurtBox ¼
+     *
+     * ڴڼ¼ʱ Tick 
+     */
+    void ProcessPendingVirtualHits();
+
+    /**
+     * ͳƼ HitBox ڲͨʱĺѡԣbm.HitBox.CountCandidates
+     *
+     * ÿ HitBox һȫ͵صѯ״γֵΪһѡԣ
+     *  HitBox Ϊ Overlap ӦļΪͨ޳
+     */
+    void CountCandidatePairs();
+
     /**
      * HitBox Overlap صд
      *
@@ -295,7 +433,8 @@ TArray<FName> FindNamesByType(EBMHitBoxType Type) const;
      * -  ActiveHitBox ʱ
      * -  Owner ظĿ
      * - Ҫ OtherActor תΪ ABMCharacterBase
-     * - Ҫ OtherComp  "BM_HurtBox" Tag
+     * - HitBox ʹñӪרײ ProfileֻжӪ HurtBox ص Tag 
+     * - OtherComp Ϊ HurtBox ʱתΪ HurtBox խ⣬ HurtBox ֱӽ
      *
      * к
      * -  FBMDamageInfo
@@ -326,13 +465,16 @@ private:
     UPROPERTY(EditAnywhere, Category = "BM|HitBox|Definitions")
     TArray<FBMHitBoxDefinition> Definitions;
 
-    // ǰڼ HitBox ּ
+    // ǰڼ HitBox 루 i λӦ Definitions[i]
+    uint64 ActiveMask = 0;
+
+    // ±еײ
     UPROPERTY(Transient)
-    TSet<FName> ActiveHitBoxNames;
+    TArray<TObjectPtr<UBoxComponent>> BoxesByIndex;
 
-    //  -> HitBoxName ķ
+    //  -> ±ķ
     UPROPERTY(Transient)
-    TMap<TObjectPtr<UPrimitiveComponent>, FName> ComponentToHitBoxName;
+    TMap<TObjectPtr<UPrimitiveComponent>, int32> ComponentToHitBoxIndex;
 
     // Name -> Definitions ±
     UPROPERTY(Transient)
@@ -343,4 +485,13 @@ private:
 
     // м¼
     TMap<TWeakObjectPtr<AActor>, FBMHitRecord> HitRecordsThisWindow;
+
+    //  HurtBox صȴխļ¼
+    TArray<FBMPendingVirtualHit> PendingVirtualHits;
+
+    // ͳƹĺѡԣHitBox ±, 
+    TSet<TPair<int32, TObjectKey<UPrimitiveComponent>>> CandidatePairsThisWindow;
+
+    // ResolveCachedHitBoxMask Ļ棺÷ -> 
+    TMap<TObjectKey<UObject>, uint64> CachedMasksByKey;
 };
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Core/BMTypes.h"
+#include "Core/BMTagRegistry.h"
 #include "DrawDebugHelpers.h"
 
 
@@ -19,6 +20,88 @@ class USkeletalMeshComponent;
  */
 DECLARE_LOG_CATEGORY_EXTERN(LogBMHurtBox, Log, All);
 
+/**
+ *  HurtBox 壨ռ OBB 
+ *
+ * κγ/壬¼ԹΧ
+ * ֻвѯҪʱŴ SkeletalMesh ռ任ʱֵ
+ *
+ *  ABMCharacterBase::RegisterVirtualHurtBox ڹ׶ע
+ */
+USTRUCT(BlueprintType)
+struct FBMHurtBoxDefinition
+{
+    GENERATED_BODY()
+
+    /** HurtBox ƣ/־ã */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox")
+    FName Name = NAME_None;
+
+    /** ҽӹȰҲʱΪ Socket */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox|Shape")
+    FName AttachSocketOrBone = NAME_None;
+
+    /** OBB ߴ */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox|Shape")
+    FVector BoxExtent = FVector(12.f, 12.f, 12.f);
+
+    /** Թľֲ任 */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox|Shape")
+    FTransform RelativeTransform;
+
+    /** λ˺ʣ UBMHurtBoxComponent::DamageMultiplier һ£ */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox")
+    float DamageMultiplier = 1.0f;
+
+    /** Ԫб */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox")
+    TArray<EBMElementType> WeaknessTypes;
+
+    /** Ԫб */
+    UPROPERTY(EditAnywhere, Category = "BM|HurtBox")
+    TArray<EBMElementType> ResistanceTypes;
+
+    /** ʱĹ±꣨INDEX_NONE ʾδ Socket ֵ */
+    int32 CachedBoneIndex = INDEX_NONE;
+
+    /**  WeaknessTypes/ResistanceTypes ԪλϣBeginPlay ʱ棩 */
+    uint8 WeaknessMask = 0;
+    uint8 ResistanceMask = 0;
+};
+
+/**
+ * HurtBox ͨù
+ *
+ *  HurtBox  HurtBox õ˺ OBB ཻ
+ */
+namespace BMHurtBoxUtils
+{
+    /**
+     * Ӧòλ/
+     *
+     * @param InOutInfo ˺Ϣ
+     * @param DamageMultiplier λ
+     * @param WeaknessMask ԪλϣBMGameplayBits::MakeElementMask
+     * @param ResistanceMask Ԫλ
+     */
+    BLACKMYTH_API void ApplyDamageModifiers(
+        FBMDamageInfo& InOutInfo,
+        float DamageMultiplier,
+        uint8 WeaknessMask,
+        uint8 ResistanceMask);
+
+    /**
+     * ΧУOBBཻԣᶨ
+     *
+     * @param A OBB A 任Żõߴ磩
+     * @param ExtentA OBB A İߴ
+     * @param B OBB B 任
+     * @param ExtentB OBB B İߴ
+     * @return ཻ true
+     */
+    BLACKMYTH_API bool OverlapOBB(const FTransform& A, const FVector& ExtentA, const FTransform& B, const FVector& ExtentB);
+}
+
 /**
  * HurtBox ܻж
  *
@@ -148,6 +231,13 @@ public:
     void SetHurtBoxEnabled(bool bEnabled);
     bool IsHurtBoxEnabled() const;
 
+    /**
+     *  WeaknessTypes/ResistanceTypes ؽԪλ
+     *
+     * BeginPlay ʱԶã޸/ֶ
+     */
+    void RefreshElementMasks();
+
     /** Debug ɫ */
     UPROPERTY(EditAnywhere, Category = "BM|HurtBox|Debug")
     FColor DebugColor = FColor::Green;
@@ -220,4 +310,8 @@ private:
      */
     UPROPERTY(Transient)
     TWeakObjectPtr<UPrimitiveComponent> BoundComponent;
+
+    /** /Ԫλϣܻʱһΰλж */
+    uint8 WeaknessMask = 0;
+    uint8 ResistanceMask = 0;
 };
@@ -8,6 +8,7 @@
 class ABMPlayerCharacter;
 class UBMDataSubsystem;
 class UBMStatsComponent;
+enum class EBMDataTable : uint8;
 
 /**
  * 技能系统日志分类
@@ -58,10 +59,17 @@ public:
     /**
      * 游戏开始时调用
      * 
-     * 从数据子系统加载技能配置数据
+     * 数据就绪后（立即或在就绪回调中）从数据子系统加载技能配置数据
      */
     virtual void BeginPlay() override;
 
+    /**
+     * 游戏结束时调用
+     * 
+     * 取消数据热重载订阅
+     */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /**
      * 初始化技能组件
      * 
@@ -228,5 +236,18 @@ private:
      * @return 如果成功扣除资源返回 true，否则返回 false
      */
     bool ConsumeResource(ABMPlayerCharacter* PlayerCharacter) const;
+
+    /**
+     * 数据热重载回调
+     * 
+     * 技能数据行变化或数据行搬迁时重新获取 SkillData 指针
+     */
+    void HandleSkillDataChanged(EBMDataTable Table, FName RowName);
+
+    /** 数据热重载订阅句柄（对应 SkillID 所在行） */
+    FDelegateHandle SkillDataHandle;
+
+    /** 等待数据就绪的回调句柄（BeginPlay 时数据尚在加载） */
+    FDelegateHandle DataReadyHandle;
 };
 
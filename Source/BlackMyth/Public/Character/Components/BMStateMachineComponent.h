@@ -3,117 +3,239 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Core/BMTypes.h"
+#include "Character/Components/BMCharacterState.h"
 #include "BMStateMachineComponent.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogBMStateMachine, Log, All);
 
-class UBMCharacterState;
+/**
+ * ״̬
+ *
+ * һɫһݣ EBMStateId ״̬ԼԤչת
+ * תÿлıλжֻһΰλ
+ */
+struct BLACKMYTH_API FBMStateMachineDefinition
+{
+    static constexpr int32 NumStates = static_cast<int32>(EBMStateId::Count);
+
+    /** תбʾ"ʼվܾ"ıλĲøλ */
+    static constexpr uint8 DenyFlags = 0x80;
+
+    FBMStateMachineDefinition();
+
+    /**
+     * һ״̬ GetTransitionRule תӦ
+     *
+     * @param Id ״̬ʶ
+     * @param Name ״̬ڵʾ
+     * @param State ״̬ͨΪ GetDefault<T>()
+     */
+    void AddState(EBMStateId Id, FName Name, const UBMCharacterState* State);
+
+    /** ȡ״̬δעʱ nullptr */
+    const UBMCharacterState* GetState(EBMStateId Id) const
+    {
+        const int32 Index = static_cast<int32>(Id);
+        return (Index >= 0 && Index < NumStates) ? States[Index] : nullptr;
+    }
+
+    /** ȡ״̬δעʱ NAME_None */
+    FName GetStateName(EBMStateId Id) const
+    {
+        const int32 Index = static_cast<int32>(Id);
+        return (Index >= 0 && Index < NumStates) ? Names[Index] : NAME_None;
+    }
+
+    /** лıλ */
+    uint8 GetRequiredFlags(EBMStateId From, EBMStateId To) const
+    {
+        return RequiredFlags[static_cast<int32>(From)][static_cast<int32>(To)];
+    }
+
+private:
+    const UBMCharacterState* States[NumStates];
+    FName Names[NumStates];
+    uint8 RequiredFlags[NumStates][NumStates];
+};
+
+/**
+ * ״̬л
+ */
+enum class EBMStateChangeResult : uint8
+{
+    Entered,        // ѽĿ״̬
+    Denied,         // תܾ
+    Unregistered,   // Ŀ״̬δע
+    Rejected,       // 淨жлܻδϹ
+    Count
+};
+
+/**
+ * һ״̬л¼
+ *
+ * ֵֻдʱ䡢ʽַ
+ * һȫͬļ¼ֻۼ Repeatܵˢʷ
+ */
+struct FBMStateTraceRecord
+{
+    /** дʱ֡ţ 32 λظϲʱΪһΣ */
+    uint32 Frame = 0;
+
+    /** дʱʱ䣨ظϲʱΪһΣ */
+    float Time = 0.f;
+
+    EBMStateId From = EBMStateId::None;
+    EBMStateId To = EBMStateId::None;
+    EBMStateChangeReason Reason = EBMStateChangeReason::Request;
+    EBMStateChangeResult Result = EBMStateChangeResult::Entered;
+
+    /** ظ */
+    uint16 Repeat = 1;
+};
 
 UCLASS(ClassGroup = (BM), meta = (BlueprintSpawnableComponent))
 /**
  * ɫ״̬FSM
  *
- * һ Name Ϊ״̬󣬲άǰ״̬
- * - RegisterStateע״̬ʵ
- * - ChangeState/ChangeStateByNameִ״̬л
- * - TickStateǰ״̬ OnUpdate
+ * һݹ״̬壬άǰ״̬
+ * - InitStateMachine󶨶岢ʼ״̬
+ * - ChangeStateByIdתִ״̬л
+ * - TickStateƽ״̬ʱӣɷڵĽֹ¼ǰ״̬ OnUpdate
+ *
+ * ÿɫֻ涨ָ롢ǰ״̬ʶģ
+ * ״̬߼ɹ UBMCharacterState ʵ
  *
- * ״̬л״̬߼ UBMCharacterState ʵ
+ * ÿлд붨λ壨FBMStateTraceRecord bm.FSM.DumpTrace Ϊ CSV
  */
 class BLACKMYTH_API UBMStateMachineComponent : public UActorComponent
 {
     GENERATED_BODY()
 
 public:
+    /** л¼λ */
+    static constexpr int32 TraceCapacity = 64;
+
     /**
      * 캯
      *
-     * ʼ״̬뵱ǰ״̬Ϣ
+     * ʼǰ״̬Ϣ
      */
     UBMStateMachineComponent();
 
     /**
-     * עһ״̬ʵ״̬
+     * ״̬岢ʼ״̬
      *
-     * ״̬ͨʹ NewObject 
+     * ɵ÷УͨΪھ̬󣩣賤
      *
-     * @param Name ״̬
-     * @param State ״̬ʵָ룬ͨΪ UBMCharacterState ࡣ
+     * @param InDefinition ״̬
+     * @param InitialState ʼ״̬ʶ
      */
-    void RegisterState(FName Name, UBMCharacterState* State);
+    void InitStateMachine(const FBMStateMachineDefinition* InDefinition, EBMStateId InitialState);
 
     /**
-     * лָ״̬ʵ
+     * лָ״̬
      *
-     * ڲӦ˳򴥷
+     * תжǰ״̬ǷлȻ˳򴥷
      * - ǰ״̬ OnExit
-     * -  Current/CurrentStateName
+     * - ݿ顢ֹ¼λ
      * - ״̬ OnEnter
      *
-     * ⲿȵ ChangeStateByName/ChangeStateById
+     * Ŀ꼴ǰ״̬ʱ½룬Ҳдл¼
      *
-     * @param NewState Ŀ״̬ʵָ
+     * @param Id Ŀ״̬ʶ
+     * @param Reason лԭΪ Request ʱλüΪ Deadline/Update
+     * @return лɹѴĿ״̬ true״̬δעлܾ false
      */
-    void ChangeState(UBMCharacterState* NewState);
+    bool ChangeStateById(EBMStateId Id, EBMStateChangeReason Reason = EBMStateChangeReason::Request);
 
     /**
-     * ͨ״̬л״̬
+     * ¼һα淨жл
+     *
+     * лǰɵ÷жĳ繥ܻδϣı״̬
      *
-     * ע״̬в Name Ӧ״̬ʵִл
-     * ڻл򷵻 false
+     * @param Id Ӧл״̬ʶ
+     * @param Reason ԭ
+     */
+    void RecordRejectedChange(EBMStateId Id, EBMStateChangeReason Reason);
+
+    /**
+     * ʱȺл¼
      *
-     * @param Name Ŀ״̬
-     * @return лɹ trueҲ״̬лܾ false
+     * @param OutRecords ¼ᱻգ
      */
-    bool ChangeStateByName(FName Name);
+    void GetTraceRecords(TArray<FBMStateTraceRecord>& OutRecords) const;
 
     /**
      * ǰ״̬
      *
-     * ͨ Owner  Tick еãִеǰ״̬ OnUpdate
-     * ǰ״̬Ϊִκ߼
+     * ͨ Owner  Tick еã
+     * - ֡ʱƽ״̬ʱӣѰʱͣOwner  Tick Ƶʱۼʱƽ
+     * - Ⱥɷֹ¼ڼ䷢л¼
+     * - ִеǰ״̬ OnUpdate֡ɽֹ¼״̬һ֡ʼ£
      *
      * @param DeltaSeconds ֡ʱ
      */
     void TickState(float DeltaSeconds);
 
     /**
-     * ȡǰ״̬
+     * ȡǰ״̬ıʶ
+     *
+     * @return ǰ״̬ʶδκ״̬Ϊ EBMStateId::None
+     */
+    EBMStateId GetCurrentStateId() const { return CurrentStateId; }
+
+    /**
+     * ȡǰ״̬ƣã
      *
      * @return ǰ״̬δκ״̬Ϊ NAME_None
      */
-    FName GetCurrentStateName() const { return CurrentStateName; }
+    FName GetCurrentStateName() const;
 
     /**
-     * ȡǰ״̬ʵ
+     * ȡǰ״̬
      *
      * @return ǰ״ָ̬룻δκ״̬Ϊ nullptr
      */
-    UBMCharacterState* GetCurrentState() const { return Current; }
+    const UBMCharacterState* GetCurrentState() const;
+
+    /** ȡ״̬ */
+    FBMStateContext& GetStateContext() { return Context; }
 
+private:
+    /** ִһлж */
+    void EnterState(EBMStateId Id);
 
+    /** дһл¼ */
+    void RecordTrace(EBMStateId From, EBMStateId To, EBMStateChangeReason Reason, EBMStateChangeResult Result);
 
-    
 private:
     /**
-     * ǰ״̬
-     *
-     * ״̬лʱάTickState ״̬ OnUpdate
+     * ״̬
      */
-    UPROPERTY()
-    TObjectPtr<UBMCharacterState> Current = nullptr;
+    const FBMStateMachineDefinition* Definition = nullptr;
 
     /**
-     * ע״̬
-     *
-     * Key Ϊ״̬Value Ϊ״̬ʵͨ Name/Id Ŀ״̬л
+     * ǰ״̬ıʶ
      */
-    UPROPERTY()
-    TMap<FName, TObjectPtr<UBMCharacterState>> States;
+    EBMStateId CurrentStateId = EBMStateId::None;
 
     /**
-     * ǰ״̬
-     *
-     * ڿٲѯǰ״̬ıʶ
+     * ǰɫ״̬
+     */
+    FBMStateContext Context;
+
+    /**
+     * з¼ԭDeadline/UpdateʱΪ Request
+     */
+    EBMStateChangeReason DispatchReason = EBMStateChangeReason::Request;
+
+    /**
+     * л¼λ
+     */
+    FBMStateTraceRecord TraceRecords[TraceCapacity];
+
+    /**
+     * дļ¼дλ = TraceWriteCount % TraceCapacity
      */
-    FName CurrentStateName = NAME_None;
+    uint32 TraceWriteCount = 0;
 };
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Core/BMTypes.h"
+#include "Core/BMTagRegistry.h"
 #include "BMStatsComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogBMStats, Log, All);
@@ -10,6 +11,9 @@ DECLARE_LOG_CATEGORY_EXTERN(LogBMStats, Log, All);
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FBMOnDeathNative, AActor* /*Killer*/);
 
+class UBMEventBusSubsystem;
+class UBMUIManagerSubsystem;
+
 /**
  * ʱЧ
  */
@@ -42,7 +46,7 @@ struct FBMBuffInstance
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Buff")
     float Value = 0.f;
 
-    /** ʣʱ䣨룩 */
+    /** ʣʱ䣨룩 GetActiveBuffs  EndTime  */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Buff")
     float RemainingTime = 0.f;
 
@@ -50,6 +54,10 @@ struct FBMBuffInstance
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Buff")
     float TotalDuration = 0.f;
 
+    /** ڵʱWorld Time */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Buff")
+    float EndTime = 0.f;
+
     FBMBuffInstance() = default;
 
     /**
@@ -64,8 +72,38 @@ struct FBMBuffInstance
     {
     }
 
-    /** жǷѹ */
-    bool IsExpired() const { return RemainingTime <= 0.f; }
+    /**
+     * жǷѹ
+     *
+     * @param WorldTime ǰʱ䣨World Time
+     * @return ѵ EndTime  true
+     */
+    bool IsExpired(float WorldTime) const { return WorldTime >= EndTime; }
+};
+
+/**
+ * ЧۺϽ
+ *
+ * ӡƳʱ㣬ѯΪ O(1)
+ */
+struct FBMBuffAggregate
+{
+    /** ڵͣ EBMBuffType ȡλ */
+    uint32 TypeMask = 0;
+
+    /** ʣAttackBoost ٷֱۼӣ */
+    float AttackMultiplier = 1.f;
+
+    /** ָʣStaminaRegenBoost ˣ */
+    float StaminaRegenMultiplier = 1.f;
+
+    /** MaxHpBoost ṩֵޣȡֵ0 ʾޣ */
+    float MaxHpFloor = 0.f;
+
+    /** ѪʣÿָЧֵٷֱȣЧۼӣ */
+    float HealthRegenPercentPerSec = 0.f;
+
+    bool Has(EBMBuffType Type) const { return (TypeMask & (1u << static_cast<uint8>(Type))) != 0; }
 };
 
 UCLASS(ClassGroup = (BM), meta = (BlueprintSpawnableComponent))
@@ -79,10 +117,21 @@ public:
     /**
      * ʼ
      *
-     * ʼ֪ͨ UI ϵͳǰѪֵ
+     *  EventBus / UIManager ϵͳԴָʱ׼֪ͨ UI ϵͳǰѪֵ
      */
     virtual void BeginPlay() override;
 
+    /** УԴ¼Ͷʱ */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /**
+     * ѱͨ
+     *
+     * ֶͨãɶʱ UIUpdateInterval ϲͣ
+     * Ҫ UI ͬĳʹ
+     */
+    void FlushStatChanges();
+
     /**
      * Ӧ˺
      *
@@ -118,15 +167,52 @@ public:
     bool TryConsumeMP(float Amount);
 
     /**
-     * ÿ֡
+     * ȡǰָʽ㣬֡£
      *
-     * ЧʱѪָͬ UI
+     * @return ǰֵ
+     */
+    float GetCurrentStamina() const;
+
+    /**
+     * ȡǰ HPѪĽ㣩
      *
-     * @param DeltaTime ֡ʱ
-     * @param TickType Tick 
-     * @param ThisTickFunction Tick ָ
+     * @return ǰ HP
      */
-    virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    float GetCurrentHP() const;
+
+    /**
+     * жԴǷڻָ
+     *
+     * UI ػʱݴ˾Ƿȡֵ
+     *
+     * @return Ѫδʱ true
+     */
+    bool IsRegenerating() const;
+
+    /** ָʣÿ룬汶ʣ */
+    float GetStaminaRegenRate() const { return StaminaRegenPerSec * BuffAggregate.StaminaRegenMultiplier; }
+
+    /**
+     * Уָӵǰʱ Fps ָ֡ӳ٣Ľֵͬʱ̱Ƚ
+     *
+     * ֻȡ״̬ bm.Stats.RegenCheck ʹ
+     *
+     * @param Seconds Уʱ룩
+     * @param Fps ֡
+     * @param OutFrames ֵ֡
+     * @return ֵֵֵ֮֡
+     */
+    float MeasureStaminaRegenError(float Seconds, float Fps, int32& OutFrames) const;
+
+    /**
+     * Уָӵǰʱ𰴸ֵ֡֡ÿ֡ĩȽ
+     *
+     * ֡Բȣ١Զʹ
+     *
+     * @param FrameDeltas ÿ֡ļ룩
+     * @return ֵֵֵ֮֡
+     */
+    float MeasureStaminaRegenError(TConstArrayView<float> FrameDeltas) const;
 
     /**
      * Ϸǩ
@@ -150,11 +236,19 @@ public:
      */
     bool HasGameplayTag(FName Tag) const;
 
-    /** ȡݿ飨ֻ */
-    const FBMStatBlock& GetStatBlock() const { return Stats; }
+    /**
+     * ȡݿ飨ֻ
+     *
+     * е HP / Ϊǰʱ̵Ľֵ㡢޸״̬
+     */
+    FBMStatBlock GetStatBlock() const;
 
-    /** ȡݿ飨޸ģ */
-    FBMStatBlock& GetStatBlockMutable() { return Stats; }
+    /**
+     * ȡݿ飨޸ģ
+     *
+     * ǰԴһ֡޸ĺֵ°Ż¼
+     */
+    FBMStatBlock& GetStatBlockMutable();
 
     /**
      * Ѫ
@@ -264,7 +358,7 @@ public:
      * @return ǰЧб
      */
     UFUNCTION(BlueprintCallable, Category = "BM|Stats|Buff")
-    TArray<FBMBuffInstance> GetActiveBuffs() const { return ActiveBuffs; }
+    TArray<FBMBuffInstance> GetActiveBuffs() const;
 
 public:
     /** ¼ */
@@ -279,31 +373,150 @@ private:
     UPROPERTY(EditAnywhere, Category = "BM|Stats", meta = (ClampMin = "0.0"))
     float StaminaRegenPerSec = 10.f;
 
+    /** ӳٻָʱ䣨룩0 ʾָ */
+    UPROPERTY(EditAnywhere, Category = "BM|Stats", meta = (ClampMin = "0.0"))
+    float StaminaRegenDelay = 0.f;
+
+    /** Ա仯͵ UI С룩0 ʾÿ֡һ */
+    UPROPERTY(EditAnywhere, Category = "BM|Stats|UI", meta = (ClampMin = "0.0"))
+    float UIUpdateInterval = 0.f;
+
+    /** UI ʾһֵ仯һʱͣ/ֵʼ */
+    UPROPERTY(EditAnywhere, Category = "BM|Stats|UI", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float UIDisplayQuantum = 0.005f;
+
+    /** һδ͵ı仯ڸʱû±仯ʱ;ȷֵ룩 */
+    UPROPERTY(EditAnywhere, Category = "BM|Stats|UI", meta = (ClampMin = "0.0"))
+    float UIDisplaySettleDelay = 0.1f;
+
+    /** С仯ʱԵһδ͵ı仯ڸʱ;ȷֵ룩 */
+    UPROPERTY(EditAnywhere, Category = "BM|Stats|UI", meta = (ClampMin = "0.0"))
+    float UIDisplaySettleTimeout = 0.3f;
+
     /** ԾʱЧб */
     UPROPERTY(Transient)
     TArray<FBMBuffInstance> ActiveBuffs;
 
+    /** ۺϻ */
+    FBMBuffAggregate BuffAggregate;
+
+    /** 絽ڵʱʱΪ MAX_flt */
+    float NextBuffExpiryTime = MAX_flt;
+
     /** ¼Ƿѹ㲥 */
     bool bDeathBroadcasted = false;
 
-    /** Ϸǩ */
-    TSet<FName> Tags;
+    /** Ϸǩλϣλ± FBMTagRegistry 䣩 */
+    FBMTagBits TagBits;
+
+    /** Ա仯ͨλǣ */
+    static constexpr uint8 StatChannel_Health  = 1 << 0;
+    static constexpr uint8 StatChannel_Stamina = 1 << 1;
+    static constexpr uint8 StatChannel_Mana    = 1 << 2;
+
+    /** ͵ͨ */
+    uint8 DirtyStatChannels = 0;
+
+    /** ϲͶʱǷѰ */
+    bool bStatFlushScheduled = false;
+
+    /** Կ鱻ⲿ޸ĺǷҪ°Դ¼ */
+    bool bResourceRescheduleRequested = false;
+
+    /** ϲͶʱ */
+    FTimerHandle StatFlushTimer;
+
+    /** һʾδ͡ȴ;ȷֵͨ */
+    uint8 UnsettledStatChannels = 0;
+
+    /** ȷֵͶʱÿµδͱ仯 */
+    FTimerHandle StatSettleTimer;
+
+    /** ȷֵ͵ʱ䣨World Time */
+    double StatSettleDeadline = 0.0;
 
     /**
-     * Чʱ
+     * Դָʱ׼World Time
      *
-     * ʣʱ䲢ƳЧMaxHpBoost ʱǰ HP
+     * Stats.HP / Stats.Stamina Ǹʱ̵ֵǰֵ = ׼ֵ +   ʱ䣨ضϵޣ
+     */
+    double ResourceAnchorTime = 0.0;
+
+    /** ָʼʱ䣨World Timeڻ׼ʱʱӳ */
+    double StaminaRegenDelayUntil = 0.0;
+
+    /** һԴ¼Ѫ浽ߣĶʱ */
+    FTimerHandle ResourceEventTimer;
+
+    /** ͨϴ͵Ĺһֵ< 0 ʾδͣ */
+    float LastSentHealth = -1.f;
+    float LastSentStamina = -1.f;
+    float LastSentMana = -1.f;
+
+    /** BeginPlay ʱϵͳ */
+    TWeakObjectPtr<UBMEventBusSubsystem> CachedEventBus;
+    TWeakObjectPtr<UBMUIManagerSubsystem> CachedUIManager;
+
+    /** ͨͣһκϲ */
+    void MarkStatDirty(uint8 Channels);
+
+    /** ϲͶʱص */
+    void HandleStatFlushTimer();
+
+    /**
+     * ͨĵǰһֵ͵ EventBus
      *
-     * @param DeltaTime ֡ʱ
+     * @param Channels Ҫ͵ͨ
+     * @param bExact Ϊ true ʱֻҪϴͲͬͣʾ
      */
-    void TickBuffs(float DeltaTime);
+    void SendStatChannels(uint8 Channels, bool bExact);
+
+    /** δ͵ı仯ʱţƳ٣ȷֵͣ StatSettleDeadline */
+    void ScheduleStatSettle();
+
+    /** ȷֵͶʱص */
+    void HandleStatSettleTimer();
+
+    /** ǰʱ */
+    double GetWorldTimeSeconds() const;
+
+    /** Ѫʣÿ룩 */
+    float GetHealthRegenRate() const { return BuffAggregate.HealthRegenPercentPerSec * GetEffectiveMaxHp() / 100.f; }
 
     /**
-     * ѪЧ
+     * ָʱ̵ / HP
      *
-     * 㲢ӦóѪÿָ֡
+     * @param Time ʱ䣨 ResourceAnchorTime
+     */
+    float EvaluateStamina(double Time) const;
+    float EvaluateHP(double Time) const;
+
+    /** ѵǰʱ̵ĽֵдԿ鲢ƶʱ׼ʻֵ仯ǰã */
+    void SettleResources();
+
+    /** ǰʰһԴ¼ */
+    void ScheduleResourceEvent();
+
+    /** Դ¼ص㡢浽ڡͻһ¼ */
+    void HandleResourceEvent();
+
+    /**
+     * жϹһֵı仯ǷҪ
      *
-     * @param DeltaTime ֡ʱ
+     * @param NewValue ֵ
+     * @param LastSent ϴ͵ֵ
+     * @param bExact Ϊ true ʱʾ
+     * @return 仯һʾ bExact ʱκα仯/ֵδ͹ʱ true
      */
-    void TickHealthRegen(float DeltaTime);
+    bool ShouldSendStat(float NewValue, float LastSent, bool bExact = false) const;
+
+    /**
+     * 浽
+     *
+     * Դ¼ʱãδ絽ʱʱֱӷأʱƳЧۺϣMaxHpBoost ʱǰ HP
+     */
+    void TickBuffs();
+
+    /** ۺϻ絽ʱ䣨ȰʽԴ°Դ¼ */
+    void RebuildBuffAggregate();
 };
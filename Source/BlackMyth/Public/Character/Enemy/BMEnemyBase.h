@@ -9,6 +9,9 @@
 class APawn;
 class UAnimSequence;
 class UBMEnemyHealthBarComponent;
+struct FBMStateMachineDefinition;
+struct FBMEnemyData;
+enum class EBMDataTable : uint8;
 
 /**
  * 敌人基类
@@ -43,6 +46,13 @@ public:
      */
     virtual void BeginPlay() override;
 
+    /**
+     * 结束游戏生命周期
+     *
+     * 取消数据热重载订阅
+     */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /**
      * 每帧更新
      *
@@ -223,13 +233,13 @@ public:
      * 从当前激活的攻击规格获取 HitBox 配置
      *
      * @param WindowId 窗口 ID
-     * @param OutHitBoxNames 输出 HitBox 名称列表
+     * @param OutHitBoxMask 输出预编译的 HitBox 掩码
      * @param OutParams 输出 HitBox 激活参数
      * @return 成功解析返回 true
      */
     virtual bool ResolveHitBoxWindow(
         FName WindowId,
-        TArray<FName>& OutHitBoxNames,
+        uint64& OutHitBoxMask,
         FBMHitBoxActivationParams& OutParams
     ) const override;
 
@@ -257,9 +267,10 @@ public:
      * 基于霸体标记和打断概率判定
      *
      * @param Incoming 传入的伤害信息
+     * @param OutReason 判定依据，写入状态机切换记录
      * @return 应该打断返回 true
      */
-    bool ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming) const;
+    bool ShouldInterruptCurrentAttack(const FBMDamageInfo& Incoming, EBMStateChangeReason& OutReason) const;
 
     // ===== 运动控制 =====
     
@@ -298,6 +309,7 @@ public:
      *
      * 根据 GetEnemyDataID() 返回的 ID 加载数据
      * 在子类中重写 GetEnemyDataID() 指定敌人类型
+     * 数据表尚在异步加载时登记就绪回调，不阻塞 BeginPlay
      */
     virtual void LoadStatsFromDataTable();
     
@@ -321,6 +333,26 @@ protected:
      */
     void LoadAssetsFromDataTable(const struct FBMEnemyData* Data);
 
+    /**
+     * 将敌人数据应用到属性、AI、闪避与掉落参数
+     *
+     * @param Data 敌人数据
+     * @param bKeepHealthRatio 为 true 时按原血量比例换算当前 HP（热重载），否则回满
+     */
+    void ApplyEnemyData(const FBMEnemyData& Data, bool bKeepHealthRatio);
+
+    /**
+     * 数据热重载回调：本敌人的数据行变化时重新应用数值
+     *
+     * 资产路径的修改在重新生成后生效
+     */
+    void HandleEnemyDataChanged(EBMDataTable Table, FName RowName);
+
+    /**
+     * 数据就绪回调：读取本敌人的数据行，应用数值与资产并订阅热重载
+     */
+    void HandleEnemyDataReady();
+
 public:
     // ===== 闪避参数 =====
     
@@ -411,6 +443,26 @@ protected:
      */
     virtual bool TryEvadeIncomingHit(const FBMDamageInfo& InInfo) override;
 
+    // ===== 状态机 =====
+
+    /**
+     * 获取该类敌人共享的状态机定义
+     *
+     * 定义为函数内静态对象，同类敌人共用一份；子类重写以追加状态
+     *
+     * @return 状态机定义
+     */
+    virtual const FBMStateMachineDefinition* GetStateMachineDefinition() const;
+
+    /**
+     * 向定义中添加通用敌人状态
+     *
+     * Idle/Patrol/Chase/Attack/Hit/Death/Dodge
+     *
+     * @param Def 待填充的状态机定义
+     */
+    static void AddCommonEnemyStates(FBMStateMachineDefinition& Def);
+
     // ===== 内部动画工具 =====
     
     /**
@@ -440,6 +492,13 @@ protected:
         float StartTime = 0.0f,
         float MaxPlayTime = -1.0f
     );
+
+    /**
+     * 预编译 AttackSpecs 的 HitBox 掩码
+     *
+     * BeginPlay 时自动调用；运行期追加攻击规格（如 Boss 二阶段）后需再次调用
+     */
+    void CompileAttackSpecHitBoxMasks();
 protected:
     // ===== AI 参数 =====
     
@@ -597,5 +656,12 @@ private:
 
     /** 感知定时器句柄 */
     FTimerHandle PerceptionTimerHandle;
+
+    /** 数据热重载订阅（行名与句柄） */
+    FName SubscribedEnemyID = NAME_None;
+    FDelegateHandle EnemyDataHandle;
+
+    /** 等待数据就绪的回调句柄 */
+    FDelegateHandle DataReadyHandle;
 };
 
@@ -6,7 +6,6 @@
 
 class USkeletalMesh;
 class UAnimSequence;
-class UBMHurtBoxComponent;
 
 /**
  * Boss 敌人类
@@ -14,7 +13,7 @@ class UBMHurtBoxComponent;
  * 继承自 ABMEnemyBase，提供 Boss 特有功能：
  * - 两阶段战斗系统（死亡后复活进入二阶段）
  * - 自定义体型和碰撞参数
- * - 多个可配置的 HurtBox 组件（身体、腹部、头部）
+ * - 多个虚拟 HurtBox（身体、腹部、头部）
  * - 阶段转换动画和过渡逻辑
  * - 二阶段新增攻击招式和属性提升
  * - 禁用悬浮血条
@@ -28,7 +27,7 @@ public:
     /**
      * 构造函数
      *
-     * 创建 HurtBox 组件并初始化 Boss 特有参数
+     * 注册虚拟 HurtBox 并初始化 Boss 特有参数
      */
     ABMEnemyBoss();
     
@@ -142,7 +141,7 @@ void BuildHitBoxes();
 /**
  * 构建 HurtBox
  *
- * 配置身体、腹部、头部的 HurtBox 受击判定
+ * 配置身体、腹部、头部的虚拟 HurtBox 受击判定
  */
 void BuildHurtBoxes();
     
@@ -173,6 +172,15 @@ virtual void HandleDeath(const FBMDamageInfo& LastHitInfo) override;
  * @return 可被击中返回 true
  */
 virtual bool CanBeDamagedBy(const FBMDamageInfo& Info) const override;
+
+/**
+ * 获取 Boss 共享的状态机定义
+ *
+ * 在通用敌人状态之外追加 PhaseChange
+ *
+ * @return 状态机定义
+ */
+virtual const FBMStateMachineDefinition* GetStateMachineDefinition() const override;
     
 /**
  * 添加二阶段攻击规格
@@ -258,21 +266,6 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "BM|Boss|Phase2")
     float Phase2BaseDamage = 60.f;           
 
-protected:
-    // ===== HurtBox 组件 =====
-    
-    /** 身体 HurtBox 组件 */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Boss|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtBody = nullptr;
-
-    /** 腹部 HurtBox 组件 */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Boss|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtAbdomen = nullptr;
-
-    /** 头部 HurtBox 组件 */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Boss|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtHead = nullptr;
-
 protected:
     // ===== Boss 可调参数 =====
     
@@ -6,7 +6,6 @@
 
 class USkeletalMesh;
 class UAnimSequence;
-class UBMHurtBoxComponent;
 
 /**
  * ħ
@@ -27,7 +26,7 @@ public:
     /**
      * 캯
      *
-     *  HurtBox ʼħ˲
+     * ע HurtBox ʼħ˲
      */
     ABMEnemyDemon();
     
@@ -70,7 +69,7 @@ protected:
     /**
      *  HurtBox
      *
-     * ͷ HurtBox ܻж
+     * ͷ HurtBox ܻж
      */
     void BuildHurtBoxes();
     
@@ -140,16 +139,6 @@ protected:
     TSoftObjectPtr<UAnimSequence> AttackHeavy2Asset;
 
 protected:
-    // ===== HurtBox  =====
-    
-    /**  HurtBox  */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Demon|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtBody = nullptr;
-
-    /** ͷ HurtBox  */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Demon|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtHead = nullptr;
-
     // ===== ħɵ =====
     
     /** ħ䷶Χ */
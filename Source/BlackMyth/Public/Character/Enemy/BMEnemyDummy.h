@@ -6,7 +6,6 @@
 
 class USkeletalMesh;
 class UAnimSequence;
-class UBMHurtBoxComponent;
 
 /**
  * С֣Dummy
@@ -22,7 +21,7 @@ public:
     /**
      * 캯
      *
-     *  HurtBox ʼ Dummy в
+     * ע HurtBox ʼ Dummy в
      */
     ABMEnemyDummy();
     
@@ -65,7 +64,7 @@ protected:
     /**
      *  HurtBox
      *
-     * ͷ HurtBox ܻж
+     * ͷ HurtBox ܻж
      */
     void BuildHurtBoxes();
     
@@ -122,13 +121,6 @@ protected:
     TSoftObjectPtr<UAnimSequence> AttackHeavy2Asset;
 
 protected:
-    // ===== HurtBox =====
-    UPROPERTY(VisibleAnywhere, Category = "BM|Dummy|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtBody = nullptr;
-
-    UPROPERTY(VisibleAnywhere, Category = "BM|Dummy|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtHead = nullptr;
-
     // ===== ɵ =====
     UPROPERTY(EditDefaultsOnly, Category = "BM|Dummy|Tuning")
     float DummyAggroRange = 900.f;
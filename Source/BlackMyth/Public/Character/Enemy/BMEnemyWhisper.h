@@ -6,14 +6,13 @@
 
 class USkeletalMesh;
 class UAnimSequence;
-class UBMHurtBoxComponent;
 
 /**
  * Whisper 
  *
  * ̳ ABMEnemyBaseṩ Whisper йܣ
  * - 21عʽ
- * -  HurtBox 塢ͷ
+ * -  HurtBox塢ͷ
  * - ܸʺͿܶ
  * - õĵƷ
  *
@@ -28,7 +27,7 @@ public:
     /**
      * 캯
      *
-     *  HurtBox ʼ Whisper в
+     * ע HurtBox ʼ Whisper в
      */
     ABMEnemyWhisper();
     
@@ -71,7 +70,7 @@ protected:
     /**
      *  HurtBox
      *
-     * 塢ͷ HurtBox ܻж
+     * 塢ͷ HurtBox ܻж
      */
     void BuildHurtBoxes();
     
@@ -140,21 +139,6 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "BM|Whisper|Assets|Attack")
     TSoftObjectPtr<UAnimSequence> AttackHeavyAsset;
 
-protected:
-    // ===== HurtBox  =====
-    
-    /**  HurtBox  */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Whisper|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtBody = nullptr;
-
-    /**  HurtBox  */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Whisper|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtAbdomen = nullptr;
-
-    /** ͷ HurtBox  */
-    UPROPERTY(VisibleAnywhere, Category = "BM|Whisper|Components")
-    TObjectPtr<UBMHurtBoxComponent> HurtHead = nullptr;
-
 protected:
     // ===== Whisper ɵ =====
     
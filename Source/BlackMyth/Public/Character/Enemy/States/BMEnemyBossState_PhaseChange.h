@@ -2,7 +2,6 @@
 
 #include "CoreMinimal.h"
 #include "Character/Components/BMCharacterState.h"
-#include "TimerManager.h"
 #include "BMEnemyBossState_PhaseChange.generated.h"
 
 /**
@@ -28,62 +27,82 @@ public:
      *
      * ֹͣƶ޵вʼ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ˳׶ת״̬
      *
-     * ʱɱ
+     * ޵붯ͳһ FinishPhaseChange 
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
-     * жǷתָ״̬
+     * ֹ¼ص
+     *
+     * һʱִһ
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
+
+    /**
+     * ȡתָ״̬Ĺ
      *
      * ڼ䲻ɱϣת Death ״̬ɺת
      *
-     * @param StateName Ŀ״̬
-     * @return ת true򷵻 false
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
+    // ===== ֹ¼˳ =====
+
+    static constexpr uint8 Event_HoldAfterDeath = 0;
+    static constexpr uint8 Event_DeathReverse = 1;
+    static constexpr uint8 Event_Energize = 2;
+    static constexpr uint8 Event_Finish = 3;
+
     /**
      * ʼͣٽ׶
      *
      * ɺͣ٣Ȼ뵹Ž׶
+     *
+     * @param Ctx ״̬
      */
-    void StartHoldAfterDeath();
+    void StartHoldAfterDeath(FBMStateContext& Ctx) const;
 
     /**
      * ʼŽ׶
      *
      * ʵָЧɺ׶
+     *
+     * @param Ctx ״̬
      */
-    void StartDeathReverse();
+    void StartDeathReverse(FBMStateContext& Ctx) const;
 
     /**
      * ʼ׶
      *
      * ɺ FinishPhaseChange ׶
+     *
+     * @param Ctx ״̬
      */
-    void StartEnergize();
+    void StartEnergize(FBMStateContext& Ctx) const;
 
     /**
      * ɽ׶ת
      *
      * ׶Ρָƶ޵кͶ Idle ״̬
+     *
+     * @param Ctx ״̬
      */
-    void FinishPhaseChange();
-
-private:
-    /** ׶תʱ */
-    FTimerHandle StepTimer;
-
-    /** ׶תǷ */
-    bool bFinished = false;
+    void FinishPhaseChange(FBMStateContext& Ctx) const;
 };
@@ -1,6 +1,5 @@
 #pragma once
 #include "Character/Components/BMCharacterState.h"
-#include "TimerManager.h"
 #include "Core/BMTypes.h"
 #include "BMEnemyState_Attack.generated.h"
 
@@ -28,53 +27,61 @@ public:
      * ֹͣƶѡ HitBox ġŹ
      * ڿлѡ񹥻ʧл Chase ״̬
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ˳״̬
      *
      *  HitBox ġر HitBox״̬
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ÿ֡¹״̬
      *
      * ڼĿ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnUpdate(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
-     * жǷתָ״̬
+     * ֹ¼ص
+     *
+     * ʱ FinishAttack
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
+
+    /**
+     * ȡתָ״̬Ĺ
      *
      * ܻ׶תܴϣɺת״̬
      *
-     * @param StateName Ŀ״̬
-     * @return ת true򷵻 false
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
+    /** ¼ */
+    static constexpr uint8 Event_Finish = 0;
+
     /**
      * ɹ
      *
      * ɱǲл Chase ״̬
+     *
+     * @param Ctx ״̬
      */
-    void FinishAttack();
-
-private:
-    /** ɶʱ */
-    FTimerHandle AttackFinishHandle;
-
-    /** Ƿ */
-    bool bFinished = false;
-
-    /** ѡĹʽ */
-    FBMEnemyAttackSpec ActiveAttack;
+    void FinishAttack(FBMStateContext& Ctx) const;
 };
\ No newline at end of file
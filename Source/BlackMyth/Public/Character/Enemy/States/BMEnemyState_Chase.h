@@ -22,9 +22,10 @@ public:
      *
      * űѭƶٶΪ׷ٶ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ÿ֡׷״̬
@@ -34,7 +35,8 @@ public:
      * -  Patrol/Idle ״̬ʧȥĿ꣩
      * - ׷ٶл
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnUpdate(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
 };
\ No newline at end of file
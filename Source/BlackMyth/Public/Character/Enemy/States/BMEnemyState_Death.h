@@ -1,9 +1,10 @@
 #pragma once
 
 #include "Character/Components/BMCharacterState.h"
-#include "TimerManager.h"
 #include "BMEnemyState_Death.generated.h"
 
+class ABMEnemyBase;
+
 /**
  * ״̬
  *
@@ -26,29 +27,41 @@ public:
      * ֹͣƶر HitBoxײ
      * ӳٶʱ Actor
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
+
+    /**
+     * ֹ¼ص
+     *
+     *  FinishDeath
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
 
     /**
-     * жǷתָ״̬
+     * ȡתָ״̬Ĺ
      *
      * ״̬Ϊս״̬תκ״̬
      *
-     * @param StateName Ŀ״̬
-     * @return ʼշ false
+     * @param Target Ŀ״̬ʶ
+     * @return ʼշ Deny
      */
-    virtual bool CanTransitionTo(FName StateName) const override { return false; }
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override { return EBMStateTransitionRule::Deny; }
 
 private:
+    /** ¼ */
+    static constexpr uint8 Event_Finish = 0;
+
     /**
      * 
      *
      *  Actor Ϊ 0.1 
+     *
+     * @param E ĵ
      */
-    void FinishDeath();
-
-private:
-    /** ɶʱ */
-    FTimerHandle DeathFinishHandle;
+    static void FinishDeath(ABMEnemyBase* E);
 };
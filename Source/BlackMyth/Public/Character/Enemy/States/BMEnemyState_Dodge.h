@@ -4,6 +4,27 @@
 #include "Character/Components/BMCharacterState.h"
 #include "BMEnemyState_Dodge.generated.h"
 
+/**
+ * ״̬ÿɫ
+ */
+struct FBMEnemyDodgeStateData
+{
+    /** Ƿڷֲƽλ */
+    bool bStepping = false;
+
+    /** ܷ򣨹һ */
+    FVector LockedDir = FVector::BackwardVector;
+
+    /** Ŀܾ */
+    float TotalDistance = 0.f;
+
+    /** ƶ */
+    float TraveledDistance = 0.f;
+
+    /** ܶڳʱ */
+    float WindowDuration = 0.f;
+};
+
 /**
  * ״̬
  *
@@ -25,39 +46,67 @@ public:
      * ״̬
      *
      * ֹͣƶر HurtBoxܷ򲢲Ŷ
-     * ֲλƼʱƽƽɫƶ
+     * ֲλƲܽĽֹ¼
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ˳״̬
      *
-     * ʱָ HurtBox״̬
+     * ָ HurtBox״̬
+     *
+     * @param Ctx ״̬
+     * @param DeltaTime ֡ʱ
+     */
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const override;
+
+    /**
+     * ÿ֡״̬
+     *
+     * ֲλδʱƽһ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
+
+    /**
+     * ֹ¼ص
+     *
+     * ܶʱ FinishDodge
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
 
     /**
-     * жǷתָ״̬
+     * ȡתָ״̬Ĺ
      *
      * ״̬ɱϣ״̬ǿжϣɺת״̬
      *
-     * @param StateName Ŀ״̬
-     * @return ת true򷵻 false
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
+    /** ܽ¼ */
+    static constexpr uint8 Event_Finish = 0;
+
     /**
      * ֲƽλ
      *
      * ÿ֡㲢Ӧλ±Եֹ
      * Ŀϰʱֹͣƽ
+     *
+     * @param Ctx ״̬
+     * @param DeltaTime ֡ʱ
      */
-    void StepDodge();
+    void StepDodge(FBMStateContext& Ctx, float DeltaTime) const;
 
     /**
      * ָλǷпߵĵ
@@ -74,34 +123,12 @@ private:
      * 
      *
      * ɱǲݾ״̬л Chase  Idle ״̬
+     *
+     * @param Ctx ״̬
      */
-    void FinishDodge();
+    void FinishDodge(FBMStateContext& Ctx) const;
 
 private:
-    /** ɶʱ */
-    FTimerHandle TimerHandleFinish;
-
-    /** ֲλƶʱ */
-    FTimerHandle TimerHandleStep;
-
-    /** Ƿ */
-    bool bFinished = false;
-
-    /** ܷ򣨹һ */
-    FVector LockedDir = FVector::BackwardVector;
-
-    /** Ŀܾ */
-    float TotalDistance = 0.f;
-
-    /** ƶ */
-    float TraveledDistance = 0.f;
-
-    /** ܶڳʱ */
-    float WindowDuration = 0.f;
-
-    /** ϴηֲƽʱ */
-    float LastStepTime = 0.f;
-
     /** ¼̽ */
     float LedgeProbeUp = 50.f;
 
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "Character/Components/BMCharacterState.h"
-#include "TimerManager.h"
 #include "BMEnemyState_Hit.generated.h"
 
 /**
@@ -24,41 +23,41 @@ public:
      *
      * ֹͣƶܻϴ˺ϢѡʵܻӦ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
-     * ˳ܻ״̬
+     * ֹ¼ص
      *
-     * ʱɱ
+     * ܻʱ FinishHit
      *
-     * @param DeltaTime ֡ʱ
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
 
     /**
-     * жǷתָ״̬
+     * ȡתָ״̬Ĺ
      *
      * ܻ״̬״̬ϣɺת״̬
      *
-     * @param StateName Ŀ״̬
-     * @return ת true򷵻 false
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
+    /** ܻ¼ */
+    static constexpr uint8 Event_Finish = 0;
+
     /**
      * ܻ
      *
      * ݾ״̬ĿЧԾл ChasePatrol  Idle ״̬
+     *
+     * @param Ctx ״̬
      */
-    void FinishHit();
-
-private:
-    /** ܻɶʱ */
-    FTimerHandle HitFinishHandle;
-
-    /** ܻǷ */
-    bool bFinished = false;
+    void FinishHit(FBMStateContext& Ctx) const;
 };
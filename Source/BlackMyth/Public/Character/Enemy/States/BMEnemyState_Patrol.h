@@ -2,6 +2,18 @@
 #include "Character/Components/BMCharacterState.h"
 #include "BMEnemyState_Patrol.generated.h"
 
+/**
+ * Ѳ״̬ÿɫ
+ */
+struct FBMEnemyPatrolStateData
+{
+    /** Ѱ·ۻʱ */
+    float RepathAccum = 0.f;
+
+    /** ǰѲĿλ */
+    FVector PatrolDest = FVector::ZeroVector;
+};
+
 /**
  * Ѳ״̬
  *
@@ -21,9 +33,10 @@ public:
      *
      * ѭƶٶΪѲٶȲѡ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ÿ֡Ѳ״̬
@@ -31,14 +44,8 @@ public:
      * 龯״̬ٶлѡѲĿ
      * ĿҾʱл Chase ״̬
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnUpdate(float DeltaTime) override;
-
-private:
-    /** Ѱ·ۻʱ */
-    float RepathAccum = 0.f;
-
-    /** ǰѲĿλ */
-    FVector PatrolDest = FVector::ZeroVector;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
 };
\ No newline at end of file
@@ -2,16 +2,92 @@
 
 #include "CoreMinimal.h"
 #include "Character/Components/BMCharacterState.h"
-#include "TimerManager.h"
 #include "BMPlayerState_Attack.generated.h"
 
+/**
+ * һεʱᣨʱ䣬뻺ʱͬһʱӣ
+ *
+ * һδӱεļƻʱ俪ʼǴɷν¼һ֡ʼ
+ * ͬڲͬ֡µõͬʱ
+ */
+struct BLACKMYTH_API FBMComboStepTiming
+{
+    /** οʼʱ */
+    double StartTime = 0.0;
+
+    /** δڿʱ */
+    double LinkWindowOpenTime = 0.0;
+
+    /** δڹرʱ䣬С 0 ʾûд */
+    double LinkWindowCloseTime = -1.0;
+
+    /** μƻʱ */
+    double EndTime = 0.0;
+
+    /**
+     * һεʱ᣺ LinkWindowSeconds Σڽǰ LinkWindowEndOffset ر
+     *
+     * @param StartTime οʼʱ
+     * @param Duration ʱ
+     * @param LinkWindowSeconds δڳ
+     * @param LinkWindowEndOffset ڹرվνǰ
+     * @return ʱ
+     */
+    static FBMComboStepTiming Make(double StartTime, float Duration, float LinkWindowSeconds, float LinkWindowEndOffset);
+};
+
+/**
+ * ҹ״̬ÿɫ
+ *
+ * /б FBMStateContext::Flags أתж
+ */
+struct FBMPlayerAttackStateData
+{
+    /** OnInputBuffered 󶨾 */
+    FDelegateHandle InputBufferedHandle;
+
+    // ===== ʱ״̬ =====
+
+    /** ǰεʱ */
+    FBMComboStepTiming Timing;
+    
+    /** ǰж */
+    int32 ComboIndex = -1;
+    
+    /** ǷΪй */
+    bool bIsCombo = false;
+    
+    /** Ƿѻһ */
+    bool bQueuedNext = false;
+
+    // ===== Բ =====
+
+    /** ǷѱԲδʱ˳ԭ */
+    bool bSavedMovement = false;
+    
+    /** ǷʹöƶĦ */
+    bool  bSavedUseSeparateBrakingFriction = false;
+    
+    /** ĵĦ */
+    float SavedGroundFriction = 0.f;
+    
+    /** ƶٶ */
+    float SavedBrakingDecelWalking = 0.f;
+    
+    /** ƶĦϵ */
+    float SavedBrakingFrictionFactor = 0.f;
+    
+    /** ƶĦ */
+    float SavedBrakingFriction = 0.f;
+};
+
 /**
  * ҹ״̬
  *
  * ҵй߼
  * - ͨϵͳ
  * - ܹ
- * - δںѯ
+ * - δ뻺壨¼ʱж
  * - н׶
  * - Բ
  * - й
@@ -26,171 +102,150 @@ public:
     /**
      * 빥״̬
      *
-     * ʼʱӶȡӦùáʼ
+     * صӶȡӦùáʼ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
     
     /**
      * ˳״̬
      *
-     * жʱġָƶ
+     * صġָƶ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const override;
+
+    /**
+     * ֹ¼ص
+     *
+     * ַνн뼼ܽ¼
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
     
     /**
-     * жǷлĿ״̬
+     * ȡлĿ״̬Ĺ
      *
      * Death/Hit ʼDodge н׶ɹ
      *
-     * @param StateName Ŀ״̬
-     * @return л true
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
+    // ===== ֹ¼ =====
+
+    /** ǰν */
+    static constexpr uint8 Event_StepEnd = 0;
+
+    /** н */
+    static constexpr uint8 Event_RecoverEnd = 1;
+
+    /** ܽ */
+    static constexpr uint8 Event_SkillEnd = 2;
+
     /**
      * ʼĳһ
      *
-     * ùġŶδڶʱѯ
+     * ùġŶ StartTime 㱾ʱᲢöν¼
      *
+     * @param Ctx ״̬
      * @param StepIndex ж
+     * @param StartTime οʼʱ䣨Ϊһεļƻʱ䣩
      */
-    void StartComboStep(int32 StepIndex);
+    void StartComboStep(FBMStateContext& Ctx, int32 StepIndex, double StartTime) const;
     
     /**
      * ʼܹ
      *
      * ùġżܶύȴ֪ͨUI
      *
+     * @param Ctx ״̬
      * @param Spec ܹ
      */
-    void StartSkill(const struct FBMPlayerAttackSpec& Spec);
+    void StartSkill(FBMStateContext& Ctx, const struct FBMPlayerAttackSpec& Spec) const;
 
     /**
-     * δ
+     * д뻺ʱĻص
      *
-     * һ
-     */
-    void OpenLinkWindow();
-    
-    /**
-     * رδ
+     * ͨʱж
      *
-     * ٽһ
+     * @param Ctx ״̬
+     * @param Action ս
      */
-    void CloseLinkWindow();
-    
+    void HandleInputBuffered(FBMStateContext& Ctx, EBMCombatAction Action) const;
+
     /**
-     * ѯ
+     * ȷһ
+     *
+     * 뻺һʱδڵͨ
      *
-     * ÿ֡Ƿͨ룬ڿʱΪЧ
+     * @param Ctx ״̬
      */
-    void PollComboInput();
+    void TryQueueNextStep(FBMStateContext& Ctx) const;
 
     /**
      * ǰνص
      *
      * жǷһλʼ
+     *
+     * @param Ctx ״̬
      */
-    void OnStepFinished();
+    void OnStepFinished(FBMStateContext& Ctx) const;
     
     /**
      * ʼָε
      *
-     * ġжжʱ
+     * ġжн¼
      *
+     * @param Ctx ״̬
      * @param FromStepIndex еĶ
      */
-    void StartRecoverForStep(int32 FromStepIndex);
+    void StartRecoverForStep(FBMStateContext& Ctx, int32 FromStepIndex) const;
     
     /**
      * ɻص
      *
      * ɹл Idle ״̬
+     *
+     * @param Ctx ״̬
      */
-    void OnRecoverFinished();
+    void OnRecoverFinished(FBMStateContext& Ctx) const;
 
     /**
      * ɹ
      *
      * ɡ
      *
+     * @param Ctx ״̬
      * @param bInterrupted Ƿ񱻴
      */
-    void FinishAttack(bool bInterrupted);
+    void FinishAttack(FBMStateContext& Ctx, bool bInterrupted) const;
 
     /**
      * Ӧù
      *
      * ԭʼòӦùרõĦͼٲ
      *
+     * @param Data ״̬
      * @param Move ɫƶ
      */
-    void ApplyAttackInertiaSettings(class UCharacterMovementComponent* Move);
+    static void ApplyAttackInertiaSettings(FBMPlayerAttackStateData& Data, class UCharacterMovementComponent* Move);
     
     /**
      * ָƶ
      *
      * ԭǰĦͼٲ
      *
+     * @param Data ״̬
      * @param Move ɫƶ
      */
-    void RestoreMovementSettings(class UCharacterMovementComponent* Move);
-
-private:
-    /** ǰνʱ */
-    FTimerHandle TimerStepEnd;
-    
-    /** δڿʱ */
-    FTimerHandle TimerWindowOpen;
-    
-    /** δڹرնʱ */
-    FTimerHandle TimerWindowClose;
-    
-    /** ѯʱ */
-    FTimerHandle TimerPollInput;
-    
-    /** нʱ */
-    FTimerHandle TimerRecoverEnd;
-
-    /** Ƿ */
-    bool bFinished = false;
-    
-    /** Ƿн׶ */
-    bool bRecover = false;
-    
-    // ===== ʱ״̬ =====
-    
-    /** ǷΪй */
-    bool bIsCombo = false;
-    
-    /** ǰж */
-    int32 ComboIndex = -1;
-
-    /** δǷ */
-    bool bLinkWindowOpen = false;
-    
-    /** Ƿѻһ */
-    bool bQueuedNext = false;
-
-    // ===== Բ =====
-    
-    /** ĵĦ */
-    float SavedGroundFriction = 0.f;
-    
-    /** ƶٶ */
-    float SavedBrakingDecelWalking = 0.f;
-    
-    /** ƶĦϵ */
-    float SavedBrakingFrictionFactor = 0.f;
-    
-    /** ǷʹöƶĦ */
-    bool  bSavedUseSeparateBrakingFriction = false;
-    
-    /** ƶĦ */
-    float SavedBrakingFriction = 0.f;
+    static void RestoreMovementSettings(const FBMPlayerAttackStateData& Data, class UCharacterMovementComponent* Move);
 };
@@ -22,17 +22,18 @@ public:
      *
      * ƶײ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float) const override;
     
     /**
-     * жǷлĿ״̬
+     * ȡлĿ״̬Ĺ
      *
      * ״̬ս״̬лκ״̬
      *
-     * @param StateName Ŀ״̬
-     * @return ʼշ false
+     * @param Target Ŀ״̬ʶ
+     * @return ʼշ Deny
      */
-    virtual bool CanTransitionTo(FName) const override { return false; }
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId) const override { return EBMStateTransitionRule::Deny; }
 };
@@ -8,6 +8,38 @@
 
 class UCharacterMovementComponent;
 
+/**
+ * ״̬ÿɫ
+ */
+struct FBMPlayerDodgeStateData
+{
+    /** Ƿƽλ */
+    bool bStepping = false;
+
+    /** ܷ*/
+    FVector LockedDir = FVector::ForwardVector;
+
+    /** λƾ */
+    float TotalDistance = 0.f;
+    
+    /** ƶ */
+    float TraveledDistance = 0.f;
+    
+    /** ܶʱ */
+    float WindowDuration = 0.f;
+
+    // ===== ƶ =====
+
+    /** Ƿѱƶδʱ˳ԭ */
+    bool bSavedMovement = false;
+    
+    /** ĳƶת־ */
+    bool bSavedOrientToMovement = true;
+    
+    /** ٶ */
+    float SavedMaxWalkSpeed = 0.f;
+};
+
 /**
  * ״̬
  *
@@ -31,43 +63,73 @@ public:
      *
      * ȴ HurtBoxƶλƲ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
     
     /**
      * ˳״̬
      *
-     * ʱָ HurtBoxָƶ
+     * ָ HurtBoxָƶ
+     *
+     * @param Ctx ״̬
+     * @param DeltaTime ֡ʱ
+     */
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const override;
+
+    /**
+     * ֡
+     *
+     * λƽδʱִһλ
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
+
+    /**
+     * ֹ¼ص
+     *
+     * ܶʱ FinishDodge
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
     
     /**
-     * жǷлĿ״̬
+     * ȡлĿ״̬Ĺ
      *
      * Death ʼ
      *
-     * @param StateName Ŀ״̬
-     * @return л true
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
+    /** ܽ¼ */
+    static constexpr uint8 Event_Finish = 0;
+
     /**
      * 
      *
      * ɲл Idle  Move ״̬
+     *
+     * @param Ctx ״̬
      */
-    void FinishDodge();
+    void FinishDodge(FBMStateContext& Ctx) const;
     
     /**
      * λ
      *
      * ÿ֡㲢ִһСλƣԵϰ
+     *
+     * @param Ctx ״̬
+     * @param DeltaTime ֡ʱ
      */
-    void StepDodge();
+    void StepDodge(FBMStateContext& Ctx, float DeltaTime) const;
     
     /**
      * ָλǷпߵĵ
@@ -81,30 +143,6 @@ private:
     bool HasWalkableFloorAt(const FVector& WorldPos, const class ACharacter* Char) const;
 
 private:
-    /** ɶʱ */
-    FTimerHandle TimerHandleFinish;
-    
-    /** λƲʱ*/
-    FTimerHandle TimerHandleStep;
-
-    /** Ƿ */
-    bool bFinished = false;
-
-    /** ܷ*/
-    FVector LockedDir = FVector::ForwardVector;
-
-    /** λƾ */
-    float TotalDistance = 0.f;
-    
-    /** ƶ */
-    float TraveledDistance = 0.f;
-    
-    /** ܶʱ */
-    float WindowDuration = 0.f;
-
-    /** ϴβʱ */
-    float LastStepTime = 0.f;
-
     // ===== Ե =====
     
     /** ̽*/
@@ -112,12 +150,4 @@ private:
     
     /** ̽ */
     float LedgeProbeDown = 150.f;
-
-    // ===== ƶ =====
-    
-    /** ĳƶת־ */
-    bool bSavedOrientToMovement = true;
-    
-    /** ٶ */
-    float SavedMaxWalkSpeed = 0.f;
 };
@@ -20,35 +20,53 @@ public:
     /**
      * ܻ״̬
      *
-     * ˺ϢܻӲֱʱ䶨ʱ
+     * ˺ϢܻӲֱĽֹ¼
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnEnter(float) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float) const override;
     
     /**
      * ˳ܻ״̬
      *
-     * ʱ
+     * 
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ
      */
-    virtual void OnExit(float) override;
+    virtual void OnExit(FBMStateContext& Ctx, float) const override;
+
+    /**
+     * ֹ¼ص
+     *
+     * Ӳֱʱ FinishHit
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
     
     /**
-     * жǷлĿ״̬
+     * ȡлĿ״̬Ĺ
      *
      * Death ʼܻӲֱ
      *
-     * @param StateName Ŀ״̬
-     * @return л true
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override;
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override;
 
 private:
-    /** ܻӲֱʱ */
-    FTimerHandle TimerHandle;
-    
-    /** ܻǷ */
-    bool bFinished = false;
-};
\ No newline at end of file
+    /** Ӳֱ¼ */
+    static constexpr uint8 Event_Finish = 0;
+
+    /**
+     * ܻӲֱص
+     *
+     * ɡл Jump/Move/Idle
+     *
+     * @param Ctx ״̬
+     */
+    void FinishHit(FBMStateContext& Ctx) const;
+};
@@ -24,9 +24,10 @@ public:
      * - Ƿƶͼл Move
      * - Ƿл Jump
      *
+     * @param Ctx ״̬
      * @param DeltaTime һθµʱ
      */
-    virtual void OnUpdate(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ״̬ص
@@ -35,7 +36,8 @@ public:
      * - /лѭ
      * - صʱ
      *
+     * @param Ctx ״̬
      * @param DeltaTime һθµʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 };
\ No newline at end of file
@@ -5,6 +5,26 @@
 #include "Core/BMTypes.h"
 #include "BMPlayerState_Jump.generated.h"
 
+/**
+ * Ծ״̬ÿɫ
+ */
+struct FBMPlayerJumpStateData
+{
+    /**
+     * ǷѾѭ׶
+     *
+     * ڱظ EnterFallLoop()
+     */
+    bool bInFallLoop = false;
+
+    /**
+     *  Jump ״̬Ƿ񲥷Ź JumpStart
+     *
+     * 
+     */
+    bool bDidPlayJumpStart = false;
+};
+
 UCLASS()
 /**
  * Ծ״̬
@@ -28,21 +48,21 @@ public:
      * - ʱ JumpStart  Jump()
      * - 󣬽 FallLoop ѭ
      *
+     * @param Ctx ״̬
      * @param DeltaTime һ Tick ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ״̬˳ص
      *
      * ڴ Jump ״̬л״̬ʱãڣ
-     * - Ծصļʱ
-     * - ڲ
      * - ֹͣ Jump 
      *
+     * @param Ctx ״̬
      * @param DeltaTime һ Tick ʱ
      */
-    virtual void OnExit(float DeltaTime) override;
+    virtual void OnExit(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * Ծ״̬֡
@@ -51,58 +71,57 @@ public:
      * - أƶͼл Idle  Move ״̬
      * - Ǳδ FallLoop򲹳 FallLoop 
      *
+     * @param Ctx ״̬
      * @param DeltaTime һ Tick ʱ
      */
-    virtual void OnUpdate(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
-     * жϴ Jump ״̬Ƿлָ״̬
+     * ֹ¼ص
+     *
+     * ʱǷҪ FallLoop
+     *
+     * @param Ctx ״̬
+     * @param EventId ¼ʶ
+     */
+    virtual void OnDeadline(FBMStateContext& Ctx, uint8 EventId) const override;
+
+    /**
+     * ȡ Jump ״̬лָ״̬Ĺ
      *
      * ֹڿл Attack ״̬й
      * ״̬Ĭ
      *
-     * @param StateName Ŀ״̬
-     * @return л򷵻 true򷵻 false
+     * @param Target Ŀ״̬ʶ
+     * @return л
      */
-    virtual bool CanTransitionTo(FName StateName) const override { return StateName == BMStateNames::Attack ? false : true; }
+    virtual EBMStateTransitionRule GetTransitionRule(EBMStateId Target) const override
+    {
+        return Target == EBMStateId::Attack ? EBMStateTransitionRule::Deny : EBMStateTransitionRule::Allow;
+    }
 
 private:
+    /** ¼ */
+    static constexpr uint8 Event_JumpStartEnd = 0;
+
     /**
      * ǷڿУҪʱл FallLoop
      *
-     * ͨϵļʱص
+     * ͨϵĽֹ¼
      * - ɫɴڿУ EnterFallLoop() ѭ
      * - ɫѾأ
+     *
+     * @param Ctx ״̬
      */
-    void StartFallLoopIfStillInAir();
+    void StartFallLoopIfStillInAir(FBMStateContext& Ctx) const;
 
     /**
      * ѭ
      *
      * ǰжлΪ FallLoop Ѵ׶Σ
      * ͿգǴƽ̨Ե䶼ý׶
-     */
-    void EnterFallLoop();
-
-private:
-    /**
-     * ɵѭļʱ
      *
-     * Ϻ󴥷صжǷҪ FallLoop ״̬
+     * @param Ctx ״̬
      */
-    FTimerHandle JumpToFallHandle;
-
-    /**
-     * ǷѾѭ׶
-     *
-     * ڱظ EnterFallLoop()
-     */
-    bool bInFallLoop = false;
-
-    /**
-     *  Jump ״̬Ƿ񲥷Ź JumpStart
-     *
-     * 
-     */
-    bool bDidPlayJumpStart = false;
+    void EnterFallLoop(FBMStateContext& Ctx) const;
 };
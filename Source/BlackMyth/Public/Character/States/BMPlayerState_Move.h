@@ -25,9 +25,10 @@ public:
      * - ƶѭ
      * -ͬɫƶǰ
      *
+     * @param Ctx ״̬
      * @param DeltaTime һ Tick ʱ
      */
-    virtual void OnEnter(float DeltaTime) override;
+    virtual void OnEnter(FBMStateContext& Ctx, float DeltaTime) const override;
 
     /**
      * ״̬»ص
@@ -36,9 +37,10 @@ public:
      * - ɫл Jump ״̬
      * - ûƶͼٶȽֵл Idle ״̬
      *
+     * @param Ctx ״̬
      * @param DeltaTime ֡ʱ䣬Ҫʱƽ/ʱ߼
      */
-    virtual void OnUpdate(float DeltaTime) override;
+    virtual void OnUpdate(FBMStateContext& Ctx, float DeltaTime) const override;
 
 private:
     /**
@@ -32,4 +32,11 @@ public:
 
     UPROPERTY(Config, EditAnywhere, Category = "Data Tables")
     TSoftObjectPtr<UDataTable> ItemDataTable;
+
+    UPROPERTY(Config, EditAnywhere, Category = "Data Tables")
+    TSoftObjectPtr<UDataTable> ProjectileDataTable;
+
+    // Cooked gameplay data blob, relative to the project content directory (-run=BMDataBlob writes it)
+    UPROPERTY(Config, EditAnywhere, Category = "Data Tables")
+    FString GameplayDataBlobPath = TEXT("Data/Blob/GameplayData.bmdata");
 };
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FProperty;
+class UDataTable;
+class UScriptStruct;
+
+/**
+ * @brief Define the FBMDataBlob class, a read-only view of the cooked gameplay data blob
+ *
+ * The blob holds every gameplay table in one position-independent buffer: all references are byte offsets from
+ * the start of the blob, so it can be read in one go (or mapped) and used in place. Layout, all little endian
+ * and 4-byte aligned:
+ *
+ *   FHeader
+ *   FTable[NumTables]
+ *   per table: FField[NumFields], uint32 RowNames[NumRows], uint32 Rows[NumRows][NumFields]
+ *   string table: NUL terminated UTF-8 strings, referenced by offset from StringsOffset
+ *
+ * Every row is a fixed-size record of one 4-byte slot per field: floats as their bits, integers, bools and enum
+ * values as int32, and strings (FName, FString, soft paths) as string table offsets. FText slots point at three
+ * consecutive strings, namespace (package namespace stripped), key and source string, and decode back into
+ * localizable text, so the localization of the running culture still applies. The fields of a table
+ * are the reflected properties of its row struct, and SchemaHash covers their names and slot types, so a blob
+ * compiled against another version of a row struct is rejected rather than misread.
+ *
+ * Compile runs in the BMDataBlob commandlet; DecodeRows fills the typed row caches of UBMDataSubsystem. Decoding
+ * copies every row into its row struct, so each string, name and text field is still allocated per row as with a
+ * table load; the blob saves the package loads and the reflected CSV/asset import, not those allocations.
+ */
+class BLACKMYTH_API FBMDataBlob
+{
+public:
+    static constexpr uint32 Magic = 0x42444D42; // "BMDB"
+
+    // Bump when the layout below changes
+    static constexpr uint32 Version = 2;
+
+    enum class EFieldType : uint32
+    {
+        Float,
+        Int,
+        Bool,
+        Enum,
+        Text,
+        Name,
+        String,
+        SoftPath,
+    };
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 TotalSize;
+        uint32 Checksum;        // CRC32 of everything after the header
+        uint32 NumTables;
+        uint32 TablesOffset;
+        uint32 StringsOffset;
+        uint32 StringsSize;
+    };
+
+    struct FTable
+    {
+        uint32 StructName;      // string offset
+        uint32 SchemaHash;
+        uint32 NumFields;
+        uint32 FieldsOffset;
+        uint32 NumRows;
+        uint32 RowNamesOffset;  // uint32 string offsets
+        uint32 RowsOffset;      // NumRows * NumFields slots
+        uint32 Reserved;
+    };
+
+    struct FField
+    {
+        uint32 Name;            // string offset
+        EFieldType Type;
+    };
+
+    static_assert(sizeof(FHeader) == 32 && sizeof(FTable) == 32 && sizeof(FField) == 8, "Blob structs are part of the file format");
+
+    /**
+     * @brief Compares two rows of one row struct field by field, the way the blob stores them:
+     * numbers bitwise, strings (FText by source string) case-sensitively
+     */
+    class BLACKMYTH_API FRowComparer
+    {
+    public:
+        explicit FRowComparer(const UScriptStruct* Struct);
+
+        // False when the struct has a property the blob cannot store
+        bool IsValid() const { return bValid; }
+
+        bool Equals(const void* RowA, const void* RowB) const;
+
+    private:
+        TArray<TPair<const FProperty*, EFieldType>> Fields;
+        bool bValid = false;
+    };
+
+    /**
+     * @brief Compile the tables into a blob, one blob table per data table
+     * @param Tables The data tables, each with a distinct row struct
+     * @param OutBytes The blob
+     * @param OutError The reason when it fails (missing table, unsupported property, duplicate row struct)
+     * @return True if the blob was compiled
+     */
+    static bool Compile(TConstArrayView<const UDataTable*> Tables, TArray<uint8>& OutBytes, FString& OutError);
+
+    /**
+     * @brief Point the view at a blob and validate its header, checksum and table directory; the bytes are not copied
+     * @param InBytes The blob, which must outlive the view
+     * @param OutError The reason when it fails
+     * @return True if the blob can be used
+     */
+    bool Initialize(TConstArrayView<uint8> InBytes, FString& OutError);
+
+    bool IsValid() const { return Bytes.Num() > 0; }
+
+    int32 GetNumTables() const { return IsValid() ? static_cast<int32>(GetHeader().NumTables) : 0; }
+
+    int64 GetSize() const { return Bytes.Num(); }
+
+    /**
+     * @brief Get the number of rows of the table compiled from the row struct
+     * @param Struct The row struct
+     * @return The number of rows, 0 when the blob has no such table
+     */
+    int32 GetNumRows(const UScriptStruct* Struct) const;
+
+    /**
+     * @brief Whether the blob has a table compiled from the row struct; unlike GetNumRows this tells an empty table from a missing one
+     * @param Struct The row struct
+     * @return True if the table is in the blob
+     */
+    bool HasTable(const UScriptStruct* Struct) const { return FindTable(Struct) != nullptr; }
+
+    /**
+     * @brief Decode every row of the table compiled from the row struct
+     * @param Struct The row struct
+     * @param EmplaceRow Adds a default constructed row named RowName and returns it; the fields are written after
+     * @param OutError The reason when it fails (schema mismatch)
+     * @return Number of rows decoded, 0 when the blob has no such table, INDEX_NONE when the schema does not match
+     */
+    int32 DecodeRows(const UScriptStruct* Struct, TFunctionRef<void*(FName RowName)> EmplaceRow, FString& OutError) const;
+
+    /**
+     * @brief Compare the table compiled from the row struct of Source with every row of Source, field by field
+     * @param Source The data table, usually imported from the CSV source
+     * @param OutReport One line per mismatch (missing or extra rows, differing fields)
+     * @return Number of mismatches
+     */
+    int32 CompareWithTable(const UDataTable* Source, TArray<FString>& OutReport) const;
+
+private:
+    const FHeader& GetHeader() const { return *reinterpret_cast<const FHeader*>(Bytes.GetData()); }
+
+    template <typename T>
+    const T* At(uint32 Offset) const { return reinterpret_cast<const T*>(Bytes.GetData() + Offset); }
+
+    // Decode a string table entry, empty for offsets outside the string table
+    FString GetString(uint32 Offset) const;
+
+    // Decode the namespace, key and source string of a text slot, false for offsets outside the string table
+    bool GetTextParts(uint32 Offset, FString& OutNamespace, FString& OutKey, FString& OutSource) const;
+
+    // Rebuild the text of a text slot: localizable when it has a key, culture invariant otherwise
+    FText GetText(uint32 Offset) const;
+
+    const FTable* FindTable(const UScriptStruct* Struct) const;
+
+    TConstArrayView<uint8> Bytes;
+};
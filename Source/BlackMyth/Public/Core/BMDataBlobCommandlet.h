@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BMDataBlobCommandlet.generated.h"
+
+/**
+ * @brief Define the UBMDataBlobCommandlet class, compiles the gameplay data tables into the cooked data blob
+ *
+ * UnrealEditor-Cmd BlackMyth.uproject -run=BMDataBlob [-Out=<file>] [-Verify] [-VerifyOnly] [-CsvDir=<dir>]
+ *
+ * Loads every table configured in UBMGameSettings (a configured table without an asset yet is imported from its
+ * source CSV in Content/Data/Tables and saved at the configured path first), compiles them with FBMDataBlob::Compile and writes the blob to
+ * GameplayDataBlobPath (or -Out). -Verify then reads the written file back, imports each <TableName>.csv from
+ * Content/Data/Tables (or -CsvDir) into a transient table and compares it with the blob field by field; any
+ * mismatch is logged and the commandlet returns 1. -VerifyOnly checks an existing blob without rewriting it.
+ * Load time and resident size of the blob and of the tables are logged for comparison.
+ */
+UCLASS()
+class BLACKMYTH_API UBMDataBlobCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBMDataBlobCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -8,12 +8,220 @@
 #include "Data/BMPlayerGrowthData.h"
 #include "Data/BMEnemyData.h"
 #include "Data/BMItemData.h"
+#include "Data/BMProjectileData.h"
+#include "Core/BMDataBlob.h"
+#include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
 #include "BMDataSubsystem.generated.h"
 
+// Watch the source tables and CSVs and reload changed rows while playing (needs the editor's CSV importer)
+#ifndef BM_DATA_HOT_RELOAD
+#define BM_DATA_HOT_RELOAD (WITH_EDITOR && !UE_BUILD_SHIPPING)
+#endif
+
+/**
+ * @brief Define the EBMDataTable enum, the gameplay tables served by UBMDataSubsystem
+ */
+enum class EBMDataTable : uint8
+{
+    Skill,
+    Scene,
+    Element,
+    PlayerGrowth,
+    Enemy,
+    Item,
+    Projectile,
+    Count
+};
+
+/**
+ * @brief Define the FBMDataDelta struct, the rows of one table changed by a reload
+ *
+ * Changed rows are overwritten in place, so row pointers handed out earlier stay valid and see the new values.
+ * Added rows are appended; when that grows the row array, bRowsMoved is set and cached row pointers of this
+ * table must be fetched again. Removed rows are no longer found by name but their storage is kept until the
+ * next full rebuild.
+ */
+struct FBMDataDelta
+{
+    EBMDataTable Table = EBMDataTable::Count;
+    TArray<FName> ChangedRows;
+    TArray<FName> AddedRows;
+    TArray<FName> RemovedRows;
+    bool bRowsMoved = false;
+
+    bool IsEmpty() const { return ChangedRows.Num() == 0 && AddedRows.Num() == 0 && RemovedRows.Num() == 0; }
+
+    bool Contains(FName RowName) const
+    {
+        return ChangedRows.Contains(RowName) || AddedRows.Contains(RowName) || RemovedRows.Contains(RowName);
+    }
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBMDataDelta, const FBMDataDelta&);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBMDataRowChanged, EBMDataTable /*Table*/, FName /*RowName*/);
+
+/**
+ * @brief Define the TBMRowCache struct, a typed flat copy of one data table
+ *
+ * Rows are copied into a contiguous array at load and found by row name through a name -> index map,
+ * so a lookup is one FName hash probe with no context string and no struct type check.
+ * Pointers returned by Find stay valid until the cache is rebuilt.
+ */
+template <typename RowType>
+struct TBMRowCache
+{
+    TArray<RowType> Rows;
+    TMap<FName, int32> IndexByName;
+
+    /**
+     * @brief Copy every row of the table, empty when the table is missing or has another row struct
+     * @param Table The data table
+     */
+    void Build(const UDataTable* Table)
+    {
+        Reset();
+        if (!Table || !Table->GetRowStruct() || !Table->GetRowStruct()->IsChildOf(RowType::StaticStruct())) return;
+
+        const TMap<FName, uint8*>& RowMap = Table->GetRowMap();
+        Rows.Reserve(RowMap.Num());
+        IndexByName.Reserve(RowMap.Num());
+        for (const TPair<FName, uint8*>& Pair : RowMap)
+        {
+            IndexByName.Add(Pair.Key, Rows.Num());
+            Rows.Add(*reinterpret_cast<const RowType*>(Pair.Value));
+        }
+    }
+
+    /**
+     * @brief Decode the table compiled from RowType, empty when the blob has no such table
+     * @param Blob The data blob
+     * @param OutError The reason when it fails
+     * @return False when the blob was compiled against another version of RowType
+     */
+    bool Build(const FBMDataBlob& Blob, FString& OutError)
+    {
+        Reset();
+        const int32 NumRows = Blob.GetNumRows(RowType::StaticStruct());
+        Rows.Reserve(NumRows);
+        IndexByName.Reserve(NumRows);
+
+        const int32 Decoded = Blob.DecodeRows(RowType::StaticStruct(), [this](FName RowName) -> void*
+        {
+            IndexByName.Add(RowName, Rows.Num());
+            return &Rows.AddDefaulted_GetRef();
+        }, OutError);
+
+        if (Decoded == INDEX_NONE)
+        {
+            Reset();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Merge a new version of the table: overwrite changed rows in place, append added rows, unindex removed rows
+     * @param Source The new version of the table
+     * @param OutDelta Receives the changed, added and removed row names
+     */
+    void ApplyDelta(const UDataTable* Source, FBMDataDelta& OutDelta)
+    {
+        const UScriptStruct* Struct = RowType::StaticStruct();
+        if (!Source || !Source->GetRowStruct() || !Source->GetRowStruct()->IsChildOf(Struct)) return;
+
+        // 逐行比较只读字段；复制与通知只发生在变化的行上
+        const FBMDataBlob::FRowComparer Comparer(Struct);
+        const RowType* OldData = Rows.GetData();
+        const TMap<FName, uint8*>& RowMap = Source->GetRowMap();
+        for (const TPair<FName, uint8*>& Pair : RowMap)
+        {
+            const RowType& NewRow = *reinterpret_cast<const RowType*>(Pair.Value);
+            if (const int32* Index = IndexByName.Find(Pair.Key))
+            {
+                if (!Comparer.Equals(&Rows[*Index], &NewRow))
+                {
+                    Rows[*Index] = NewRow;
+                    OutDelta.ChangedRows.Add(Pair.Key);
+                }
+            }
+            else
+            {
+                IndexByName.Add(Pair.Key, Rows.Add(NewRow));
+                OutDelta.AddedRows.Add(Pair.Key);
+            }
+        }
+
+        if (IndexByName.Num() != RowMap.Num())
+        {
+            for (auto It = IndexByName.CreateIterator(); It; ++It)
+            {
+                if (!RowMap.Contains(It.Key()))
+                {
+                    OutDelta.RemovedRows.Add(It.Key());
+                    It.RemoveCurrent();
+                }
+            }
+        }
+
+        OutDelta.bRowsMoved |= Rows.GetData() != OldData;
+    }
+
+    void Reset()
+    {
+        Rows.Reset();
+        IndexByName.Reset();
+    }
+
+    const RowType* Find(FName RowName) const
+    {
+        const int32* Index = IndexByName.Find(RowName);
+        return Index ? &Rows[*Index] : nullptr;
+    }
+
+    int32 Num() const { return Rows.Num(); }
+
+    SIZE_T GetAllocatedSize() const { return Rows.GetAllocatedSize() + IndexByName.GetAllocatedSize(); }
+};
+
+/**
+ * @brief Define the EBMDataLoadState enum, where the data tables are in their load
+ */
+enum class EBMDataLoadState : uint8
+{
+    NotStarted,
+    Loading,
+    Ready,
+};
+
+DECLARE_MULTICAST_DELEGATE(FOnBMDataReady);
+
 /**
  * @brief Define the UBMDataSubsystem class, data subsystem, used to manage the data
  * @param UBMDataSubsystem The name of the class
  * @param UGameInstanceSubsystem The parent class
+ *
+ * Tables are loaded once and copied into typed row caches (TBMRowCache); player growth rows are additionally
+ * indexed by level. All Get*Data accessors read those caches and return pointers that stay valid until the
+ * caches are rebuilt. bm.Data.Bench (loaded tables) and the BlackMyth.Data.RowCacheLookup test (generated tables)
+ * compare the cached lookups with UDataTable::FindRow.
+ *
+ * The element table is compiled into a dense multiplier matrix indexed by EBMElementType (attack row, defend column);
+ * missing rows or columns are reported at load and read as 1.0. ABMCharacterBase::TakeDamageFromHit reads it for
+ * every hit; BlackMyth.Data.ElementMatrix checks every pair against the table.
+ *
+ * Initialize requests every table as one async batch (bm.Data.AsyncPreload, on by default) and returns at once.
+ * OnDataReady fires when the caches are built; CallOrRegisterOnDataReady runs a callback now if they already are.
+ * Enemies and the skill and experience components register that way at BeginPlay instead of reading the rows at once.
+ * Any accessor used before that blocks on the batch and logs who forced the load, with a callstack outside shipping;
+ * the first-frame startup log reports how many waits were forced and how long they blocked.
+ *
+ * Outside the editor the caches are decoded from the cooked data blob (FBMDataBlob, written by -run=BMDataBlob)
+ * when it exists and matches the row structs (bm.Data.UseBlob); otherwise the tables above are loaded as before.
+ *
+ * With BM_DATA_HOT_RELOAD the subsystem watches the loaded tables (editor edits and reimports) and the source CSVs
+ * (polled, bm.Data.HotReloadPoll) and merges only the rows that changed into the caches. Consumers either listen
+ * to the rows they depend on (SubscribeRow) or to whole tables (OnDataDelta); nothing else is rebuilt.
  */
 UCLASS()
 class BLACKMYTH_API UBMDataSubsystem : public UGameInstanceSubsystem
@@ -22,6 +230,45 @@ class BLACKMYTH_API UBMDataSubsystem : public UGameInstanceSubsystem
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Broadcast once the tables are loaded and the caches are built
+    FOnBMDataReady OnDataReady;
+
+    // Get the load state of the tables
+    EBMDataLoadState GetLoadState() const { return LoadState; }
+
+    // Whether the tables are loaded and the caches are built
+    bool IsDataReady() const { return LoadState == EBMDataLoadState::Ready; }
+
+    // Run the callback now if the data is ready, otherwise when it becomes ready
+    FDelegateHandle CallOrRegisterOnDataReady(FOnBMDataReady::FDelegate&& Callback);
+
+    // Block until the tables are loaded; Caller is reported in the log as the one that forced the wait
+    void WaitForData(const TCHAR* Caller) const;
+
+    // Broadcast after a reload changed rows of a table
+    FOnBMDataDelta OnDataDelta;
+
+    // Call Callback when the row is changed, added or removed by a reload (or when its table's rows move)
+    FDelegateHandle SubscribeRow(EBMDataTable Table, FName RowName, FOnBMDataRowChanged::FDelegate&& Callback);
+
+    void UnsubscribeRow(EBMDataTable Table, FName RowName, FDelegateHandle Handle);
+
+    /**
+     * @brief Merge a new version of a table into its cache and notify the consumers of the rows that changed
+     * @param Table The table
+     * @param Source The new version, with the table's row struct
+     * @return The number of changed, added and removed rows
+     */
+    int32 ReloadTable(EBMDataTable Table, const UDataTable* Source);
+
+    /**
+     * @brief Reimport the source CSV of every table whose file changed since the last check
+     * @param bForce Reimport every CSV regardless of its timestamp
+     * @return The number of rows that changed
+     */
+    int32 PollSourceCsvs(bool bForce);
 
     // Get skill data from the skill table
     const FBMSkillData* GetSkillData(FName SkillID) const;
@@ -38,12 +285,32 @@ public:
     // Get item data from the item table
     const FBMItemData* GetItemData(FName ItemID) const;
 
+    // Get projectile data from the projectile table
+    const FBMProjectileData* GetProjectileData(FName ProjectileID) const;
+
 	// Get the item table path for debugging
 	FString GetItemTablePathDebug() const;
 
 	// Get the elemental multiplier for the attack and defend elements
     float GetElementalMultiplier(FName AttackElement, FName DefendElement) const;
 
+    // Get the elemental multiplier from the matrix, two array reads (damage path)
+    float GetElementalMultiplier(EBMElementType AttackElement, EBMElementType DefendElement) const
+    {
+        EnsureDataReady(TEXT("GetElementalMultiplier"));
+        const int32 Attack = static_cast<int32>(AttackElement);
+        const int32 Defend = static_cast<int32>(DefendElement);
+        return (Attack < NumElements && Defend < NumElements) ? ElementMatrix[Attack][Defend] : 1.0f;
+    }
+
+    // Time cached lookups against UDataTable::FindRow over the loaded rows and log the results
+    void RunLookupBenchmark(int32 Iterations) const;
+
+#if WITH_EDITOR
+    // Build a table from its source CSV (Content/Data/Tables/<AssetName>.csv); nullptr when there is no CSV
+    static UDataTable* ImportTableFromSourceCsv(const TSoftObjectPtr<UDataTable>& Table, const UScriptStruct* RowStruct, UObject* Outer, EObjectFlags Flags = RF_NoFlags);
+#endif
+
 protected:
     // Cache for the tables
     UPROPERTY()
@@ -64,8 +331,115 @@ protected:
     UPROPERTY()
     UDataTable* ItemTableCache;
 
+    UPROPERTY()
+    UDataTable* ProjectileTableCache;
+
 private:
-    // Helper function to find a row in a data table
-    template <typename T>
-    T* FindRow(UDataTable* Table, FName RowName) const;
+    // Block on the load when an accessor is used before the data is ready
+    void EnsureDataReady(const TCHAR* Accessor) const
+    {
+        if (LoadState != EBMDataLoadState::Ready)
+        {
+            WaitForData(Accessor);
+        }
+    }
+
+    // Table paths from the game settings, with the C++ fallback for the item table
+    void GatherTablePaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+    // Resolve the loaded tables, build the caches and broadcast OnDataReady (once)
+    void HandleTablesLoaded();
+
+    // Copy the loaded tables into the row caches
+    void RebuildRowCaches();
+
+    // Read the cooked data blob and decode it into the row caches; false (caches empty) if it cannot be used
+    bool LoadFromBlob();
+
+    // Index the player growth rows by level
+    void RebuildGrowthIndex(const TBMRowCache<FBMPlayerGrowthData>& Source);
+
+    // Build the element matrix, enter Ready, report the load and broadcast OnDataReady
+    void CompleteLoad(const TCHAR* Source, int64 SourceBytes);
+
+    // Loaded table of the given kind, nullptr when it came from the blob or is not configured
+    UDataTable* GetTableCache(EBMDataTable Table) const;
+
+    // Merge a new version of the growth table into the level index
+    void ApplyGrowthDelta(const UDataTable* Source, FBMDataDelta& OutDelta);
+
+#if BM_DATA_HOT_RELOAD
+    // Watch the loaded tables and record the source CSV timestamps
+    void StartWatchingSources();
+
+    void StopWatchingSources();
+
+    void HandleSourceTableChanged(EBMDataTable Table);
+
+    bool TickSourcePoll(float DeltaTime);
+#endif
+
+    // Compile the element table into the multiplier matrix and report missing pairs
+    void RebuildElementMatrix();
+
+    // EBMElementType has no Count entry; keep in sync with its last value
+    static constexpr int32 NumElements = static_cast<int32>(EBMElementType::Poison) + 1;
+
+    // Typed row caches, rebuilt from the tables above or decoded from the blob
+    TBMRowCache<FBMSkillData> SkillRows;
+    TBMRowCache<FBMElementalData> ElementRows;
+    TBMRowCache<FBMSceneData> SceneRows;
+    TBMRowCache<FBMEnemyData> EnemyRows;
+    TBMRowCache<FBMItemData> ItemRows;
+    TBMRowCache<FBMProjectileData> ProjectileRows;
+
+    // Player growth rows sorted by level, and level -> row index (INDEX_NONE for missing levels)
+    TArray<FBMPlayerGrowthData> GrowthRows;
+    TArray<int32> GrowthIndexByLevel;
+
+    // Elemental multipliers, [attack][defend]
+    float ElementMatrix[NumElements][NumElements];
+
+    // Element names as used for row names and column properties, by EBMElementType value
+    FName ElementNames[NumElements];
+
+    // ===== Loading =====
+
+    EBMDataLoadState LoadState = EBMDataLoadState::NotStarted;
+
+    // Async batch of all tables, reset once they are resolved
+    TSharedPtr<FStreamableHandle> LoadHandle;
+
+    // FPlatformTime::Seconds() when the batch was requested
+    double LoadRequestTime = 0.0;
+
+    // Blob file the caches were decoded from, empty when they came from the tables
+    FString LoadedBlobPath;
+
+    // Per-row consumers, by table
+    TMap<FName, FOnBMDataRowChanged> RowSubscribers[static_cast<int32>(EBMDataTable::Count)];
+
+#if BM_DATA_HOT_RELOAD
+    // A source CSV and the timestamp it had when last imported
+    struct FWatchedCsv
+    {
+        EBMDataTable Table = EBMDataTable::Count;
+        FString Path;
+        FDateTime TimeStamp;
+    };
+
+    TArray<FWatchedCsv> WatchedCsvs;
+
+    // OnDataTableChanged bindings of the loaded tables
+    TArray<TPair<TWeakObjectPtr<UDataTable>, FDelegateHandle>> TableChangedHandles;
+
+    FTSTicker::FDelegateHandle SourcePollHandle;
+#endif
+
+    // Accessor calls that had to block on the load, and how long they blocked in total
+    int32 NumForcedWaits = 0;
+    double ForcedWaitSeconds = 0.0;
+
+    // One-shot hook that logs the boot time to the first frame
+    FDelegateHandle FirstFrameHandle;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/BMTypes.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBMTagRegistry, Log, All);
+
+/**
+ * 定宽位集合（64 位）
+ *
+ * 用于标签/阵营/元素/HitBox 类型的集合判定，"是否拥有"只需一次按位与
+ */
+struct FBMTagBits
+{
+    uint64 Bits = 0;
+
+    FBMTagBits() = default;
+    explicit constexpr FBMTagBits(uint64 InBits) : Bits(InBits) {}
+
+    /** 由单个位下标构造；下标越界时返回空集合 */
+    static constexpr FBMTagBits FromIndex(int32 Index)
+    {
+        return FBMTagBits((Index >= 0 && Index < 64) ? (uint64(1) << Index) : 0);
+    }
+
+    void Add(FBMTagBits Other) { Bits |= Other.Bits; }
+    void Remove(FBMTagBits Other) { Bits &= ~Other.Bits; }
+    void Reset() { Bits = 0; }
+
+    bool HasAny(FBMTagBits Other) const { return (Bits & Other.Bits) != 0; }
+    bool HasAll(FBMTagBits Other) const { return (Bits & Other.Bits) == Other.Bits; }
+    bool IsEmpty() const { return Bits == 0; }
+
+    FBMTagBits operator|(FBMTagBits Other) const { return FBMTagBits(Bits | Other.Bits); }
+    FBMTagBits operator&(FBMTagBits Other) const { return FBMTagBits(Bits & Other.Bits); }
+    bool operator==(FBMTagBits Other) const { return Bits == Other.Bits; }
+    bool operator!=(FBMTagBits Other) const { return Bits != Other.Bits; }
+};
+
+/**
+ * 游戏标签注册表
+ *
+ * 将 FName 标签映射到 FBMTagBits 的位下标（最多 64 个）
+ * 常用标签在构造时预注册，其余标签首次使用时注册；仅在游戏线程访问
+ */
+class BLACKMYTH_API FBMTagRegistry
+{
+public:
+    static constexpr int32 MaxTags = 64;
+
+    /** 获取全局注册表 */
+    static FBMTagRegistry& Get();
+
+    /**
+     * 查找标签的位下标，不存在时注册
+     *
+     * @param Tag 标签名
+     * @return 位下标；标签为空或注册表已满时返回 INDEX_NONE
+     */
+    int32 FindOrAddTag(FName Tag);
+
+    /**
+     * 查找标签的位下标
+     *
+     * @param Tag 标签名
+     * @return 位下标；未注册时返回 INDEX_NONE
+     */
+    int32 FindTag(FName Tag) const;
+
+    /** 标签对应的位集合（未注册时为空） */
+    FBMTagBits GetTagBits(FName Tag) const { return FBMTagBits::FromIndex(FindTag(Tag)); }
+
+    /** 由标签列表构造位集合（未注册的标签会被注册） */
+    FBMTagBits MakeTagBits(const TArray<FName>& Tags);
+
+    /** 位下标对应的标签名 */
+    FName GetTagName(int32 Index) const { return TagNames.IsValidIndex(Index) ? TagNames[Index] : NAME_None; }
+
+private:
+    FBMTagRegistry();
+
+    TMap<FName, int32> TagToIndex;
+    TArray<FName> TagNames;
+};
+
+/**
+ * @brief Define the BMGameplayTags namespace, used to store the predefined gameplay tags
+ * @param BMGameplayTags The name of the namespace
+ */
+namespace BMGameplayTags
+{
+    static const FName Boss = TEXT("Boss");
+}
+
+/**
+ * @brief Define the BMGameplayBits namespace, used to map teams, elements and hit box types to bit masks
+ * @param BMGameplayBits The name of the namespace
+ *
+ * 枚举值直接作为位下标（编译期确定），集合判定只需一次按位与
+ */
+namespace BMGameplayBits
+{
+    inline uint8 TeamBit(EBMTeam Team) { return uint8(1u << static_cast<uint8>(Team)); }
+    inline uint8 ElementBit(EBMElementType Element) { return uint8(1u << static_cast<uint8>(Element)); }
+    inline uint8 HitBoxTypeBit(EBMHitBoxType Type) { return uint8(1u << static_cast<uint8>(Type)); }
+    static_assert(static_cast<uint8>(EBMHitBoxType::Skill) < 8, "EBMHitBoxType must fit in the 8 bit hit box type mask");
+
+    /** 由元素列表构造元素位集合（供 Blueprint/编辑器的数组配置转换） */
+    inline uint8 MakeElementMask(const TArray<EBMElementType>& Elements)
+    {
+        uint8 Mask = 0;
+        for (const EBMElementType Element : Elements)
+        {
+            Mask |= ElementBit(Element);
+        }
+        return Mask;
+    }
+
+    inline bool HasElement(uint8 Mask, EBMElementType Element) { return (Mask & ElementBit(Element)) != 0; }
+
+    /**
+     * 各阵营的敌对阵营位集合
+     *
+     * 同阵营互不伤害，中立阵营与所有阵营（包括其他中立）敌对
+     */
+    inline uint8 HostileTeamsOf(EBMTeam Team)
+    {
+        static const uint8 Table[] =
+        {
+            /* Player  */ uint8((1u << uint8(EBMTeam::Enemy)) | (1u << uint8(EBMTeam::Neutral))),
+            /* Enemy   */ uint8((1u << uint8(EBMTeam::Player)) | (1u << uint8(EBMTeam::Neutral))),
+            /* Neutral */ uint8((1u << uint8(EBMTeam::Player)) | (1u << uint8(EBMTeam::Enemy)) | (1u << uint8(EBMTeam::Neutral))),
+        };
+        const uint8 Index = static_cast<uint8>(Team);
+        return Index < UE_ARRAY_COUNT(Table) ? Table[Index] : 0;
+    }
+
+    /** 阵营 A 是否可以伤害阵营 B */
+    inline bool IsHostile(EBMTeam A, EBMTeam B) { return (HostileTeamsOf(A) & TeamBit(B)) != 0; }
+}
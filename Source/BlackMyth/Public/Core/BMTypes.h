@@ -187,6 +187,28 @@ enum class EBMHitDedupPolicy : uint8
     Unlimited       // 不去重（不建议默认用）
 };
 
+/**
+ * 范围伤害形状
+ */
+UENUM(BlueprintType)
+enum class EBMAoEShape : uint8
+{
+    Sphere,         // 以 Origin 为球心，Radius 为半径
+    Cone,           // 以 Origin 为顶点，沿 Direction 张开 ConeHalfAngle，长度 Radius
+    Capsule         // 从 Origin 沿 Direction 延伸 Length 的线段，半径 Radius
+};
+
+/**
+ * 范围伤害目标优先级（超出目标上限时按此排序截断）
+ */
+UENUM(BlueprintType)
+enum class EBMAoETargetPriority : uint8
+{
+    Nearest,        // 距 Origin 最近优先
+    LowestHealth,   // 当前生命值最低优先
+    MostAligned     // 与 Direction 夹角最小优先
+};
+
 /**
  * 游戏全局事件类型（EventBus 使用）
  */
@@ -325,6 +347,136 @@ struct FBMHitBoxActivationParams
     EBMHitReaction OverrideReaction = EBMHitReaction::None;
 };
 
+/**
+ * 范围伤害规格
+ *
+ * 由 UBMCombatComponent::ApplyAreaDamage 使用：一次空间查询收集候选，
+ * 按优先级截断后批量计算部位/弱点/元素修正，每个受害者只结算一次（多段命中合并）
+ */
+USTRUCT(BlueprintType)
+struct FBMAoEDamageSpec
+{
+    GENERATED_BODY()
+
+    // 触发这次范围伤害的招式（调试用）
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    FName AttackId = NAME_None;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    EBMAoEShape Shape = EBMAoEShape::Sphere;
+
+    // 世界空间原点（Cone 顶点 / Capsule 起点）
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    FVector Origin = FVector::ZeroVector;
+
+    // 朝向（Cone/Capsule 使用，MostAligned 排序使用）
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    FVector Direction = FVector::ForwardVector;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE", meta = (ClampMin = "0.0"))
+    float Radius = 300.f;
+
+    // Capsule 线段长度
+    UPROPERTY(EditAnywhere, Category = "BM|AoE", meta = (ClampMin = "0.0"))
+    float Length = 0.f;
+
+    // Cone 半角（度）
+    UPROPERTY(EditAnywhere, Category = "BM|AoE", meta = (ClampMin = "0.0", ClampMax = "180.0"))
+    float ConeHalfAngle = 45.f;
+
+    // 单段基础伤害；<=0 时取攻击者 Attack * AttackMultiplier
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    float BaseDamage = 0.f;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE", meta = (ClampMin = "0.0"))
+    float DamageScale = 1.0f;
+
+    // 段数：多段伤害合并为每个受害者一次结算
+    UPROPERTY(EditAnywhere, Category = "BM|AoE", meta = (ClampMin = "1"))
+    int32 HitCount = 1;
+
+    // 目标上限（还会被 UBMCombatComponent::MaxAoETargets 硬性截断）
+    UPROPERTY(EditAnywhere, Category = "BM|AoE", meta = (ClampMin = "1"))
+    int32 MaxTargets = 16;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    EBMAoETargetPriority Priority = EBMAoETargetPriority::Nearest;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    EBMDamageType DamageType = EBMDamageType::Magic;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    EBMElementType ElementType = EBMElementType::Physical;
+
+    UPROPERTY(EditAnywhere, Category = "BM|AoE")
+    EBMHitReaction HitReaction = EBMHitReaction::Light;
+};
+
+/**
+ * 范围伤害结算结果
+ */
+USTRUCT(BlueprintType)
+struct FBMAoEDamageResult
+{
+    GENERATED_BODY()
+
+    // 空间查询得到并通过形状/阵营过滤的候选数
+    UPROPERTY(BlueprintReadOnly, Category = "BM|AoE")
+    int32 NumCandidates = 0;
+
+    // 实际结算的受害者数（<= 目标上限）
+    UPROPERTY(BlueprintReadOnly, Category = "BM|AoE")
+    int32 NumVictims = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BM|AoE")
+    float TotalDamage = 0.f;
+};
+
+/**
+ * 持续状态效果规格（中毒/灼烧/流血/持续回血等）
+ *
+ * 由 UBMStatusEffectSubsystem 统一调度：按 Period 周期结算，Duration 到期移除；
+ * 同一目标重复施加同一 EffectId 时刷新持续时间并叠层
+ */
+USTRUCT(BlueprintType)
+struct FBMStatusEffectSpec
+{
+    GENERATED_BODY()
+
+    // 效果标识（同一目标上同名效果只存在一个实例）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect")
+    FName EffectId = NAME_None;
+
+    // 持续时间（秒）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect", meta = (ClampMin = "0.0"))
+    float Duration = 5.f;
+
+    // 结算周期（秒）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect", meta = (ClampMin = "0.05"))
+    float Period = 1.f;
+
+    // 每层每次结算的数值（伤害或回复量）
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect", meta = (ClampMin = "0.0"))
+    float MagnitudePerTick = 5.f;
+
+    // true 为持续回复，false 为持续伤害
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect")
+    bool bHeal = false;
+
+    // 施加时是否立即结算一次
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect")
+    bool bTickOnApply = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect", meta = (ClampMin = "1"))
+    int32 MaxStacks = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect")
+    EBMDamageType DamageType = EBMDamageType::DOT;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BM|StatusEffect")
+    EBMElementType ElementType = EBMElementType::Physical;
+};
+
 /**
  * 敌人攻击规格
  */ 
@@ -380,6 +532,9 @@ struct FBMEnemyAttackSpec
     UPROPERTY(EditAnywhere, Category = "BM|Enemy|Attack|HitBox")
     TArray<FName> HitBoxNames;
 
+    // 由 HitBoxNames 预编译的 HitBox 掩码（角色 BeginPlay 时解析）
+    uint64 HitBoxMask = 0;
+
     // 这个攻击窗口的参数（倍率/去重/反馈覆写等）
     UPROPERTY(EditAnywhere, Category = "BM|Enemy|Attack|HitBox")
     FBMHitBoxActivationParams HitBoxParams;
@@ -417,6 +572,9 @@ struct FBMPlayerComboStep
     UPROPERTY(EditAnywhere)
     TArray<FName> HitBoxNames;
 
+    // 由 HitBoxNames 预编译的 HitBox 掩码（角色 BeginPlay 时解析）
+    uint64 HitBoxMask = 0;
+
     UPROPERTY(EditAnywhere)
     FBMHitBoxActivationParams HitBoxParams;
 
@@ -492,6 +650,9 @@ struct FBMPlayerAttackSpec
     UPROPERTY(EditAnywhere, Category = "BM|Player|Attack|HitBox")
     TArray<FName> HitBoxNames;
 
+    // 由 HitBoxNames 预编译的 HitBox 掩码（角色 BeginPlay 时解析）
+    uint64 HitBoxMask = 0;
+
     UPROPERTY(EditAnywhere, Category = "BM|Player|Attack|HitBox")
     FBMHitBoxActivationParams HitBoxParams;
 
@@ -686,6 +847,14 @@ struct FBMDamageInfo
     UPROPERTY(BlueprintReadWrite, Category = "Damage")
     TObjectPtr<UPrimitiveComponent> HitComponent = nullptr;
 
+    // 可选：命中的虚拟 HurtBox 下标（骨骼空间 OBB，无碰撞组件；INDEX_NONE 表示未命中虚拟 HurtBox）
+    UPROPERTY(BlueprintReadWrite, Category = "Damage")
+    int32 VirtualHurtBoxIndex = INDEX_NONE;
+
+    // 本次结算合并的命中段数（范围伤害多段合并时 > 1）
+    UPROPERTY(BlueprintReadWrite, Category = "Damage")
+    int32 HitCount = 1;
+
     FBMDamageInfo() = default;
 };
 
@@ -828,9 +997,50 @@ struct FBMPerceptionInfo
     FVector LastKnownPlayerLocation = FVector::ZeroVector;
 };
 
+/**
+ * 状态机状态标识
+ *
+ * 状态机按该值直接索引状态表与转换表；玩家与敌人共用同一组标识，
+ * 由各自的状态机定义决定标识对应的状态类
+ */
+UENUM(BlueprintType)
+enum class EBMStateId : uint8
+{
+    None        UMETA(DisplayName = "None"),
+    Idle        UMETA(DisplayName = "Idle"),
+    Move        UMETA(DisplayName = "Move"),
+    Jump        UMETA(DisplayName = "Jump"),
+    Dodge       UMETA(DisplayName = "Dodge"),
+    Attack      UMETA(DisplayName = "Attack"),
+    Hit         UMETA(DisplayName = "Hit"),
+    Death       UMETA(DisplayName = "Death"),
+    Patrol      UMETA(DisplayName = "Patrol"),
+    Chase       UMETA(DisplayName = "Chase"),
+    PhaseChange UMETA(DisplayName = "PhaseChange"),
+    Count       UMETA(Hidden)
+};
+
+/**
+ * 状态切换原因
+ *
+ * 写入状态机的切换记录，用于事后定位"卡在某状态"或受击打断异常
+ */
+enum class EBMStateChangeReason : uint8
+{
+    Request,            // 玩法代码直接请求
+    Init,               // 状态机初始化
+    Deadline,           // 截止事件回调中发起
+    Update,             // OnUpdate 中发起
+    InterruptNoContext, // 攻击中受击：没有招式信息，默认打断
+    Interrupted,        // 攻击中受击：打断判定成功
+    InterruptResisted,  // 攻击中受击：打断判定失败
+    Uninterruptible,    // 攻击中受击：霸体
+    Count
+};
+
 /**
  * 轻量辅助：把 StateId 映射成 FName（给你的 FSM 用）
- * 说明：FSM 内部如果用 FName 做 Key，这个函数能避免散落魔法字符串。
+ * 说明：状态机内部按 EBMStateId 索引，名称仅用于注册时的调试显示。
  */
 namespace BMStateNames
 {
@@ -887,4 +1097,30 @@ namespace BMCombatUtils
             || A == EBMCombatAction::Skill2
             || A == EBMCombatAction::Skill3;
     }
+}
+
+/**
+ * @brief Define the BMCollisionProfiles namespace, used to store the hit box / hurt box collision profiles
+ * @param BMCollisionProfiles The name of the namespace
+ *
+ * 对应 DefaultEngine.ini 中的专用 Object Channel 与 Profile：
+ * HitBox 只与敌对阵营的 HurtBox 产生 Overlap，其余通道一律 Ignore
+ */
+namespace BMCollisionProfiles
+{
+    static const FName PlayerHitBox = TEXT("BMPlayerHitBox");
+    static const FName EnemyHitBox = TEXT("BMEnemyHitBox");
+    static const FName PlayerHurtBox = TEXT("BMPlayerHurtBox");
+    static const FName EnemyHurtBox = TEXT("BMEnemyHurtBox");
+
+    // 中立阵营沿用敌方一侧的 Profile
+    inline FName HitBoxForTeam(EBMTeam Team)
+    {
+        return Team == EBMTeam::Player ? PlayerHitBox : EnemyHitBox;
+    }
+
+    inline FName HurtBoxForTeam(EBMTeam Team)
+    {
+        return Team == EBMTeam::Player ? PlayerHurtBox : EnemyHurtBox;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Core/BMTypes.h"
+#include "BMProjectileData.generated.h"
+
+class UStaticMesh;
+
+/*
+ * @brief Define the FBMProjectileData struct, projectile data struct, used to store the projectile type data
+ * @param FBMProjectileData The name of the struct
+ * @param FTableRowBase The parent struct
+ */
+USTRUCT(BlueprintType)
+struct FBMProjectileData : public FTableRowBase
+{
+    GENERATED_BODY()
+
+public:
+    // 对应 CSV: Speed（厘米/秒）
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+    float Speed = 2000.0f;
+
+    // 对应 CSV: GravityScale（0 为直线飞行）
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+    float GravityScale = 0.0f;
+
+    // 对应 CSV: Radius（扫掠半径，厘米）
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+    float Radius = 10.0f;
+
+    // 对应 CSV: LifeSeconds
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+    float LifeSeconds = 3.0f;
+
+    // 对应 CSV: BaseDamage（<=0 时取发射者 Attack * AttackMultiplier）
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    float BaseDamage = 0.0f;
+
+    // 对应 CSV: DamageMult
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    float DamageMult = 1.0f;
+
+    // 对应 CSV: MaxHits（穿透数，1 为命中即消失）
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    int32 MaxHits = 1;
+
+    // 对应 CSV: DamageType
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    EBMDamageType DamageType = EBMDamageType::Ranged;
+
+    // 对应 CSV: ElementType
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    EBMElementType ElementType = EBMElementType::Physical;
+
+    // 对应 CSV: HitReaction
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    EBMHitReaction HitReaction = EBMHitReaction::Light;
+
+    // 对应 CSV: bCollideWithWorld（是否被场景静态几何阻挡）
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Projectile")
+    bool bCollideWithWorld = true;
+
+    // 对应 CSV: MeshPath
+    // 存储格式：/Game/Effects/Meshes/SM_Orb.SM_Orb
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Assets")
+    TSoftObjectPtr<UStaticMesh> MeshPath;
+
+    // 对应 CSV: MeshScale
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Assets")
+    float MeshScale = 1.0f;
+};
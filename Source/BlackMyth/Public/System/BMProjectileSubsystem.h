@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "Core/BMTypes.h"
+#include "Data/BMProjectileData.h"
+#include "BMProjectileSubsystem.generated.h"
+
+class ABMCharacterBase;
+class UInstancedStaticMeshComponent;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBMProjectile, Log, All);
+
+/**
+ * 投射物子系统
+ *
+ * 负责：
+ * - 投射物以纯数据形式存放在连续数组中（SoA），不为单发投射物创建任何 UObject
+ * - 每帧批量积分与扫掠检测：角色走包围球粗筛 + HurtBox OBB 细筛，场景几何走批量异步射线
+ * - 命中后构造 FBMDamageInfo，经 ABMCharacterBase::TakeDamageFromHit 走与 HitBox 相同的受击路径
+ * - 表现层按投射物类型复用一个 InstancedStaticMesh 组件，实例只增不删（池化）
+ *
+ * 投射物类型来自 DT_Projectiles（UBMDataSubsystem::GetProjectileData），首次使用时解析并缓存
+ */
+UCLASS()
+class BLACKMYTH_API UBMProjectileSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * 发射一枚投射物
+     *
+     * @param TypeId DT_Projectiles 中的行名（或 RegisterProjectileType 注册的类型名）
+     * @param Instigator 发射者（决定阵营与默认攻击力，可为空）
+     * @param Location 发射位置
+     * @param Direction 飞行方向
+     * @param DamageOverride 单发伤害覆写；<0 时按类型配置计算
+     * @return 成功发射返回 true；类型不存在或已达上限返回 false
+     */
+    bool SpawnProjectile(FName TypeId, ABMCharacterBase* Instigator, const FVector& Location, const FVector& Direction, float DamageOverride = -1.f);
+
+    /**
+     * 以代码方式注册投射物类型（覆盖同名的表格行）
+     *
+     * @param TypeId 类型名
+     * @param Data 类型配置
+     */
+    void RegisterProjectileType(FName TypeId, const FBMProjectileData& Data);
+
+    /** 当前存活的投射物数量 */
+    int32 GetLiveProjectileCount() const { return Positions.Num(); }
+
+    /** 清空所有存活投射物 */
+    void ClearAllProjectiles();
+
+    /** 同时存活投射物上限 */
+    UPROPERTY(EditAnywhere, Category = "BM|Projectile", meta = (ClampMin = "1"))
+    int32 MaxLiveProjectiles = 8192;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** 已解析的投射物类型 */
+    struct FBMProjectileType
+    {
+        FName Id = NAME_None;
+        FBMProjectileData Data;
+
+        // 对应的实例化网格组件（无网格时为空，仅模拟不渲染）
+        TWeakObjectPtr<UInstancedStaticMeshComponent> Visual;
+
+        // 上一帧实际使用的实例数（多余实例缩放为 0 隐藏）
+        int32 UsedInstances = 0;
+
+        // 本帧该类型的实例变换（每帧复用内存）
+        TArray<FTransform> VisualScratch;
+    };
+
+    /** 本帧的命中候选角色（包围球粗筛用） */
+    struct FBMProjectileTarget
+    {
+        ABMCharacterBase* Character = nullptr;
+        FVector Center = FVector::ZeroVector;
+        float Radius = 0.f;
+        EBMTeam Team = EBMTeam::Neutral;
+    };
+
+    /**
+     * 查找或解析投射物类型
+     *
+     * @param TypeId 类型名
+     * @return 类型下标；找不到返回 INDEX_NONE
+     */
+    int32 ResolveType(FName TypeId);
+
+    /** 为类型创建实例化网格组件 */
+    void CreateVisual(FBMProjectileType& Type);
+
+    /** 收集本帧所有存活角色的包围球 */
+    void GatherTargets();
+
+    /**
+     * 对单枚投射物的本帧扫掠线段做角色命中检测
+     *
+     * @param Index 投射物下标
+     * @param Start 线段起点
+     * @param End 线段终点
+     * @return 投射物是否应被销毁
+     */
+    bool SweepCharacters(int32 Index, const FVector& Start, const FVector& End);
+
+    /**
+     * 结算一次命中（与 HitBox 相同的受击路径）
+     *
+     * @param Index 投射物下标
+     * @param Victim 受击角色
+     * @param HitComp 命中的 HurtBox 碰撞组件（虚拟 HurtBox 时为空）
+     * @param VirtualHurtBoxIndex 命中的虚拟 HurtBox 下标
+     * @param HitLocation 命中位置
+     */
+    void ApplyHit(int32 Index, ABMCharacterBase* Victim, UPrimitiveComponent* HitComp, int32 VirtualHurtBoxIndex, const FVector& HitLocation);
+
+    /** 交换删除一枚投射物（保持数组连续） */
+    void RemoveProjectile(int32 Index);
+
+    /** 按类型批量刷新实例变换（投射物只遍历一次，按类型分桶） */
+    void UpdateVisuals();
+
+private:
+    // ===== 投射物数据（SoA，下标一一对应） =====
+
+    TArray<FVector> Positions;
+    TArray<FVector> Velocities;
+    TArray<float> RemainingLife;
+    TArray<float> Damages;
+    TArray<int32> TypeIndices;
+    TArray<int32> RemainingHits;
+    TArray<EBMTeam> Teams;
+    TArray<TWeakObjectPtr<ABMCharacterBase>> Instigators;
+
+    // 投射物已命中的全部角色（穿透型不会重复结算同一目标；容量按 MaxHits 预留）
+    TArray<TArray<TWeakObjectPtr<ABMCharacterBase>>> HitVictims;
+
+    // 已销毁投射物归还的命中列表（保留容量，发射时取回复用，稳定后不再分配）
+    TArray<TArray<TWeakObjectPtr<ABMCharacterBase>>> FreeVictimLists;
+
+    // 上一帧发出的场景阻挡射线（下一帧取结果）
+    TArray<FTraceHandle> WorldTraces;
+
+    // ===== 类型与表现 =====
+
+    TArray<FBMProjectileType> Types;
+    TMap<FName, int32> TypeIndexById;
+
+    /** 承载实例化网格组件的宿主 Actor */
+    UPROPERTY(Transient)
+    TObjectPtr<AActor> VisualHost = nullptr;
+
+    // ===== 帧内临时数据（复用内存） =====
+
+    TArray<FBMProjectileTarget> Targets;
+};
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Core/BMTypes.h"
+#include "BMStatusEffectSubsystem.generated.h"
+
+class ABMCharacterBase;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBMStatusEffect, Log, All);
+
+/**
+ * 隔离压测的结果
+ */
+struct FBMStatusEffectStressResult
+{
+    /** 平均每帧耗时（微秒） */
+    double AverageMicroseconds = 0.0;
+
+    /** 99 分位的单帧耗时（微秒） */
+    double P99Microseconds = 0.0;
+
+    /** 最慢一帧的耗时（微秒） */
+    double MaxMicroseconds = 0.0;
+
+    /** 压测期间实际结算（进入受击/回复路径）的次数 */
+    int32 SettledTicks = 0;
+};
+
+/**
+ * 持续状态效果子系统
+ *
+ * 负责：
+ * - 全部持续效果实例存放在连续数组中（空闲下标复用），角色组件不再为持续效果逐帧 Tick
+ * - 周期结算与到期移除由分层时间轮调度：每个实例只挂一个"下一事件"节点，推进成本只与到期事件数相关
+ * - 本帧到期的伤害先收集，再批量经 ABMCharacterBase::TakeDamageFromHit 走统一受击路径
+ * - 没有任何效果时整轮跳过，不产生逐帧开销
+ */
+UCLASS()
+class BLACKMYTH_API UBMStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * 施加一个持续效果
+     *
+     * 目标身上已有同名效果时刷新持续时间（取较晚者）并叠层，不新建实例
+     *
+     * @param Target 目标角色
+     * @param Spec 效果规格
+     * @param Instigator 施加者（伤害归属，可为空）
+     * @return 成功施加或刷新返回 true
+     */
+    UFUNCTION(BlueprintCallable, Category = "BM|StatusEffect")
+    bool ApplyStatusEffect(ABMCharacterBase* Target, const FBMStatusEffectSpec& Spec, ABMCharacterBase* Instigator = nullptr);
+
+    /**
+     * 移除目标身上的指定效果
+     *
+     * @param Target 目标角色
+     * @param EffectId 效果标识
+     * @return 存在并移除返回 true
+     */
+    UFUNCTION(BlueprintCallable, Category = "BM|StatusEffect")
+    bool RemoveStatusEffect(const ABMCharacterBase* Target, FName EffectId);
+
+    /** 移除目标身上的全部效果 */
+    UFUNCTION(BlueprintCallable, Category = "BM|StatusEffect")
+    void RemoveAllStatusEffects(const ABMCharacterBase* Target);
+
+    /** 目标身上是否有指定效果 */
+    UFUNCTION(BlueprintPure, Category = "BM|StatusEffect")
+    bool HasStatusEffect(const ABMCharacterBase* Target, FName EffectId) const;
+
+    /** 当前存活的效果实例数量 */
+    int32 GetActiveEffectCount() const { return NumActiveEffects; }
+
+    /** 清空所有效果 */
+    void ClearAllStatusEffects();
+
+    /**
+     * 在独立的调度状态上压测
+     *
+     * 临时换出实时的效果实例、时间轮与时钟，在空白状态上施加 Count 个效果（持续伤害与持续回复成对，
+     * 数值非零，真正走受击/回复路径）并同步推进 Ticks 帧，逐帧计时；结束后原样换回：实时效果不会被推进、结算或移除，
+     * 但目标角色的生命值会受到压测效果的影响
+     *
+     * @param Characters 效果分布的目标角色
+     * @param Count 施加的效果数量
+     * @param Ticks 推进的帧数（固定 60Hz 步长）
+     * @return 每帧耗时统计与结算次数
+     */
+    FBMStatusEffectStressResult RunIsolatedStress(TConstArrayView<ABMCharacterBase*> Characters, int32 Count, int32 Ticks);
+
+    /**
+     * 单帧调度与结算的耗时预算（微秒）
+     *
+     * 超出时输出 Warning，配合 stat BMCombat 观察；<= 0 关闭检查
+     */
+    UPROPERTY(EditAnywhere, Category = "BM|StatusEffect")
+    float TickBudgetMicroseconds = 500.f;
+
+    /** 时间轮的最小刻度（秒） */
+    static constexpr float WheelTickSeconds = 1.f / 30.f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** 单个效果实例 */
+    struct FBMStatusEffectInstance
+    {
+        TWeakObjectPtr<ABMCharacterBase> Target;
+        TWeakObjectPtr<ABMCharacterBase> Instigator;
+        FObjectKey TargetKey;
+        FName EffectId = NAME_None;
+
+        float MagnitudePerTick = 0.f;
+        int32 Stacks = 0;
+        int32 MaxStacks = 1;
+        bool bHeal = false;
+        EBMDamageType DamageType = EBMDamageType::DOT;
+        EBMElementType ElementType = EBMElementType::Physical;
+
+        // 以时间轮刻度计的周期、下次结算与到期
+        uint64 PeriodTicks = 1;
+        uint64 NextPeriodicTick = 0;
+        uint64 ExpireTick = 0;
+
+        // 下标复用时递增，用于识别时间轮中的过期节点
+        uint32 Serial = 0;
+        bool bActive = false;
+    };
+
+    /** 时间轮节点 */
+    struct FBMWheelEntry
+    {
+        int32 EffectIndex = INDEX_NONE;
+        uint32 Serial = 0;
+    };
+
+    /** 本帧待结算的一次数值（实例可能在批量结算前被移除，故拷贝所需字段） */
+    struct FBMPendingEffectTick
+    {
+        TWeakObjectPtr<ABMCharacterBase> Target;
+        TWeakObjectPtr<ABMCharacterBase> Instigator;
+        float Amount = 0.f;
+        bool bHeal = false;
+        EBMDamageType DamageType = EBMDamageType::DOT;
+        EBMElementType ElementType = EBMElementType::Physical;
+    };
+
+    // 三层时间轮，每层 64 槽：覆盖 64 / 4096 / 262144 个刻度
+    static constexpr int32 WheelBitsPerLevel = 6;
+    static constexpr int32 WheelSlotsPerLevel = 1 << WheelBitsPerLevel;
+    static constexpr int32 WheelNumLevels = 3;
+
+    /** 调度状态（效果实例、时间轮与时钟），压测时与实时状态整体互换 */
+    struct FBMSchedulerState
+    {
+        TArray<FBMStatusEffectInstance> Effects;
+        TArray<int32> FreeEffectIndices;
+        int32 NumActiveEffects = 0;
+        TMap<TTuple<FObjectKey, FName>, int32> EffectIndexByKey;
+        TArray<FBMWheelEntry> Wheel[WheelNumLevels][WheelSlotsPerLevel];
+        double SimTime = 0.0;
+        uint64 CurrentTick = 0;
+        TArray<FBMPendingEffectTick> PendingTicks;
+    };
+
+    /** 与 Other 互换调度状态（只交换数组指针，不拷贝元素） */
+    void SwapSchedulerState(FBMSchedulerState& Other);
+
+    /** 当前时间（刻度） */
+    uint64 NowTick() const { return (uint64)(SimTime / WheelTickSeconds); }
+
+    /**
+     * 把实例的下一事件挂入时间轮
+     *
+     * @param EffectIndex 实例下标
+     * @param TargetTick 事件刻度（不早于 CurrentTick + 1）
+     */
+    void ScheduleEffect(int32 EffectIndex, uint64 TargetTick);
+
+    /** 按目标刻度与基准刻度的距离选择层级与槽位并插入 */
+    void InsertWheelEntry(const FBMWheelEntry& Entry, uint64 TargetTick, uint64 BaseTick);
+
+    /** 推进一个刻度：高层槽位下沉，然后处理第 0 层当前槽位 */
+    void AdvanceOneTick();
+
+    /** 处理一个实例的到期事件（周期结算 / 到期移除 / 重新挂入） */
+    void ProcessEffectEvent(int32 EffectIndex);
+
+    /** 把实例当前的一次结算加入待结算列表 */
+    void QueueEffectTick(const FBMStatusEffectInstance& Effect);
+
+    /** 批量结算本帧收集的数值 */
+    void FlushPendingTicks();
+
+    /** 释放实例下标 */
+    void ReleaseEffect(int32 EffectIndex);
+
+    /** 清空时间轮所有槽位 */
+    void ResetWheel();
+
+    /** 实例的下一事件刻度 */
+    static uint64 NextEventTick(const FBMStatusEffectInstance& Effect)
+    {
+        return FMath::Min(Effect.NextPeriodicTick, Effect.ExpireTick);
+    }
+
+private:
+    // ===== 效果实例（连续存储 + 空闲下标） =====
+
+    TArray<FBMStatusEffectInstance> Effects;
+    TArray<int32> FreeEffectIndices;
+    int32 NumActiveEffects = 0;
+
+    // (目标, 效果标识) -> 实例下标
+    TMap<TTuple<FObjectKey, FName>, int32> EffectIndexByKey;
+
+    // ===== 时间轮 =====
+
+    TArray<FBMWheelEntry> Wheel[WheelNumLevels][WheelSlotsPerLevel];
+
+    // 子系统自身的时间（只在 Tick 中推进，随游戏暂停）
+    double SimTime = 0.0;
+
+    // 已处理到的刻度
+    uint64 CurrentTick = 0;
+
+    // ===== 帧内临时数据（复用内存） =====
+
+    TArray<FBMWheelEntry> SlotScratch;
+    TArray<FBMPendingEffectTick> PendingTicks;
+
+    // 累计结算次数（压测取差值）
+    int32 NumSettledTicks = 0;
+};
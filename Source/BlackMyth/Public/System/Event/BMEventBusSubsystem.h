@@ -5,12 +5,216 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Delegates/DelegateCombinations.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Containers/Queue.h"
+#include <atomic>
+#include <type_traits>
 #include "BMEventBusSubsystem.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogBMEventBus, Log, All);
+DECLARE_STATS_GROUP(TEXT("BMEventBus"), STATGROUP_BMEventBus, STATCAT_Advanced);
+
+// Per channel and per subscriber instrumentation (bm.EventBus.Profile), compiled out of shipping builds
+#ifndef BM_EVENTBUS_INSTRUMENTATION
+#define BM_EVENTBUS_INSTRUMENTATION !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * @brief Define the EBMEventChannel enum, one entry per dispatcher of the event bus
+ */
+enum class EBMEventChannel : uint8
+{
+    PlayerHealth,
+    PlayerMana,
+    PlayerStamina,
+    SkillCooldownStarted,
+    SkillCooldownReady,
+    BossPhase,
+    BossHealth,
+    Notify,
+    PlayerDied,
+    PlayerLevelUp,
+    PlayerXP,
+    SkillPoints,
+    AttributePoints,
+    Count
+};
+
+/**
+ * @brief Define the EBMEventRecordType enum, the events that can be posted to the bus from any thread
+ */
+enum class EBMEventRecordType : uint8
+{
+    PlayerHealth,
+    PlayerMana,
+    PlayerStamina,
+    BossHealth,
+    PlayerXP,
+    SkillPoints,
+    AttributePoints,
+    SkillCooldownStarted,
+    SkillCooldownReady,
+    PlayerDied,
+    PlayerLevelUp,
+    BossPhase,
+    Notify,
+    Probe,          // Stress test only: Int0 = producer, Int1 = sequence
+};
+
+// Heap payload of the records that carry text (boss phase hint, notification), owned by the record until it is drained
+struct FBMEventRecordPayload;
+
+/**
+ * @brief Define the FBMEventRecord struct, a trivially copyable event posted from any thread
+ *
+ * Field usage per type:
+ * - health/mana/stamina/boss health: Float0 = normalized value
+ * - XP: Float0/1/2 = current, max, percent
+ * - skill/attribute points: Int0
+ * - cooldown started/ready: Name = skill id, Float0/1 = end time, duration
+ * - level up: Int0/1 = old level, new level
+ * - boss phase: Int0 = phase, Payload = hint
+ * - notify: Payload = notification
+ *
+ * Sequence is stamped by EnqueueEvent from the same counter as the game thread value emits,
+ * so a worker value drained after a newer game thread emit of the same channel is dropped.
+ */
+struct FBMEventRecord
+{
+    FBMEventRecord() = default;
+
+    explicit FBMEventRecord(EBMEventRecordType InType, FName InName = NAME_None, float InFloat0 = 0.f, float InFloat1 = 0.f, float InFloat2 = 0.f, int32 InInt0 = 0, int32 InInt1 = 0)
+        : Type(InType), Name(InName), Float0(InFloat0), Float1(InFloat1), Float2(InFloat2), Int0(InInt0), Int1(InInt1)
+    {
+    }
+
+    EBMEventRecordType Type = EBMEventRecordType::Probe;
+    FName Name;
+    float Float0 = 0.f;
+    float Float1 = 0.f;
+    float Float2 = 0.f;
+    int32 Int0 = 0;
+    int32 Int1 = 0;
+    FBMEventRecordPayload* Payload = nullptr;
+    uint64 Sequence = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FBMEventRecord>, "FBMEventRecord must stay trivially copyable");
+
+/**
+ * @brief Define the EBMNotifyMessage enum, what a notification says; the consumer picks the format pattern from it
+ */
+enum class EBMNotifyMessage : uint8
+{
+    Text,           // Preformatted text in FBMNotifyPayload::Text (menus, save/load)
+    LootCurrency,   // Args: Int amount
+    LootXP,         // Args: Float amount
+    LootItem,       // Args: Name item id, Int count
+    Count
+};
+
+/**
+ * @brief Define the EBMNotifyPriority enum, higher priorities jump ahead of lower ones when the feed is full
+ */
+enum class EBMNotifyPriority : uint8
+{
+    Low,
+    Normal,
+    High,
+};
+
+/**
+ * @brief Define the FBMNotifyArg struct, one typed argument of a notification
+ */
+struct FBMNotifyArg
+{
+    enum class EType : uint8
+    {
+        None,
+        Int,
+        Float,
+        Name,
+    };
+
+    EType Type = EType::None;
+    int32 Int = 0;
+    float Float = 0.f;
+    FName Name;
+
+    bool operator==(const FBMNotifyArg& Other) const
+    {
+        return Type == Other.Type && Int == Other.Int && Float == Other.Float && Name == Other.Name;
+    }
+};
+
+/**
+ * @brief Define the FBMNotifyPayload struct, a notification as message id plus a few typed arguments
+ *
+ * Sources fill it without building any string; the consumer formats only the messages it actually shows.
+ * Usage: EmitNotify(FBMNotifyPayload::Make(EBMNotifyMessage::LootItem, EBMNotifyPriority::Low).AddName(ItemId).AddInt(Count))
+ */
+struct FBMNotifyPayload
+{
+    static constexpr int32 MaxArgs = 4;
+
+    EBMNotifyMessage Message = EBMNotifyMessage::Text;
+    EBMNotifyPriority Priority = EBMNotifyPriority::Normal;
+    uint8 NumArgs = 0;
+    FBMNotifyArg Args[MaxArgs];
+
+    // Only used by EBMNotifyMessage::Text
+    FText Text;
+
+    static FBMNotifyPayload Make(EBMNotifyMessage InMessage, EBMNotifyPriority InPriority = EBMNotifyPriority::Normal)
+    {
+        FBMNotifyPayload Payload;
+        Payload.Message = InMessage;
+        Payload.Priority = InPriority;
+        return Payload;
+    }
+
+    static FBMNotifyPayload MakeText(const FText& InText, EBMNotifyPriority InPriority = EBMNotifyPriority::Normal)
+    {
+        FBMNotifyPayload Payload = Make(EBMNotifyMessage::Text, InPriority);
+        Payload.Text = InText;
+        return Payload;
+    }
+
+    FBMNotifyPayload& AddInt(int32 Value) { if (FBMNotifyArg* Arg = AddArg(FBMNotifyArg::EType::Int)) Arg->Int = Value; return *this; }
+    FBMNotifyPayload& AddFloat(float Value) { if (FBMNotifyArg* Arg = AddArg(FBMNotifyArg::EType::Float)) Arg->Float = Value; return *this; }
+    FBMNotifyPayload& AddName(FName Value) { if (FBMNotifyArg* Arg = AddArg(FBMNotifyArg::EType::Name)) Arg->Name = Value; return *this; }
+
+private:
+    FBMNotifyArg* AddArg(FBMNotifyArg::EType Type)
+    {
+        if (!ensureMsgf(NumArgs < MaxArgs, TEXT("FBMNotifyPayload holds at most %d arguments"), MaxArgs)) return nullptr;
+        FBMNotifyArg& Arg = Args[NumArgs++];
+        Arg.Type = Type;
+        return &Arg;
+    }
+};
+
 /**
  * @brief Define the UBMEventBusSubsystem class, event bus subsystem, used to manage the events
  * @param UBMEventBusSubsystem The name of the class
  * @param UGameInstanceSubsystem The parent class
+ *
+ * In deferred mode (bm.EventBus.Deferred, on by default) the Emit* functions only record the event:
+ * - "latest value" channels (health, mana, stamina, boss health, XP, points, per-skill cooldowns)
+ *   keep one pending value, later emits in the same frame overwrite it and are counted as coalesced
+ * - discrete events (died, level up, boss phase, notify) are queued in emit order
+ * Everything is broadcast once per frame after the owning world has ticked its actors,
+ * values first and then the discrete queue. Flush() delivers immediately when a caller needs it.
+ *
+ * Emits from other threads go through a lock-free multi-producer single-consumer queue of FBMEventRecord.
+ * The game thread drains it right before the flush, so records from one producer keep their order.
+ * Boss phase and notify records carry their text in a heap payload that the drain takes ownership of,
+ * so they share the queue (and the ordering) with every other event.
+ * Notifications are structured (FBMNotifyPayload) and dropped on emit when nobody listens.
+ *
+ * Outside shipping, bm.EventBus.Profile 1 counts emits, coalesced emits, broadcasts and broadcasts that repeat
+ * the previous arguments per channel, and times every broadcast. Listeners bound through Subscribe() are also
+ * timed one by one and attributed to their subscriber object; bm.EventBus.ProfileDump prints both tables.
  */
 UCLASS()
 class BLACKMYTH_API UBMEventBusSubsystem : public UGameInstanceSubsystem
@@ -22,14 +226,16 @@ public:
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnPlayerHealthChanged, float /*Normalized*/);
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnPlayerManaChanged, float /*Normalized*/);
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnPlayerStaminaChanged, float /*Normalized*/);
-    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSkillCooldownChanged, FName /*SkillId*/, float /*RemainingSeconds*/);
+    // Skill cooldowns carry absolute world-time end stamps; listeners compute the remaining time themselves
+    DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnSkillCooldownStarted, FName /*SkillId*/, float /*EndTime*/, float /*Duration*/);
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnSkillCooldownReady, FName /*SkillId*/);
 
     // Boss bar
     DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBossPhaseChanged, int32 /*Phase*/, FText /*PhaseHint*/);
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnBossHealthChanged, float /*Normalized*/);
 
     // Notifications
-    DECLARE_MULTICAST_DELEGATE_OneParam(FOnNotifyMessage, FText /*Message*/);
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnNotifyMessage, const FBMNotifyPayload& /*Payload*/);
 
     // Lifecycle
     DECLARE_MULTICAST_DELEGATE(FOnPlayerDied);
@@ -44,7 +250,8 @@ public:
     FOnPlayerHealthChanged OnPlayerHealthChanged;
     FOnPlayerManaChanged OnPlayerManaChanged;
     FOnPlayerStaminaChanged OnPlayerStaminaChanged;
-    FOnSkillCooldownChanged OnSkillCooldownChanged;
+    FOnSkillCooldownStarted OnSkillCooldownStarted;
+    FOnSkillCooldownReady OnSkillCooldownReady;
 
     // Boss phase
     FOnBossPhaseChanged OnBossPhaseChanged;
@@ -61,19 +268,279 @@ public:
     FOnPlayerAttributePointsChanged OnPlayerAttributePointsChanged;
 
 public:
-    // Convenience emitters for the events
-    void EmitPlayerHealth(float Normalized) { OnPlayerHealthChanged.Broadcast(Normalized); }
-    void EmitPlayerMana(float Normalized) { OnPlayerManaChanged.Broadcast(Normalized); }
-    void EmitPlayerStamina(float Normalized) { OnPlayerStaminaChanged.Broadcast(Normalized); }
-    void EmitSkillCooldown(FName SkillId, float Remaining) { OnSkillCooldownChanged.Broadcast(SkillId, Remaining); }
-    void EmitBossPhase(int32 Phase, const FText& Hint) { OnBossPhaseChanged.Broadcast(Phase, Hint); }
-    void EmitBossHealth(float Normalized) { OnBossHealthChanged.Broadcast(Normalized); }
-    void EmitNotify(const FText& Msg) { OnNotifyMessage.Broadcast(Msg); }
-    void EmitPlayerDied() { OnPlayerDied.Broadcast(); }
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Convenience emitters for the events (deferred or immediate, see the class comment)
+    void EmitPlayerHealth(float Normalized);
+    void EmitPlayerMana(float Normalized);
+    void EmitPlayerStamina(float Normalized);
+    void EmitSkillCooldownStarted(FName SkillId, float EndTime, float Duration);
+    void EmitSkillCooldownReady(FName SkillId);
+    void EmitBossPhase(int32 Phase, const FText& Hint);
+    void EmitBossHealth(float Normalized);
+    void EmitNotify(const FText& Msg);
+    void EmitNotify(const FBMNotifyPayload& Payload);
+    void EmitPlayerDied();
     
     // Experience/Level events
-    void EmitPlayerLevelUp(int32 OldLevel, int32 NewLevel) { OnPlayerLevelUp.Broadcast(OldLevel, NewLevel); }
-    void EmitPlayerXPChanged(float CurrentXP, float MaxXP, float Percent) { OnPlayerXPChanged.Broadcast(CurrentXP, MaxXP, Percent); }
-    void EmitPlayerSkillPointsChanged(int32 NewSkillPoints) { OnPlayerSkillPointsChanged.Broadcast(NewSkillPoints); }
-    void EmitPlayerAttributePointsChanged(int32 NewAttributePoints) { OnPlayerAttributePointsChanged.Broadcast(NewAttributePoints); }
+    void EmitPlayerLevelUp(int32 OldLevel, int32 NewLevel);
+    void EmitPlayerXPChanged(float CurrentXP, float MaxXP, float Percent);
+    void EmitPlayerSkillPointsChanged(int32 NewSkillPoints);
+    void EmitPlayerAttributePointsChanged(int32 NewAttributePoints);
+
+    /**
+     * @brief Bind a handler of a subscriber object to one of the dispatchers above, same as AddWeakLambda on it
+     *
+     * Instrumented builds wrap the handler so its calls and time are attributed to the subscriber;
+     * shipping builds bind the handler directly. Unbind by removing the handle from the dispatcher.
+     *
+     * @param Delegate One of the dispatchers of this bus
+     * @param Subscriber The object that owns the handler, the binding is dropped when it is destroyed
+     * @param Functor The handler
+     * @return The delegate handle
+     */
+    template <typename DelegateType, typename UserClass, typename FunctorType>
+    FDelegateHandle Subscribe(DelegateType& Delegate, UserClass* Subscriber, FunctorType&& Functor)
+    {
+#if BM_EVENTBUS_INSTRUMENTATION
+        const int32 ProfileIndex = RegisterSubscriber(&Delegate, Subscriber);
+        return Delegate.AddWeakLambda(Subscriber, [this, ProfileIndex, Functor = Forward<FunctorType>(Functor)](auto&&... Args)
+            {
+                const uint64 StartCycles = BeginSubscriberCall();
+                Functor(Forward<decltype(Args)>(Args)...);
+                EndSubscriberCall(ProfileIndex, StartCycles);
+            });
+#else
+        return Delegate.AddWeakLambda(Subscriber, Forward<FunctorType>(Functor));
+#endif
+    }
+
+    /**
+     * @brief Broadcast everything that is pending right now, values first and then the discrete queue
+     */
+    void Flush();
+
+    /**
+     * @brief Post an event from any thread, it is dispatched when the game thread next drains the queue
+     * @param Record The event record
+     */
+    void EnqueueEvent(const FBMEventRecord& Record);
+
+    /**
+     * @brief Dispatch the records that were queued before this call, game thread only
+     * @return The number of records dispatched
+     */
+    int32 DrainQueuedEvents();
+
+    /**
+     * @brief Reset the stress test probe validation, game thread only
+     * @param NumProducers The number of producers that will post probe records
+     */
+    void ResetProbeValidation(int32 NumProducers);
+
+    /**
+     * @brief Get the stress test probe results
+     * @param OutReceived The number of probe records dispatched
+     * @param OutDuplicates The number of probe records whose sequence was not above the last one of their producer
+     * @param OutGaps The number of probe records that skipped sequences of their producer
+     */
+    void GetProbeResults(int64& OutReceived, int64& OutDuplicates, int64& OutGaps) const;
+
+    /** @brief Whether emits are currently deferred to the end of the frame */
+    bool IsDeferredDispatch() const;
+
+    // Lifetime counters, used to measure how much the deferred mode saves
+    uint64 GetTotalEmitCount() const { return TotalEmits; }
+    uint64 GetCoalescedEmitCount() const { return TotalCoalesced; }
+    uint64 GetBroadcastCount() const { return TotalBroadcasts; }
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    /** @brief Log the per channel and per subscriber tables collected while bm.EventBus.Profile is on */
+    void DumpProfile() const;
+
+    /** @brief Zero the collected instrumentation, subscribers stay registered */
+    void ResetProfile();
+#endif
+
+private:
+    // Latest value channels, one dirty bit each
+    enum EValueChannel : uint32
+    {
+        Value_PlayerHealth      = 1 << 0,
+        Value_PlayerMana        = 1 << 1,
+        Value_PlayerStamina     = 1 << 2,
+        Value_BossHealth        = 1 << 3,
+        Value_PlayerXP          = 1 << 4,
+        Value_SkillPoints       = 1 << 5,
+        Value_AttributePoints   = 1 << 6,
+        NumValueChannels        = 7,
+    };
+
+    // Discrete event kinds kept in the ordered queue
+    enum class EQueuedEventType : uint8
+    {
+        PlayerDied,
+        PlayerLevelUp,
+        BossPhase,
+        Notify,
+    };
+
+    struct FQueuedEvent
+    {
+        EQueuedEventType Type = EQueuedEventType::Notify;
+        int32 IntA = 0;
+        int32 IntB = 0;
+        FText Text;
+        FBMNotifyPayload Notify;
+    };
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    // Counters and handler time of one channel; time is inclusive of broadcasts nested in the handlers
+    struct FChannelProfile
+    {
+        uint64 Emits = 0;
+        uint64 Coalesced = 0;
+        uint64 Broadcasts = 0;
+        uint64 Redundant = 0;
+        uint64 Cycles = 0;
+        uint64 MaxCycles = 0;
+        uint32 LastArgsHash = 0;
+        bool bHasLastArgs = false;
+    };
+
+    // One Subscribe() binding
+    struct FSubscriberProfile
+    {
+        EBMEventChannel Channel = EBMEventChannel::Count;
+        TWeakObjectPtr<const UObject> Object;
+        FString Label;
+        uint64 Calls = 0;
+        uint64 Cycles = 0;
+        uint64 MaxCycles = 0;
+    };
+#endif
+
+    // Latest cooldown event of one skill (started or ready)
+    struct FPendingCooldown
+    {
+        FName SkillId;
+        bool bReady = false;
+        float EndTime = 0.f;
+        float Duration = 0.f;
+    };
+
+    /** @brief Count one emit, returns true if it should be recorded instead of broadcast */
+    bool BeginEmit(EBMEventChannel Channel);
+
+    /** @brief Mark a value channel dirty, an already dirty channel counts as coalesced */
+    void MarkValueDirty(uint32 ValueBit, EBMEventChannel Channel);
+
+    /** @brief Stamp a value emit, returns false (and counts it coalesced) if a newer value of the channel was already emitted */
+    bool AcceptValueSequence(uint32 ValueBit, EBMEventChannel Channel);
+
+    /** @brief Count one emit that overwrote a pending one */
+    void NoteCoalesced(EBMEventChannel Channel);
+
+    /** @brief Broadcast one dispatcher, timed and counted per channel in instrumented builds */
+    template <typename DelegateType, typename... ArgTypes>
+    void BroadcastChannel(EBMEventChannel Channel, DelegateType& Delegate, const ArgTypes&... Args);
+
+    /** @brief Record the latest cooldown event of a skill */
+    void SetPendingCooldown(FName SkillId, bool bReady, float EndTime, float Duration);
+
+    /** @brief Whether anything is waiting to be flushed */
+    bool HasPending() const { return DirtyValues != 0 || PendingCooldowns.Num() > 0 || QueuedEvents.Num() > 0; }
+
+    /** @brief Broadcast one snapshot of the pending values and events */
+    void FlushOnce();
+
+    /** @brief Flush point, called after the owning world has ticked its actors */
+    void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+    /** @brief Dispatch one drained record through the game thread emit path */
+    void DispatchRecord(const FBMEventRecord& Record);
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    /** @brief Whether bm.EventBus.Profile is on */
+    bool IsProfiling() const;
+
+    /** @brief Map a dispatcher of this bus to its channel, Count if it is not one of ours */
+    EBMEventChannel GetChannelOf(const void* Delegate) const;
+
+    /** @brief Whether the subscriber still has a binding on the channel's dispatcher */
+    bool IsSubscriberBound(EBMEventChannel Channel, const UObject* Subscriber) const;
+
+    /** @brief Find or add the profile entry of a Subscribe() binding, one per (channel, live object); returns its index */
+    int32 RegisterSubscriber(const void* Delegate, const UObject* Subscriber);
+
+    /** @brief Start timing one subscriber call, 0 when the current broadcast is not profiled */
+    uint64 BeginSubscriberCall() const { return bProfilingBroadcast ? FPlatformTime::Cycles64() : 0; }
+
+    /** @brief Finish timing one subscriber call */
+    void EndSubscriberCall(int32 ProfileIndex, uint64 StartCycles);
+#endif
+
+private:
+    // ===== Pending values =====
+
+    uint32 DirtyValues = 0;
+    float PendingPlayerHealth = 0.f;
+    float PendingPlayerMana = 0.f;
+    float PendingPlayerStamina = 0.f;
+    float PendingBossHealth = 0.f;
+    float PendingXPCurrent = 0.f;
+    float PendingXPMax = 0.f;
+    float PendingXPPercent = 0.f;
+    int32 PendingSkillPoints = 0;
+    int32 PendingAttributePoints = 0;
+
+    TArray<FPendingCooldown> PendingCooldowns;
+
+    // ===== Pending discrete events =====
+
+    TArray<FQueuedEvent> QueuedEvents;
+
+    // ===== Flush scratch (reused, so flushing does not allocate) =====
+
+    TArray<FPendingCooldown> FlushCooldowns;
+    TArray<FQueuedEvent> FlushEvents;
+
+    FDelegateHandle PostActorTickHandle;
+
+    // ===== Cross-thread queue =====
+
+    TQueue<FBMEventRecord, EQueueMode::Mpsc> IncomingRecords;
+
+    // Records enqueued but not drained yet; the drain only takes what was there when it started
+    std::atomic<int64> NumIncomingRecords { 0 };
+
+    // Emit order shared by the queued records and the game thread value emits
+    std::atomic<uint64> NextEmitSequence { 1 };
+
+    // Sequence of the newest accepted emit per value channel, and of the record being dispatched (0 outside a drain)
+    uint64 ValueSequences[NumValueChannels] = {};
+    uint64 DispatchingSequence = 0;
+
+    // Stress test validation: last sequence seen per producer
+    TArray<int32> ProbeLastSequence;
+    int64 ProbeReceived = 0;
+    int64 ProbeDuplicates = 0;
+    int64 ProbeGaps = 0;
+
+    // ===== Counters =====
+
+    uint64 TotalEmits = 0;
+    uint64 TotalCoalesced = 0;
+    uint64 TotalBroadcasts = 0;
+
+#if BM_EVENTBUS_INSTRUMENTATION
+    // ===== Instrumentation =====
+
+    FChannelProfile ChannelProfiles[static_cast<int32>(EBMEventChannel::Count)];
+    TArray<FSubscriberProfile> SubscriberProfiles;
+
+    // Set while a profiled broadcast is running, subscriber wrappers only time themselves then
+    bool bProfilingBroadcast = false;
+#endif
 };
@@ -7,6 +7,7 @@
 class UProgressBar;
 class UTextBlock;
 class UBMExperienceComponent;
+class UBMStatsComponent;
 #include "BMHUDWidget.generated.h"
 
 /**
@@ -66,11 +67,14 @@ private:
     FDelegateHandle HealthChangedHandle;
     FDelegateHandle ManaChangedHandle;
     FDelegateHandle StaminaChangedHandle;
-    FDelegateHandle SkillCooldownHandle;
+    FDelegateHandle SkillCooldownStartedHandle;
+    FDelegateHandle SkillCooldownReadyHandle;
     FDelegateHandle LevelChangedHandle;
     // Direct binding to XP component (native delegate) as a fallback
     TWeakObjectPtr<UBMExperienceComponent> CachedXP;
     FDelegateHandle XPLevelUpHandle;
+    // Player stats, read directly while resources regenerate
+    TWeakObjectPtr<UBMStatsComponent> CachedPlayerStats;
 
     // Handle health changed
     void HandleHealthChanged(float Normalized);
@@ -78,8 +82,10 @@ private:
     void HandleManaChanged(float Normalized);
     // Handle stamina changed
     void HandleStaminaChanged(float Normalized);
-    // Handle skill cooldown changed
-    void HandleSkillCooldownChanged(FName SkillId, float RemainingSeconds);
+    // Handle skill cooldown started (absolute end time)
+    void HandleSkillCooldownStarted(FName SkillId, float EndTime, float Duration);
+    // Handle skill cooldown ready
+    void HandleSkillCooldownReady(FName SkillId);
     // Handle level changed
     void HandleLevelChanged(int32 NewLevel);
 
@@ -89,8 +95,17 @@ private:
     // Format cooldown according to UX rules. Returns empty when ready.
     FText FormatCooldownText(float RemainingSeconds) const;
 
-    /** мܵȴʾ */
+    /** Դָڼ䰴ֵˢѪָ̲֡¼ */
+    void UpdateRegeneratingBars();
+
+    /** мܵȴʾɾԽʱʣʱ䣩 */
     void UpdateCooldownDisplays(float DeltaTime);
+
+    /** ͬڽеȴHUD ȴʱ */
+    void SyncActiveCooldowns(APawn* PlayerPawn);
+
+    /** ܶӦȴıؼδʱ nullptr */
+    UTextBlock* FindCooldownText(FName SkillId) const;
     
     /** µܵȴʾ */
     void UpdateSingleCooldownDisplay(FName SkillId, FSkillCooldownData& CooldownData, UTextBlock* TextWidget);
@@ -4,12 +4,20 @@
 #include "UI/BMWidgetBase.h"
 #include "Components/TextBlock.h"
 #include "Components/VerticalBox.h"
+#include "System/Event/BMEventBusSubsystem.h"
 #include "BMNotificationWidget.generated.h"
 
 /**
  * @brief Define the UBMNotificationWidget class
  * @param UBMNotificationWidget The name of the class
  * @param UBMWidgetBase The parent class
+ *
+ * Rows come from a fixed pool of text blocks built once in NativeOnInitialized and recycled, so showing
+ * a message never creates a widget. At most MaxVisibleRows messages are shown, later ones wait in a bounded
+ * queue, higher priorities ahead of lower ones. A message matching one shown or queued within MergeWindow seconds
+ * is merged into it instead of taking a new row: loot amounts are summed, anything else gets an "xN" counter.
+ * Messages arrive as FBMNotifyPayload and are formatted only when they land on a row, with cached patterns.
+ * All rows fade from one feed clock: each message only stores when it was (re)shown.
  */
 UCLASS()
 class BLACKMYTH_API UBMNotificationWidget : public UBMWidgetBase
@@ -24,7 +32,22 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Notification")
     void ShowNotification(const FString& Message);
 
+    // Rows shown at once, also the size of the row pool
+    UPROPERTY(EditAnywhere, Category = "Notification", meta = (ClampMin = "1"))
+    int32 MaxVisibleRows = 5;
+
+    // Messages waiting for a free row, ordered by priority. When full, the oldest message of the lowest queued
+    // priority is dropped, or the new message itself if every queued message has a higher priority
+    UPROPERTY(EditAnywhere, Category = "Notification", meta = (ClampMin = "0"))
+    int32 MaxQueuedMessages = 16;
+
+    // Seconds during which an identical message is merged into the same row as "xN"
+    UPROPERTY(EditAnywhere, Category = "Notification", meta = (ClampMin = "0"))
+    float MergeWindow = 2.f;
+
 protected:
+    // Build the row pool
+    virtual void NativeOnInitialized() override;
     // Bind event bus
     virtual void BindEventBus(class UBMEventBusSubsystem* EventBus) override;
     // Unbind event bus
@@ -36,14 +59,47 @@ private:
     // Notify handle
     FDelegateHandle NotifyHandle;
     // Handle notify
-    void HandleNotify(const FText& Msg);
-
-    // Active notifications created at runtime (parallel arrays)
-    TArray<TWeakObjectPtr<UTextBlock>> ActiveTextWidgets;
-    // Active time remaining
-    TArray<float> ActiveTimeRemaining;
-    // Active opacity
-    TArray<float> ActiveOpacity;
+    void HandleNotify(const FBMNotifyPayload& Payload);
+
+    // One message, shown or queued
+    struct FNotificationEntry
+    {
+        FBMNotifyPayload Payload;
+        // Formatted text, built when the entry lands on a row
+        FText Display;
+        bool bDisplayDirty = true;
+        // Times an identical message was merged in (messages without a summed argument)
+        int32 Count = 1;
+        // Feed time when it was shown or last merged; fading starts InitialDelay later
+        double ShowTime = 0.0;
+    };
+
+    // Find an entry that the payload can merge into, shown or merged within MergeWindow
+    static FNotificationEntry* FindMergeTarget(TArray<FNotificationEntry>& Entries, const FBMNotifyPayload& Payload, double Now, float Window);
+    // Merge the payload into the entry: sum the summed argument, or bump the counter
+    static void MergeInto(FNotificationEntry& Entry, const FBMNotifyPayload& Payload, double Now);
+    // Show the entry on a row, or queue it when all rows are in use
+    void PushEntry(const FBMNotifyPayload& Payload);
+    // Format an entry with the cached pattern of its message
+    FText FormatEntry(const FNotificationEntry& Entry) const;
+    // Write the active entries to the pooled rows and collapse the rest
+    void RefreshRows();
+    // Opacity of an entry at the current feed time
+    float GetEntryOpacity(const FNotificationEntry& Entry) const;
+
+    // Pooled rows, children of MessageList for the lifetime of the widget
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UTextBlock>> RowPool;
+
+    // Entries on rows, top to bottom
+    TArray<FNotificationEntry> ActiveEntries;
+    // Entries waiting for a row, oldest first
+    TArray<FNotificationEntry> QueuedEntries;
+    // Last opacity written to each row, to skip unchanged writes
+    TArray<float> RowOpacity;
+
+    // Feed clock, the single timeline all rows fade on
+    double FeedTime = 0.0;
 
     // Seconds before fade begins
     float InitialDelay = 5.f;